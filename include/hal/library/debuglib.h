@@ -43,6 +43,32 @@
 **/
 void debug_print(IN uintn error_level, IN const char8 *format, ...);
 
+/**
+  Returns TRUE if any bit in error_level is enabled for debug_print().
+
+  It lets a caller skip formatting a debug message, such as a hex dump, which is not printed.
+
+  @param  error_level  The error level of the debug message.
+
+  @retval TRUE   Current error_level is enabled.
+  @retval FALSE  Current error_level is not enabled.
+**/
+boolean debug_print_level_enabled(IN uintn error_level);
+
+/**
+  Returns the error levels enabled for debug_print().
+
+  @return The bitmask of the enabled error levels.
+**/
+uintn get_debug_print_error_level(void);
+
+/**
+  Sets the error levels enabled for debug_print() at runtime.
+
+  @param  error_level  The bitmask of the error levels to enable, for example DEBUG_ERROR only.
+**/
+void set_debug_print_error_level(IN uintn error_level);
+
 /**
   Prints an assert message containing a filename, line number, and description.
   This may be followed by a breakpoint or a dead loop.
@@ -142,6 +168,21 @@ void debug_assert(IN const char8 *file_name, IN uintn line_number,
 #define DEBUG(expression)
 #endif
 
+/**
+  Macro that calls debug_print_level_enabled().
+
+  If MDEPKG_NDEBUG is defined, it is FALSE, so that the code formatting a debug message is removed.
+
+  @param  error_level  The error level of the debug message.
+
+**/
+#if !defined(MDEPKG_NDEBUG)
+#define DEBUG_PRINT_LEVEL_ENABLED(error_level)                                 \
+	debug_print_level_enabled(error_level)
+#else
+#define DEBUG_PRINT_LEVEL_ENABLED(error_level) FALSE
+#endif
+
 /**
   Macro that calls debug_assert() if a return_status evaluates to an error code.
 
@@ -33,6 +33,24 @@ typedef struct {
 	uint16 key_schedule;
 } spdm_device_algorithm_t;
 
+//
+// Hash of a certificate chain which passed the X.509 verification.
+//
+typedef struct {
+	uint32 base_hash_algo;
+	uint8 hash[MAX_HASH_SIZE];
+} spdm_cert_chain_verify_cache_entry_t;
+
+typedef struct {
+	libspdm_lock_func acquire_lock;
+	libspdm_lock_func release_lock;
+	void *lock;
+	uintn entry_count;
+	uintn entry_next;
+	spdm_cert_chain_verify_cache_entry_t
+		entry[MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT];
+} spdm_cert_chain_verify_cache_t;
+
 typedef struct {
 	//
 	// Local device info
@@ -63,6 +81,8 @@ typedef struct {
 	uintn peer_cert_chain_provision_size;
 	// Peer Cert verify
 	libspdm_verify_spdm_cert_chain_func verify_peer_spdm_cert_chain;
+	// Peer Cert chain verification cache, may be shared by SPDM contexts
+	spdm_cert_chain_verify_cache_t *cert_chain_verify_cache;
 	//
 	// PSK provision locally
 	//
@@ -119,12 +139,6 @@ typedef struct {
 	uint8 buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 } large_managed_buffer_t;
 
-typedef struct {
-	uintn max_buffer_size;
-	uintn buffer_size;
-	uint8 buffer[MAX_SPDM_MESSAGE_MEDIUM_BUFFER_SIZE];
-} medium_managed_buffer_t;
-
 typedef struct {
 	uintn max_buffer_size;
 	uintn buffer_size;
@@ -175,6 +189,9 @@ typedef struct {
 	// Ct = certificate chain
 	// K  = Concatenate (KEY_EXCHANGE request, KEY_EXCHANGE response\verify_data)
 	//
+	// Every HMAC is calculated as HMAC(finished_key, Hash(TH)),
+	// so only the running hash of TH needs to be kept.
+	//
 	// TH for FINISH request signature: Concatenate (A, Ct, K, CM, F)
 	// Ct = certificate chain
 	// K  = Concatenate (KEY_EXCHANGE request, KEY_EXCHANGE response)
@@ -216,24 +233,30 @@ typedef struct {
 	// K  = Concatenate (PSK_EXCHANGE request, PSK_EXCHANGE response)
 	// F  = Concatenate (PSK_FINISH request, PSK_FINISH response)
 	//
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+//
+// message F = Concatenate (Hash(mut_cert_chain)*, FINISH request, FINISH response)
+//
+#define MAX_SPDM_MESSAGE_F_DATA_SIZE                                           \
+	(MAX_HASH_SIZE + sizeof(spdm_finish_request_t) + MAX_ASYM_KEY_SIZE +   \
+	 MAX_HASH_SIZE + sizeof(spdm_finish_response_t) + MAX_HASH_SIZE)
+#endif
+
 typedef struct {
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	large_managed_buffer_t message_k;
 	large_managed_buffer_t message_f;
 	large_managed_buffer_t message_m;
 #else
-	// the message_k must be plan text because we do not know the finished_key yet.
-	medium_managed_buffer_t temp_message_k;
 	boolean                message_f_initialized;
-	boolean                finished_key_ready;
 	void                   *digest_context_th;
 	void                   *digest_context_l1l2;
-	void                   *hmac_rsp_context_th;
-	void                   *hmac_req_context_th;
-	// this is back up for message F reset.
-	void                   *digest_context_th_backup;
-	void                   *hmac_rsp_context_th_backup;
-	void                   *hmac_req_context_th_backup;
+	// digest_context_th stops at the end of message K.
+	// message F is short, so it is kept here and only folded into a copy of
+	// digest_context_th when the TH hash is calculated. That makes reset of
+	// message F (FINISH retry) free.
+	uintn                  message_f_data_size;
+	uint8                  message_f_data[MAX_SPDM_MESSAGE_F_DATA_SIZE];
 #endif
 } spdm_session_transcript_t;
 
@@ -246,6 +269,43 @@ typedef struct {
 	void *secured_message_context;
 } spdm_session_info_t;
 
+//
+// Cached measurement summary hash, valid for one measurement generation.
+//
+typedef struct {
+	boolean valid;
+	uint32 generation;
+	spdm_version_number_t spdm_version;
+	uint8 measurement_spec;
+	uint32 measurement_hash_algo;
+	uint32 base_hash_algo;
+	uint8 hash[MAX_HASH_SIZE];
+} spdm_measurement_summary_hash_cache_t;
+
+#define SPDM_MEASUREMENT_SUMMARY_HASH_CACHE_TCB 0
+#define SPDM_MEASUREMENT_SUMMARY_HASH_CACHE_ALL 1
+#define SPDM_MEASUREMENT_SUMMARY_HASH_CACHE_NUM 2
+
+#if LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT
+//
+// Cached unsigned MEASUREMENTS response, valid for one measurement generation.
+//
+typedef struct {
+	boolean valid;
+	uint32 generation;
+	spdm_version_number_t spdm_version;
+	uint8 measurement_spec;
+	uint32 measurement_hash_algo;
+	uint8 request_attribute;
+	uint8 measurement_operation;
+	uintn opaque_measurement_rsp_size;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+} spdm_measurement_response_cache_t;
+#endif
+
+#define MAX_SPDM_REQUEST_RESPONSE_CODE_COUNT 0x100
+
 #define MAX_ENCAP_REQUEST_OP_CODE_SEQUENCE_COUNT 3
 typedef struct {
 	uint32 error_state;
@@ -262,7 +322,21 @@ typedef struct {
 	large_managed_buffer_t certificate_chain_buffer;
 } spdm_encap_context_t;
 
-#define spdm_context_struct_VERSION 0x1
+#define SPDM_STEP_FLOW_NONE 0
+#define SPDM_STEP_FLOW_INIT_CONNECTION 1
+
+typedef struct {
+	uint8 flow;
+	boolean get_version_only;
+	// The request being exchanged. request_size is 0 until it is built.
+	uint8 request_code;
+	boolean request_sent;
+	uint8 retry;
+	uintn request_size;
+	uint8 request[MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE];
+} spdm_step_context_t;
+
+#define spdm_context_struct_VERSION 0x2
 
 typedef struct {
 	uint32 version;
@@ -271,11 +345,29 @@ typedef struct {
 	//
 	libspdm_device_send_message_func send_message;
 	libspdm_device_receive_message_func receive_message;
+	void *sender_buffer;
+	uintn sender_buffer_size;
+	void *receiver_buffer;
+	uintn receiver_buffer_size;
+#if LIBSPDM_DEFAULT_DEVICE_BUFFER_SUPPORT
+	uint8 default_sender_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 default_receiver_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+#endif
+	libspdm_device_acquire_sender_buffer_func acquire_sender_buffer;
+	libspdm_device_release_sender_buffer_func release_sender_buffer;
+	libspdm_device_acquire_receiver_buffer_func acquire_receiver_buffer;
+	libspdm_device_release_receiver_buffer_func release_receiver_buffer;
 	//
 	// Transport Layer infomration
 	//
 	libspdm_transport_encode_message_func transport_encode_message;
 	libspdm_transport_decode_message_func transport_decode_message;
+	//
+	// External transcript backend
+	//
+	libspdm_transcript_append_func transcript_append;
+	libspdm_transcript_reset_func transcript_reset;
+	libspdm_transcript_extend_func transcript_extend;
 
 	//
 	// command status
@@ -302,11 +394,19 @@ typedef struct {
 	//
 	uintn get_response_func;
 	//
+	// Register GetResponse function via request code (responder only)
+	//
+	uintn get_response_func_table[MAX_SPDM_REQUEST_RESPONSE_CODE_COUNT];
+	//
 	// Register GetEncapResponse function (requester only)
 	//
 	uintn get_encap_response_func;
 	spdm_encap_context_t encap_context;
 	//
+	// Non-blocking flow started by libspdm_start_xxx and driven by libspdm_step (requester only)
+	//
+	spdm_step_context_t step_context;
+	//
 	// Register spdm_session_state_callback function (responder only)
 	// Register can know the state after StartSession / EndSession.
 	//
@@ -323,6 +423,20 @@ typedef struct {
 	spdm_connection_info_t connection_info;
 	spdm_transcript_t transcript;
 
+	//
+	// Cached TCB and all measurements summary hash (responder only)
+	//
+	spdm_measurement_summary_hash_cache_t
+		measurement_summary_hash_cache[SPDM_MEASUREMENT_SUMMARY_HASH_CACHE_NUM];
+#if LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT
+	//
+	// Cached unsigned MEASUREMENTS responses (responder only)
+	//
+	spdm_measurement_response_cache_t
+		measurement_response_cache[MAX_SPDM_MEASUREMENT_RESPONSE_CACHE_COUNT];
+	uintn measurement_response_cache_next;
+#endif
+
 	spdm_session_info_t session_info[MAX_SPDM_SESSION_COUNT];
 	//
 	// Cache lastest session ID for HANDSHAKE_IN_THE_CLEAR
@@ -343,6 +457,33 @@ typedef struct {
 	// Register for the retry times when receive "BUSY" Error response (requester only)
 	//
 	uint8 retry_times;
+	//
+	// Register for the wait before a retry or RESPOND_IF_READY (requester only)
+	//
+	libspdm_sleep_func sleep;
+#if LIBSPDM_STATISTICS_SUPPORT
+	//
+	// Statistics, and the function to return the time for them
+	//
+	libspdm_get_time_func get_time;
+	spdm_statistics_t statistics;
+	//
+	// The request waiting for a response, for the round trip statistics (requester only)
+	//
+	uint8 statistics_request_code;
+	uint64 statistics_request_start_time;
+#endif
+#if LIBSPDM_TRACE_SUPPORT
+	//
+	// Register spdm_trace_callback function
+	//
+	uintn spdm_trace_callback[MAX_SPDM_TRACE_CALLBACK_NUM];
+	//
+	// The session ID and the request code of the message being processed, for the trace callbacks
+	//
+	uint32 trace_session_id;
+	uint8 trace_request_code;
+#endif
 
 	//
 	// Opaque context data for use by application
@@ -558,6 +699,91 @@ boolean spdm_calculate_l1l2_hash(IN void *context, IN void *session_info,
 				IN OUT uintn *l1l2_hash_size, OUT void *l1l2_hash);
 #endif
 
+/**
+  Acquire a sender buffer for transport layer message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_msg_size                  size in bytes of the sender buffer.
+  @param  msg_buf_ptr                   A pointer to the sender buffer.
+
+  @retval RETURN_SUCCESS               The sender buffer is acquired.
+  @retval RETURN_OUT_OF_RESOURCES      No sender buffer is registered, and there is no default one.
+**/
+return_status libspdm_acquire_sender_buffer(IN spdm_context_t *spdm_context,
+					    OUT uintn *max_msg_size,
+					    OUT void **msg_buf_ptr);
+
+/**
+  Release a sender buffer for transport layer message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  msg_buf_ptr                   A pointer to the sender buffer.
+**/
+void libspdm_release_sender_buffer(IN spdm_context_t *spdm_context,
+				   IN void *msg_buf_ptr);
+
+/**
+  Acquire a receiver buffer for transport layer message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_msg_size                  size in bytes of the receiver buffer.
+  @param  msg_buf_ptr                   A pointer to the receiver buffer.
+
+  @retval RETURN_SUCCESS               The receiver buffer is acquired.
+  @retval RETURN_OUT_OF_RESOURCES      No receiver buffer is registered, and there is no default one.
+**/
+return_status libspdm_acquire_receiver_buffer(IN spdm_context_t *spdm_context,
+					      OUT uintn *max_msg_size,
+					      OUT void **msg_buf_ptr);
+
+/**
+  Release a receiver buffer for transport layer message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  msg_buf_ptr                   A pointer to the receiver buffer.
+**/
+void libspdm_release_receiver_buffer(IN spdm_context_t *spdm_context,
+				     IN void *msg_buf_ptr);
+
+/**
+  Append a message to the registered external transcript backend.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context, or NULL for a connection transcript.
+  @param  message_type                  The transcript message type.
+  @param  message                       message buffer.
+  @param  message_size                  size in bytes of message buffer.
+
+  @return RETURN_SUCCESS          message is appended, or no external transcript backend is registered.
+  @return others                  message is rejected by the external transcript backend.
+**/
+return_status libspdm_append_transcript_message(IN void *spdm_context, IN void *session_info,
+					      IN spdm_transcript_message_t message_type,
+					      IN void *message, IN uintn message_size);
+
+/**
+  Reset a message in the registered external transcript backend.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context, or NULL for a connection transcript.
+  @param  message_type                  The transcript message type.
+**/
+void libspdm_reset_transcript_message(IN void *spdm_context, IN void *session_info,
+				      IN spdm_transcript_message_t message_type);
+
+/**
+  Extend a finalized transcript digest to the registered external transcript backend.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context, or NULL for a connection transcript.
+  @param  digest_type                   The transcript digest type.
+  @param  digest                        A pointer to the digest.
+  @param  digest_size                   size in bytes of the digest.
+**/
+void libspdm_extend_transcript_digest(IN void *spdm_context, IN void *session_info,
+				      IN spdm_transcript_digest_t digest_type,
+				      IN void *digest, IN uintn digest_size);
+
 /**
   This function generates the certificate chain hash.
 
@@ -584,6 +810,23 @@ boolean spdm_generate_cert_chain_hash(IN spdm_context_t *spdm_context,
 boolean spdm_verify_peer_digests(IN spdm_context_t *spdm_context,
 				 IN void *digest, IN uintn digest_count);
 
+/**
+  This function verifies the integrity of a certificate chain buffer including spdm_cert_chain_t header.
+
+  If a certificate chain verification cache is registered, a certificate chain found in the cache
+  is not verified again, and a certificate chain passing the verification is added to the cache.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+
+  @retval TRUE  certificate chain buffer verification passed.
+  @retval FALSE certificate chain buffer verification failed.
+**/
+boolean spdm_verify_cert_chain_buffer_with_cache(IN spdm_context_t *spdm_context,
+						 IN void *cert_chain_buffer,
+						 IN uintn cert_chain_buffer_size);
+
 /**
   This function verifies peer certificate chain buffer including spdm_cert_chain_t header.
 
@@ -662,6 +905,28 @@ spdm_get_measurement_summary_hash_size(IN spdm_context_t *spdm_context,
 				       IN boolean is_requester,
 				       IN uint8 measurement_summary_hash_type);
 
+/**
+  This function collects the next device measurement block after a measurement index.
+
+  Measurement blocks are collected one at a time, so that the whole measurement
+  record never needs to be held in one buffer.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_index             On input, the index after which to search (0 to start).
+                                       On output, the index of the returned measurement block.
+  @param  measurement_block             A pointer to a destination buffer to store the measurement block.
+  @param  measurement_block_size         On input, indicates the size in bytes of the destination buffer.
+                                       On output, indicates the size in bytes of the measurement block.
+
+  @retval RETURN_SUCCESS               The measurement block is returned.
+  @retval RETURN_NOT_FOUND             There is no measurement block after measurement_index.
+  @retval RETURN_***                   Any other RETURN_ error from spdm_measurement_collection.
+**/
+return_status libspdm_get_next_measurement_block(IN spdm_context_t *spdm_context,
+						 IN OUT uint8 *measurement_index,
+						 OUT void *measurement_block,
+						 IN OUT uintn *measurement_block_size);
+
 /**
   This function calculate the measurement summary hash.
 
@@ -1022,4 +1287,87 @@ spdm_process_opaque_data_supported_version_data(IN spdm_context_t *spdm_context,
   @return the SPDMversion of the version number struct.
 **/
 uint8 spdm_get_version_from_version_number(IN spdm_version_number_t ver);
+
+#if LIBSPDM_STATISTICS_SUPPORT
+/**
+  Return the time for the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The time stamp, or 0 if no time function is registered.
+**/
+uint64 spdm_statistics_get_time(IN spdm_context_t *spdm_context);
+
+/**
+  Record the time of a crypto operation in the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  crypto                        The crypto operation.
+  @param  start_time                    The time returned by spdm_statistics_get_time before the operation.
+**/
+void spdm_statistics_record_crypto(IN spdm_context_t *spdm_context,
+				   IN spdm_statistics_crypto_t crypto,
+				   IN uint64 start_time);
+
+/**
+  Record the time to build the response to a request in the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The SPDM request code.
+  @param  start_time                    The time returned by spdm_statistics_get_time before handling the request.
+**/
+void spdm_statistics_record_response(IN spdm_context_t *spdm_context,
+				     IN uint8 request_code,
+				     IN uint64 start_time);
+
+/**
+  Start the round trip of a request in the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The SPDM request code.
+**/
+void spdm_statistics_start_request(IN spdm_context_t *spdm_context,
+				   IN uint8 request_code);
+
+/**
+  Record the round trip of the request started by spdm_statistics_start_request in the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_statistics_end_request(IN spdm_context_t *spdm_context);
+
+#define SPDM_STATISTICS_ADD(spdm_context, counter, value)                     \
+	((spdm_context)->statistics.counter += (value))
+#else
+#define spdm_statistics_get_time(spdm_context) 0
+#define spdm_statistics_record_crypto(spdm_context, crypto, start_time)      \
+	((void)(start_time))
+#define spdm_statistics_record_response(spdm_context, request_code,          \
+					start_time)                          \
+	((void)(start_time))
+#define spdm_statistics_start_request(spdm_context, request_code)
+#define spdm_statistics_end_request(spdm_context)
+#define SPDM_STATISTICS_ADD(spdm_context, counter, value)
+#endif
+
+#if LIBSPDM_TRACE_SUPPORT
+/**
+  Set the session ID and the request code of the message being processed, for the trace callbacks.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    The session ID of the message, or INVALID_SESSION_ID.
+  @param  request_code                  The SPDM request code of the message, or 0 if it is unknown.
+**/
+void spdm_trace_set_message(IN spdm_context_t *spdm_context,
+			    IN uint32 session_id, IN uint8 request_code);
+
+#define spdm_trace_begin(spdm_context, phase)                                 \
+	libspdm_trace(spdm_context, phase, SPDM_TRACE_EVENT_BEGIN)
+#define spdm_trace_end(spdm_context, phase)                                   \
+	libspdm_trace(spdm_context, phase, SPDM_TRACE_EVENT_END)
+#else
+#define spdm_trace_set_message(spdm_context, session_id, request_code)
+#define spdm_trace_begin(spdm_context, phase)
+#define spdm_trace_end(spdm_context, phase)
+#endif
 #endif
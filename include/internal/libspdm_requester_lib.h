@@ -11,6 +11,39 @@
 #include <library/spdm_secured_message_lib.h>
 #include "internal/libspdm_common_lib.h"
 
+/**
+  This function waits before the next request, if a sleep function is registered.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  duration                      The time to wait, in microseconds.
+**/
+void spdm_requester_sleep(IN spdm_context_t *spdm_context, IN uint64 duration);
+
+/**
+  This function returns the time to wait before retrying a request after a BUSY error.
+
+  The wait doubles on each retry, from SPDM_BUSY_RETRY_BASE_DELAY up to SPDM_BUSY_RETRY_MAX_DELAY,
+  and a random jitter of up to half of the wait is removed, so that requesters do not retry together.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  retry                         The number of retries left, as counted down from retry_times.
+
+  @return The time to wait, in microseconds.
+**/
+uint64 spdm_requester_get_busy_backoff_delay(IN spdm_context_t *spdm_context,
+					     IN uintn retry);
+
+/**
+  This function waits before retrying a request after a BUSY error.
+
+  The wait is returned by spdm_requester_get_busy_backoff_delay.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  retry                         The number of retries left, as counted down from retry_times.
+**/
+void spdm_requester_busy_backoff(IN spdm_context_t *spdm_context,
+				 IN uintn retry);
+
 /**
   This function handles simple error code.
 
@@ -86,6 +119,109 @@ return_status spdm_get_capabilities(IN spdm_context_t *spdm_context);
 **/
 return_status spdm_negotiate_algorithms(IN spdm_context_t *spdm_context);
 
+/**
+  This function builds GET_VERSION request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the request data buffer.
+                                       On input, it means the size in bytes of request data buffer.
+                                       On output, it means the size in bytes of the request.
+  @param  spdm_request                  A pointer to the request data buffer.
+
+  @retval RETURN_SUCCESS               The GET_VERSION is built.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the request.
+**/
+return_status spdm_build_get_version_request(IN spdm_context_t *spdm_context,
+					     IN OUT uintn *spdm_request_size,
+					     OUT void *spdm_request);
+
+/**
+  This function processes VERSION response to GET_VERSION request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the GET_VERSION request.
+  @param  spdm_request                  A pointer to the GET_VERSION request.
+  @param  spdm_response_size             size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The VERSION is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The response cannot be cached.
+**/
+return_status spdm_process_version_response(IN spdm_context_t *spdm_context,
+					    IN uintn spdm_request_size,
+					    IN void *spdm_request,
+					    IN uintn spdm_response_size,
+					    IN void *response);
+
+/**
+  This function builds GET_CAPABILITIES request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the request data buffer.
+                                       On input, it means the size in bytes of request data buffer.
+                                       On output, it means the size in bytes of the request.
+  @param  spdm_request                  A pointer to the request data buffer.
+
+  @retval RETURN_SUCCESS               The GET_CAPABILITIES is built.
+  @retval RETURN_UNSUPPORTED           The connection state is not AFTER_VERSION.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the request.
+**/
+return_status spdm_build_get_capabilities_request(
+	IN spdm_context_t *spdm_context, IN OUT uintn *spdm_request_size,
+	OUT void *spdm_request);
+
+/**
+  This function processes CAPABILITIES response to GET_CAPABILITIES request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the GET_CAPABILITIES request.
+  @param  spdm_request                  A pointer to the GET_CAPABILITIES request.
+  @param  spdm_response_size             size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The CAPABILITIES is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The response cannot be cached.
+**/
+return_status spdm_process_capabilities_response(
+	IN spdm_context_t *spdm_context, IN uintn spdm_request_size,
+	IN void *spdm_request, IN uintn spdm_response_size, IN void *response);
+
+/**
+  This function builds NEGOTIATE_ALGORITHMS request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the request data buffer.
+                                       On input, it means the size in bytes of request data buffer.
+                                       On output, it means the size in bytes of the request.
+  @param  spdm_request                  A pointer to the request data buffer.
+
+  @retval RETURN_SUCCESS               The NEGOTIATE_ALGORITHMS is built.
+  @retval RETURN_UNSUPPORTED           The connection state is not AFTER_CAPABILITIES.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the request.
+**/
+return_status spdm_build_negotiate_algorithms_request(
+	IN spdm_context_t *spdm_context, IN OUT uintn *spdm_request_size,
+	OUT void *spdm_request);
+
+/**
+  This function processes ALGORITHMS response to NEGOTIATE_ALGORITHMS request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the NEGOTIATE_ALGORITHMS request.
+  @param  spdm_request                  A pointer to the NEGOTIATE_ALGORITHMS request.
+  @param  spdm_response_size             size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The ALGORITHMS is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The negotiated algorithms are not supported.
+**/
+return_status spdm_process_algorithms_response(
+	IN spdm_context_t *spdm_context, IN uintn spdm_request_size,
+	IN void *spdm_request, IN uintn spdm_response_size, IN void *response);
+
 /**
   This function sends KEY_EXCHANGE and receives KEY_EXCHANGE_RSP for SPDM key exchange.
 
@@ -397,4 +533,20 @@ return_status spdm_receive_spdm_response(IN spdm_context_t *spdm_context,
 					 IN OUT uintn *response_size,
 					 OUT void *response);
 
+typedef struct {
+	spdm_orchestrator_policy_t policy;
+	spdm_orchestrator_device_t *device;
+	uintn device_count;
+	// The next device to be started, and the number of finished devices.
+	uintn device_next;
+	uintn device_finished;
+	libspdm_lock_func acquire_lock;
+	libspdm_lock_func release_lock;
+	void *lock;
+	libspdm_get_time_func get_time;
+	uint64 start_time;
+	uint64 end_time;
+	spdm_cert_chain_verify_cache_t cert_chain_verify_cache;
+} spdm_orchestrator_t;
+
 #endif
@@ -599,12 +599,14 @@ return_status spdm_process_encap_response_key_update(
 /**
   Return the GET_SPDM_RESPONSE function via request code.
 
+  @param  spdm_context                  The SPDM context for the device.
   @param  request_code                  The SPDM request code.
 
   @return GET_SPDM_RESPONSE function according to the request code.
 **/
 spdm_get_spdm_response_func
-spdm_get_response_func_via_request_code(IN uint8 request_code);
+spdm_get_response_func_via_request_code(IN spdm_context_t *spdm_context,
+					IN uint8 request_code);
 
 /**
   This function initializes the mut_auth encapsulated state.
@@ -655,4 +657,18 @@ void spdm_set_session_state(IN spdm_context_t *spdm_context,
 void spdm_set_connection_state(IN spdm_context_t *spdm_context,
 			       IN spdm_connection_state_t connection_state);
 
+typedef struct {
+	uint32 endpoint_id;
+	spdm_context_t *spdm_context;
+} spdm_responder_engine_endpoint_t;
+
+typedef struct {
+	libspdm_responder_engine_send_message_func send_message;
+	libspdm_responder_engine_receive_message_func receive_message;
+	uintn endpoint_count;
+	spdm_responder_engine_endpoint_t
+		endpoint[MAX_SPDM_RESPONDER_ENGINE_ENDPOINT_COUNT];
+	uint8 receiver_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+} spdm_responder_engine_t;
+
 #endif
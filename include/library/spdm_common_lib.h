@@ -117,6 +117,11 @@ typedef enum {
 	//
 	SPDM_DATA_OPAQUE_CONTEXT_DATA,
 	//
+	// Statistics of the SPDM context, as spdm_statistics_t.
+	// Only available if LIBSPDM_STATISTICS_SUPPORT is enabled.
+	//
+	SPDM_DATA_STATISTICS,
+	//
 	// MAX
 	//
 	SPDM_DATA_MAX,
@@ -138,6 +143,117 @@ typedef struct {
 	uint8 additional_data[4];
 } spdm_data_parameter_t;
 
+//
+// The statistics of an SPDM context, returned by SPDM_DATA_STATISTICS.
+// The times are measured by the function registered by libspdm_register_get_time_func, in its unit.
+//
+// The request statistics are indexed by (request_code - SPDM_STATISTICS_REQUEST_CODE_BASE).
+//
+#define SPDM_STATISTICS_REQUEST_CODE_BASE 0x80
+#define SPDM_STATISTICS_REQUEST_CODE_COUNT 0x80
+
+typedef struct {
+	uint64 count;
+	uint64 total_time;
+	uint64 max_time;
+} spdm_statistics_timer_t;
+
+typedef enum {
+	SPDM_STATISTICS_CRYPTO_SIGN,
+	SPDM_STATISTICS_CRYPTO_VERIFY,
+	SPDM_STATISTICS_CRYPTO_DHE,
+	SPDM_STATISTICS_CRYPTO_AEAD,
+	SPDM_STATISTICS_CRYPTO_HASH,
+	SPDM_STATISTICS_CRYPTO_MAX,
+} spdm_statistics_crypto_t;
+
+typedef struct {
+	//
+	// Responder: the handling of each request in libspdm_build_response.
+	//
+	spdm_statistics_timer_t
+		response[SPDM_STATISTICS_REQUEST_CODE_COUNT];
+	//
+	// Requester: the round trip of each request, from sending the request to receiving the response.
+	//
+	spdm_statistics_timer_t
+		request[SPDM_STATISTICS_REQUEST_CODE_COUNT];
+	//
+	// The transport messages sent and received through the device IO functions.
+	// A responder calling libspdm_process_message sends the response itself,
+	// so the response is not counted in messages_sent.
+	//
+	uint64 messages_sent;
+	uint64 bytes_sent;
+	uint64 messages_received;
+	uint64 bytes_received;
+	//
+	// The time spent in crypto, indexed by spdm_statistics_crypto_t.
+	// AEAD is the encoding and decoding of the secured messages.
+	// HASH is the transcript hash finalization and the local certificate chain hash.
+	//
+	spdm_statistics_timer_t crypto[SPDM_STATISTICS_CRYPTO_MAX];
+	//
+	// Requester: the requests sent again after a BUSY error.
+	//
+	uint64 retry_count;
+	//
+	// Requester: the ResponseNotReady errors received.
+	//
+	uint64 not_ready_count;
+	//
+	// The secured messages which cannot be decrypted.
+	//
+	uint64 decrypt_failure_count;
+} spdm_statistics_t;
+
+//
+// The phases of the SPDM message processing reported to the trace callbacks.
+//
+typedef enum {
+	//
+	// Decode a transport layer message. It includes SPDM_TRACE_PHASE_SECURED_MESSAGE_DECODE.
+	//
+	SPDM_TRACE_PHASE_TRANSPORT_DECODE,
+	//
+	// Decrypt and verify a secured message, reported by the transport layer library.
+	//
+	SPDM_TRACE_PHASE_SECURED_MESSAGE_DECODE,
+	//
+	// Build the response to a request (responder only).
+	//
+	SPDM_TRACE_PHASE_HANDLER,
+	SPDM_TRACE_PHASE_TRANSCRIPT_APPEND,
+	SPDM_TRACE_PHASE_SIGN,
+	SPDM_TRACE_PHASE_VERIFY,
+	//
+	// Generate the DHE key pair, or compute the DHE shared secret.
+	//
+	SPDM_TRACE_PHASE_DHE,
+	//
+	// Derive the session handshake keys or data keys.
+	//
+	SPDM_TRACE_PHASE_KEY_SCHEDULE,
+	//
+	// Encrypt a secured message, reported by the transport layer library.
+	//
+	SPDM_TRACE_PHASE_SECURED_MESSAGE_ENCODE,
+	//
+	// Encode a transport layer message. It includes SPDM_TRACE_PHASE_SECURED_MESSAGE_ENCODE.
+	//
+	SPDM_TRACE_PHASE_TRANSPORT_ENCODE,
+	//
+	// Send a transport layer message through the device IO function.
+	//
+	SPDM_TRACE_PHASE_SEND,
+	SPDM_TRACE_PHASE_MAX,
+} spdm_trace_phase_t;
+
+typedef enum {
+	SPDM_TRACE_EVENT_BEGIN,
+	SPDM_TRACE_EVENT_END,
+} spdm_trace_event_t;
+
 typedef enum {
 	//
 	// Before GET_VERSION/VERSION
@@ -296,6 +412,69 @@ void libspdm_reset_context(IN void *context);
 **/
 uintn libspdm_get_context_size(void);
 
+/**
+  Return the size in bytes of a snapshot of an SPDM context.
+
+  @return the size in bytes of a snapshot of an SPDM context.
+**/
+uintn libspdm_get_context_snapshot_size(void);
+
+/**
+  Save the state of an SPDM context to a snapshot.
+
+  The snapshot is a copy of the SPDM context, including the secured message contexts of the sessions.
+  If LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT is disabled, the transcript hash contexts are duplicated.
+  They are owned by the snapshot, until libspdm_free_context_snapshot is called.
+  The snapshot refers to the same registered functions and provisioned data as the SPDM context,
+  so it is only valid in the same process.
+
+  A test, a fuzzer or a benchmark can set up an SPDM context once, for example to the negotiated state,
+  and then restore it before each iteration, instead of repeating the setup.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  snapshot                      A pointer to the snapshot buffer.
+                                       Its size in bytes can be returned by libspdm_get_context_snapshot_size.
+  @param  snapshot_size                 On input, the size in bytes of the snapshot buffer.
+                                       On output, the size in bytes of the snapshot.
+
+  @retval RETURN_SUCCESS               The snapshot is saved.
+  @retval RETURN_BUFFER_TOO_SMALL      The snapshot buffer is too small. snapshot_size is updated.
+  @retval RETURN_OUT_OF_RESOURCES      A transcript hash context cannot be duplicated.
+**/
+return_status libspdm_snapshot_context(IN void *spdm_context, OUT void *snapshot,
+				       IN OUT uintn *snapshot_size);
+
+/**
+  Restore the state of an SPDM context from a snapshot.
+
+  The SPDM context must be initialized by libspdm_init_context.
+  It may be the SPDM context of the snapshot, or another one. Its previous state is discarded.
+  If LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT is disabled, the transcript hash contexts of the snapshot are duplicated,
+  so that the snapshot can be restored again.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  snapshot                      A pointer to the snapshot saved by libspdm_snapshot_context.
+  @param  snapshot_size                 The size in bytes of the snapshot.
+
+  @retval RETURN_SUCCESS               The SPDM context is restored.
+  @retval RETURN_INVALID_PARAMETER     The snapshot is invalid, or it is saved by another version of the library.
+  @retval RETURN_OUT_OF_RESOURCES      A transcript hash context cannot be duplicated.
+                                       The SPDM context is not changed.
+**/
+return_status libspdm_restore_context(IN OUT void *spdm_context,
+				      IN const void *snapshot,
+				      IN uintn snapshot_size);
+
+/**
+  Free the resources of a snapshot of an SPDM context.
+
+  If LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT is disabled, the transcript hash contexts of the snapshot are freed.
+  The snapshot buffer itself is owned by the caller.
+
+  @param  snapshot                      A pointer to the snapshot saved by libspdm_snapshot_context.
+**/
+void libspdm_free_context_snapshot(IN void *snapshot);
+
 /**
   Send an SPDM transport layer message to a device.
 
@@ -375,6 +554,111 @@ void libspdm_register_device_io_func(
 	IN void *spdm_context, IN libspdm_device_send_message_func send_message,
 	IN libspdm_device_receive_message_func receive_message);
 
+/**
+  Register SPDM device sender and receiver buffers.
+
+  The sender buffer holds the transport layer message sent by libspdm_send_request()
+  and libspdm_responder_dispatch_message().
+  The receiver buffer holds the transport layer message received by libspdm_receive_response()
+  and libspdm_responder_dispatch_message(). After the request is consumed, the responder
+  also uses the receiver buffer to build the plain SPDM response.
+
+  The buffer sizes define the largest transport layer message which can be carried,
+  so they are chosen by the integrator at runtime instead of MAX_SPDM_MESSAGE_BUFFER_SIZE.
+  The buffers must stay valid as long as the SPDM context is used.
+
+  If no buffer is registered, SPDM lib uses the default buffers of MAX_SPDM_MESSAGE_BUFFER_SIZE
+  in the SPDM context (LIBSPDM_DEFAULT_DEVICE_BUFFER_SUPPORT). A NULL buffer restores the default.
+
+  This function must be called after libspdm_init_context, and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sender_buffer                 A pointer to the sender buffer.
+  @param  sender_buffer_size            size in bytes of the sender buffer.
+  @param  receiver_buffer               A pointer to the receiver buffer.
+  @param  receiver_buffer_size          size in bytes of the receiver buffer.
+**/
+void libspdm_register_device_buffer(IN void *spdm_context,
+				    IN void *sender_buffer,
+				    IN uintn sender_buffer_size,
+				    IN void *receiver_buffer,
+				    IN uintn receiver_buffer_size);
+
+/**
+  Acquire a device sender buffer for transport layer message.
+
+  The max_msg_size must be large enough to hold the largest transport layer message,
+  including the transport header, the secured message header, random data, MAC and
+  the transport alignment padding.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_msg_size                  size in bytes of the maximum transport layer message.
+  @param  msg_buf_ptr                   A pointer to a sender buffer.
+
+  @retval RETURN_SUCCESS               The sender buffer is acquired.
+**/
+typedef return_status (*libspdm_device_acquire_sender_buffer_func)(
+	IN void *spdm_context, OUT uintn *max_msg_size, OUT void **msg_buf_ptr);
+
+/**
+  Release a device sender buffer for transport layer message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  msg_buf_ptr                   A pointer to a sender buffer.
+**/
+typedef void (*libspdm_device_release_sender_buffer_func)(
+	IN void *spdm_context, IN void *msg_buf_ptr);
+
+/**
+  Acquire a device receiver buffer for transport layer message.
+
+  The max_msg_size must follow the same rule as the sender buffer.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_msg_size                  size in bytes of the maximum transport layer message.
+  @param  msg_buf_ptr                   A pointer to a receiver buffer.
+
+  @retval RETURN_SUCCESS               The receiver buffer is acquired.
+**/
+typedef return_status (*libspdm_device_acquire_receiver_buffer_func)(
+	IN void *spdm_context, OUT uintn *max_msg_size, OUT void **msg_buf_ptr);
+
+/**
+  Release a device receiver buffer for transport layer message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  msg_buf_ptr                   A pointer to a receiver buffer.
+**/
+typedef void (*libspdm_device_release_receiver_buffer_func)(
+	IN void *spdm_context, IN void *msg_buf_ptr);
+
+/**
+  Register SPDM device buffer management functions.
+
+  They let SPDM lib encode and decode transport layer messages directly in the device
+  driver memory, such as a DMA buffer or a mailbox, instead of its own stack.
+  Each buffer is acquired for one message and released as soon as the message is
+  sent or consumed. At most one sender buffer and one receiver buffer are acquired
+  at the same time.
+
+  If they are NOT registered, the buffers from libspdm_register_device_buffer are used,
+  or the default buffers in the SPDM context.
+
+  This function must be called after libspdm_init_context, and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  acquire_sender_buffer         The fuction to acquire a sender buffer.
+  @param  release_sender_buffer         The fuction to release a sender buffer.
+  @param  acquire_receiver_buffer       The fuction to acquire a receiver buffer.
+  @param  release_receiver_buffer       The fuction to release a receiver buffer.
+**/
+void libspdm_register_device_buffer_func(
+	IN void *spdm_context,
+	IN libspdm_device_acquire_sender_buffer_func acquire_sender_buffer,
+	IN libspdm_device_release_sender_buffer_func release_sender_buffer,
+	IN libspdm_device_acquire_receiver_buffer_func acquire_receiver_buffer,
+	IN libspdm_device_release_receiver_buffer_func release_receiver_buffer);
+
 /**
   Encode an SPDM or APP message to a transport layer message.
 
@@ -499,6 +783,261 @@ void libspdm_register_verify_spdm_cert_chain_func(
 	IN void *spdm_context,
 	IN libspdm_verify_spdm_cert_chain_func verify_spdm_cert_chain);
 
+/**
+  Wait before the next message to a device.
+
+  A blocking requester may just sleep. A requester running in an event loop or a coroutine
+  should yield to other work until the time expires.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  duration                      The time to wait, in microseconds.
+**/
+typedef void (*libspdm_sleep_func)(IN void *spdm_context, IN uint64 duration);
+
+/**
+  Return the current time of a monotonic clock, for example in microseconds.
+
+  @return the current time.
+**/
+typedef uint64 (*libspdm_get_time_func)(void);
+
+/**
+  Register the function returning the time for the statistics of an SPDM context.
+
+  If it is NOT registered, only the counters of the statistics are collected, and the times are 0.
+  If LIBSPDM_STATISTICS_SUPPORT is disabled, this function does nothing.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  get_time                      The fuction to return the time, or NULL.
+**/
+void libspdm_register_get_time_func(IN void *spdm_context,
+				    IN libspdm_get_time_func get_time OPTIONAL);
+
+/**
+  Reset the statistics of an SPDM context.
+
+  If LIBSPDM_STATISTICS_SUPPORT is disabled, this function does nothing.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void libspdm_reset_statistics(IN void *spdm_context);
+
+/**
+  Notify the begin or the end of a phase to a tracer.
+
+  The spans of the phases are nested. They are reported for the message being processed,
+  so the session ID and the request code are known after the message is decoded.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  phase                         The phase of the SPDM message processing.
+  @param  event                         The begin or the end of the phase.
+  @param  session_id                    The session ID of the message, or 0 if it is not a secured message.
+  @param  request_code                  The SPDM request code of the message, or 0 if it is unknown.
+**/
+typedef void (*libspdm_trace_callback_func)(IN void *spdm_context,
+					    IN spdm_trace_phase_t phase,
+					    IN spdm_trace_event_t event,
+					    IN uint32 session_id,
+					    IN uint8 request_code);
+
+/**
+  Register an SPDM trace callback function.
+
+  This function can be called multiple times to let different tracers register its own callback.
+  If LIBSPDM_TRACE_SUPPORT is disabled, this function does nothing.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_trace_callback           The function to be called at the begin and the end of each phase.
+
+  @retval RETURN_SUCCESS          The callback is registered.
+  @retval RETURN_ALREADY_STARTED  No enough memory to register the callback.
+**/
+return_status
+libspdm_register_trace_callback_func(IN void *spdm_context,
+				     IN libspdm_trace_callback_func spdm_trace_callback);
+
+/**
+  Notify the begin or the end of a phase to the registered trace callbacks.
+
+  It is used by the transport layer libraries for the secured message phases.
+  If LIBSPDM_TRACE_SUPPORT is disabled, this function does nothing.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  phase                         The phase of the SPDM message processing.
+  @param  event                         The begin or the end of the phase.
+**/
+void libspdm_trace(IN void *spdm_context, IN spdm_trace_phase_t phase,
+		   IN spdm_trace_event_t event);
+
+/**
+  Acquire or release a lock shared by multiple threads.
+
+  @param  lock                          A pointer to the lock.
+**/
+typedef void (*libspdm_lock_func)(IN void *lock);
+
+/**
+  Return the size in bytes of a certificate chain verification cache.
+
+  @return the size in bytes of a certificate chain verification cache.
+**/
+uintn libspdm_get_cert_chain_verify_cache_size(void);
+
+/**
+  Initialize a certificate chain verification cache.
+
+  The cache remembers the hash of the last MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT certificate chains
+  which pass the X.509 verification of the certificate chain integrity, so that a certificate chain
+  returned by many devices is verified once. The trust anchor is still checked for every device.
+
+  If the cache is shared by SPDM contexts used in different threads, the lock functions must be provided.
+  The cache is not aware of certificate revocation or trust anchor updates. The integrator calls
+  libspdm_invalidate_cert_chain_verify_cache when they change, or periodically to bound the age
+  of a cached verification.
+
+  @param  cache                         A pointer to the certificate chain verification cache.
+  @param  acquire_lock                  The fuction to acquire the lock, if not NULL.
+  @param  release_lock                  The fuction to release the lock, if not NULL.
+  @param  lock                          A pointer to the lock passed to the lock functions.
+**/
+void libspdm_init_cert_chain_verify_cache(IN void *cache,
+					  IN libspdm_lock_func acquire_lock OPTIONAL,
+					  IN libspdm_lock_func release_lock OPTIONAL,
+					  IN void *lock OPTIONAL);
+
+/**
+  Invalidate all certificate chains remembered by a certificate chain verification cache.
+
+  The next certificate chain received by any SPDM context using the cache is fully verified again.
+  It may be called while the cache is in use, with the lock functions of the cache.
+
+  @param  cache                         A pointer to the certificate chain verification cache.
+**/
+void libspdm_invalidate_cert_chain_verify_cache(IN void *cache);
+
+/**
+  Register a certificate chain verification cache in an SPDM context.
+
+  The same cache may be registered in many SPDM contexts. It is used by the default
+  certificate chain verification only.
+
+  This function must be called after libspdm_init_context, and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cache                         A pointer to the certificate chain verification cache, or NULL.
+**/
+void libspdm_register_cert_chain_verify_cache(IN void *spdm_context,
+					      IN void *cache OPTIONAL);
+
+///
+/// The transcript messages which are appended by SPDM lib.
+///
+typedef enum {
+	SPDM_TRANSCRIPT_MESSAGE_A,
+	SPDM_TRANSCRIPT_MESSAGE_B,
+	SPDM_TRANSCRIPT_MESSAGE_C,
+	SPDM_TRANSCRIPT_MESSAGE_MUT_B,
+	SPDM_TRANSCRIPT_MESSAGE_MUT_C,
+	SPDM_TRANSCRIPT_MESSAGE_M,
+	SPDM_TRANSCRIPT_MESSAGE_K,
+	SPDM_TRANSCRIPT_MESSAGE_F,
+	//
+	// MAX
+	//
+	SPDM_TRANSCRIPT_MESSAGE_MAX,
+} spdm_transcript_message_t;
+
+///
+/// The transcript digests which are finalized by SPDM lib.
+///
+typedef enum {
+	SPDM_TRANSCRIPT_DIGEST_M1M2,
+	SPDM_TRANSCRIPT_DIGEST_MUT_M1M2,
+	SPDM_TRANSCRIPT_DIGEST_L1L2,
+	SPDM_TRANSCRIPT_DIGEST_TH1,
+	SPDM_TRANSCRIPT_DIGEST_TH2,
+	//
+	// MAX
+	//
+	SPDM_TRANSCRIPT_DIGEST_MAX,
+} spdm_transcript_digest_t;
+
+/**
+  Append a message to an external transcript.
+
+  It is called after the message is appended to the internal transcript, so it
+  only sees the messages that SPDM lib keeps. The caller may record the message
+  for audit, or just ignore it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicate if the message belongs to a session.
+                                        If session_id is NULL, it is a connection transcript.
+  @param  message_type                  The transcript message type.
+  @param  message                       A pointer to the message.
+  @param  message_size                  size in bytes of the message.
+
+  @retval RETURN_SUCCESS                The message is appended.
+  @retval others                        The message is rejected. The SPDM flow fails.
+**/
+typedef return_status (*libspdm_transcript_append_func)(
+	IN void *spdm_context, IN uint32 *session_id OPTIONAL,
+	IN spdm_transcript_message_t message_type, IN void *message,
+	IN uintn message_size);
+
+/**
+  Reset a message in an external transcript.
+
+  It is called when SPDM lib rolls back a transcript message, such as
+  message F on a FINISH retry or message M on a non GET_MEASUREMENTS request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicate if the message belongs to a session.
+                                        If session_id is NULL, it is a connection transcript.
+  @param  message_type                  The transcript message type.
+**/
+typedef void (*libspdm_transcript_reset_func)(
+	IN void *spdm_context, IN uint32 *session_id OPTIONAL,
+	IN spdm_transcript_message_t message_type);
+
+/**
+  Extend a finalized transcript digest into an external log, such as a
+  measured-boot event log or a TPM PCR.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicate if the digest belongs to a session.
+                                        If session_id is NULL, it is a connection transcript.
+  @param  digest_type                   The transcript digest type.
+  @param  digest                        A pointer to the digest.
+  @param  digest_size                   size in bytes of the digest.
+**/
+typedef void (*libspdm_transcript_extend_func)(
+	IN void *spdm_context, IN uint32 *session_id OPTIONAL,
+	IN spdm_transcript_digest_t digest_type, IN void *digest,
+	IN uintn digest_size);
+
+/**
+  Register an external transcript backend.
+
+  SPDM lib always keeps the transcript it needs for signature and HMAC, either as
+  plain text buffers (LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT) or as running hashes.
+  The external backend is informed of every transcript operation, so that a full
+  transcript can be recorded for audit or the final digests can be extended into
+  a measured-boot log, without building every connection in record mode.
+
+  Any function may be NULL. This function must be called after libspdm_init_context,
+  and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  transcript_append             The fuction to append a transcript message.
+  @param  transcript_reset              The fuction to reset a transcript message.
+  @param  transcript_extend             The fuction to extend a finalized transcript digest.
+**/
+void libspdm_register_transcript_func(
+	IN void *spdm_context,
+	IN libspdm_transcript_append_func transcript_append OPTIONAL,
+	IN libspdm_transcript_reset_func transcript_reset OPTIONAL,
+	IN libspdm_transcript_extend_func transcript_extend OPTIONAL);
+
 /**
   Reset message A cache in SPDM context.
 
@@ -44,6 +44,13 @@ typedef return_status (*spdm_measurement_collection_func)(
 	IN uint8 measurement_index, OUT uint8 *measurement_count,
 	OUT void *measurement, IN OUT uintn *measurement_size);
 
+/**
+  Return the device measurement generation.
+
+  @return the current measurement generation. 0 means unknown.
+**/
+typedef uint32 (*spdm_measurement_generation_func)(void);
+
 /**
   Sign an SPDM message data.
 
@@ -180,6 +187,20 @@ return_status spdm_measurement_collection(
 				    OUT void *measurements,
 				    IN OUT uintn *measurements_size);
 
+/**
+  Return the device measurement generation.
+
+  libspdm caches data derived from the measurements (such as the TCB and all
+  measurements summary hash) and reuses it as long as the generation does not
+  change. The device must return a different value whenever any measurement
+  returned by spdm_measurement_collection() may have changed, for example
+  after a firmware update.
+
+  @return the current measurement generation.
+          0 means the generation is unknown, and nothing is cached.
+**/
+uint32 spdm_measurement_generation(void);
+
 /**
   Sign an SPDM message data.
 
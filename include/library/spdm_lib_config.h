@@ -20,15 +20,50 @@
 
 #define MAX_SPDM_MESSAGE_BUFFER_SIZE 0x1200
 #define MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE 0x100  // to hold message_a before negotiate
-#define MAX_SPDM_MESSAGE_MEDIUM_BUFFER_SIZE 0x300 // to hold message_k before finished_key is ready
 
 #define MAX_SPDM_REQUEST_RETRY_TIMES 3
+// Wait before retrying a request after BUSY, in microseconds, if a sleep function is registered.
+// The wait doubles on each retry up to the max, with a random jitter of up to half of the wait.
+#define SPDM_BUSY_RETRY_BASE_DELAY 1000
+#define SPDM_BUSY_RETRY_MAX_DELAY 1000000
+// Max wait for a ResponseNotReady response (RDT * RDTM), in microseconds.
+#define MAX_SPDM_RESPONSE_NOT_READY_WAIT_TIME 10000000
 #define MAX_SPDM_SESSION_STATE_CALLBACK_NUM 4
 #define MAX_SPDM_CONNECTION_STATE_CALLBACK_NUM 4
 
+// Max SPDM contexts (endpoints) served by one responder engine
+#define MAX_SPDM_RESPONDER_ENGINE_ENDPOINT_COUNT 16
+
+// Max certificate chains remembered by a certificate chain verification cache
+#define MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT 8
+
+// If keep default sender and receiver buffers of MAX_SPDM_MESSAGE_BUFFER_SIZE in the SPDM context.
+// They are used if the integrator does not register its own buffers.
+// Set to 0 if libspdm_register_device_buffer or libspdm_register_device_buffer_func is always called.
+#define LIBSPDM_DEFAULT_DEVICE_BUFFER_SUPPORT 1
+
 // If cache transcript data or transcript hash
 #define LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT 0
 
+// If cache unsigned MEASUREMENTS responses, for requesters polling the same measurements.
+// The cache is invalidated by the device measurement generation.
+// It may be enabled from the build with -DMEASUREMENT_RESPONSE_CACHE=ON.
+#ifndef LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT
+#define LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT 0
+#endif
+#define MAX_SPDM_MEASUREMENT_RESPONSE_CACHE_COUNT 4
+
+// If collect per-context statistics, returned by libspdm_get_data(SPDM_DATA_STATISTICS).
+// The times are only collected if a time function is registered by libspdm_register_get_time_func.
+// It may be enabled from the build with -DSTATISTICS=ON.
+#ifndef LIBSPDM_STATISTICS_SUPPORT
+#define LIBSPDM_STATISTICS_SUPPORT 0
+#endif
+
+// If call the trace callbacks registered by libspdm_register_trace_callback_func.
+#define LIBSPDM_TRACE_SUPPORT 1
+#define MAX_SPDM_TRACE_CALLBACK_NUM 4
+
 //
 // Crypto Configuation
 // In each category, at least one should be selected.
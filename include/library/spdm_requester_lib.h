@@ -51,6 +51,22 @@ return_status libspdm_receive_response(IN void *spdm_context,
 				    IN OUT uintn *response_size,
 				    OUT void *response);
 
+/**
+  Register the function to wait before retrying a request.
+
+  If it is registered, the requester waits RDT (2^RDTExponent microseconds) after a ResponseNotReady
+  error before sending RESPOND_IF_READY, and polls again with a doubling wait until RDT * RDTM.
+  After a BUSY error, it waits with a jittered exponential backoff before retrying the request.
+  If it is not registered, the requester retries at once, and only sends RESPOND_IF_READY once.
+
+  This function must be called after libspdm_init_context, and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sleep                         The fuction to wait, or NULL.
+**/
+void libspdm_register_sleep_func(IN void *spdm_context,
+				 IN libspdm_sleep_func sleep OPTIONAL);
+
 /**
   This function sends GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHMS
   to initialize the connection with SPDM responder.
@@ -67,6 +83,66 @@ return_status libspdm_receive_response(IN void *spdm_context,
 return_status libspdm_init_connection(IN void *spdm_context,
 				   IN boolean get_version_only);
 
+typedef enum {
+	//
+	// The flow is finished. libspdm_step returns the status of the flow.
+	//
+	SPDM_STEP_STATE_DONE,
+	//
+	// The request cannot be sent yet. Call libspdm_step when the device can accept a message.
+	//
+	SPDM_STEP_STATE_NEEDS_SEND,
+	//
+	// The response is not received yet. Call libspdm_step when the device has a message.
+	//
+	SPDM_STEP_STATE_NEEDS_RECEIVE,
+	//
+	// The responder is busy. Call libspdm_step after the returned wait time to send the request again.
+	//
+	SPDM_STEP_STATE_NEEDS_WAIT,
+} spdm_step_state_t;
+
+/**
+  This function starts a non-blocking GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHMS flow
+  to initialize the connection with SPDM responder.
+
+  No message is sent by this function. The flow is driven by libspdm_step.
+  The result is the same as libspdm_init_connection.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  get_version_only               If the requester sends GET_VERSION only or not.
+
+  @retval RETURN_SUCCESS               The flow is started.
+  @retval RETURN_ALREADY_STARTED       Another flow is in progress.
+**/
+return_status libspdm_start_init_connection(IN void *spdm_context,
+					    IN boolean get_version_only);
+
+/**
+  This function drives the non-blocking flow started in the SPDM context.
+
+  In a non-blocking flow, the device IO functions must not wait. They return RETURN_NOT_READY
+  if the message cannot be sent, or no message is received. This function then returns
+  RETURN_SUCCESS with SPDM_STEP_STATE_NEEDS_SEND or SPDM_STEP_STATE_NEEDS_RECEIVE,
+  and the caller calls it again once the device is ready, for example after epoll().
+  This function never sleeps. If the responder is busy, it returns RETURN_SUCCESS with
+  SPDM_STEP_STATE_NEEDS_WAIT and the time the caller waits before the next call.
+  All state of the flow is kept in the SPDM context, so one thread can drive many contexts.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  step_state                    The state of the flow after this step.
+  @param  wait_time                     The time to wait before the next call, in microseconds.
+                                       It is 0 unless step_state is SPDM_STEP_STATE_NEEDS_WAIT.
+
+  @retval RETURN_SUCCESS               The flow is in progress, or it is finished successfully.
+  @retval RETURN_NOT_STARTED           No flow is started.
+  @retval RETURN_OUT_OF_RESOURCES      No sender or receiver buffer can be acquired. The flow is finished.
+  @retval others                       The flow is finished with error, as the blocking function.
+**/
+return_status libspdm_step(IN void *spdm_context,
+			   OUT spdm_step_state_t *step_state,
+			   OUT uint64 *wait_time);
+
 /**
   This function sends GET_DIGEST
   to get all digest of the certificate chains from device.
@@ -315,6 +391,43 @@ return_status libspdm_get_measurement_ex(IN void *context, IN uint32 *session_id
 				   OUT void *requester_nonce OPTIONAL,
 				   OUT void *responder_nonce OPTIONAL);
 
+/**
+  This function sends a batch of GET_MEASUREMENT requests, one per measurement index,
+  to get the measurements from the device.
+
+  The requests are sent back to back. Only the last request carries request_attribute,
+  so that when a signature is requested, a single signature covers L1/L2 of the whole batch.
+  If any request fails, the batch is aborted and L1/L2 is reset.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the last request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  measurement_index_count        The number of entries in measurement_indices.
+  @param  measurement_indices            The measurement indices to get, each in range 1 to 0xFE.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement blocks,
+                                       in the order of measurement_indices.
+  @param  measurement_blocks            An array of measurement_index_count entries to receive a pointer to
+                                       each measurement block in measurement_record, if not NULL.
+
+  @retval RETURN_SUCCESS               The measurements are got successfully.
+  @retval RETURN_INVALID_PARAMETER     The measurement index list is invalid.
+  @retval RETURN_BUFFER_TOO_SMALL      The measurement record buffer is too small.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device,
+                                       or a response does not carry the requested measurement block.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status libspdm_get_measurements_batch(
+	IN void *context, IN uint32 *session_id, IN uint8 request_attribute,
+	IN uint8 slot_id_param, IN uintn measurement_index_count,
+	IN const uint8 *measurement_indices,
+	IN OUT uint32 *measurement_record_length, OUT void *measurement_record,
+	OUT spdm_measurement_block_common_header_t **measurement_blocks OPTIONAL);
+
 /**
   This function sends KEY_EXCHANGE/FINISH or PSK_EXCHANGE/PSK_FINISH
   to start an SPDM Session.
@@ -565,4 +678,137 @@ return_status libspdm_generate_encap_extended_error_response(
 	IN uintn extended_error_data_size, IN uint8 *extended_error_data,
 	IN OUT uintn *spdm_response_size, OUT void *spdm_response);
 
+//
+// The flows run by an attestation orchestrator on each device.
+// GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHMS are always sent first.
+//
+#define SPDM_ORCHESTRATOR_FLOW_INIT_CONNECTION BIT0
+#define SPDM_ORCHESTRATOR_FLOW_GET_DIGEST BIT1
+#define SPDM_ORCHESTRATOR_FLOW_GET_CERTIFICATE BIT2
+#define SPDM_ORCHESTRATOR_FLOW_CHALLENGE BIT3
+#define SPDM_ORCHESTRATOR_FLOW_GET_MEASUREMENT BIT4
+
+typedef struct {
+	// Bitmask of SPDM_ORCHESTRATOR_FLOW_*
+	uint32 flows;
+	uint8 slot_id;
+	// CHALLENGE
+	uint8 measurement_hash_type;
+	// GET_MEASUREMENT
+	uint8 request_attribute;
+	uint8 measurement_operation;
+} spdm_orchestrator_policy_t;
+
+typedef struct {
+	// RETURN_NOT_STARTED until the device is attested.
+	return_status status;
+	// The SPDM_ORCHESTRATOR_FLOW_* which fails, or 0 on success.
+	uint32 failed_flow;
+	// Start time and latency, in the unit of libspdm_get_time_func.
+	uint64 start_time;
+	uint64 latency;
+	// CHALLENGE
+	uint8 slot_mask;
+	uint8 measurement_hash[MAX_HASH_SIZE];
+	// GET_MEASUREMENT
+	uint8 number_of_blocks;
+	uint32 measurement_record_length;
+	uint8 measurement_record[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+} spdm_orchestrator_result_t;
+
+typedef struct {
+	// The SPDM context of the device, with device IO and transport layer functions registered.
+	void *spdm_context;
+	spdm_orchestrator_result_t result;
+} spdm_orchestrator_device_t;
+
+typedef struct {
+	uintn device_count;
+	uintn finished_count;
+	uintn success_count;
+	uintn failure_count;
+	// Per-device latency of the finished devices.
+	uint64 total_latency;
+	uint64 min_latency;
+	uint64 max_latency;
+	// Time from the first device started to the last device finished.
+	uint64 elapsed_time;
+} spdm_orchestrator_statistics_t;
+
+/**
+  Return the size in bytes of an SPDM attestation orchestrator.
+
+  @return the size in bytes of an SPDM attestation orchestrator.
+**/
+uintn libspdm_orchestrator_get_size(void);
+
+/**
+  Initialize an SPDM attestation orchestrator to run a policy on a list of devices.
+
+  Each device has its own SPDM context. The SPDM contexts share one certificate chain
+  verification cache in the orchestrator, so that a certificate chain returned by many devices
+  is verified once. A context with its own verify_spdm_cert_chain function does not use the cache.
+  The cache starts empty on each call, so a new attestation run verifies every certificate chain again.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+  @param  policy                        The flows to run on each device.
+  @param  device                        The devices to attest. The results are stored in this array.
+  @param  device_count                  The number of entries in device.
+**/
+void libspdm_orchestrator_init(IN void *orchestrator,
+			       IN const spdm_orchestrator_policy_t *policy,
+			       IN OUT spdm_orchestrator_device_t *device,
+			       IN uintn device_count);
+
+/**
+  Register the lock functions of an SPDM attestation orchestrator.
+
+  The lock must be registered if libspdm_orchestrator_run_worker is called in multiple threads.
+  It protects the device queue, the statistics and the certificate chain verification cache.
+  It is never held while communicating with a device.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+  @param  acquire_lock                  The fuction to acquire the lock.
+  @param  release_lock                  The fuction to release the lock.
+  @param  lock                          A pointer to the lock passed to the lock functions.
+**/
+void libspdm_orchestrator_register_lock_func(IN void *orchestrator,
+					     IN libspdm_lock_func acquire_lock,
+					     IN libspdm_lock_func release_lock,
+					     IN void *lock);
+
+/**
+  Register the time function of an SPDM attestation orchestrator, to measure the latency.
+
+  If it is not registered, all latency is 0.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+  @param  get_time                      The fuction to get the current time.
+**/
+void libspdm_orchestrator_register_get_time_func(IN void *orchestrator,
+						 IN libspdm_get_time_func get_time);
+
+/**
+  Run a worker of an SPDM attestation orchestrator.
+
+  The worker takes the next device not yet started, runs the policy on it, records the result,
+  and repeats until every device is started. The caller runs a bounded worker pool by calling
+  this function in each of its worker threads, so the pool size limits the devices attested
+  at the same time. One device is only attested by one worker.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+
+  @retval RETURN_SUCCESS               No device is left. The status of each device is in its result.
+**/
+return_status libspdm_orchestrator_run_worker(IN void *orchestrator);
+
+/**
+  Get the aggregate statistics of an SPDM attestation orchestrator.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+  @param  statistics                    The statistics of the finished devices.
+**/
+void libspdm_orchestrator_get_statistics(
+	IN void *orchestrator, OUT spdm_orchestrator_statistics_t *statistics);
+
 #endif
\ No newline at end of file
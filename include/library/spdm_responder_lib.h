@@ -51,6 +51,45 @@ typedef return_status (*libspdm_get_response_func)(
 void libspdm_register_get_response_func(
 	IN void *spdm_context, IN libspdm_get_response_func get_response_func);
 
+/**
+  Process the SPDM request and return the response.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_size                  size in bytes of the request data.
+  @param  request                      A pointer to the request data.
+  @param  response_size                 size in bytes of the response data.
+                                       On input, it means the size in bytes of response data buffer.
+                                       On output, it means the size in bytes of copied response data buffer if RETURN_SUCCESS is returned,
+                                       and means the size in bytes of desired response data buffer if RETURN_BUFFER_TOO_SMALL is returned.
+  @param  response                     A pointer to the response data.
+
+  @retval RETURN_SUCCESS               The request is processed and the response is returned.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the data.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+typedef return_status (*libspdm_get_spdm_response_func)(
+	IN void *spdm_context, IN uintn request_size, IN void *request,
+	IN OUT uintn *response_size, OUT void *response);
+
+/**
+  Register an SPDM request process function for a request code.
+
+  The function is invoked for the request code instead of the default message process function.
+  It can be used to handle vendor defined requests or request codes unknown to libspdm.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The SPDM request code.
+  @param  get_response_func              The function to process the request.
+                                       NULL restores the default message process function.
+
+  @retval RETURN_SUCCESS               The function is registered.
+  @retval RETURN_INVALID_PARAMETER     The request code is not a registrable SPDM request code.
+**/
+return_status libspdm_register_get_response_func_via_request_code(
+	IN void *spdm_context, IN uint8 request_code,
+	IN libspdm_get_spdm_response_func get_response_func);
+
 /**
   Process a SPDM request from a device.
 
@@ -140,6 +179,155 @@ return_status libspdm_process_message(IN void *context, IN OUT uint32 **session_
 **/
 return_status libspdm_responder_dispatch_message(IN void *spdm_context);
 
+/**
+  Send an SPDM transport layer message to an endpoint served by a responder engine.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint, such as MCTP EID or PCI DOE function.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to the message data buffer.
+  @param  timeout                      The timeout, in 100ns units, to use for the execution
+                                       of the message. A timeout value of 0
+                                       means that this function will wait indefinitely for the
+                                       message to execute.
+
+  @retval RETURN_SUCCESS               The SPDM message is sent successfully.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM message is sent to the device.
+  @retval RETURN_TIMEOUT               A timeout occurred while waiting for the SPDM message
+                                       to execute.
+**/
+typedef return_status (*libspdm_responder_engine_send_message_func)(
+	IN void *spdm_responder_engine, IN uint32 endpoint_id,
+	IN uintn message_size, IN void *message, IN uint64 timeout);
+
+/**
+  Receive an SPDM transport layer message from any endpoint served by a responder engine.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint the message is received from.
+  @param  message_size                  size in bytes of the message data buffer.
+                                       On input, it means the size in bytes of message data buffer.
+                                       On output, it means the size in bytes of received message.
+  @param  message                      A pointer to a destination buffer to store the message.
+  @param  timeout                      The timeout, in 100ns units, to use for the execution
+                                       of the message. A timeout value of 0
+                                       means that this function will wait indefinitely for the
+                                       message to execute.
+
+  @retval RETURN_SUCCESS               The SPDM message is received successfully.
+  @retval RETURN_NOT_READY             No message is pending.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM message is received from the device.
+  @retval RETURN_TIMEOUT               A timeout occurred while waiting for the SPDM message
+                                       to execute.
+**/
+typedef return_status (*libspdm_responder_engine_receive_message_func)(
+	IN void *spdm_responder_engine, OUT uint32 *endpoint_id,
+	IN OUT uintn *message_size, OUT void *message, IN uint64 timeout);
+
+/**
+  Return the size in bytes of the SPDM responder engine.
+
+  @return the size in bytes of the SPDM responder engine.
+**/
+uintn libspdm_responder_engine_get_size(void);
+
+/**
+  Initialize an SPDM responder engine.
+
+  A responder engine serves many SPDM contexts from one transport, one context per endpoint.
+  Each context keeps its own connection and session state, and is initialized and configured
+  by the caller as for libspdm_responder_dispatch_message, except for the device IO functions.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  send_message                  The fuction to send an SPDM transport layer message to an endpoint.
+  @param  receive_message               The fuction to receive an SPDM transport layer message from any endpoint.
+**/
+void libspdm_responder_engine_init(
+	IN void *spdm_responder_engine,
+	IN libspdm_responder_engine_send_message_func send_message,
+	IN libspdm_responder_engine_receive_message_func receive_message);
+
+/**
+  Register the SPDM context serving an endpoint in an SPDM responder engine.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint.
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The SPDM context is registered.
+  @retval RETURN_ALREADY_STARTED       The endpoint is already registered.
+  @retval RETURN_OUT_OF_RESOURCES      MAX_SPDM_RESPONDER_ENGINE_ENDPOINT_COUNT endpoints are registered.
+**/
+return_status libspdm_responder_engine_register_context(
+	IN void *spdm_responder_engine, IN uint32 endpoint_id,
+	IN void *spdm_context);
+
+/**
+  Unregister the SPDM context serving an endpoint from an SPDM responder engine.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint.
+
+  @retval RETURN_SUCCESS               The SPDM context is unregistered.
+  @retval RETURN_NOT_FOUND             The endpoint is not registered.
+**/
+return_status libspdm_responder_engine_unregister_context(
+	IN void *spdm_responder_engine, IN uint32 endpoint_id);
+
+/**
+  Return the SPDM context serving an endpoint in an SPDM responder engine.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint.
+
+  @return A pointer to the SPDM context, or NULL if the endpoint is not registered.
+**/
+void *libspdm_responder_engine_get_context(IN void *spdm_responder_engine,
+					   IN uint32 endpoint_id);
+
+/**
+  Process one SPDM transport layer request message from an endpoint and send the response message.
+
+  The response is built in the sender buffer of the SPDM context serving the endpoint.
+  This function may be called concurrently for different endpoints, for example from a worker pool.
+  libspdm does not modify any global state on this path, but the device secret library, the transport
+  send function and any registered callbacks are shared by all endpoints and must be thread safe too.
+  Requests from one endpoint must be processed in order, and contexts must not be registered or
+  unregistered concurrently.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint the request is received from.
+  @param  request_size                  size in bytes of the request data.
+  @param  request                      A pointer to the request data.
+
+  @retval RETURN_SUCCESS               One SPDM request message is processed.
+  @retval RETURN_NOT_FOUND             The endpoint is not registered.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_UNSUPPORTED           One request message is not supported.
+**/
+return_status libspdm_responder_engine_process_message(
+	IN void *spdm_responder_engine, IN uint32 endpoint_id,
+	IN uintn request_size, IN void *request);
+
+/**
+  This is the main dispatch function in SPDM responder engine.
+
+  It receives one request message from any endpoint, processes it with the SPDM context
+  serving the endpoint and sends the response message back to the endpoint.
+
+  It should be called in an event loop when the transport has a pending message.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+
+  @retval RETURN_SUCCESS               One SPDM request message is processed.
+  @retval RETURN_NOT_READY             No message is pending.
+  @retval RETURN_NOT_FOUND             The message is received from an unregistered endpoint.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_UNSUPPORTED           One request message is not supported.
+**/
+return_status
+libspdm_responder_engine_dispatch_message(IN void *spdm_responder_engine);
+
 /**
   Generate ERROR message.
 
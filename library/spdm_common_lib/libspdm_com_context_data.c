@@ -561,6 +561,15 @@ return_status libspdm_get_data(IN void *context, IN spdm_data_type_t data_type,
 		target_data_size = sizeof(void *);
 		target_data = &spdm_context->opaque_context_data_ptr;
 		break;
+#if LIBSPDM_STATISTICS_SUPPORT
+	case SPDM_DATA_STATISTICS:
+		if (parameter->location != SPDM_DATA_LOCATION_LOCAL) {
+			return RETURN_INVALID_PARAMETER;
+		}
+		target_data_size = sizeof(spdm_statistics_t);
+		target_data = &spdm_context->statistics;
+		break;
+#endif
 	default:
 		return RETURN_UNSUPPORTED;
 		break;
@@ -576,6 +585,87 @@ return_status libspdm_get_data(IN void *context, IN spdm_data_type_t data_type,
 	return RETURN_SUCCESS;
 }
 
+/**
+  Append a message to the registered external transcript backend.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context, or NULL for a connection transcript.
+  @param  message_type                  The transcript message type.
+  @param  message                       message buffer.
+  @param  message_size                  size in bytes of message buffer.
+
+  @return RETURN_SUCCESS          message is appended, or no external transcript backend is registered.
+  @return others                  message is rejected by the external transcript backend.
+**/
+return_status libspdm_append_transcript_message(IN void *context, IN void *session_info,
+					      IN spdm_transcript_message_t message_type,
+					      IN void *message, IN uintn message_size)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *spdm_session_info;
+
+	spdm_context = context;
+	spdm_session_info = session_info;
+	if (spdm_context->transcript_append == NULL || message_size == 0) {
+		return RETURN_SUCCESS;
+	}
+	return spdm_context->transcript_append(
+		spdm_context,
+		(spdm_session_info == NULL) ? NULL : &spdm_session_info->session_id,
+		message_type, message, message_size);
+}
+
+/**
+  Reset a message in the registered external transcript backend.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context, or NULL for a connection transcript.
+  @param  message_type                  The transcript message type.
+**/
+void libspdm_reset_transcript_message(IN void *context, IN void *session_info,
+				      IN spdm_transcript_message_t message_type)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *spdm_session_info;
+
+	spdm_context = context;
+	spdm_session_info = session_info;
+	if (spdm_context->transcript_reset == NULL) {
+		return;
+	}
+	spdm_context->transcript_reset(
+		spdm_context,
+		(spdm_session_info == NULL) ? NULL : &spdm_session_info->session_id,
+		message_type);
+}
+
+/**
+  Extend a finalized transcript digest to the registered external transcript backend.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_info                  A pointer to the SPDM session context, or NULL for a connection transcript.
+  @param  digest_type                   The transcript digest type.
+  @param  digest                        A pointer to the digest.
+  @param  digest_size                   size in bytes of the digest.
+**/
+void libspdm_extend_transcript_digest(IN void *context, IN void *session_info,
+				      IN spdm_transcript_digest_t digest_type,
+				      IN void *digest, IN uintn digest_size)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *spdm_session_info;
+
+	spdm_context = context;
+	spdm_session_info = session_info;
+	if (spdm_context->transcript_extend == NULL) {
+		return;
+	}
+	spdm_context->transcript_extend(
+		spdm_context,
+		(spdm_session_info == NULL) ? NULL : &spdm_session_info->session_id,
+		digest_type, digest, digest_size);
+}
+
 /**
   Reset message A cache in SPDM context.
 
@@ -586,6 +676,7 @@ void libspdm_reset_message_a(IN void *context)
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+	libspdm_reset_transcript_message(context, NULL, SPDM_TRANSCRIPT_MESSAGE_A);
 	reset_managed_buffer(&spdm_context->transcript.message_a);
 }
 
@@ -599,6 +690,7 @@ void libspdm_reset_message_b(IN void *context)
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+	libspdm_reset_transcript_message(context, NULL, SPDM_TRANSCRIPT_MESSAGE_B);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	reset_managed_buffer(&spdm_context->transcript.message_b);
 #else
@@ -620,6 +712,7 @@ void libspdm_reset_message_c(IN void *context)
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+	libspdm_reset_transcript_message(context, NULL, SPDM_TRANSCRIPT_MESSAGE_C);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	reset_managed_buffer(&spdm_context->transcript.message_c);
 #else
@@ -641,6 +734,7 @@ void libspdm_reset_message_mut_b(IN void *context)
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+	libspdm_reset_transcript_message(context, NULL, SPDM_TRANSCRIPT_MESSAGE_MUT_B);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	reset_managed_buffer(&spdm_context->transcript.message_mut_b);
 #else
@@ -662,6 +756,7 @@ void libspdm_reset_message_mut_c(IN void *context)
 	spdm_context_t *spdm_context;
 
 	spdm_context = context;
+	libspdm_reset_transcript_message(context, NULL, SPDM_TRANSCRIPT_MESSAGE_MUT_C);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	reset_managed_buffer(&spdm_context->transcript.message_mut_c);
 #else
@@ -688,6 +783,7 @@ void libspdm_reset_message_m(IN void *context, IN void *session_info)
 
 	spdm_context = context;
 	spdm_session_info = session_info;
+	libspdm_reset_transcript_message(context, session_info, SPDM_TRANSCRIPT_MESSAGE_M);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	if (spdm_session_info == NULL) {
 		reset_managed_buffer(&spdm_context->transcript.message_m);
@@ -722,49 +818,20 @@ void libspdm_reset_message_k(IN void *context, IN void *session_info)
 	spdm_session_info_t *spdm_session_info;
 
 	spdm_session_info = session_info;
+	libspdm_reset_transcript_message(context, session_info, SPDM_TRANSCRIPT_MESSAGE_K);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	reset_managed_buffer(&spdm_session_info->session_transcript.message_k);
 #else
 	{
 		spdm_context_t *spdm_context;
-		void *secured_message_context;
-	
-		spdm_context = context;
-		secured_message_context = spdm_session_info->secured_message_context;
 
-		reset_managed_buffer(&spdm_session_info->session_transcript.temp_message_k);
+		spdm_context = context;
 
 		if (spdm_session_info->session_transcript.digest_context_th != NULL) {
 			spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
 				spdm_session_info->session_transcript.digest_context_th);
 			spdm_session_info->session_transcript.digest_context_th = NULL;
 		}
-		if (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL) {
-			spdm_hmac_free_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_rsp_context_th);
-			spdm_session_info->session_transcript.hmac_rsp_context_th = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_req_context_th != NULL) {
-			spdm_hmac_free_with_request_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_req_context_th);
-			spdm_session_info->session_transcript.hmac_req_context_th = NULL;
-		}
-		if (spdm_session_info->session_transcript.digest_context_th_backup != NULL) {
-			spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-				spdm_session_info->session_transcript.digest_context_th_backup);
-			spdm_session_info->session_transcript.digest_context_th_backup = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_rsp_context_th_backup != NULL) {
-			spdm_hmac_free_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_rsp_context_th_backup);
-			spdm_session_info->session_transcript.hmac_rsp_context_th_backup = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_req_context_th_backup != NULL) {
-			spdm_hmac_free_with_request_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_req_context_th_backup);
-			spdm_session_info->session_transcript.hmac_req_context_th_backup = NULL;
-		}
-		spdm_session_info->session_transcript.finished_key_ready = FALSE;
 	}
 #endif
 }
@@ -780,36 +847,16 @@ void libspdm_reset_message_f(IN void *context, IN void *session_info)
 	spdm_session_info_t *spdm_session_info;
 
 	spdm_session_info = session_info;
+	libspdm_reset_transcript_message(context, session_info, SPDM_TRANSCRIPT_MESSAGE_F);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	reset_managed_buffer(&spdm_session_info->session_transcript.message_f);
 #else
-	{
-		spdm_context_t *spdm_context;
-		void *secured_message_context;
-	
-		spdm_context = context;
-		secured_message_context = spdm_session_info->secured_message_context;
-
-		if (spdm_session_info->session_transcript.digest_context_th != NULL) {
-			spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-				spdm_session_info->session_transcript.digest_context_th);
-			spdm_session_info->session_transcript.digest_context_th = spdm_session_info->session_transcript.digest_context_th_backup;
-			spdm_session_info->session_transcript.digest_context_th_backup = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL) {
-			spdm_hmac_free_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_rsp_context_th);
-			spdm_session_info->session_transcript.hmac_rsp_context_th = spdm_session_info->session_transcript.hmac_rsp_context_th_backup;
-			spdm_session_info->session_transcript.hmac_rsp_context_th_backup = NULL;
-		}
-		if (spdm_session_info->session_transcript.hmac_req_context_th != NULL) {
-			spdm_hmac_free_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_req_context_th);
-			spdm_session_info->session_transcript.hmac_req_context_th = spdm_session_info->session_transcript.hmac_req_context_th_backup;
-			spdm_session_info->session_transcript.hmac_req_context_th_backup = NULL;
-		}
-		spdm_session_info->session_transcript.message_f_initialized = FALSE;
-	}
+	//
+	// digest_context_th still holds the state at the end of message K,
+	// so dropping the pending message F data is enough.
+	//
+	spdm_session_info->session_transcript.message_f_data_size = 0;
+	spdm_session_info->session_transcript.message_f_initialized = FALSE;
 #endif
 }
 
@@ -868,16 +915,9 @@ void spdm_reset_message_buffer_via_request_code(IN void *context, IN void *sessi
 	}
 }
 /**
-  Append message A cache in SPDM context.
-
-  @param  spdm_context                  A pointer to the SPDM context.
-  @param  message                      message buffer.
-  @param  message_size                  size in bytes of message buffer.
-
-  @return RETURN_SUCCESS          message is appended.
-  @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
+  Append message A cache in SPDM context, without the trace.
 **/
-return_status libspdm_append_message_a(IN void *context, IN void *message,
+static return_status spdm_append_message_a(IN void *context, IN void *message,
 				    IN uintn message_size)
 {
 	spdm_context_t *spdm_context;
@@ -888,7 +928,7 @@ return_status libspdm_append_message_a(IN void *context, IN void *message,
 }
 
 /**
-  Append message B cache in SPDM context.
+  Append message A cache in SPDM context.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  message                      message buffer.
@@ -897,7 +937,26 @@ return_status libspdm_append_message_a(IN void *context, IN void *message,
   @return RETURN_SUCCESS          message is appended.
   @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
 **/
-return_status libspdm_append_message_b(IN void *context, IN void *message,
+return_status libspdm_append_message_a(IN void *context, IN void *message,
+				    IN uintn message_size)
+{
+	return_status status;
+
+	spdm_trace_begin(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	status = spdm_append_message_a(context, message, message_size);
+	if (!RETURN_ERROR(status)) {
+		status = libspdm_append_transcript_message(
+			context, NULL, SPDM_TRANSCRIPT_MESSAGE_A,
+			message, message_size);
+	}
+	spdm_trace_end(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	return status;
+}
+
+/**
+  Append message B cache in SPDM context, without the trace.
+**/
+static return_status spdm_append_message_b(IN void *context, IN void *message,
 				    IN uintn message_size)
 {
 	spdm_context_t *spdm_context;
@@ -924,7 +983,7 @@ return_status libspdm_append_message_b(IN void *context, IN void *message,
 }
 
 /**
-  Append message C cache in SPDM context.
+  Append message B cache in SPDM context.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  message                      message buffer.
@@ -933,7 +992,26 @@ return_status libspdm_append_message_b(IN void *context, IN void *message,
   @return RETURN_SUCCESS          message is appended.
   @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
 **/
-return_status libspdm_append_message_c(IN void *context, IN void *message,
+return_status libspdm_append_message_b(IN void *context, IN void *message,
+				    IN uintn message_size)
+{
+	return_status status;
+
+	spdm_trace_begin(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	status = spdm_append_message_b(context, message, message_size);
+	if (!RETURN_ERROR(status)) {
+		status = libspdm_append_transcript_message(
+			context, NULL, SPDM_TRANSCRIPT_MESSAGE_B,
+			message, message_size);
+	}
+	spdm_trace_end(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	return status;
+}
+
+/**
+  Append message C cache in SPDM context, without the trace.
+**/
+static return_status spdm_append_message_c(IN void *context, IN void *message,
 				    IN uintn message_size)
 {
 	spdm_context_t *spdm_context;
@@ -960,7 +1038,7 @@ return_status libspdm_append_message_c(IN void *context, IN void *message,
 }
 
 /**
-  Append message MutB cache in SPDM context.
+  Append message C cache in SPDM context.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  message                      message buffer.
@@ -969,7 +1047,26 @@ return_status libspdm_append_message_c(IN void *context, IN void *message,
   @return RETURN_SUCCESS          message is appended.
   @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
 **/
-return_status libspdm_append_message_mut_b(IN void *context, IN void *message,
+return_status libspdm_append_message_c(IN void *context, IN void *message,
+				    IN uintn message_size)
+{
+	return_status status;
+
+	spdm_trace_begin(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	status = spdm_append_message_c(context, message, message_size);
+	if (!RETURN_ERROR(status)) {
+		status = libspdm_append_transcript_message(
+			context, NULL, SPDM_TRANSCRIPT_MESSAGE_C,
+			message, message_size);
+	}
+	spdm_trace_end(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	return status;
+}
+
+/**
+  Append message MutB cache in SPDM context, without the trace.
+**/
+static return_status spdm_append_message_mut_b(IN void *context, IN void *message,
 					IN uintn message_size)
 {
 	spdm_context_t *spdm_context;
@@ -992,7 +1089,7 @@ return_status libspdm_append_message_mut_b(IN void *context, IN void *message,
 }
 
 /**
-  Append message MutC cache in SPDM context.
+  Append message MutB cache in SPDM context.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  message                      message buffer.
@@ -1001,7 +1098,26 @@ return_status libspdm_append_message_mut_b(IN void *context, IN void *message,
   @return RETURN_SUCCESS          message is appended.
   @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
 **/
-return_status libspdm_append_message_mut_c(IN void *context, IN void *message,
+return_status libspdm_append_message_mut_b(IN void *context, IN void *message,
+					IN uintn message_size)
+{
+	return_status status;
+
+	spdm_trace_begin(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	status = spdm_append_message_mut_b(context, message, message_size);
+	if (!RETURN_ERROR(status)) {
+		status = libspdm_append_transcript_message(
+			context, NULL, SPDM_TRANSCRIPT_MESSAGE_MUT_B,
+			message, message_size);
+	}
+	spdm_trace_end(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	return status;
+}
+
+/**
+  Append message MutC cache in SPDM context, without the trace.
+**/
+static return_status spdm_append_message_mut_c(IN void *context, IN void *message,
 					IN uintn message_size)
 {
 	spdm_context_t *spdm_context;
@@ -1024,19 +1140,35 @@ return_status libspdm_append_message_mut_c(IN void *context, IN void *message,
 }
 
 /**
-  Append message M cache in SPDM context.
-  If session_info is NULL, this function will use M cache of SPDM context,
-  else will use M cache of SPDM session context.
+  Append message MutC cache in SPDM context.
 
   @param  spdm_context                  A pointer to the SPDM context.
-  @param  session_info                  A pointer to the SPDM session context.
   @param  message                      message buffer.
   @param  message_size                  size in bytes of message buffer.
 
   @return RETURN_SUCCESS          message is appended.
   @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
 **/
-return_status libspdm_append_message_m(IN void *context, IN void *session_info,
+return_status libspdm_append_message_mut_c(IN void *context, IN void *message,
+					IN uintn message_size)
+{
+	return_status status;
+
+	spdm_trace_begin(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	status = spdm_append_message_mut_c(context, message, message_size);
+	if (!RETURN_ERROR(status)) {
+		status = libspdm_append_transcript_message(
+			context, NULL, SPDM_TRANSCRIPT_MESSAGE_MUT_C,
+			message, message_size);
+	}
+	spdm_trace_end(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	return status;
+}
+
+/**
+  Append message M cache in SPDM context, without the trace.
+**/
+static return_status spdm_append_message_m(IN void *context, IN void *session_info,
 					IN void *message, IN uintn message_size)
 {
 	spdm_context_t *spdm_context;
@@ -1078,18 +1210,39 @@ return_status libspdm_append_message_m(IN void *context, IN void *session_info,
 }
 
 /**
-  Append message K cache in SPDM context.
+  Append message M cache in SPDM context.
+  If session_info is NULL, this function will use M cache of SPDM context,
+  else will use M cache of SPDM session context.
 
   @param  spdm_context                  A pointer to the SPDM context.
-  @param  spdm_session_info              A pointer to the SPDM session context.
-  @param  is_requester                  Indicate of the key generation for a requester or a responder.
+  @param  session_info                  A pointer to the SPDM session context.
   @param  message                      message buffer.
   @param  message_size                  size in bytes of message buffer.
 
   @return RETURN_SUCCESS          message is appended.
   @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
 **/
-return_status libspdm_append_message_k(IN void *context, IN void *session_info,
+return_status libspdm_append_message_m(IN void *context, IN void *session_info,
+					IN void *message, IN uintn message_size)
+{
+	return_status status;
+
+	spdm_trace_begin(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	status = spdm_append_message_m(context, session_info, message,
+				       message_size);
+	if (!RETURN_ERROR(status)) {
+		status = libspdm_append_transcript_message(
+			context, session_info, SPDM_TRANSCRIPT_MESSAGE_M,
+			message, message_size);
+	}
+	spdm_trace_end(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	return status;
+}
+
+/**
+  Append message K cache in SPDM context, without the trace.
+**/
+static return_status spdm_append_message_k(IN void *context, IN void *session_info,
             IN boolean is_requester, IN void *message, IN uintn message_size)
 {
 	spdm_session_info_t *spdm_session_info;
@@ -1102,18 +1255,22 @@ return_status libspdm_append_message_k(IN void *context, IN void *session_info,
 #else
 	{
 		spdm_context_t *spdm_context;
-		void *secured_message_context;
 		uint8 *cert_chain_buffer;
 		uintn cert_chain_buffer_size;
 		boolean result;
 		uint8 cert_chain_buffer_hash[MAX_HASH_SIZE];
 		uint32 hash_size;
-		boolean finished_key_ready;
 
 		spdm_context = context;
-		secured_message_context = spdm_session_info->secured_message_context;
-		finished_key_ready = spdm_secured_message_is_finished_key_ready(secured_message_context);
 
+		//
+		// The HMAC is calculated over Hash(TH), so only the running hash is kept here.
+		// There is no need to cache message_k until the finished_key is ready.
+		//
+
+		//
+		// prepare digest_context_th
+		//
 		if (spdm_session_info->session_transcript.digest_context_th == NULL) {
 			if (!spdm_session_info->use_psk) {
 				if (is_requester) {
@@ -1124,7 +1281,7 @@ return_status libspdm_append_message_k(IN void *context, IN void *session_info,
 						spdm_context, (void **)&cert_chain_buffer, &cert_chain_buffer_size);
 				}
 				if (!result) {
-					return FALSE;
+					return RETURN_UNSUPPORTED;
 				}
 				hash_size = spdm_get_hash_size(
 					spdm_context->connection_info.algorithm.base_hash_algo);
@@ -1133,92 +1290,33 @@ return_status libspdm_append_message_k(IN void *context, IN void *session_info,
 					cert_chain_buffer, cert_chain_buffer_size,
 					cert_chain_buffer_hash);
 			}
-		}
 
-		//
-		// prepare digest_context_th
-		//
-		if (spdm_session_info->session_transcript.digest_context_th == NULL) {
 			spdm_session_info->session_transcript.digest_context_th = spdm_hash_new (
 				spdm_context->connection_info.algorithm.base_hash_algo);
+			if (spdm_session_info->session_transcript.digest_context_th == NULL) {
+				return RETURN_OUT_OF_RESOURCES;
+			}
 			spdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
 				spdm_session_info->session_transcript.digest_context_th);
 			spdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
 				spdm_session_info->session_transcript.digest_context_th,
 				get_managed_buffer(&spdm_context->transcript.message_a),
 				get_managed_buffer_size(&spdm_context->transcript.message_a));
-			append_managed_buffer(
-				&spdm_session_info->session_transcript.temp_message_k,
-				get_managed_buffer(&spdm_context->transcript.message_a),
-				get_managed_buffer_size(&spdm_context->transcript.message_a));
 			if (!spdm_session_info->use_psk) {
 				spdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
 					spdm_session_info->session_transcript.digest_context_th,
 					cert_chain_buffer_hash, hash_size);
-				append_managed_buffer(
-					&spdm_session_info->session_transcript.temp_message_k,
-					cert_chain_buffer_hash, hash_size);
 			}
 		}
-		spdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-			spdm_session_info->session_transcript.digest_context_th, message, message_size);
-		if (!finished_key_ready) {
-			//
-			// append message only if finished_key is NOT ready.
-			//
-			append_managed_buffer(
-				&spdm_session_info->session_transcript.temp_message_k, message, message_size);
-		}
-
-		//
-		// Above action is to calculate HASH for message_k.
-		// However, we cannot use similar way to calculate HMAC. (chicken-egg problem)
-		// HMAC need finished_key, and finished_key calculation need message_k.
-		// If the finished_key is NOT ready, then we cannot calculate HMAC. We have to cache to temp_message_k and stop here.
-		// If the finished_key is ready, then we can start calculating HMAC. No need to cache temp_message_k.
-		//
-		if (!finished_key_ready) {
-			return RETURN_SUCCESS;
-		}
-
-		//
-		// prepare hmac_rsp_context_th
-		//
-		if (spdm_session_info->session_transcript.hmac_rsp_context_th == NULL) {
-			spdm_session_info->session_transcript.hmac_rsp_context_th = spdm_hmac_new_with_response_finished_key (
-				secured_message_context);
-			spdm_hmac_init_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_rsp_context_th);
-			spdm_hmac_update_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_rsp_context_th,
-				get_managed_buffer(&spdm_session_info->session_transcript.temp_message_k),
-				get_managed_buffer_size(&spdm_session_info->session_transcript.temp_message_k));
-		}
-		spdm_hmac_update_with_response_finished_key (secured_message_context,
-			spdm_session_info->session_transcript.hmac_rsp_context_th, message, message_size);
-
-		//
-		// prepare hmac_req_context_th
-		//
-		if (spdm_session_info->session_transcript.hmac_req_context_th == NULL) {
-			spdm_session_info->session_transcript.hmac_req_context_th = spdm_hmac_new_with_request_finished_key (
-				secured_message_context);
-			spdm_hmac_init_with_request_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_req_context_th);
-			spdm_hmac_update_with_request_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_req_context_th,
-				get_managed_buffer(&spdm_session_info->session_transcript.temp_message_k),
-				get_managed_buffer_size(&spdm_session_info->session_transcript.temp_message_k));
-		}
-		spdm_hmac_update_with_request_finished_key (secured_message_context,
-			spdm_session_info->session_transcript.hmac_req_context_th, message, message_size);
-		return RETURN_SUCCESS;
+		return spdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
+			spdm_session_info->session_transcript.digest_context_th, message, message_size) ?
+			RETURN_SUCCESS : RETURN_DEVICE_ERROR;
 	}
 #endif
 }
 
 /**
-  Append message F cache in SPDM context.
+  Append message K cache in SPDM context.
 
   @param  spdm_context                  A pointer to the SPDM context.
   @param  spdm_session_info              A pointer to the SPDM session context.
@@ -1229,7 +1327,27 @@ return_status libspdm_append_message_k(IN void *context, IN void *session_info,
   @return RETURN_SUCCESS          message is appended.
   @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
 **/
-return_status libspdm_append_message_f(IN void *context, IN void *session_info, 
+return_status libspdm_append_message_k(IN void *context, IN void *session_info,
+            IN boolean is_requester, IN void *message, IN uintn message_size)
+{
+	return_status status;
+
+	spdm_trace_begin(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	status = spdm_append_message_k(context, session_info, is_requester,
+				       message, message_size);
+	if (!RETURN_ERROR(status)) {
+		status = libspdm_append_transcript_message(
+			context, session_info, SPDM_TRANSCRIPT_MESSAGE_K,
+			message, message_size);
+	}
+	spdm_trace_end(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	return status;
+}
+
+/**
+  Append message F cache in SPDM context, without the trace.
+**/
+static return_status spdm_append_message_f(IN void *context, IN void *session_info, 
             IN boolean is_requester, IN void *message, IN uintn message_size)
 {
 	spdm_session_info_t *spdm_session_info;
@@ -1242,33 +1360,29 @@ return_status libspdm_append_message_f(IN void *context, IN void *session_info,
 #else
 	{
 		spdm_context_t *spdm_context;
-		void *secured_message_context;
 		uint8 *mut_cert_chain_buffer;
 		uintn mut_cert_chain_buffer_size;
 		boolean result;
-		uint8 mut_cert_chain_buffer_hash[MAX_HASH_SIZE];
 		uint32 hash_size;
-		boolean finished_key_ready;
+		return_status status;
+		spdm_session_transcript_t *session_transcript;
 
 		spdm_context = context;
-		secured_message_context = spdm_session_info->secured_message_context;
-		finished_key_ready = spdm_secured_message_is_finished_key_ready(secured_message_context);
-		ASSERT (finished_key_ready);
+		session_transcript = &spdm_session_info->session_transcript;
 
-		if (!spdm_session_info->session_transcript.message_f_initialized) {
+		if (!session_transcript->message_f_initialized) {
 			//
 			// digest_context_th might be NULL in unit test, where message_k is hardcoded.
-			// hmac_{rsp,req}_context_th might be NULL in real case, because
-			//   after finished_key_ready is generated, no one trigger libspdm_append_message_k.
-			// trigger message_k to initialize by using zero length message_k, no impact to hash or HMAC.
-			//   only temp_message_k is appended.
+			// trigger message_k to initialize by using zero length message_k, no impact to hash.
 			//
-			if (spdm_session_info->session_transcript.digest_context_th == NULL ||
-				spdm_session_info->session_transcript.hmac_rsp_context_th == NULL ||
-				spdm_session_info->session_transcript.hmac_req_context_th == NULL) {
-				libspdm_append_message_k (context, session_info, is_requester, NULL, 0);
+			if (session_transcript->digest_context_th == NULL) {
+				status = libspdm_append_message_k (context, session_info, is_requester, NULL, 0);
+				if (RETURN_ERROR(status)) {
+					return status;
+				}
 			}
 
+			session_transcript->message_f_data_size = 0;
 			if (!spdm_session_info->use_psk && spdm_session_info->mut_auth_requested) {
 				if (is_requester) {
 					result = libspdm_get_local_cert_chain_buffer(
@@ -1287,81 +1401,62 @@ return_status libspdm_append_message_f(IN void *context, IN void *session_info,
 
 				hash_size = spdm_get_hash_size(
 					spdm_context->connection_info.algorithm.base_hash_algo);
-				spdm_hash_all(
+				result = spdm_hash_all(
 					spdm_context->connection_info.algorithm.base_hash_algo,
 					mut_cert_chain_buffer, mut_cert_chain_buffer_size,
-					mut_cert_chain_buffer_hash);
+					session_transcript->message_f_data);
+				if (!result) {
+					return RETURN_DEVICE_ERROR;
+				}
+				session_transcript->message_f_data_size = hash_size;
 			}
-
-			//
-			// It is first time call, backup current message_k context
-			// this backup will be used in reset_message_f.
-			//
-			ASSERT (spdm_session_info->session_transcript.digest_context_th != NULL);
-			spdm_session_info->session_transcript.digest_context_th_backup = spdm_hash_new (
-				spdm_context->connection_info.algorithm.base_hash_algo);
-			spdm_hash_duplicate (spdm_context->connection_info.algorithm.base_hash_algo,
-				spdm_session_info->session_transcript.digest_context_th,
-				spdm_session_info->session_transcript.digest_context_th_backup);
-
-			ASSERT (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL);
-			spdm_session_info->session_transcript.hmac_rsp_context_th_backup = spdm_hmac_new_with_response_finished_key (
-				secured_message_context);
-			spdm_hmac_duplicate_with_response_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_rsp_context_th,
-				spdm_session_info->session_transcript.hmac_rsp_context_th_backup);
-
-			ASSERT (spdm_session_info->session_transcript.hmac_req_context_th != NULL);
-			spdm_session_info->session_transcript.hmac_req_context_th_backup = spdm_hmac_new_with_request_finished_key (
-				secured_message_context);
-			spdm_hmac_duplicate_with_request_finished_key (secured_message_context,
-				spdm_session_info->session_transcript.hmac_req_context_th,
-				spdm_session_info->session_transcript.hmac_req_context_th_backup);
+			session_transcript->message_f_initialized = TRUE;
 		}
 
 		//
-		// prepare digest_context_th
+		// message F is not hashed into digest_context_th here,
+		// so that reset_message_f does not need a backup of it.
 		//
-		ASSERT (spdm_session_info->session_transcript.digest_context_th != NULL);
-		if (!spdm_session_info->session_transcript.message_f_initialized) {
-			if (!spdm_session_info->use_psk && spdm_session_info->mut_auth_requested) {
-				spdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-					spdm_session_info->session_transcript.digest_context_th, mut_cert_chain_buffer_hash, hash_size);
-			}
+		if (message_size > sizeof(session_transcript->message_f_data) -
+					   session_transcript->message_f_data_size) {
+			return RETURN_OUT_OF_RESOURCES;
 		}
-		spdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-			spdm_session_info->session_transcript.digest_context_th, message, message_size);
+		copy_mem(session_transcript->message_f_data +
+				 session_transcript->message_f_data_size,
+			 message, message_size);
+		session_transcript->message_f_data_size += message_size;
+		return RETURN_SUCCESS;
+	}
+#endif
+}
 
-		//
-		// prepare hmac_rsp_context_th
-		//
-		ASSERT (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL);
-		if (!spdm_session_info->session_transcript.message_f_initialized) {
-			if (!spdm_session_info->use_psk && spdm_session_info->mut_auth_requested) {
-				spdm_hmac_update_with_response_finished_key (secured_message_context,
-					spdm_session_info->session_transcript.hmac_rsp_context_th, mut_cert_chain_buffer_hash, hash_size);
-			}
-		}
-		spdm_hmac_update_with_response_finished_key (secured_message_context,
-			spdm_session_info->session_transcript.hmac_rsp_context_th, message, message_size);
+/**
+  Append message F cache in SPDM context.
 
-		//
-		// prepare hmac_req_context_th
-		//
-		ASSERT (spdm_session_info->session_transcript.hmac_req_context_th != NULL);
-		if (!spdm_session_info->session_transcript.message_f_initialized) {
-			if (!spdm_session_info->use_psk && spdm_session_info->mut_auth_requested) {
-				spdm_hmac_update_with_request_finished_key (secured_message_context,
-					spdm_session_info->session_transcript.hmac_req_context_th, mut_cert_chain_buffer_hash, hash_size);
-			}
-		}
-		spdm_hmac_update_with_request_finished_key (secured_message_context,
-			spdm_session_info->session_transcript.hmac_req_context_th, message, message_size);
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_session_info              A pointer to the SPDM session context.
+  @param  is_requester                  Indicate of the key generation for a requester or a responder.
+  @param  message                      message buffer.
+  @param  message_size                  size in bytes of message buffer.
 
-		spdm_session_info->session_transcript.message_f_initialized = TRUE;
-		return RETURN_SUCCESS;
+  @return RETURN_SUCCESS          message is appended.
+  @return RETURN_OUT_OF_RESOURCES message is not appended because the internal cache is full.
+**/
+return_status libspdm_append_message_f(IN void *context, IN void *session_info, 
+            IN boolean is_requester, IN void *message, IN uintn message_size)
+{
+	return_status status;
+
+	spdm_trace_begin(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	status = spdm_append_message_f(context, session_info, is_requester,
+				       message, message_size);
+	if (!RETURN_ERROR(status)) {
+		status = libspdm_append_transcript_message(
+			context, session_info, SPDM_TRANSCRIPT_MESSAGE_F,
+			message, message_size);
 	}
-#endif
+	spdm_trace_end(context, SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	return status;
 }
 
 /**
@@ -1457,6 +1552,155 @@ void libspdm_register_device_io_func(
 	return;
 }
 
+/**
+  Register SPDM device sender and receiver buffers.
+
+  This function must be called after libspdm_init_context, and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sender_buffer                 A pointer to the sender buffer.
+  @param  sender_buffer_size            size in bytes of the sender buffer.
+  @param  receiver_buffer               A pointer to the receiver buffer.
+  @param  receiver_buffer_size          size in bytes of the receiver buffer.
+**/
+void libspdm_register_device_buffer(IN void *context,
+				    IN void *sender_buffer,
+				    IN uintn sender_buffer_size,
+				    IN void *receiver_buffer,
+				    IN uintn receiver_buffer_size)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->sender_buffer = sender_buffer;
+	spdm_context->sender_buffer_size = sender_buffer_size;
+	spdm_context->receiver_buffer = receiver_buffer;
+	spdm_context->receiver_buffer_size = receiver_buffer_size;
+	return;
+}
+
+/**
+  Register SPDM device buffer management functions.
+
+  This function must be called after libspdm_init_context, and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  acquire_sender_buffer         The fuction to acquire a sender buffer.
+  @param  release_sender_buffer         The fuction to release a sender buffer.
+  @param  acquire_receiver_buffer       The fuction to acquire a receiver buffer.
+  @param  release_receiver_buffer       The fuction to release a receiver buffer.
+**/
+void libspdm_register_device_buffer_func(
+	IN void *context,
+	IN libspdm_device_acquire_sender_buffer_func acquire_sender_buffer,
+	IN libspdm_device_release_sender_buffer_func release_sender_buffer,
+	IN libspdm_device_acquire_receiver_buffer_func acquire_receiver_buffer,
+	IN libspdm_device_release_receiver_buffer_func release_receiver_buffer)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->acquire_sender_buffer = acquire_sender_buffer;
+	spdm_context->release_sender_buffer = release_sender_buffer;
+	spdm_context->acquire_receiver_buffer = acquire_receiver_buffer;
+	spdm_context->release_receiver_buffer = release_receiver_buffer;
+	return;
+}
+
+/**
+  Acquire a sender buffer for transport layer message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_msg_size                  size in bytes of the sender buffer.
+  @param  msg_buf_ptr                   A pointer to the sender buffer.
+
+  @retval RETURN_SUCCESS               The sender buffer is acquired.
+  @retval RETURN_OUT_OF_RESOURCES      No sender buffer is registered, and there is no default one.
+**/
+return_status libspdm_acquire_sender_buffer(IN spdm_context_t *spdm_context,
+					    OUT uintn *max_msg_size,
+					    OUT void **msg_buf_ptr)
+{
+	if (spdm_context->acquire_sender_buffer != NULL) {
+		return spdm_context->acquire_sender_buffer(
+			spdm_context, max_msg_size, msg_buf_ptr);
+	}
+	if (spdm_context->sender_buffer != NULL) {
+		*max_msg_size = spdm_context->sender_buffer_size;
+		*msg_buf_ptr = spdm_context->sender_buffer;
+		return RETURN_SUCCESS;
+	}
+#if LIBSPDM_DEFAULT_DEVICE_BUFFER_SUPPORT
+	*max_msg_size = sizeof(spdm_context->default_sender_buffer);
+	*msg_buf_ptr = spdm_context->default_sender_buffer;
+	return RETURN_SUCCESS;
+#else
+	DEBUG((DEBUG_ERROR, "no sender buffer is registered\n"));
+	return RETURN_OUT_OF_RESOURCES;
+#endif
+}
+
+/**
+  Release a sender buffer for transport layer message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  msg_buf_ptr                   A pointer to the sender buffer.
+**/
+void libspdm_release_sender_buffer(IN spdm_context_t *spdm_context,
+				   IN void *msg_buf_ptr)
+{
+	if (spdm_context->release_sender_buffer != NULL) {
+		spdm_context->release_sender_buffer(spdm_context, msg_buf_ptr);
+	}
+}
+
+/**
+  Acquire a receiver buffer for transport layer message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  max_msg_size                  size in bytes of the receiver buffer.
+  @param  msg_buf_ptr                   A pointer to the receiver buffer.
+
+  @retval RETURN_SUCCESS               The receiver buffer is acquired.
+  @retval RETURN_OUT_OF_RESOURCES      No receiver buffer is registered, and there is no default one.
+**/
+return_status libspdm_acquire_receiver_buffer(IN spdm_context_t *spdm_context,
+					      OUT uintn *max_msg_size,
+					      OUT void **msg_buf_ptr)
+{
+	if (spdm_context->acquire_receiver_buffer != NULL) {
+		return spdm_context->acquire_receiver_buffer(
+			spdm_context, max_msg_size, msg_buf_ptr);
+	}
+	if (spdm_context->receiver_buffer != NULL) {
+		*max_msg_size = spdm_context->receiver_buffer_size;
+		*msg_buf_ptr = spdm_context->receiver_buffer;
+		return RETURN_SUCCESS;
+	}
+#if LIBSPDM_DEFAULT_DEVICE_BUFFER_SUPPORT
+	*max_msg_size = sizeof(spdm_context->default_receiver_buffer);
+	*msg_buf_ptr = spdm_context->default_receiver_buffer;
+	return RETURN_SUCCESS;
+#else
+	DEBUG((DEBUG_ERROR, "no receiver buffer is registered\n"));
+	return RETURN_OUT_OF_RESOURCES;
+#endif
+}
+
+/**
+  Release a receiver buffer for transport layer message.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  msg_buf_ptr                   A pointer to the receiver buffer.
+**/
+void libspdm_release_receiver_buffer(IN spdm_context_t *spdm_context,
+				     IN void *msg_buf_ptr)
+{
+	if (spdm_context->release_receiver_buffer != NULL) {
+		spdm_context->release_receiver_buffer(spdm_context, msg_buf_ptr);
+	}
+}
+
 /**
   Register SPDM transport layer encode/decode functions for SPDM or APP messages.
 
@@ -1479,6 +1723,108 @@ void libspdm_register_transport_layer_func(
 	return;
 }
 
+/**
+  Register an external transcript backend.
+
+  Any function may be NULL. This function must be called after libspdm_init_context,
+  and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  transcript_append             The fuction to append a transcript message.
+  @param  transcript_reset              The fuction to reset a transcript message.
+  @param  transcript_extend             The fuction to extend a finalized transcript digest.
+**/
+void libspdm_register_transcript_func(
+	IN void *context,
+	IN libspdm_transcript_append_func transcript_append OPTIONAL,
+	IN libspdm_transcript_reset_func transcript_reset OPTIONAL,
+	IN libspdm_transcript_extend_func transcript_extend OPTIONAL)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->transcript_append = transcript_append;
+	spdm_context->transcript_reset = transcript_reset;
+	spdm_context->transcript_extend = transcript_extend;
+	return;
+}
+
+/**
+  Return the size in bytes of a certificate chain verification cache.
+
+  @return the size in bytes of a certificate chain verification cache.
+**/
+uintn libspdm_get_cert_chain_verify_cache_size(void)
+{
+	return sizeof(spdm_cert_chain_verify_cache_t);
+}
+
+/**
+  Initialize a certificate chain verification cache.
+
+  If the cache is shared by SPDM contexts used in different threads, the lock functions must be provided.
+
+  @param  cache                         A pointer to the certificate chain verification cache.
+  @param  acquire_lock                  The fuction to acquire the lock, if not NULL.
+  @param  release_lock                  The fuction to release the lock, if not NULL.
+  @param  lock                          A pointer to the lock passed to the lock functions.
+**/
+void libspdm_init_cert_chain_verify_cache(IN void *cache,
+					  IN libspdm_lock_func acquire_lock OPTIONAL,
+					  IN libspdm_lock_func release_lock OPTIONAL,
+					  IN void *lock OPTIONAL)
+{
+	spdm_cert_chain_verify_cache_t *cert_chain_verify_cache;
+
+	cert_chain_verify_cache = cache;
+	zero_mem(cert_chain_verify_cache, sizeof(spdm_cert_chain_verify_cache_t));
+	cert_chain_verify_cache->acquire_lock = acquire_lock;
+	cert_chain_verify_cache->release_lock = release_lock;
+	cert_chain_verify_cache->lock = lock;
+}
+
+/**
+  Invalidate all certificate chains remembered by a certificate chain verification cache.
+
+  @param  cache                         A pointer to the certificate chain verification cache.
+**/
+void libspdm_invalidate_cert_chain_verify_cache(IN void *cache)
+{
+	spdm_cert_chain_verify_cache_t *cert_chain_verify_cache;
+
+	cert_chain_verify_cache = cache;
+	if (cert_chain_verify_cache->acquire_lock != NULL) {
+		cert_chain_verify_cache->acquire_lock(
+			cert_chain_verify_cache->lock);
+	}
+	zero_mem(cert_chain_verify_cache->entry,
+		 sizeof(cert_chain_verify_cache->entry));
+	cert_chain_verify_cache->entry_count = 0;
+	cert_chain_verify_cache->entry_next = 0;
+	if (cert_chain_verify_cache->release_lock != NULL) {
+		cert_chain_verify_cache->release_lock(
+			cert_chain_verify_cache->lock);
+	}
+}
+
+/**
+  Register a certificate chain verification cache in an SPDM context.
+
+  This function must be called after libspdm_init_context, and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cache                         A pointer to the certificate chain verification cache, or NULL.
+**/
+void libspdm_register_cert_chain_verify_cache(IN void *context,
+					      IN void *cache OPTIONAL)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->local_context.cert_chain_verify_cache = cache;
+	return;
+}
+
 /**
   Get the last error of an SPDM context.
 
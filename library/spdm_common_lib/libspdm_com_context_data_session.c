@@ -69,9 +69,6 @@ void spdm_session_info_init(IN spdm_context_t *spdm_context,
 		sizeof(session_info->session_transcript.message_f.buffer);
 	session_info->session_transcript.message_m.max_buffer_size =
 		sizeof(session_info->session_transcript.message_m.buffer);
-#else
-	session_info->session_transcript.temp_message_k.max_buffer_size =
-		sizeof(session_info->session_transcript.temp_message_k.buffer);
 #endif
 }
 
@@ -0,0 +1,311 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "internal/libspdm_common_lib.h"
+
+#define SPDM_CONTEXT_SNAPSHOT_SIGNATURE SIGNATURE_32('S', 'N', 'A', 'P')
+
+//
+// A snapshot is this header, followed by a copy of the SPDM context and its secured message contexts.
+//
+typedef struct {
+	uint32 signature;
+	uint32 version;
+	uintn context_size;
+} spdm_context_snapshot_header_t;
+
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+//
+// The transcript hash contexts allocated out of the SPDM context:
+// M1M2, mutual M1M2 and L1L2 of the connection, then TH and L1L2 of each session.
+//
+#define SPDM_CONTEXT_HASH_CONTEXT_COUNT (3 + 2 * MAX_SPDM_SESSION_COUNT)
+
+/**
+  Return the location of each transcript hash context of an SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  hash_context                  The location of each transcript hash context.
+**/
+static void spdm_get_transcript_hash_context_list(
+	IN spdm_context_t *spdm_context,
+	OUT void **hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT])
+{
+	uintn index;
+
+	hash_context[0] = &spdm_context->transcript.digest_context_m1m2;
+	hash_context[1] = &spdm_context->transcript.digest_context_mut_m1m2;
+	hash_context[2] = &spdm_context->transcript.digest_context_l1l2;
+	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
+		hash_context[3 + index * 2] =
+			&spdm_context->session_info[index]
+				 .session_transcript.digest_context_th;
+		hash_context[3 + index * 2 + 1] =
+			&spdm_context->session_info[index]
+				 .session_transcript.digest_context_l1l2;
+	}
+}
+
+/**
+  Free the hash contexts of a list.
+
+  @param  base_hash_algo                Indicates the hash algorithm.
+  @param  hash_context                  The hash contexts. The NULL entries are skipped.
+**/
+static void spdm_free_hash_context_list(
+	IN uint32 base_hash_algo,
+	IN void *hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT])
+{
+	uintn index;
+
+	for (index = 0; index < SPDM_CONTEXT_HASH_CONTEXT_COUNT; index++) {
+		if (hash_context[index] != NULL) {
+			spdm_hash_free(base_hash_algo, hash_context[index]);
+			hash_context[index] = NULL;
+		}
+	}
+}
+
+/**
+  Duplicate the transcript hash contexts of an SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  new_hash_context              The duplicated hash contexts, NULL if the hash context is not allocated.
+
+  @retval TRUE   The hash contexts are duplicated.
+  @retval FALSE  A hash context cannot be duplicated. No hash context is returned.
+**/
+static boolean spdm_duplicate_transcript_hash_context(
+	IN spdm_context_t *spdm_context,
+	OUT void *new_hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT])
+{
+	void **hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT];
+	uint32 base_hash_algo;
+	uintn index;
+
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+	spdm_get_transcript_hash_context_list(spdm_context, hash_context);
+	zero_mem(new_hash_context,
+		 sizeof(void *) * SPDM_CONTEXT_HASH_CONTEXT_COUNT);
+	for (index = 0; index < SPDM_CONTEXT_HASH_CONTEXT_COUNT; index++) {
+		if (*hash_context[index] == NULL) {
+			continue;
+		}
+		new_hash_context[index] = spdm_hash_new(base_hash_algo);
+		if ((new_hash_context[index] == NULL) ||
+		    !spdm_hash_duplicate(base_hash_algo, *hash_context[index],
+					 new_hash_context[index])) {
+			spdm_free_hash_context_list(base_hash_algo,
+						    new_hash_context);
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/**
+  Replace the transcript hash contexts of an SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  new_hash_context              The new hash contexts, owned by the SPDM context on return.
+**/
+static void spdm_set_transcript_hash_context(
+	IN OUT spdm_context_t *spdm_context,
+	IN void *new_hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT])
+{
+	void **hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT];
+	uintn index;
+
+	spdm_get_transcript_hash_context_list(spdm_context, hash_context);
+	for (index = 0; index < SPDM_CONTEXT_HASH_CONTEXT_COUNT; index++) {
+		*hash_context[index] = new_hash_context[index];
+	}
+}
+
+/**
+  Remove the transcript hash contexts from an SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  old_hash_context              The removed hash contexts, owned by the caller on return.
+**/
+static void spdm_take_transcript_hash_context(
+	IN OUT spdm_context_t *spdm_context,
+	OUT void *old_hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT])
+{
+	void **hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT];
+	uintn index;
+
+	spdm_get_transcript_hash_context_list(spdm_context, hash_context);
+	for (index = 0; index < SPDM_CONTEXT_HASH_CONTEXT_COUNT; index++) {
+		old_hash_context[index] = *hash_context[index];
+		*hash_context[index] = NULL;
+	}
+}
+#endif
+
+/**
+  Return the size in bytes of a snapshot of an SPDM context.
+
+  @return the size in bytes of a snapshot of an SPDM context.
+**/
+uintn libspdm_get_context_snapshot_size(void)
+{
+	return sizeof(spdm_context_snapshot_header_t) +
+	       libspdm_get_context_size();
+}
+
+/**
+  Save the state of an SPDM context to a snapshot.
+
+  The snapshot is a copy of the SPDM context, including the secured message contexts of the sessions.
+  If LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT is disabled, the transcript hash contexts are duplicated.
+  They are owned by the snapshot, until libspdm_free_context_snapshot is called.
+  The snapshot refers to the same registered functions and provisioned data as the SPDM context,
+  so it is only valid in the same process.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  snapshot                      A pointer to the snapshot buffer.
+  @param  snapshot_size                 On input, the size in bytes of the snapshot buffer.
+                                       On output, the size in bytes of the snapshot.
+
+  @retval RETURN_SUCCESS               The snapshot is saved.
+  @retval RETURN_BUFFER_TOO_SMALL      The snapshot buffer is too small. snapshot_size is updated.
+  @retval RETURN_OUT_OF_RESOURCES      A transcript hash context cannot be duplicated.
+**/
+return_status libspdm_snapshot_context(IN void *context, OUT void *snapshot,
+				       IN OUT uintn *snapshot_size)
+{
+	spdm_context_t *spdm_context;
+	spdm_context_snapshot_header_t *snapshot_header;
+	uintn context_size;
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	void *new_hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT];
+#endif
+
+	spdm_context = context;
+	if (*snapshot_size < libspdm_get_context_snapshot_size()) {
+		*snapshot_size = libspdm_get_context_snapshot_size();
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	if (!spdm_duplicate_transcript_hash_context(spdm_context,
+						    new_hash_context)) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+#endif
+
+	context_size = libspdm_get_context_size();
+	snapshot_header = snapshot;
+	snapshot_header->signature = SPDM_CONTEXT_SNAPSHOT_SIGNATURE;
+	snapshot_header->version = spdm_context->version;
+	snapshot_header->context_size = context_size;
+	copy_mem(snapshot_header + 1, spdm_context, context_size);
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	spdm_set_transcript_hash_context(
+		(spdm_context_t *)(snapshot_header + 1), new_hash_context);
+#endif
+
+	*snapshot_size = libspdm_get_context_snapshot_size();
+	return RETURN_SUCCESS;
+}
+
+/**
+  Restore the state of an SPDM context from a snapshot.
+
+  The SPDM context must be initialized by libspdm_init_context.
+  It may be the SPDM context of the snapshot, or another one. Its previous state is discarded.
+  If LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT is disabled, the transcript hash contexts of the snapshot are duplicated,
+  so that the snapshot can be restored again.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  snapshot                      A pointer to the snapshot saved by libspdm_snapshot_context.
+  @param  snapshot_size                 The size in bytes of the snapshot.
+
+  @retval RETURN_SUCCESS               The SPDM context is restored.
+  @retval RETURN_INVALID_PARAMETER     The snapshot is invalid, or it is saved by another version of the library.
+  @retval RETURN_OUT_OF_RESOURCES      A transcript hash context cannot be duplicated.
+                                       The SPDM context is not changed.
+**/
+return_status libspdm_restore_context(IN OUT void *context,
+				      IN const void *snapshot,
+				      IN uintn snapshot_size)
+{
+	spdm_context_t *spdm_context;
+	const spdm_context_snapshot_header_t *snapshot_header;
+	uintn secured_message_context_size;
+	uintn index;
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	void *old_hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT];
+	void *new_hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT];
+#endif
+
+	spdm_context = context;
+	snapshot_header = snapshot;
+	if ((snapshot_size < libspdm_get_context_snapshot_size()) ||
+	    (snapshot_header->signature != SPDM_CONTEXT_SNAPSHOT_SIGNATURE) ||
+	    (snapshot_header->version != spdm_context_struct_VERSION) ||
+	    (snapshot_header->context_size != libspdm_get_context_size())) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	if (!spdm_duplicate_transcript_hash_context(
+		    (spdm_context_t *)(snapshot_header + 1),
+		    new_hash_context)) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	spdm_take_transcript_hash_context(spdm_context, old_hash_context);
+	spdm_free_hash_context_list(
+		spdm_context->connection_info.algorithm.base_hash_algo,
+		old_hash_context);
+#endif
+
+	copy_mem(spdm_context, snapshot_header + 1,
+		 snapshot_header->context_size);
+
+	//
+	// The secured message contexts follow the SPDM context, so they are relocated.
+	//
+	secured_message_context_size = spdm_secured_message_get_context_size();
+	for (index = 0; index < MAX_SPDM_SESSION_COUNT; index++) {
+		spdm_context->session_info[index].secured_message_context =
+			(void *)((uintn)(spdm_context + 1) +
+				 secured_message_context_size * index);
+	}
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	spdm_set_transcript_hash_context(spdm_context, new_hash_context);
+#endif
+
+	return RETURN_SUCCESS;
+}
+
+/**
+  Free the resources of a snapshot of an SPDM context.
+
+  If LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT is disabled, the transcript hash contexts of the snapshot are freed.
+  The snapshot buffer itself is owned by the caller.
+
+  @param  snapshot                      A pointer to the snapshot saved by libspdm_snapshot_context.
+**/
+void libspdm_free_context_snapshot(IN void *snapshot)
+{
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	spdm_context_snapshot_header_t *snapshot_header;
+	spdm_context_t *spdm_context;
+	void *hash_context[SPDM_CONTEXT_HASH_CONTEXT_COUNT];
+
+	snapshot_header = snapshot;
+	if (snapshot_header->signature != SPDM_CONTEXT_SNAPSHOT_SIGNATURE) {
+		return;
+	}
+	spdm_context = (spdm_context_t *)(snapshot_header + 1);
+	spdm_take_transcript_hash_context(spdm_context, hash_context);
+	spdm_free_hash_context_list(
+		spdm_context->connection_info.algorithm.base_hash_algo,
+		hash_context);
+#endif
+}
@@ -213,6 +213,9 @@ boolean spdm_calculate_m1m2(IN void *context, IN boolean is_mut,
 		DEBUG((DEBUG_INFO, "m1m2 Mut hash - "));
 		internal_dump_data(hash_data, hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
+		libspdm_extend_transcript_digest(spdm_context, NULL,
+						 SPDM_TRANSCRIPT_DIGEST_MUT_M1M2,
+						 hash_data, hash_size);
 
 	} else {
 		DEBUG((DEBUG_INFO, "message_a data :\n"));
@@ -265,6 +268,9 @@ boolean spdm_calculate_m1m2(IN void *context, IN boolean is_mut,
 		DEBUG((DEBUG_INFO, "m1m2 hash - "));
 		internal_dump_data(hash_data, hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
+		libspdm_extend_transcript_digest(spdm_context, NULL,
+						 SPDM_TRANSCRIPT_DIGEST_M1M2,
+						 hash_data, hash_size);
 	}
 
 	*m1m2_buffer_size = get_managed_buffer_size(&m1m2);
@@ -289,8 +295,10 @@ boolean spdm_calculate_m1m2_hash(IN void *context, IN boolean is_mut,
 {
 	spdm_context_t *spdm_context;
 	uint32 hash_size;
+	uint64 start_time;
 
 	spdm_context = context;
+	start_time = spdm_statistics_get_time(spdm_context);
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -301,6 +309,9 @@ boolean spdm_calculate_m1m2_hash(IN void *context, IN boolean is_mut,
 		DEBUG((DEBUG_INFO, "m1m2 Mut hash - "));
 		internal_dump_data(m1m2_hash, hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
+		libspdm_extend_transcript_digest(spdm_context, NULL,
+						 SPDM_TRANSCRIPT_DIGEST_MUT_M1M2,
+						 m1m2_hash, hash_size);
 
 	} else {
 		spdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
@@ -308,8 +319,13 @@ boolean spdm_calculate_m1m2_hash(IN void *context, IN boolean is_mut,
 		DEBUG((DEBUG_INFO, "m1m2 hash - "));
 		internal_dump_data(m1m2_hash, hash_size);
 		DEBUG((DEBUG_INFO, "\n"));
+		libspdm_extend_transcript_digest(spdm_context, NULL,
+						 SPDM_TRANSCRIPT_DIGEST_M1M2,
+						 m1m2_hash, hash_size);
 	}
 
+	spdm_statistics_record_crypto(spdm_context, SPDM_STATISTICS_CRYPTO_HASH,
+				      start_time);
 	*m1m2_hash_size = hash_size;
 
 	return TRUE;
@@ -368,6 +384,9 @@ boolean spdm_calculate_l1l2(IN void *context, IN void *session_info,
 	DEBUG((DEBUG_INFO, "l1l2 hash - "));
 	internal_dump_data(hash_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
+	libspdm_extend_transcript_digest(spdm_context, spdm_session_info,
+					 SPDM_TRANSCRIPT_DIGEST_L1L2,
+					 hash_data, hash_size);
 
 	return TRUE;
 }
@@ -391,9 +410,11 @@ boolean spdm_calculate_l1l2_hash(IN void *context, IN void *session_info,
 	spdm_session_info_t *spdm_session_info;
 
 	uint32 hash_size;
+	uint64 start_time;
 
 	spdm_context = context;
 	spdm_session_info = session_info;
+	start_time = spdm_statistics_get_time(spdm_context);
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -409,7 +430,12 @@ boolean spdm_calculate_l1l2_hash(IN void *context, IN void *session_info,
 	DEBUG((DEBUG_INFO, "l1l2 hash - "));
 	internal_dump_data(l1l2_hash, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
+	libspdm_extend_transcript_digest(spdm_context, spdm_session_info,
+					 SPDM_TRANSCRIPT_DIGEST_L1L2,
+					 l1l2_hash, hash_size);
 
+	spdm_statistics_record_crypto(spdm_context, SPDM_STATISTICS_CRYPTO_HASH,
+				      start_time);
 	*l1l2_hash_size = hash_size;
 
 	return TRUE;
@@ -429,13 +455,18 @@ boolean spdm_calculate_l1l2_hash(IN void *context, IN void *session_info,
 boolean spdm_generate_cert_chain_hash(IN spdm_context_t *spdm_context,
 				      IN uintn slot_id, OUT uint8 *hash)
 {
+	uint64 start_time;
+
 	ASSERT(slot_id < spdm_context->local_context.slot_count);
+	start_time = spdm_statistics_get_time(spdm_context);
 	spdm_hash_all(
 		spdm_context->connection_info.algorithm.base_hash_algo,
 		spdm_context->local_context.local_cert_chain_provision[slot_id],
 		spdm_context->local_context
 			.local_cert_chain_provision_size[slot_id],
 		hash);
+	spdm_statistics_record_crypto(spdm_context, SPDM_STATISTICS_CRYPTO_HASH,
+				      start_time);
 	return TRUE;
 }
 
@@ -491,6 +522,112 @@ boolean spdm_verify_peer_digests(IN spdm_context_t *spdm_context,
 	return TRUE;
 }
 
+/**
+  This function finds a certificate chain hash in a certificate chain verification cache.
+
+  The caller must hold the lock of the cache.
+
+  @param  cache                         A pointer to the certificate chain verification cache.
+  @param  base_hash_algo                 The hash algorithm of the certificate chain hash.
+  @param  hash                          The certificate chain hash.
+
+  @retval TRUE  the certificate chain hash is found.
+  @retval FALSE the certificate chain hash is not found.
+**/
+static boolean
+spdm_find_cert_chain_verify_cache(IN spdm_cert_chain_verify_cache_t *cache,
+				  IN uint32 base_hash_algo, IN uint8 *hash)
+{
+	uintn index;
+
+	for (index = 0; index < cache->entry_count; index++) {
+		if ((cache->entry[index].base_hash_algo == base_hash_algo) &&
+		    (const_compare_mem(cache->entry[index].hash, hash,
+				       spdm_get_hash_size(base_hash_algo)) == 0)) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/**
+  This function verifies the integrity of a certificate chain buffer including spdm_cert_chain_t header.
+
+  If a certificate chain verification cache is registered, a certificate chain found in the cache
+  is not verified again, and a certificate chain passing the verification is added to the cache.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cert_chain_buffer              Certitiface chain buffer including spdm_cert_chain_t header.
+  @param  cert_chain_buffer_size          size in bytes of the certitiface chain buffer.
+
+  @retval TRUE  certificate chain buffer verification passed.
+  @retval FALSE certificate chain buffer verification failed.
+**/
+boolean spdm_verify_cert_chain_buffer_with_cache(IN spdm_context_t *spdm_context,
+						 IN void *cert_chain_buffer,
+						 IN uintn cert_chain_buffer_size)
+{
+	spdm_cert_chain_verify_cache_t *cache;
+	spdm_cert_chain_verify_cache_entry_t *entry;
+	uint32 base_hash_algo;
+	uint8 hash[MAX_HASH_SIZE];
+	boolean result;
+
+	base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+	cache = spdm_context->local_context.cert_chain_verify_cache;
+	if (cache == NULL) {
+		return spdm_verify_certificate_chain_buffer(
+			base_hash_algo, cert_chain_buffer,
+			cert_chain_buffer_size);
+	}
+
+	result = spdm_hash_all(base_hash_algo, cert_chain_buffer,
+			       cert_chain_buffer_size, hash);
+	if (!result) {
+		return FALSE;
+	}
+
+	if (cache->acquire_lock != NULL) {
+		cache->acquire_lock(cache->lock);
+	}
+	result = spdm_find_cert_chain_verify_cache(cache, base_hash_algo, hash);
+	if (cache->release_lock != NULL) {
+		cache->release_lock(cache->lock);
+	}
+	if (result) {
+		DEBUG((DEBUG_INFO, "!!! verify_cert_chain_buffer - cached !!!\n"));
+		return TRUE;
+	}
+
+	//
+	// Verify without the lock, so that other threads are not blocked.
+	//
+	result = spdm_verify_certificate_chain_buffer(
+		base_hash_algo, cert_chain_buffer, cert_chain_buffer_size);
+	if (!result) {
+		return FALSE;
+	}
+
+	if (cache->acquire_lock != NULL) {
+		cache->acquire_lock(cache->lock);
+	}
+	if (!spdm_find_cert_chain_verify_cache(cache, base_hash_algo, hash)) {
+		entry = &cache->entry[cache->entry_next];
+		entry->base_hash_algo = base_hash_algo;
+		copy_mem(entry->hash, hash, spdm_get_hash_size(base_hash_algo));
+		cache->entry_next = (cache->entry_next + 1) %
+				    MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT;
+		if (cache->entry_count < MAX_SPDM_CERT_CHAIN_VERIFY_CACHE_COUNT) {
+			cache->entry_count++;
+		}
+	}
+	if (cache->release_lock != NULL) {
+		cache->release_lock(cache->lock);
+	}
+
+	return TRUE;
+}
+
 /**
   This function verifies peer certificate chain buffer including spdm_cert_chain_t header.
 
@@ -519,9 +656,8 @@ boolean spdm_verify_peer_cert_chain_buffer(IN spdm_context_t *spdm_context,
 	uintn received_root_cert_size;
 	boolean result;
 
-	result = spdm_verify_certificate_chain_buffer(
-		spdm_context->connection_info.algorithm.base_hash_algo,
-		cert_chain_buffer, cert_chain_buffer_size);
+	result = spdm_verify_cert_chain_buffer_with_cache(
+		spdm_context, cert_chain_buffer, cert_chain_buffer_size);
 	if (!result) {
 		return FALSE;
 	}
@@ -614,6 +750,7 @@ boolean spdm_generate_challenge_auth_signature(IN spdm_context_t *spdm_context,
 					       OUT uint8 *signature)
 {
 	boolean result;
+	uint64 start_time;
 	uintn signature_size;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 m1m2_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
@@ -640,6 +777,8 @@ boolean spdm_generate_challenge_auth_signature(IN spdm_context_t *spdm_context,
 		signature_size = spdm_get_req_asym_signature_size(
 			spdm_context->connection_info.algorithm
 				.req_base_asym_alg);
+		start_time = spdm_statistics_get_time(spdm_context);
+		spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_SIGN);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 		result = spdm_requester_data_sign(
 			spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
@@ -657,9 +796,14 @@ boolean spdm_generate_challenge_auth_signature(IN spdm_context_t *spdm_context,
 			TRUE, m1m2_hash, m1m2_hash_size, signature,
 			&signature_size);
 #endif
+		spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_SIGN);
+		spdm_statistics_record_crypto(spdm_context,
+					      SPDM_STATISTICS_CRYPTO_SIGN, start_time);
 	} else {
 		signature_size = spdm_get_asym_signature_size(
 			spdm_context->connection_info.algorithm.base_asym_algo);
+		start_time = spdm_statistics_get_time(spdm_context);
+		spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_SIGN);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 		result = spdm_responder_data_sign(
 			spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
@@ -675,6 +819,9 @@ boolean spdm_generate_challenge_auth_signature(IN spdm_context_t *spdm_context,
 			TRUE, m1m2_hash, m1m2_hash_size, signature,
 			&signature_size);
 #endif
+		spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_SIGN);
+		spdm_statistics_record_crypto(spdm_context,
+					      SPDM_STATISTICS_CRYPTO_SIGN, start_time);
 	}
 
 	return result;
@@ -746,6 +893,7 @@ boolean spdm_verify_challenge_auth_signature(IN spdm_context_t *spdm_context,
 					     IN uintn sign_data_size)
 {
 	boolean result;
+	uint64 start_time;
 	uint8 *cert_buffer;
 	uintn cert_buffer_size;
 	void *context;
@@ -796,6 +944,8 @@ boolean spdm_verify_challenge_auth_signature(IN spdm_context_t *spdm_context,
 			return FALSE;
 		}
 
+		start_time = spdm_statistics_get_time(spdm_context);
+		spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_VERIFY);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 		result = spdm_asym_verify(
 			spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
@@ -811,6 +961,9 @@ boolean spdm_verify_challenge_auth_signature(IN spdm_context_t *spdm_context,
 			context, m1m2_hash, m1m2_hash_size, sign_data,
 			sign_data_size);
 #endif
+		spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_VERIFY);
+		spdm_statistics_record_crypto(spdm_context,
+					      SPDM_STATISTICS_CRYPTO_VERIFY, start_time);
 		spdm_asym_free(
 			spdm_context->connection_info.algorithm.base_asym_algo,
 			context);
@@ -823,6 +976,8 @@ boolean spdm_verify_challenge_auth_signature(IN spdm_context_t *spdm_context,
 			return FALSE;
 		}
 
+		start_time = spdm_statistics_get_time(spdm_context);
+		spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_VERIFY);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 		result = spdm_req_asym_verify(
 			spdm_context->connection_info.version, SPDM_CHALLENGE_AUTH,
@@ -840,6 +995,9 @@ boolean spdm_verify_challenge_auth_signature(IN spdm_context_t *spdm_context,
 			context, m1m2_hash, m1m2_hash_size, sign_data,
 			sign_data_size);
 #endif
+		spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_VERIFY);
+		spdm_statistics_record_crypto(spdm_context,
+					      SPDM_STATISTICS_CRYPTO_VERIFY, start_time);
 		spdm_req_asym_free(spdm_context->connection_info.algorithm
 					   .req_base_asym_alg,
 				   context);
@@ -891,9 +1049,137 @@ spdm_get_measurement_summary_hash_size(IN spdm_context_t *spdm_context,
 	return 0;
 }
 
+/**
+  This function returns the measurement summary hash cache for a measurement summary hash type.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_summary_hash_type   The type of the measurement summary hash.
+
+  @return the measurement summary hash cache.
+**/
+static spdm_measurement_summary_hash_cache_t *
+spdm_get_measurement_summary_hash_cache(IN spdm_context_t *spdm_context,
+					IN uint8 measurement_summary_hash_type)
+{
+	if (measurement_summary_hash_type ==
+	    SPDM_CHALLENGE_REQUEST_TCB_COMPONENT_MEASUREMENT_HASH) {
+		return &spdm_context->measurement_summary_hash_cache
+				[SPDM_MEASUREMENT_SUMMARY_HASH_CACHE_TCB];
+	}
+	return &spdm_context->measurement_summary_hash_cache
+			[SPDM_MEASUREMENT_SUMMARY_HASH_CACHE_ALL];
+}
+
+/**
+  This function checks if a measurement summary hash cache entry was calculated
+  with the currently negotiated version and algorithms.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cache                         A pointer to the measurement summary hash cache.
+
+  @retval TRUE  the cache matches the negotiated version and algorithms.
+  @retval FALSE the cache does not match.
+**/
+static boolean spdm_is_measurement_summary_hash_cache_match(
+	IN spdm_context_t *spdm_context,
+	IN spdm_measurement_summary_hash_cache_t *cache)
+{
+	return (const_compare_mem(&cache->spdm_version,
+				  &spdm_context->connection_info.version,
+				  sizeof(spdm_version_number_t)) == 0) &&
+	       (cache->measurement_spec ==
+		spdm_context->connection_info.algorithm.measurement_spec) &&
+	       (cache->measurement_hash_algo ==
+		spdm_context->connection_info.algorithm.measurement_hash_algo) &&
+	       (cache->base_hash_algo ==
+		spdm_context->connection_info.algorithm.base_hash_algo);
+}
+
+/**
+  This function records a measurement summary hash in the cache.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cache                         A pointer to the measurement summary hash cache.
+  @param  generation                    The device measurement generation the hash is calculated from.
+  @param  measurement_summary_hash       The measurement summary hash.
+**/
+static void spdm_update_measurement_summary_hash_cache(
+	IN spdm_context_t *spdm_context,
+	IN OUT spdm_measurement_summary_hash_cache_t *cache,
+	IN uint32 generation, IN uint8 *measurement_summary_hash)
+{
+	cache->generation = generation;
+	copy_mem(&cache->spdm_version, &spdm_context->connection_info.version,
+		 sizeof(spdm_version_number_t));
+	cache->measurement_spec =
+		spdm_context->connection_info.algorithm.measurement_spec;
+	cache->measurement_hash_algo =
+		spdm_context->connection_info.algorithm.measurement_hash_algo;
+	cache->base_hash_algo =
+		spdm_context->connection_info.algorithm.base_hash_algo;
+	copy_mem(cache->hash, measurement_summary_hash,
+		 spdm_get_hash_size(cache->base_hash_algo));
+	cache->valid = TRUE;
+}
+
+/**
+  This function collects the next device measurement block after a measurement index.
+
+  Measurement blocks are collected one at a time, so that the whole measurement
+  record never needs to be held in one buffer.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurement_index             On input, the index after which to search (0 to start).
+                                       On output, the index of the returned measurement block.
+  @param  measurement_block             A pointer to a destination buffer to store the measurement block.
+  @param  measurement_block_size         On input, indicates the size in bytes of the destination buffer.
+                                       On output, indicates the size in bytes of the measurement block.
+
+  @retval RETURN_SUCCESS               The measurement block is returned.
+  @retval RETURN_NOT_FOUND             There is no measurement block after measurement_index.
+  @retval RETURN_***                   Any other RETURN_ error from spdm_measurement_collection.
+**/
+return_status libspdm_get_next_measurement_block(IN spdm_context_t *spdm_context,
+						 IN OUT uint8 *measurement_index,
+						 OUT void *measurement_block,
+						 IN OUT uintn *measurement_block_size)
+{
+	uint8 index;
+	uint8 measurement_count;
+	uintn block_size;
+	return_status status;
+
+	for (index = *measurement_index + 1;
+	     index < SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS;
+	     index++) {
+		block_size = *measurement_block_size;
+		status = spdm_measurement_collection(
+			spdm_context->connection_info.version,
+			spdm_context->connection_info.algorithm.measurement_spec,
+			spdm_context->connection_info.algorithm.measurement_hash_algo,
+			index, &measurement_count, measurement_block,
+			&block_size);
+		if (status == RETURN_NOT_FOUND) {
+			continue;
+		}
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		ASSERT(measurement_count == 1);
+		*measurement_index = index;
+		*measurement_block_size = block_size;
+		return RETURN_SUCCESS;
+	}
+	return RETURN_NOT_FOUND;
+}
+
 /**
   This function calculate the measurement summary hash.
 
+  The TCB and all measurements summary hash are cached in the SPDM context,
+  and only recalculated when the device measurement generation or the
+  negotiated algorithms change.
+
   @param  spdm_context                  A pointer to the SPDM context.
   @param  is_requester                  Is the function called from a requester.
   @param  measurement_summary_hash_type   The type of the measurement summary hash.
@@ -908,15 +1194,17 @@ spdm_generate_measurement_summary_hash(IN spdm_context_t *spdm_context,
 				       IN uint8 measurement_summary_hash_type,
 				       OUT uint8 *measurement_summary_hash)
 {
-	uint8 measurement_data[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uint8 measurement_block[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uintn measurement_block_size;
+	uint8 measurement_index;
 	uintn index;
 	spdm_measurement_block_dmtf_t *cached_measurment_block;
-	uintn measurment_data_size;
-	uintn measurment_block_size;
-	uint8 device_measurement[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
 	uint8 device_measurement_count;
-	uintn device_measurement_size;
+	void *hash_context;
+	boolean result;
 	return_status status;
+	spdm_measurement_summary_hash_cache_t *cache;
+	uint32 generation;
 
 	if (!spdm_is_capabilities_flag_supported(
 		    spdm_context, is_requester, 0,
@@ -930,16 +1218,30 @@ spdm_generate_measurement_summary_hash(IN spdm_context_t *spdm_context,
 
 	case SPDM_CHALLENGE_REQUEST_TCB_COMPONENT_MEASUREMENT_HASH:
 	case SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH:
-		// get all measurement data
-		device_measurement_size = sizeof(device_measurement);
+		cache = spdm_get_measurement_summary_hash_cache(
+			spdm_context, measurement_summary_hash_type);
+		generation = spdm_measurement_generation();
+		if ((generation != 0) && cache->valid &&
+		    (cache->generation == generation) &&
+		    spdm_is_measurement_summary_hash_cache_match(spdm_context,
+								 cache)) {
+			copy_mem(measurement_summary_hash, cache->hash,
+				 spdm_get_hash_size(
+					 spdm_context->connection_info.algorithm
+						 .base_hash_algo));
+			break;
+		}
+		cache->valid = FALSE;
+
+		// get measurement count
+		measurement_block_size = sizeof(measurement_block);
 		status = spdm_measurement_collection(
 			spdm_context->connection_info.version,
 			spdm_context->connection_info.algorithm.measurement_spec,
 			spdm_context->connection_info.algorithm.measurement_hash_algo,
-			0xFF, // Get all measurements
-			&device_measurement_count,
-			device_measurement,
-			&device_measurement_size);
+			SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS,
+			&device_measurement_count, measurement_block,
+			&measurement_block_size);
 		if (RETURN_ERROR(status)) {
 			return FALSE;
 		}
@@ -947,15 +1249,28 @@ spdm_generate_measurement_summary_hash(IN spdm_context_t *spdm_context,
 		ASSERT(device_measurement_count <=
 		       MAX_SPDM_MEASUREMENT_BLOCK_COUNT);
 
-		// double confirm that MeasurmentData internal size is correct
-		measurment_data_size = 0;
-		cached_measurment_block = (void *)device_measurement;
-		for (index = 0; index < device_measurement_count; index++) {
-			measurment_block_size =
-				sizeof(spdm_measurement_block_common_header_t) +
-				cached_measurment_block
-					->Measurement_block_common_header
-					.measurement_size;
+		// get required blocks one by one and hash them
+		hash_context = spdm_hash_new(
+			spdm_context->connection_info.algorithm.base_hash_algo);
+		if (hash_context == NULL) {
+			return FALSE;
+		}
+		result = spdm_hash_init(
+			spdm_context->connection_info.algorithm.base_hash_algo,
+			hash_context);
+		measurement_index = 0;
+		for (index = 0; result && (index < device_measurement_count);
+		     index++) {
+			measurement_block_size = sizeof(measurement_block);
+			status = libspdm_get_next_measurement_block(
+				spdm_context, &measurement_index,
+				measurement_block, &measurement_block_size);
+			if (RETURN_ERROR(status)) {
+				result = FALSE;
+				break;
+			}
+			cached_measurment_block = (void *)measurement_block;
+			// double confirm that MeasurmentData internal size is correct
 			ASSERT(cached_measurment_block
 				       ->Measurement_block_common_header
 				       .measurement_size ==
@@ -963,27 +1278,6 @@ spdm_generate_measurement_summary_hash(IN spdm_context_t *spdm_context,
 				       cached_measurment_block
 					       ->Measurement_block_dmtf_header
 					       .dmtf_spec_measurement_value_size);
-			measurment_data_size +=
-				cached_measurment_block
-					->Measurement_block_common_header
-					.measurement_size;
-			cached_measurment_block =
-				(void *)((uintn)cached_measurment_block +
-					 measurment_block_size);
-		}
-
-		ASSERT(measurment_data_size <=
-		       MAX_SPDM_MEASUREMENT_RECORD_SIZE);
-
-		// get required data and hash them
-		cached_measurment_block = (void *)device_measurement;
-		measurment_data_size = 0;
-		for (index = 0; index < device_measurement_count; index++) {
-			measurment_block_size =
-				sizeof(spdm_measurement_block_common_header_t) +
-				cached_measurment_block
-					->Measurement_block_common_header
-					.measurement_size;
 			// filter unneeded data
 			if (((measurement_summary_hash_type ==
 			      SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH) &&
@@ -997,27 +1291,35 @@ spdm_generate_measurement_summary_hash(IN spdm_context_t *spdm_context,
 				      .dmtf_spec_measurement_value_type &
 			      SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_MASK) ==
 			     SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_IMMUTABLE_ROM)) {
-				copy_mem(
-					&measurement_data[measurment_data_size],
+				result = spdm_hash_update(
+					spdm_context->connection_info.algorithm
+						.base_hash_algo,
+					hash_context,
 					&cached_measurment_block
 						 ->Measurement_block_dmtf_header,
 					cached_measurment_block
 						->Measurement_block_common_header
 						.measurement_size);
-
-				measurment_data_size +=
-					cached_measurment_block
-						->Measurement_block_common_header
-						.measurement_size;
 			}
-			cached_measurment_block =
-				(void *)((uintn)cached_measurment_block +
-					 measurment_block_size);
 		}
-		spdm_hash_all(
+		if (result) {
+			result = spdm_hash_final(
+				spdm_context->connection_info.algorithm
+					.base_hash_algo,
+				hash_context, measurement_summary_hash);
+		}
+		spdm_hash_free(
 			spdm_context->connection_info.algorithm.base_hash_algo,
-			measurement_data, measurment_data_size,
-			measurement_summary_hash);
+			hash_context);
+		if (!result) {
+			return FALSE;
+		}
+
+		if (generation != 0) {
+			spdm_update_measurement_summary_hash_cache(
+				spdm_context, cache, generation,
+				measurement_summary_hash);
+		}
 		break;
 	default:
 		return FALSE;
@@ -1044,6 +1346,7 @@ boolean spdm_generate_measurement_signature(IN spdm_context_t *spdm_context,
 {
 	uintn signature_size;
 	boolean result;
+	uint64 start_time;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 l1l2_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn l1l2_buffer_size;
@@ -1067,6 +1370,8 @@ boolean spdm_generate_measurement_signature(IN spdm_context_t *spdm_context,
 
 	signature_size = spdm_get_asym_signature_size(
 		spdm_context->connection_info.algorithm.base_asym_algo);
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_SIGN);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	result = spdm_responder_data_sign(
 		spdm_context->connection_info.version, SPDM_MEASUREMENTS,
@@ -1080,6 +1385,9 @@ boolean spdm_generate_measurement_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_hash_algo,
 		TRUE, l1l2_hash, l1l2_hash_size, signature, &signature_size);
 #endif
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_SIGN);
+	spdm_statistics_record_crypto(spdm_context,
+				      SPDM_STATISTICS_CRYPTO_SIGN, start_time);
 	return result;
 }
 
@@ -1102,6 +1410,7 @@ boolean spdm_verify_measurement_signature(IN spdm_context_t *spdm_context,
 					  IN uintn sign_data_size)
 {
 	boolean result;
+	uint64 start_time;
 	uint8 *cert_buffer;
 	uintn cert_buffer_size;
 	void *context;
@@ -1151,6 +1460,8 @@ boolean spdm_verify_measurement_signature(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_VERIFY);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	result = spdm_asym_verify(
 		spdm_context->connection_info.version, SPDM_MEASUREMENTS,
@@ -1164,6 +1475,9 @@ boolean spdm_verify_measurement_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_hash_algo, context,
 		l1l2_hash, l1l2_hash_size, sign_data, sign_data_size);
 #endif
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_VERIFY);
+	spdm_statistics_record_crypto(spdm_context,
+				      SPDM_STATISTICS_CRYPTO_VERIFY, start_time);
 	spdm_asym_free(spdm_context->connection_info.algorithm.base_asym_algo,
 		       context);
 	if (!result) {
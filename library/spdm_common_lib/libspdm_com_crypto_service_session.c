@@ -105,9 +105,11 @@ boolean libspdm_calculate_th_hash_for_exchange(
 	spdm_session_info_t *session_info;
 	uint32 hash_size;
 	void *digest_context_th;
+	uint64 start_time;
 
 	spdm_context = context;
 	session_info = spdm_session_info;
+	start_time = spdm_statistics_get_time(spdm_context);
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -122,6 +124,8 @@ boolean libspdm_calculate_th_hash_for_exchange(
 	spdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
 		digest_context_th, th_hash_buffer);
 	spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, digest_context_th);
+	spdm_statistics_record_crypto(spdm_context, SPDM_STATISTICS_CRYPTO_HASH,
+				      start_time);
 
 	*th_hash_buffer_size = hash_size;
 
@@ -146,7 +150,9 @@ boolean libspdm_calculate_th_hmac_for_exchange_rsp(
 	spdm_session_info_t *session_info;
 	void *secured_message_context;
 	uint32 hash_size;
-	void *hmac_context_th;
+	uintn th_hash_size;
+	uint8 th_hash_data[MAX_HASH_SIZE];
+	boolean result;
 
 	spdm_context = context;
 	session_info = spdm_session_info;
@@ -157,19 +163,23 @@ boolean libspdm_calculate_th_hmac_for_exchange_rsp(
 
 	ASSERT(*th_hmac_buffer_size >= hash_size);
 
-	if (session_info->session_transcript.hmac_rsp_context_th == NULL) {
-		// trigger message_k to initialize hmac context after finished_key is ready.
+	if (session_info->session_transcript.digest_context_th == NULL) {
+		// trigger message_k to initialize digest context.
 		libspdm_append_message_k (context, spdm_session_info, is_requester, NULL, 0);
-		ASSERT(session_info->session_transcript.hmac_rsp_context_th != NULL);
+		ASSERT(session_info->session_transcript.digest_context_th != NULL);
 	}
 
-	// duplicate the th context, because we still need use original context to continue.
-	hmac_context_th = spdm_hmac_new_with_response_finished_key (secured_message_context);
-	spdm_hmac_duplicate_with_response_finished_key (secured_message_context,
-		session_info->session_transcript.hmac_rsp_context_th, hmac_context_th);
-	spdm_hmac_final_with_response_finished_key (secured_message_context,
-		hmac_context_th, th_hmac_buffer);
-	spdm_hmac_free_with_response_finished_key (secured_message_context, hmac_context_th);
+	th_hash_size = sizeof(th_hash_data);
+	result = libspdm_calculate_th_hash_for_exchange(
+		context, spdm_session_info, &th_hash_size, th_hash_data);
+	if (!result) {
+		return FALSE;
+	}
+	result = spdm_hmac_all_with_response_finished_key(
+		secured_message_context, th_hash_data, th_hash_size, th_hmac_buffer);
+	if (!result) {
+		return FALSE;
+	}
 
 	*th_hmac_buffer_size = hash_size;
 
@@ -313,9 +323,11 @@ boolean libspdm_calculate_th_hash_for_finish(IN void *context,
 	spdm_session_info_t *session_info;
 	uint32 hash_size;
 	void *digest_context_th;
+	uint64 start_time;
 
 	spdm_context = context;
 	session_info = spdm_session_info;
+	start_time = spdm_statistics_get_time(spdm_context);
 
 	hash_size = spdm_get_hash_size(
 		spdm_context->connection_info.algorithm.base_hash_algo);
@@ -327,9 +339,15 @@ boolean libspdm_calculate_th_hash_for_finish(IN void *context,
 		spdm_context->connection_info.algorithm.base_hash_algo);
 	spdm_hash_duplicate (spdm_context->connection_info.algorithm.base_hash_algo,
 		session_info->session_transcript.digest_context_th, digest_context_th);
+	// message F is only folded into the copy, so the original stays at the end of message K.
+	spdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
+		digest_context_th, session_info->session_transcript.message_f_data,
+		session_info->session_transcript.message_f_data_size);
 	spdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
 		digest_context_th, th_hash_buffer);
 	spdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, digest_context_th);
+	spdm_statistics_record_crypto(spdm_context, SPDM_STATISTICS_CRYPTO_HASH,
+				      start_time);
 
 	*th_hash_buffer_size = hash_size;
 
@@ -355,7 +373,9 @@ boolean libspdm_calculate_th_hmac_for_finish_rsp(IN void *context,
 	spdm_session_info_t *session_info;
 	void *secured_message_context;
 	uint32 hash_size;
-	void *hmac_context_th;
+	uintn th_hash_size;
+	uint8 th_hash_data[MAX_HASH_SIZE];
+	boolean result;
 
 	spdm_context = context;
 	session_info = spdm_session_info;
@@ -366,15 +386,19 @@ boolean libspdm_calculate_th_hmac_for_finish_rsp(IN void *context,
 
 	ASSERT(*th_hmac_buffer_size >= hash_size);
 
-	ASSERT(session_info->session_transcript.hmac_rsp_context_th != NULL);
+	ASSERT(session_info->session_transcript.digest_context_th != NULL);
 
-	// duplicate the th context, because we still need use original context to continue.
-	hmac_context_th = spdm_hmac_new_with_response_finished_key (secured_message_context);
-	spdm_hmac_duplicate_with_response_finished_key (secured_message_context,
-		session_info->session_transcript.hmac_rsp_context_th, hmac_context_th);
-	spdm_hmac_final_with_response_finished_key (secured_message_context,
-		hmac_context_th, th_hmac_buffer);
-	spdm_hmac_free_with_response_finished_key (secured_message_context, hmac_context_th);
+	th_hash_size = sizeof(th_hash_data);
+	result = libspdm_calculate_th_hash_for_finish(
+		context, spdm_session_info, &th_hash_size, th_hash_data);
+	if (!result) {
+		return FALSE;
+	}
+	result = spdm_hmac_all_with_response_finished_key(
+		secured_message_context, th_hash_data, th_hash_size, th_hmac_buffer);
+	if (!result) {
+		return FALSE;
+	}
 
 	*th_hmac_buffer_size = hash_size;
 
@@ -400,7 +424,9 @@ boolean libspdm_calculate_th_hmac_for_finish_req(IN void *context,
 	spdm_session_info_t *session_info;
 	void *secured_message_context;
 	uint32 hash_size;
-	void *hmac_context_th;
+	uintn th_hash_size;
+	uint8 th_hash_data[MAX_HASH_SIZE];
+	boolean result;
 
 	spdm_context = context;
 	session_info = spdm_session_info;
@@ -411,15 +437,19 @@ boolean libspdm_calculate_th_hmac_for_finish_req(IN void *context,
 
 	ASSERT(*th_hmac_buffer_size >= hash_size);
 
-	ASSERT(session_info->session_transcript.hmac_req_context_th != NULL);
+	ASSERT(session_info->session_transcript.digest_context_th != NULL);
 
-	// duplicate the th context, because we still need use original context to continue.
-	hmac_context_th = spdm_hmac_new_with_request_finished_key (secured_message_context);
-	spdm_hmac_duplicate_with_request_finished_key (secured_message_context,
-		session_info->session_transcript.hmac_req_context_th, hmac_context_th);
-	spdm_hmac_final_with_request_finished_key (secured_message_context,
-		hmac_context_th, th_hmac_buffer);
-	spdm_hmac_free_with_request_finished_key (secured_message_context, hmac_context_th);
+	th_hash_size = sizeof(th_hash_data);
+	result = libspdm_calculate_th_hash_for_finish(
+		context, spdm_session_info, &th_hash_size, th_hash_data);
+	if (!result) {
+		return FALSE;
+	}
+	result = spdm_hmac_all_with_request_finished_key(
+		secured_message_context, th_hash_data, th_hash_size, th_hmac_buffer);
+	if (!result) {
+		return FALSE;
+	}
 
 	*th_hmac_buffer_size = hash_size;
 
@@ -446,6 +476,7 @@ spdm_generate_key_exchange_rsp_signature(IN spdm_context_t *spdm_context,
 	uint8 *cert_chain_buffer;
 	uintn cert_chain_buffer_size;
 	boolean result;
+	uint64 start_time;
 	uintn signature_size;
 	uintn hash_size;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
@@ -487,6 +518,8 @@ spdm_generate_key_exchange_rsp_signature(IN spdm_context_t *spdm_context,
 	internal_dump_data(hash_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_SIGN);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	result = spdm_responder_data_sign(
 		spdm_context->connection_info.version, SPDM_KEY_EXCHANGE_RSP,
@@ -500,6 +533,9 @@ spdm_generate_key_exchange_rsp_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_hash_algo,
 		TRUE, hash_data, hash_size, signature, &signature_size);
 #endif
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_SIGN);
+	spdm_statistics_record_crypto(spdm_context,
+				      SPDM_STATISTICS_CRYPTO_SIGN, start_time);
 	if (result) {
 		DEBUG((DEBUG_INFO, "signature - "));
 		internal_dump_data(signature, signature_size);
@@ -530,6 +566,7 @@ spdm_generate_key_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 #endif
 	boolean result;
 
@@ -551,9 +588,11 @@ spdm_generate_key_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      th_curr_data, th_curr_data_size, th_curr_hash_data);
 	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, hmac_data);
+		session_info->secured_message_context, th_curr_hash_data,
+		hash_size, hmac_data);
 #else
 	result = libspdm_calculate_th_hmac_for_exchange_rsp(
 		spdm_context, session_info, FALSE, &hash_size, hmac_data);
@@ -587,6 +626,7 @@ boolean spdm_verify_key_exchange_rsp_signature(
 	uintn hash_size;
 	uint8 hash_data[MAX_HASH_SIZE];
 	boolean result;
+	uint64 start_time;
 	uint8 *cert_chain_data;
 	uintn cert_chain_data_size;
 	uint8 *cert_chain_buffer;
@@ -657,6 +697,8 @@ boolean spdm_verify_key_exchange_rsp_signature(
 		return FALSE;
 	}
 
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_VERIFY);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	result = spdm_asym_verify(
 		spdm_context->connection_info.version, SPDM_KEY_EXCHANGE_RSP,
@@ -670,6 +712,9 @@ boolean spdm_verify_key_exchange_rsp_signature(
 		spdm_context->connection_info.algorithm.base_hash_algo, context,
 		hash_data, hash_size, sign_data, sign_data_size);
 #endif
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_VERIFY);
+	spdm_statistics_record_crypto(spdm_context,
+				      SPDM_STATISTICS_CRYPTO_VERIFY, start_time);
 	spdm_asym_free(spdm_context->connection_info.algorithm.base_asym_algo,
 		       context);
 	if (!result) {
@@ -706,6 +751,7 @@ boolean spdm_verify_key_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 #endif
 
 	hash_size = spdm_get_hash_size(
@@ -727,9 +773,11 @@ boolean spdm_verify_key_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      th_curr_data, th_curr_data_size, th_curr_hash_data);
 	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, calc_hmac_data);
+		session_info->secured_message_context, th_curr_hash_data,
+		hash_size, calc_hmac_data);
 #else
 	result = libspdm_calculate_th_hmac_for_exchange_rsp(
 		spdm_context, session_info, TRUE, &hash_size, calc_hmac_data);
@@ -771,6 +819,7 @@ boolean spdm_generate_finish_req_signature(IN spdm_context_t *spdm_context,
 	uint8 *mut_cert_chain_buffer;
 	uintn mut_cert_chain_buffer_size;
 	boolean result;
+	uint64 start_time;
 	uintn signature_size;
 	uintn hash_size;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
@@ -820,6 +869,8 @@ boolean spdm_generate_finish_req_signature(IN spdm_context_t *spdm_context,
 	internal_dump_data(hash_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
 
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_SIGN);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	result = spdm_requester_data_sign(
 		spdm_context->connection_info.version, SPDM_FINISH,
@@ -833,6 +884,9 @@ boolean spdm_generate_finish_req_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_hash_algo,
 		TRUE, hash_data, hash_size, signature, &signature_size);
 #endif
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_SIGN);
+	spdm_statistics_record_crypto(spdm_context,
+				      SPDM_STATISTICS_CRYPTO_SIGN, start_time);
 	if (result) {
 		DEBUG((DEBUG_INFO, "signature - "));
 		internal_dump_data(signature, signature_size);
@@ -866,6 +920,7 @@ boolean spdm_generate_finish_req_hmac(IN spdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 #endif
 
 	hash_size = spdm_get_hash_size(
@@ -899,9 +954,11 @@ boolean spdm_generate_finish_req_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      th_curr_data, th_curr_data_size, th_curr_hash_data);
 	spdm_hmac_all_with_request_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, calc_hmac_data);
+		session_info->secured_message_context, th_curr_hash_data,
+		hash_size, calc_hmac_data);
 #else
 	result = libspdm_calculate_th_hmac_for_finish_req(
 		spdm_context, session_info, &hash_size, calc_hmac_data);
@@ -937,6 +994,7 @@ boolean spdm_verify_finish_req_signature(IN spdm_context_t *spdm_context,
 	uintn hash_size;
 	uint8 hash_data[MAX_HASH_SIZE];
 	boolean result;
+	uint64 start_time;
 	uint8 *cert_chain_buffer;
 	uintn cert_chain_buffer_size;
 	uint8 *mut_cert_chain_data;
@@ -1019,6 +1077,8 @@ boolean spdm_verify_finish_req_signature(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_VERIFY);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	result = spdm_req_asym_verify(
 		spdm_context->connection_info.version, SPDM_FINISH,
@@ -1032,6 +1092,9 @@ boolean spdm_verify_finish_req_signature(IN spdm_context_t *spdm_context,
 		spdm_context->connection_info.algorithm.base_hash_algo, context,
 		hash_data, hash_size, sign_data, sign_data_size);
 #endif
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_VERIFY);
+	spdm_statistics_record_crypto(spdm_context,
+				      SPDM_STATISTICS_CRYPTO_VERIFY, start_time);
 	spdm_req_asym_free(
 		spdm_context->connection_info.algorithm.req_base_asym_alg,
 		context);
@@ -1069,6 +1132,7 @@ boolean spdm_verify_finish_req_hmac(IN spdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 #endif
 
 	hash_size = spdm_get_hash_size(
@@ -1103,9 +1167,11 @@ boolean spdm_verify_finish_req_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      th_curr_data, th_curr_data_size, th_curr_hash_data);
 	spdm_hmac_all_with_request_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, hmac_data);
+		session_info->secured_message_context, th_curr_hash_data,
+		hash_size, hmac_data);
 #else
 	result = libspdm_calculate_th_hmac_for_finish_req(
 		spdm_context, session_info, &hash_size, hmac_data);
@@ -1149,6 +1215,7 @@ boolean spdm_generate_finish_rsp_hmac(IN spdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 #endif
 
 	hash_size = spdm_get_hash_size(
@@ -1182,9 +1249,11 @@ boolean spdm_generate_finish_rsp_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      th_curr_data, th_curr_data_size, th_curr_hash_data);
 	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, hmac_data);
+		session_info->secured_message_context, th_curr_hash_data,
+		hash_size, hmac_data);
 #else
 	result = libspdm_calculate_th_hmac_for_finish_rsp(
 		spdm_context, session_info, &hash_size, hmac_data);
@@ -1226,6 +1295,7 @@ boolean spdm_verify_finish_rsp_hmac(IN spdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 #endif
 
 	hash_size = spdm_get_hash_size(
@@ -1260,9 +1330,11 @@ boolean spdm_verify_finish_rsp_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      th_curr_data, th_curr_data_size, th_curr_hash_data);
 	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, calc_hmac_data);
+		session_info->secured_message_context, th_curr_hash_data,
+		hash_size, calc_hmac_data);
 #else
 	result = libspdm_calculate_th_hmac_for_finish_rsp(
 		spdm_context, session_info, &hash_size, calc_hmac_data);
@@ -1304,6 +1376,7 @@ spdm_generate_psk_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 #endif
 
 	hash_size = spdm_get_hash_size(
@@ -1318,9 +1391,11 @@ spdm_generate_psk_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      th_curr_data, th_curr_data_size, th_curr_hash_data);
 	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, hmac_data);
+		session_info->secured_message_context, th_curr_hash_data,
+		hash_size, hmac_data);
 #else
 	result = libspdm_calculate_th_hmac_for_exchange_rsp(
 		spdm_context, session_info, FALSE, &hash_size, hmac_data);
@@ -1359,6 +1434,7 @@ boolean spdm_verify_psk_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 #endif
 
 	hash_size = spdm_get_hash_size(
@@ -1374,9 +1450,11 @@ boolean spdm_verify_psk_exchange_rsp_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      th_curr_data, th_curr_data_size, th_curr_hash_data);
 	spdm_hmac_all_with_response_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, calc_hmac_data);
+		session_info->secured_message_context, th_curr_hash_data,
+		hash_size, calc_hmac_data);
 #else
 	result = libspdm_calculate_th_hmac_for_exchange_rsp(
 		spdm_context, session_info, TRUE, &hash_size, calc_hmac_data);
@@ -1419,6 +1497,7 @@ spdm_generate_psk_exchange_req_hmac(IN spdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 #endif
 
 	hash_size = spdm_get_hash_size(
@@ -1433,9 +1512,11 @@ spdm_generate_psk_exchange_req_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      th_curr_data, th_curr_data_size, th_curr_hash_data);
 	spdm_hmac_all_with_request_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, calc_hmac_data);
+		session_info->secured_message_context, th_curr_hash_data,
+		hash_size, calc_hmac_data);
 #else
 	result = libspdm_calculate_th_hmac_for_finish_req(
 		spdm_context, session_info, &hash_size, calc_hmac_data);
@@ -1473,6 +1554,7 @@ boolean spdm_verify_psk_finish_req_hmac(IN spdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 	uint8 th_curr_data[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn th_curr_data_size;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 #endif
 
 	hash_size = spdm_get_hash_size(
@@ -1488,9 +1570,11 @@ boolean spdm_verify_psk_finish_req_hmac(IN spdm_context_t *spdm_context,
 		return FALSE;
 	}
 
+	spdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+		      th_curr_data, th_curr_data_size, th_curr_hash_data);
 	spdm_hmac_all_with_request_finished_key(
-		session_info->secured_message_context, th_curr_data,
-		th_curr_data_size, hmac_data);
+		session_info->secured_message_context, th_curr_hash_data,
+		hash_size, hmac_data);
 #else
 	result = libspdm_calculate_th_hmac_for_finish_req(
 		spdm_context, session_info, &hash_size, hmac_data);
@@ -1585,6 +1669,9 @@ return_status libspdm_calculate_th1_hash(IN void *context,
 	DEBUG((DEBUG_INFO, "th1 hash - "));
 	internal_dump_data(th1_hash_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
+	libspdm_extend_transcript_digest(spdm_context, session_info,
+					 SPDM_TRANSCRIPT_DIGEST_TH1,
+					 th1_hash_data, hash_size);
 
 	return RETURN_SUCCESS;
 }
@@ -1687,6 +1774,9 @@ return_status libspdm_calculate_th2_hash(IN void *context,
 	DEBUG((DEBUG_INFO, "th2 hash - "));
 	internal_dump_data(th2_hash_data, hash_size);
 	DEBUG((DEBUG_INFO, "\n"));
+	libspdm_extend_transcript_digest(spdm_context, session_info,
+					 SPDM_TRANSCRIPT_DIGEST_TH2,
+					 th2_hash_data, hash_size);
 
 	return RETURN_SUCCESS;
 }
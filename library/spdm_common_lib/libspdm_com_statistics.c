@@ -0,0 +1,160 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "internal/libspdm_common_lib.h"
+
+/**
+  Register the function returning the time for the statistics of an SPDM context.
+
+  If it is NOT registered, only the counters of the statistics are collected, and the times are 0.
+  If LIBSPDM_STATISTICS_SUPPORT is disabled, this function does nothing.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  get_time                      The fuction to return the time, or NULL.
+**/
+void libspdm_register_get_time_func(IN void *context,
+				    IN libspdm_get_time_func get_time OPTIONAL)
+{
+#if LIBSPDM_STATISTICS_SUPPORT
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->get_time = get_time;
+#endif
+}
+
+/**
+  Reset the statistics of an SPDM context.
+
+  If LIBSPDM_STATISTICS_SUPPORT is disabled, this function does nothing.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void libspdm_reset_statistics(IN void *context)
+{
+#if LIBSPDM_STATISTICS_SUPPORT
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	zero_mem(&spdm_context->statistics, sizeof(spdm_context->statistics));
+	spdm_context->statistics_request_code = 0;
+	spdm_context->statistics_request_start_time = 0;
+#endif
+}
+
+#if LIBSPDM_STATISTICS_SUPPORT
+/**
+  Return the time for the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The time stamp, or 0 if no time function is registered.
+**/
+uint64 spdm_statistics_get_time(IN spdm_context_t *spdm_context)
+{
+	if (spdm_context->get_time == NULL) {
+		return 0;
+	}
+	return spdm_context->get_time();
+}
+
+/**
+  Record the time elapsed since start_time in a statistics timer.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  timer                         The statistics timer.
+  @param  start_time                    The time returned by spdm_statistics_get_time before the operation.
+**/
+static void spdm_statistics_record_time(IN spdm_context_t *spdm_context,
+					IN OUT spdm_statistics_timer_t *timer,
+					IN uint64 start_time)
+{
+	uint64 time;
+
+	time = spdm_statistics_get_time(spdm_context);
+	time = (time > start_time) ? time - start_time : 0;
+	timer->count++;
+	timer->total_time += time;
+	if (time > timer->max_time) {
+		timer->max_time = time;
+	}
+}
+
+/**
+  Record the time of a crypto operation in the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  crypto                        The crypto operation.
+  @param  start_time                    The time returned by spdm_statistics_get_time before the operation.
+**/
+void spdm_statistics_record_crypto(IN spdm_context_t *spdm_context,
+				   IN spdm_statistics_crypto_t crypto,
+				   IN uint64 start_time)
+{
+	ASSERT(crypto < SPDM_STATISTICS_CRYPTO_MAX);
+	spdm_statistics_record_time(spdm_context,
+				    &spdm_context->statistics.crypto[crypto],
+				    start_time);
+}
+
+/**
+  Record the time to build the response to a request in the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The SPDM request code.
+  @param  start_time                    The time returned by spdm_statistics_get_time before handling the request.
+**/
+void spdm_statistics_record_response(IN spdm_context_t *spdm_context,
+				     IN uint8 request_code,
+				     IN uint64 start_time)
+{
+	if (request_code < SPDM_STATISTICS_REQUEST_CODE_BASE) {
+		return;
+	}
+	spdm_statistics_record_time(
+		spdm_context,
+		&spdm_context->statistics
+			 .response[request_code -
+				   SPDM_STATISTICS_REQUEST_CODE_BASE],
+		start_time);
+}
+
+/**
+  Start the round trip of a request in the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The SPDM request code.
+**/
+void spdm_statistics_start_request(IN spdm_context_t *spdm_context,
+				   IN uint8 request_code)
+{
+	spdm_context->statistics_request_code = request_code;
+	spdm_context->statistics_request_start_time =
+		spdm_statistics_get_time(spdm_context);
+}
+
+/**
+  Record the round trip of the request started by spdm_statistics_start_request in the statistics.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+**/
+void spdm_statistics_end_request(IN spdm_context_t *spdm_context)
+{
+	uint8 request_code;
+
+	request_code = spdm_context->statistics_request_code;
+	if (request_code < SPDM_STATISTICS_REQUEST_CODE_BASE) {
+		return;
+	}
+	spdm_statistics_record_time(
+		spdm_context,
+		&spdm_context->statistics
+			 .request[request_code -
+				  SPDM_STATISTICS_REQUEST_CODE_BASE],
+		spdm_context->statistics_request_start_time);
+	spdm_context->statistics_request_code = 0;
+}
+#endif
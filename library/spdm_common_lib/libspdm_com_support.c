@@ -6,6 +6,41 @@
 
 #include "internal/libspdm_common_lib.h"
 
+//
+// Bytes formatted into one debug message by the dump functions.
+// A line of internal_dump_hex is "oooo: " followed by 3 characters per byte, within MAX_DEBUG_MESSAGE_LENGTH.
+//
+#define DUMP_LINE_SIZE 32
+
+/**
+  Format data as hex characters into a line buffer.
+
+  @param  line       The line buffer, with at least 3 * size + 1 characters.
+  @param  data       raw data
+  @param  size       raw data size
+  @param  separator  Append a space after each byte.
+
+  @return The number of characters written to line, excluding the terminating NULL.
+**/
+static uintn internal_format_hex(OUT char8 *line, IN uint8 *data, IN uintn size,
+				 IN boolean separator)
+{
+	static const char8 hex_char[] = "0123456789abcdef";
+	uintn index;
+	uintn length;
+
+	length = 0;
+	for (index = 0; index < size; index++) {
+		line[length++] = hex_char[data[index] >> 4];
+		line[length++] = hex_char[data[index] & 0xF];
+		if (separator) {
+			line[length++] = ' ';
+		}
+	}
+	line[length] = '\0';
+	return length;
+}
+
 /**
   This function dump raw data.
 
@@ -14,9 +49,17 @@
 **/
 void internal_dump_hex_str(IN uint8 *data, IN uintn size)
 {
+	char8 line[DUMP_LINE_SIZE * 2 + 1];
 	uintn index;
-	for (index = 0; index < size; index++) {
-		DEBUG((DEBUG_INFO, "%02x", (uintn)data[index]));
+	uintn count;
+
+	if (!DEBUG_PRINT_LEVEL_ENABLED(DEBUG_INFO)) {
+		return;
+	}
+	for (index = 0; index < size; index += count) {
+		count = MIN(size - index, DUMP_LINE_SIZE);
+		internal_format_hex(line, data + index, count, FALSE);
+		DEBUG((DEBUG_INFO, "%s", line));
 	}
 }
 
@@ -28,38 +71,41 @@ void internal_dump_hex_str(IN uint8 *data, IN uintn size)
 **/
 void internal_dump_data(IN uint8 *data, IN uintn size)
 {
+	char8 line[DUMP_LINE_SIZE * 3 + 1];
 	uintn index;
-	for (index = 0; index < size; index++) {
-		DEBUG((DEBUG_INFO, "%02x ", (uintn)data[index]));
+	uintn count;
+
+	if (!DEBUG_PRINT_LEVEL_ENABLED(DEBUG_INFO)) {
+		return;
+	}
+	for (index = 0; index < size; index += count) {
+		count = MIN(size - index, DUMP_LINE_SIZE);
+		internal_format_hex(line, data + index, count, TRUE);
+		DEBUG((DEBUG_INFO, "%s", line));
 	}
 }
 
 /**
   This function dump raw data with colume format.
 
+  Each line is formatted in a buffer and printed by one debug message.
+
   @param  data  raw data
   @param  size  raw data size
 **/
 void internal_dump_hex(IN uint8 *data, IN uintn size)
 {
+	char8 line[DUMP_LINE_SIZE * 3 + 1];
 	uintn index;
 	uintn count;
-	uintn left;
 
-#define COLUME_SIZE (16 * 2)
-
-	count = size / COLUME_SIZE;
-	left = size % COLUME_SIZE;
-	for (index = 0; index < count; index++) {
-		DEBUG((DEBUG_INFO, "%04x: ", index * COLUME_SIZE));
-		internal_dump_data(data + index * COLUME_SIZE, COLUME_SIZE);
-		DEBUG((DEBUG_INFO, "\n"));
+	if (!DEBUG_PRINT_LEVEL_ENABLED(DEBUG_INFO)) {
+		return;
 	}
-
-	if (left != 0) {
-		DEBUG((DEBUG_INFO, "%04x: ", index * COLUME_SIZE));
-		internal_dump_data(data + index * COLUME_SIZE, left);
-		DEBUG((DEBUG_INFO, "\n"));
+	for (index = 0; index < size; index += count) {
+		count = MIN(size - index, DUMP_LINE_SIZE);
+		internal_format_hex(line, data + index, count, TRUE);
+		DEBUG((DEBUG_INFO, "%04x: %s\n", (uint32)index, line));
 	}
 }
 
@@ -118,8 +164,6 @@ return_status append_managed_buffer(IN OUT void *m_buffer, IN void *buffer,
 	ASSERT(buffer_size != 0);
 	ASSERT((managed_buffer->max_buffer_size ==
 		MAX_SPDM_MESSAGE_BUFFER_SIZE) ||
-	       (managed_buffer->max_buffer_size ==
-		MAX_SPDM_MESSAGE_MEDIUM_BUFFER_SIZE) ||
 	       (managed_buffer->max_buffer_size ==
 		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE));
 	ASSERT(managed_buffer->max_buffer_size >= managed_buffer->buffer_size);
@@ -158,8 +202,6 @@ void reset_managed_buffer(IN OUT void *m_buffer)
 
 	ASSERT((managed_buffer->max_buffer_size ==
 		MAX_SPDM_MESSAGE_BUFFER_SIZE) ||
-	       (managed_buffer->max_buffer_size ==
-		MAX_SPDM_MESSAGE_MEDIUM_BUFFER_SIZE) ||
 	       (managed_buffer->max_buffer_size ==
 		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE));
 	managed_buffer->buffer_size = 0;
@@ -181,8 +223,6 @@ uintn get_managed_buffer_size(IN OUT void *m_buffer)
 
 	ASSERT((managed_buffer->max_buffer_size ==
 		MAX_SPDM_MESSAGE_BUFFER_SIZE) ||
-	       (managed_buffer->max_buffer_size ==
-		MAX_SPDM_MESSAGE_MEDIUM_BUFFER_SIZE) ||
 	       (managed_buffer->max_buffer_size ==
 		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE));
 	return managed_buffer->buffer_size;
@@ -203,8 +243,6 @@ void *get_managed_buffer(IN OUT void *m_buffer)
 
 	ASSERT((managed_buffer->max_buffer_size ==
 		MAX_SPDM_MESSAGE_BUFFER_SIZE) ||
-	       (managed_buffer->max_buffer_size ==
-		MAX_SPDM_MESSAGE_MEDIUM_BUFFER_SIZE) ||
 	       (managed_buffer->max_buffer_size ==
 		MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE));
 	return (managed_buffer + 1);
@@ -223,7 +261,6 @@ void init_managed_buffer(IN OUT void *m_buffer, IN uintn max_buffer_size)
 	managed_buffer = m_buffer;
 
 	ASSERT((max_buffer_size == MAX_SPDM_MESSAGE_BUFFER_SIZE) ||
-	       (max_buffer_size == MAX_SPDM_MESSAGE_MEDIUM_BUFFER_SIZE) ||
 	       (max_buffer_size == MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE));
 
 	managed_buffer->max_buffer_size = max_buffer_size;
@@ -0,0 +1,89 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "internal/libspdm_common_lib.h"
+
+/**
+  Register an SPDM trace callback function.
+
+  This function can be called multiple times to let different tracers register its own callback.
+  If LIBSPDM_TRACE_SUPPORT is disabled, this function does nothing.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_trace_callback           The function to be called at the begin and the end of each phase.
+
+  @retval RETURN_SUCCESS          The callback is registered.
+  @retval RETURN_ALREADY_STARTED  No enough memory to register the callback.
+**/
+return_status
+libspdm_register_trace_callback_func(IN void *context,
+				     IN libspdm_trace_callback_func spdm_trace_callback)
+{
+#if LIBSPDM_TRACE_SUPPORT
+	spdm_context_t *spdm_context;
+	uintn index;
+
+	spdm_context = context;
+	for (index = 0; index < MAX_SPDM_TRACE_CALLBACK_NUM; index++) {
+		if (spdm_context->spdm_trace_callback[index] == 0) {
+			spdm_context->spdm_trace_callback[index] =
+				(uintn)spdm_trace_callback;
+			return RETURN_SUCCESS;
+		}
+	}
+	ASSERT(FALSE);
+
+	return RETURN_ALREADY_STARTED;
+#else
+	return RETURN_SUCCESS;
+#endif
+}
+
+/**
+  Notify the begin or the end of a phase to the registered trace callbacks.
+
+  It is used by the transport layer libraries for the secured message phases.
+  If LIBSPDM_TRACE_SUPPORT is disabled, this function does nothing.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  phase                         The phase of the SPDM message processing.
+  @param  event                         The begin or the end of the phase.
+**/
+void libspdm_trace(IN void *context, IN spdm_trace_phase_t phase,
+		   IN spdm_trace_event_t event)
+{
+#if LIBSPDM_TRACE_SUPPORT
+	spdm_context_t *spdm_context;
+	uintn index;
+
+	spdm_context = context;
+	for (index = 0; index < MAX_SPDM_TRACE_CALLBACK_NUM; index++) {
+		if (spdm_context->spdm_trace_callback[index] != 0) {
+			((libspdm_trace_callback_func)spdm_context
+				 ->spdm_trace_callback[index])(
+				spdm_context, phase, event,
+				spdm_context->trace_session_id,
+				spdm_context->trace_request_code);
+		}
+	}
+#endif
+}
+
+#if LIBSPDM_TRACE_SUPPORT
+/**
+  Set the session ID and the request code of the message being processed, for the trace callbacks.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    The session ID of the message, or INVALID_SESSION_ID.
+  @param  request_code                  The SPDM request code of the message, or 0 if it is unknown.
+**/
+void spdm_trace_set_message(IN spdm_context_t *spdm_context,
+			    IN uint32 session_id, IN uint8 request_code)
+{
+	spdm_context->trace_session_id = session_id;
+	spdm_context->trace_request_code = request_code;
+}
+#endif
@@ -339,6 +339,7 @@ return_status libspdm_challenge(IN void *context, IN uint8 slot_id,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -389,6 +390,7 @@ return_status libspdm_challenge_ex(IN void *context, IN uint8 slot_id,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
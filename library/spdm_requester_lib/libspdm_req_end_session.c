@@ -128,6 +128,7 @@ return_status spdm_send_receive_end_session(IN spdm_context_t *spdm_context,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
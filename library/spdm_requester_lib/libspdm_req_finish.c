@@ -90,6 +90,7 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 
 	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
 	spdm_request.header.request_response_code = SPDM_FINISH;
+	spdm_trace_set_message(spdm_context, session_id, SPDM_FINISH);
 	if (session_info->mut_auth_requested) {
 		spdm_request.header.param1 =
 			SPDM_FINISH_REQUEST_ATTRIBUTES_SIGNATURE_INCLUDED;
@@ -235,8 +236,10 @@ return_status try_spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	status = spdm_generate_session_data_key(
 		session_info->secured_message_context, th2_hash_data);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
@@ -263,6 +266,7 @@ return_status spdm_send_receive_finish(IN spdm_context_t *spdm_context,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -89,20 +89,23 @@ boolean spdm_check_response_flag_compability(IN uint32 capabilities_flag,
 }
 
 /**
-  This function sends GET_CAPABILITIES and receives CAPABILITIES.
+  This function builds GET_CAPABILITIES request.
 
   @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the request data buffer.
+                                       On input, it means the size in bytes of request data buffer.
+                                       On output, it means the size in bytes of the request.
+  @param  spdm_request                  A pointer to the request data buffer.
 
-  @retval RETURN_SUCCESS               The GET_CAPABILITIES is sent and the CAPABILITIES is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SUCCESS               The GET_CAPABILITIES is built.
+  @retval RETURN_UNSUPPORTED           The connection state is not AFTER_VERSION.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the request.
 **/
-return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
+return_status spdm_build_get_capabilities_request(
+	IN spdm_context_t *spdm_context, IN OUT uintn *spdm_request_size,
+	OUT void *spdm_request)
 {
-	return_status status;
-	spdm_get_capabilities_request spdm_request;
-	uintn spdm_request_size;
-	spdm_capabilities_response spdm_response;
-	uintn spdm_response_size;
+	spdm_get_capabilities_request *get_capabilities_request;
 
 	spdm_reset_message_buffer_via_request_code(spdm_context, NULL,
 								SPDM_GET_CAPABILITIES);
@@ -111,33 +114,60 @@ return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
 		return RETURN_UNSUPPORTED;
 	}
 
-	zero_mem(&spdm_request, sizeof(spdm_request));
+	ASSERT(*spdm_request_size >= sizeof(spdm_get_capabilities_request));
+	if (*spdm_request_size < sizeof(spdm_get_capabilities_request)) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+
+	get_capabilities_request = spdm_request;
+	zero_mem(get_capabilities_request,
+		 sizeof(spdm_get_capabilities_request));
 	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
-		spdm_request_size = sizeof(spdm_request);
+		get_capabilities_request->header.spdm_version =
+			SPDM_MESSAGE_VERSION_11;
+		*spdm_request_size = sizeof(spdm_get_capabilities_request);
 	} else {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
-		spdm_request_size = sizeof(spdm_request.header);
+		get_capabilities_request->header.spdm_version =
+			SPDM_MESSAGE_VERSION_10;
+		*spdm_request_size = sizeof(spdm_message_header_t);
 	}
-	spdm_request.header.request_response_code = SPDM_GET_CAPABILITIES;
-	spdm_request.header.param1 = 0;
-	spdm_request.header.param2 = 0;
-	spdm_request.ct_exponent =
+	get_capabilities_request->header.request_response_code =
+		SPDM_GET_CAPABILITIES;
+	get_capabilities_request->header.param1 = 0;
+	get_capabilities_request->header.param2 = 0;
+	get_capabilities_request->ct_exponent =
 		spdm_context->local_context.capability.ct_exponent;
-	spdm_request.flags = spdm_context->local_context.capability.flags;
-	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
-					&spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	get_capabilities_request->flags =
+		spdm_context->local_context.capability.flags;
 
-	spdm_response_size = sizeof(spdm_response);
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes CAPABILITIES response to GET_CAPABILITIES request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the GET_CAPABILITIES request.
+  @param  spdm_request                  A pointer to the GET_CAPABILITIES request.
+  @param  spdm_response_size             size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The CAPABILITIES is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The response cannot be cached.
+**/
+return_status spdm_process_capabilities_response(
+	IN spdm_context_t *spdm_context, IN uintn spdm_request_size,
+	IN void *spdm_request, IN uintn spdm_response_size, IN void *response)
+{
+	return_status status;
+	spdm_get_capabilities_request *get_capabilities_request;
+	spdm_capabilities_response spdm_response;
+
+	get_capabilities_request = spdm_request;
 	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	copy_mem(&spdm_response, response,
+		 MIN(spdm_response_size, sizeof(spdm_response)));
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
@@ -158,7 +188,7 @@ return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
 		return RETURN_DEVICE_ERROR;
 	}
 	//Check if received message version matches sent message version
-	if (spdm_request.header.spdm_version !=
+	if (get_capabilities_request->header.spdm_version !=
 	    spdm_response.header.spdm_version) {
 		return RETURN_DEVICE_ERROR;
 	}
@@ -172,7 +202,7 @@ return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
 	//
 	// Cache data
 	//
-	status = libspdm_append_message_a(spdm_context, &spdm_request,
+	status = libspdm_append_message_a(spdm_context, spdm_request,
 				       spdm_request_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
@@ -194,6 +224,48 @@ return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends GET_CAPABILITIES and receives CAPABILITIES.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The GET_CAPABILITIES is sent and the CAPABILITIES is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_get_capabilities(IN spdm_context_t *spdm_context)
+{
+	return_status status;
+	spdm_get_capabilities_request spdm_request;
+	uintn spdm_request_size;
+	spdm_capabilities_response spdm_response;
+	uintn spdm_response_size;
+
+	spdm_request_size = sizeof(spdm_request);
+	status = spdm_build_get_capabilities_request(
+		spdm_context, &spdm_request_size, &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
+					&spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	return spdm_process_capabilities_response(
+		spdm_context, spdm_request_size, &spdm_request,
+		spdm_response_size, &spdm_response);
+}
+
 /**
   This function sends GET_CAPABILITIES and receives CAPABILITIES.
 
@@ -213,6 +285,7 @@ return_status spdm_get_capabilities(IN spdm_context_t *spdm_context)
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
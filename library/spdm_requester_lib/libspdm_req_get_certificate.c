@@ -352,6 +352,7 @@ return_status libspdm_get_certificate_choose_length(IN void *context,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -400,6 +401,7 @@ return_status libspdm_get_certificate_choose_length_ex(IN void *context,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -198,6 +198,7 @@ return_status libspdm_get_digest(IN void *context, OUT uint8 *slot_mask,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -503,6 +503,7 @@ return_status libspdm_get_measurement(IN void *context, IN uint32 *session_id,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -559,9 +560,132 @@ return_status libspdm_get_measurement_ex(IN void *context, IN uint32 *session_id
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
 }
 
+/**
+  This function sends a batch of GET_MEASUREMENT requests, one per measurement index,
+  to get the measurements from the device.
+
+  The requests are sent back to back. Only the last request carries request_attribute,
+  so that when a signature is requested, a single signature covers L1/L2 of the whole batch.
+  If any request fails, the batch is aborted and L1/L2 is reset.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+                                       If session_id is NULL, it is a normal message.
+                                       If session_id is NOT NULL, it is a secured message.
+  @param  request_attribute             The request attribute of the last request message.
+  @param  slot_id                      The number of slot for the certificate chain.
+  @param  measurement_index_count        The number of entries in measurement_indices.
+  @param  measurement_indices            The measurement indices to get, each in range 1 to 0xFE.
+  @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+                                       On output, indicate the size in bytes of the measurement record.
+  @param  measurement_record            A pointer to a destination buffer to store the measurement blocks,
+                                       in the order of measurement_indices.
+  @param  measurement_blocks            An array of measurement_index_count entries to receive a pointer to
+                                       each measurement block in measurement_record, if not NULL.
+
+  @retval RETURN_SUCCESS               The measurements are got successfully.
+  @retval RETURN_INVALID_PARAMETER     The measurement index list is invalid.
+  @retval RETURN_BUFFER_TOO_SMALL      The measurement record buffer is too small.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device,
+                                       or a response does not carry the requested measurement block.
+  @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+**/
+return_status libspdm_get_measurements_batch(
+	IN void *context, IN uint32 *session_id, IN uint8 request_attribute,
+	IN uint8 slot_id_param, IN uintn measurement_index_count,
+	IN const uint8 *measurement_indices,
+	IN OUT uint32 *measurement_record_length, OUT void *measurement_record,
+	OUT spdm_measurement_block_common_header_t **measurement_blocks OPTIONAL)
+{
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uintn index;
+	uintn retry;
+	uint8 attribute;
+	uint8 number_of_blocks;
+	uint32 record_offset;
+	uint32 block_length;
+	spdm_measurement_block_common_header_t *measurement_block;
+	return_status status;
+
+	spdm_context = context;
+	if ((measurement_index_count == 0) || (measurement_indices == NULL) ||
+	    (measurement_record_length == NULL) ||
+	    (measurement_record == NULL)) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	for (index = 0; index < measurement_index_count; index++) {
+		if ((measurement_indices[index] ==
+		     SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) ||
+		    (measurement_indices[index] ==
+		     SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS)) {
+			return RETURN_INVALID_PARAMETER;
+		}
+	}
+
+	record_offset = 0;
+	for (index = 0; index < measurement_index_count; index++) {
+		if (index == measurement_index_count - 1) {
+			attribute = request_attribute;
+		} else {
+			attribute = 0;
+		}
+		retry = spdm_context->retry_times;
+		do {
+			block_length = *measurement_record_length - record_offset;
+			status = try_spdm_get_measurement(
+				spdm_context, session_id, attribute,
+				measurement_indices[index], slot_id_param,
+				&number_of_blocks, &block_length,
+				(uint8 *)measurement_record + record_offset,
+				NULL, NULL, NULL);
+			if (status != RETURN_NO_RESPONSE) {
+				break;
+			}
+			spdm_requester_busy_backoff(spdm_context, retry);
+		} while (retry-- != 0);
+		//
+		// Each response must carry exactly the requested block, so that
+		// measurement_blocks[index] matches measurement_indices[index].
+		//
+		if (!RETURN_ERROR(status)) {
+			measurement_block = (void *)((uint8 *)measurement_record +
+						     record_offset);
+			if ((number_of_blocks != 1) ||
+			    (block_length <
+			     sizeof(spdm_measurement_block_common_header_t)) ||
+			    (measurement_block->index !=
+			     measurement_indices[index])) {
+				status = RETURN_DEVICE_ERROR;
+			}
+		}
+		if (RETURN_ERROR(status)) {
+			//
+			// Do not leave a partial L1/L2 behind for the next request.
+			//
+			if (session_id == NULL) {
+				session_info = NULL;
+			} else {
+				session_info = libspdm_get_session_info_via_session_id(
+					spdm_context, *session_id);
+			}
+			libspdm_reset_message_m(spdm_context, session_info);
+			return status;
+		}
+		if (measurement_blocks != NULL) {
+			measurement_blocks[index] = measurement_block;
+		}
+		record_offset += block_length;
+	}
+
+	*measurement_record_length = record_offset;
+	return RETURN_SUCCESS;
+}
+
 #endif // SPDM_ENABLE_CAPABILITY_MEAS_CAP
\ No newline at end of file
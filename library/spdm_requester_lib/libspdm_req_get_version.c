@@ -132,51 +132,77 @@ boolean spdm_negotiate_connection_version(IN OUT void *context, IN spdm_version_
 }
 
 /**
-  This function sends GET_VERSION and receives VERSION.
+  This function builds GET_VERSION request.
 
   @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the request data buffer.
+                                       On input, it means the size in bytes of request data buffer.
+                                       On output, it means the size in bytes of the request.
+  @param  spdm_request                  A pointer to the request data buffer.
 
-  @retval RETURN_SUCCESS               The GET_VERSION is sent and the VERSION is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SUCCESS               The GET_VERSION is built.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the request.
 **/
-return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
+return_status spdm_build_get_version_request(IN spdm_context_t *spdm_context,
+					     IN OUT uintn *spdm_request_size,
+					     OUT void *spdm_request)
 {
-	return_status status;
-	boolean result;
-	spdm_get_version_request_t spdm_request;
-	spdm_version_response_max_t spdm_response;
-	uintn spdm_response_size;
+	spdm_get_version_request_t *spdm_get_version_request;
+
+	ASSERT(*spdm_request_size >= sizeof(spdm_get_version_request_t));
+	if (*spdm_request_size < sizeof(spdm_get_version_request_t)) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
 
 	spdm_context->connection_info.connection_state =
 		SPDM_CONNECTION_STATE_NOT_STARTED;
 
-	spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
-	spdm_request.header.request_response_code = SPDM_GET_VERSION;
-	spdm_request.header.param1 = 0;
-	spdm_request.header.param2 = 0;
+	spdm_get_version_request = spdm_request;
+	spdm_get_version_request->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	spdm_get_version_request->header.request_response_code =
+		SPDM_GET_VERSION;
+	spdm_get_version_request->header.param1 = 0;
+	spdm_get_version_request->header.param2 = 0;
+	*spdm_request_size = sizeof(spdm_get_version_request_t);
 
 	libspdm_reset_context(spdm_context);
 
 	spdm_reset_message_buffer_via_request_code(spdm_context, NULL,
-						spdm_request.header.request_response_code);
+						SPDM_GET_VERSION);
 
-	status = spdm_send_spdm_request(spdm_context, NULL,
-					sizeof(spdm_request), &spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function processes VERSION response to GET_VERSION request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the GET_VERSION request.
+  @param  spdm_request                  A pointer to the GET_VERSION request.
+  @param  spdm_response_size             size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The VERSION is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The response cannot be cached.
+**/
+return_status spdm_process_version_response(IN spdm_context_t *spdm_context,
+					    IN uintn spdm_request_size,
+					    IN void *spdm_request,
+					    IN uintn spdm_response_size,
+					    IN void *response)
+{
+	return_status status;
+	boolean result;
+	spdm_version_response_max_t spdm_response;
 
 	libspdm_reset_message_a(spdm_context);
 	libspdm_reset_message_b(spdm_context);
 	libspdm_reset_message_c(spdm_context);
 
-	spdm_response_size = sizeof(spdm_response);
 	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	copy_mem(&spdm_response, response,
+		 MIN(spdm_response_size, sizeof(spdm_response)));
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
@@ -217,8 +243,8 @@ return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
 	//
 	// Cache data
 	//
-	status = libspdm_append_message_a(spdm_context, &spdm_request,
-				       sizeof(spdm_request));
+	status = libspdm_append_message_a(spdm_context, spdm_request,
+				       spdm_request_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
@@ -247,6 +273,48 @@ return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends GET_VERSION and receives VERSION.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The GET_VERSION is sent and the VERSION is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_get_version(IN spdm_context_t *spdm_context)
+{
+	return_status status;
+	spdm_get_version_request_t spdm_request;
+	uintn spdm_request_size;
+	spdm_version_response_max_t spdm_response;
+	uintn spdm_response_size;
+
+	spdm_request_size = sizeof(spdm_request);
+	status = spdm_build_get_version_request(spdm_context, &spdm_request_size,
+						&spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
+					&spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	return spdm_process_version_response(spdm_context, spdm_request_size,
+					     &spdm_request, spdm_response_size,
+					     &spdm_response);
+}
+
 /**
   This function sends GET_VERSION and receives VERSION.
 
@@ -268,6 +336,7 @@ return_status spdm_get_version(IN spdm_context_t *spdm_context)
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
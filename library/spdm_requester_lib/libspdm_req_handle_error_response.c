@@ -6,6 +6,99 @@
 
 #include "internal/libspdm_requester_lib.h"
 
+/**
+  Register the function to wait before retrying a request.
+
+  This function must be called after libspdm_init_context, and before any SPDM communication.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  sleep                         The fuction to wait, or NULL.
+**/
+void libspdm_register_sleep_func(IN void *context,
+				 IN libspdm_sleep_func sleep OPTIONAL)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	spdm_context->sleep = sleep;
+}
+
+/**
+  This function waits before the next request, if a sleep function is registered.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  duration                      The time to wait, in microseconds.
+**/
+void spdm_requester_sleep(IN spdm_context_t *spdm_context, IN uint64 duration)
+{
+	if ((spdm_context->sleep == NULL) || (duration == 0)) {
+		return;
+	}
+	spdm_context->sleep(spdm_context, duration);
+}
+
+/**
+  This function returns the time to wait before retrying a request after a BUSY error.
+
+  The wait doubles on each retry, from SPDM_BUSY_RETRY_BASE_DELAY up to SPDM_BUSY_RETRY_MAX_DELAY,
+  and a random jitter of up to half of the wait is removed, so that requesters do not retry together.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  retry                         The number of retries left, as counted down from retry_times.
+
+  @return The time to wait, in microseconds.
+**/
+uint64 spdm_requester_get_busy_backoff_delay(IN spdm_context_t *spdm_context,
+					     IN uintn retry)
+{
+	uintn attempt;
+	uint64 delay;
+	uint32 jitter;
+
+	attempt = 0;
+	if (spdm_context->retry_times > retry) {
+		attempt = spdm_context->retry_times - retry;
+	}
+	delay = SPDM_BUSY_RETRY_BASE_DELAY;
+	while ((attempt > 0) && (delay < SPDM_BUSY_RETRY_MAX_DELAY)) {
+		delay *= 2;
+		attempt--;
+	}
+	delay = MIN(delay, SPDM_BUSY_RETRY_MAX_DELAY);
+
+	spdm_get_random_number(sizeof(jitter), (uint8 *)&jitter);
+	delay -= jitter % (delay / 2 + 1);
+
+	return delay;
+}
+
+/**
+  This function waits before retrying a request after a BUSY error.
+
+  The wait is returned by spdm_requester_get_busy_backoff_delay.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  retry                         The number of retries left, as counted down from retry_times.
+**/
+void spdm_requester_busy_backoff(IN spdm_context_t *spdm_context,
+				 IN uintn retry)
+{
+	//
+	// No wait after the last attempt.
+	//
+	if (retry == 0) {
+		return;
+	}
+	SPDM_STATISTICS_ADD(spdm_context, retry_count, 1);
+	if (spdm_context->sleep == NULL) {
+		return;
+	}
+
+	spdm_requester_sleep(spdm_context,
+			     spdm_requester_get_busy_backoff_delay(spdm_context,
+								    retry));
+}
+
 /**
   This function sends RESPOND_IF_READY and receives an expected SPDM response.
 
@@ -18,6 +111,7 @@
   @param  expected_response_size         Indicate the expected response size.
 
   @retval RETURN_SUCCESS               The RESPOND_IF_READY is sent and an expected SPDM response is received.
+  @retval RETURN_NOT_READY             The RESPOND_IF_READY is sent and a ResponseNotReady error is received again.
   @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
 **/
 return_status spdm_requester_respond_if_ready(IN spdm_context_t *spdm_context,
@@ -30,6 +124,7 @@ return_status spdm_requester_respond_if_ready(IN spdm_context_t *spdm_context,
 	return_status status;
 	spdm_response_if_ready_request_t spdm_request;
 	spdm_message_header_t *spdm_response;
+	spdm_error_data_response_not_ready_t *extend_error_data;
 
 	spdm_response = response;
 
@@ -57,6 +152,22 @@ return_status spdm_requester_respond_if_ready(IN spdm_context_t *spdm_context,
 	if (*response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
+	if ((spdm_response->request_response_code == SPDM_ERROR) &&
+	    (spdm_response->param1 == SPDM_ERROR_CODE_RESPONSE_NOT_READY) &&
+	    (*response_size == sizeof(spdm_error_response_t) +
+				       sizeof(spdm_error_data_response_not_ready_t))) {
+		extend_error_data = (spdm_error_data_response_not_ready_t
+					     *)((spdm_error_response_t *)response + 1);
+		if (extend_error_data->request_code !=
+		    spdm_context->error_data.request_code) {
+			return RETURN_DEVICE_ERROR;
+		}
+		spdm_context->error_data.rd_exponent =
+			extend_error_data->rd_exponent;
+		spdm_context->error_data.token = extend_error_data->token;
+		spdm_context->error_data.rd_tm = extend_error_data->rd_tm;
+		return RETURN_NOT_READY;
+	}
 	if (spdm_response->request_response_code != expected_response_code) {
 		return RETURN_DEVICE_ERROR;
 	}
@@ -103,9 +214,28 @@ return_status spdm_handle_simple_error_response(IN void *context,
 	return RETURN_DEVICE_ERROR;
 }
 
+/**
+  This function returns the time to wait for a ResponseNotReady responder.
+
+  @param  rd_exponent                   The RDTExponent of the ResponseNotReady error.
+
+  @return RDT (2^RDTExponent microseconds), up to MAX_SPDM_RESPONSE_NOT_READY_WAIT_TIME.
+**/
+uint64 spdm_get_response_not_ready_wait_time(IN uint8 rd_exponent)
+{
+	if (rd_exponent >= 64) {
+		return MAX_SPDM_RESPONSE_NOT_READY_WAIT_TIME;
+	}
+	return MIN((uint64)1 << rd_exponent,
+		   (uint64)MAX_SPDM_RESPONSE_NOT_READY_WAIT_TIME);
+}
+
 /**
   This function handles RESPONSE_NOT_READY error code.
 
+  If a sleep function is registered, RESPOND_IF_READY is sent after RDT, and sent again with a
+  doubling wait while the responder is not ready, until RDT * RDTM.
+
   @param  spdm_context                  A pointer to the SPDM context.
   @param  response_size                 The size of the response.
                                        On input, it means the size in bytes of response data buffer.
@@ -128,6 +258,10 @@ return_status spdm_handle_response_not_ready(IN spdm_context_t *spdm_context,
 {
 	spdm_error_response_t *spdm_response;
 	spdm_error_data_response_not_ready_t *extend_error_data;
+	return_status status;
+	uint64 wait_time;
+	uint64 max_wait_time;
+	uint64 total_wait_time;
 
 	spdm_response = response;
 	extend_error_data =
@@ -144,11 +278,30 @@ return_status spdm_handle_response_not_ready(IN spdm_context_t *spdm_context,
 	spdm_context->error_data.request_code = extend_error_data->request_code;
 	spdm_context->error_data.token = extend_error_data->token;
 	spdm_context->error_data.rd_tm = extend_error_data->rd_tm;
+	SPDM_STATISTICS_ADD(spdm_context, not_ready_count, 1);
+
+	wait_time = spdm_get_response_not_ready_wait_time(
+		spdm_context->error_data.rd_exponent);
+	max_wait_time = MIN(wait_time * MAX(spdm_context->error_data.rd_tm, 1),
+			    (uint64)MAX_SPDM_RESPONSE_NOT_READY_WAIT_TIME);
+	total_wait_time = 0;
+	while (TRUE) {
+		spdm_requester_sleep(spdm_context, wait_time);
+		total_wait_time += wait_time;
 
-	return spdm_requester_respond_if_ready(spdm_context, session_id,
-					       response_size, response,
-					       expected_response_code,
-					       expected_response_size);
+		status = spdm_requester_respond_if_ready(
+			spdm_context, session_id, response_size, response,
+			expected_response_code, expected_response_size);
+		if (status != RETURN_NOT_READY) {
+			return status;
+		}
+		SPDM_STATISTICS_ADD(spdm_context, not_ready_count, 1);
+		if ((spdm_context->sleep == NULL) ||
+		    (total_wait_time >= max_wait_time)) {
+			return RETURN_DEVICE_ERROR;
+		}
+		wait_time = MIN(wait_time * 2, max_wait_time - total_wait_time);
+	}
 }
 
 /**
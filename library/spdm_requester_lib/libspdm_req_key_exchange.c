@@ -77,6 +77,7 @@ return_status try_spdm_send_receive_key_exchange(
 	uint8 *signature;
 	uint8 *verify_data;
 	void *dhe_context;
+	uint64 start_time;
 	uint16 req_session_id;
 	uint16 rsp_session_id;
 	spdm_session_info_t *session_info;
@@ -123,6 +124,8 @@ return_status try_spdm_send_receive_key_exchange(
 		copy_mem (requester_random, spdm_request.random_data, SPDM_RANDOM_DATA_SIZE);
 	}
 
+	spdm_trace_set_message(spdm_context, INVALID_SESSION_ID,
+			       SPDM_KEY_EXCHANGE);
 	req_session_id = spdm_allocate_req_session_id(spdm_context);
 	spdm_request.req_session_id = req_session_id;
 	spdm_request.reserved = 0;
@@ -130,11 +133,16 @@ return_status try_spdm_send_receive_key_exchange(
 	ptr = spdm_request.exchange_data;
 	dhe_key_size = spdm_get_dhe_pub_key_size(
 		spdm_context->connection_info.algorithm.dhe_named_group);
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_DHE);
 	dhe_context = spdm_secured_message_dhe_new(
 		spdm_context->connection_info.algorithm.dhe_named_group);
 	spdm_secured_message_dhe_generate_key(
 		spdm_context->connection_info.algorithm.dhe_named_group,
 		dhe_context, ptr, &dhe_key_size);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_DHE);
+	spdm_statistics_record_crypto(spdm_context, SPDM_STATISTICS_CRYPTO_DHE,
+				      start_time);
 	DEBUG((DEBUG_INFO, "ClientKey (0x%x):\n", dhe_key_size));
 	internal_dump_hex(ptr, dhe_key_size);
 	ptr += dhe_key_size;
@@ -260,6 +268,7 @@ return_status try_spdm_send_receive_key_exchange(
 			dhe_context);
 		return RETURN_DEVICE_ERROR;
 	}
+	spdm_trace_set_message(spdm_context, *session_id, SPDM_KEY_EXCHANGE);
 
 	signature_size = spdm_get_asym_signature_size(
 		spdm_context->connection_info.algorithm.base_asym_algo);
@@ -393,6 +402,8 @@ return_status try_spdm_send_receive_key_exchange(
 	//
 	// Fill data to calc Secret for HMAC verification
 	//
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_DHE);
 	result = spdm_secured_message_dhe_compute_key(
 		spdm_context->connection_info.algorithm.dhe_named_group,
 		dhe_context, spdm_response.exchange_data, dhe_key_size,
@@ -400,6 +411,9 @@ return_status try_spdm_send_receive_key_exchange(
 	spdm_secured_message_dhe_free(
 		spdm_context->connection_info.algorithm.dhe_named_group,
 		dhe_context);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_DHE);
+	spdm_statistics_record_crypto(spdm_context, SPDM_STATISTICS_CRYPTO_DHE,
+				      start_time);
 	if (!result) {
 		libspdm_free_session_id(spdm_context, *session_id);
 		return RETURN_SECURITY_VIOLATION;
@@ -413,8 +427,10 @@ return_status try_spdm_send_receive_key_exchange(
 		libspdm_free_session_id(spdm_context, *session_id);
 		return RETURN_SECURITY_VIOLATION;
 	}
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	status = spdm_generate_session_handshake_key(
 		session_info->secured_message_context, th1_hash_data);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	if (RETURN_ERROR(status)) {
 		libspdm_free_session_id(spdm_context, *session_id);
 		return RETURN_SECURITY_VIOLATION;
@@ -490,6 +506,7 @@ return_status spdm_send_receive_key_exchange(
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -533,6 +550,7 @@ return_status spdm_send_receive_key_exchange_ex(
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
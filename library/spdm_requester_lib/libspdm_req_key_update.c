@@ -256,6 +256,7 @@ return_status libspdm_key_update(IN void *context, IN uint32 session_id,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -46,24 +46,23 @@ typedef struct {
 #pragma pack()
 
 /**
-  This function sends NEGOTIATE_ALGORITHMS and receives ALGORITHMS.
+  This function builds NEGOTIATE_ALGORITHMS request.
 
   @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the request data buffer.
+                                       On input, it means the size in bytes of request data buffer.
+                                       On output, it means the size in bytes of the request.
+  @param  spdm_request                  A pointer to the request data buffer.
 
-  @retval RETURN_SUCCESS               The NEGOTIATE_ALGORITHMS is sent and the ALGORITHMS is received.
-  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_SUCCESS               The NEGOTIATE_ALGORITHMS is built.
+  @retval RETURN_UNSUPPORTED           The connection state is not AFTER_CAPABILITIES.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the request.
 **/
-return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
+return_status spdm_build_negotiate_algorithms_request(
+	IN spdm_context_t *spdm_context, IN OUT uintn *spdm_request_size,
+	OUT void *spdm_request)
 {
-	return_status status;
-	spdm_negotiate_algorithms_request_mine_t spdm_request;
-	spdm_algorithms_response_max_t spdm_response;
-	uintn spdm_response_size;
-	uint32 algo_size;
-	uintn index;
-	spdm_negotiate_algorithms_common_struct_table_t *struct_table;
-	uint8 fixed_alg_size;
-	uint8 ext_alg_count;
+	spdm_negotiate_algorithms_request_mine_t *algorithms_request;
 
 	spdm_reset_message_buffer_via_request_code(spdm_context, NULL,
 									SPDM_NEGOTIATE_ALGORITHMS);
@@ -73,62 +72,97 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 		return RETURN_UNSUPPORTED;
 	}
 
-	zero_mem(&spdm_request, sizeof(spdm_request));
+	ASSERT(*spdm_request_size >=
+	       sizeof(spdm_negotiate_algorithms_request_mine_t));
+	if (*spdm_request_size <
+	    sizeof(spdm_negotiate_algorithms_request_mine_t)) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+
+	algorithms_request = spdm_request;
+	zero_mem(algorithms_request,
+		 sizeof(spdm_negotiate_algorithms_request_mine_t));
 	if (spdm_is_version_supported(spdm_context, SPDM_MESSAGE_VERSION_11)) {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_11;
-		spdm_request.length = sizeof(spdm_request);
-		spdm_request.header.param1 =
+		algorithms_request->header.spdm_version =
+			SPDM_MESSAGE_VERSION_11;
+		algorithms_request->length =
+			sizeof(spdm_negotiate_algorithms_request_mine_t);
+		algorithms_request->header.param1 =
 			4; // Number of Algorithms Structure Tables
 	} else {
-		spdm_request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
-		spdm_request.length = sizeof(spdm_request) -
-				      sizeof(spdm_request.struct_table);
-		spdm_request.header.param1 = 0;
+		algorithms_request->header.spdm_version =
+			SPDM_MESSAGE_VERSION_10;
+		algorithms_request->length =
+			sizeof(spdm_negotiate_algorithms_request_mine_t) -
+			sizeof(algorithms_request->struct_table);
+		algorithms_request->header.param1 = 0;
 	}
-	spdm_request.header.request_response_code = SPDM_NEGOTIATE_ALGORITHMS;
-	spdm_request.header.param2 = 0;
-	spdm_request.measurement_specification =
+	algorithms_request->header.request_response_code =
+		SPDM_NEGOTIATE_ALGORITHMS;
+	algorithms_request->header.param2 = 0;
+	algorithms_request->measurement_specification =
 		spdm_context->local_context.algorithm.measurement_spec;
-	spdm_request.base_asym_algo =
+	algorithms_request->base_asym_algo =
 		spdm_context->local_context.algorithm.base_asym_algo;
-	spdm_request.base_hash_algo =
+	algorithms_request->base_hash_algo =
 		spdm_context->local_context.algorithm.base_hash_algo;
-	spdm_request.ext_asym_count = 0;
-	spdm_request.ext_hash_count = 0;
-	spdm_request.struct_table[0].alg_type =
+	algorithms_request->ext_asym_count = 0;
+	algorithms_request->ext_hash_count = 0;
+	algorithms_request->struct_table[0].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_DHE;
-	spdm_request.struct_table[0].alg_count = 0x20;
-	spdm_request.struct_table[0].alg_supported =
+	algorithms_request->struct_table[0].alg_count = 0x20;
+	algorithms_request->struct_table[0].alg_supported =
 		spdm_context->local_context.algorithm.dhe_named_group;
-	spdm_request.struct_table[1].alg_type =
+	algorithms_request->struct_table[1].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_AEAD;
-	spdm_request.struct_table[1].alg_count = 0x20;
-	spdm_request.struct_table[1].alg_supported =
+	algorithms_request->struct_table[1].alg_count = 0x20;
+	algorithms_request->struct_table[1].alg_supported =
 		spdm_context->local_context.algorithm.aead_cipher_suite;
-	spdm_request.struct_table[2].alg_type =
+	algorithms_request->struct_table[2].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_REQ_BASE_ASYM_ALG;
-	spdm_request.struct_table[2].alg_count = 0x20;
-	spdm_request.struct_table[2].alg_supported =
+	algorithms_request->struct_table[2].alg_count = 0x20;
+	algorithms_request->struct_table[2].alg_supported =
 		spdm_context->local_context.algorithm.req_base_asym_alg;
-	spdm_request.struct_table[3].alg_type =
+	algorithms_request->struct_table[3].alg_type =
 		SPDM_NEGOTIATE_ALGORITHMS_STRUCT_TABLE_ALG_TYPE_KEY_SCHEDULE;
-	spdm_request.struct_table[3].alg_count = 0x20;
-	spdm_request.struct_table[3].alg_supported =
+	algorithms_request->struct_table[3].alg_count = 0x20;
+	algorithms_request->struct_table[3].alg_supported =
 		spdm_context->local_context.algorithm.key_schedule;
+	*spdm_request_size = algorithms_request->length;
 
-	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request.length,
-					&spdm_request);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	return RETURN_SUCCESS;
+}
 
-	spdm_response_size = sizeof(spdm_response);
+/**
+  This function processes ALGORITHMS response to NEGOTIATE_ALGORITHMS request.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request_size              size in bytes of the NEGOTIATE_ALGORITHMS request.
+  @param  spdm_request                  A pointer to the NEGOTIATE_ALGORITHMS request.
+  @param  spdm_response_size             size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The ALGORITHMS is processed.
+  @retval RETURN_DEVICE_ERROR          The response is invalid.
+  @retval RETURN_SECURITY_VIOLATION    The negotiated algorithms are not supported.
+**/
+return_status spdm_process_algorithms_response(
+	IN spdm_context_t *spdm_context, IN uintn spdm_request_size,
+	IN void *spdm_request, IN uintn spdm_response_size, IN void *response)
+{
+	return_status status;
+	spdm_negotiate_algorithms_request_mine_t *algorithms_request;
+	spdm_algorithms_response_max_t spdm_response;
+	uint32 algo_size;
+	uintn index;
+	spdm_negotiate_algorithms_common_struct_table_t *struct_table;
+	uint8 fixed_alg_size;
+	uint8 ext_alg_count;
+
+	algorithms_request = spdm_request;
 	zero_mem(&spdm_response, sizeof(spdm_response));
-	status = spdm_receive_spdm_response(
-		spdm_context, NULL, &spdm_response_size, &spdm_response);
-	if (RETURN_ERROR(status)) {
-		return RETURN_DEVICE_ERROR;
-	}
+	copy_mem(&spdm_response, response,
+		 MIN(spdm_response_size, sizeof(spdm_response)));
 	if (spdm_response_size < sizeof(spdm_message_header_t)) {
 		return RETURN_DEVICE_ERROR;
 	}
@@ -148,7 +182,7 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 	if (spdm_response_size > sizeof(spdm_response)) {
 		return RETURN_DEVICE_ERROR;
 	}
-	if (spdm_response.header.spdm_version != spdm_request.header.spdm_version){
+	if (spdm_response.header.spdm_version != algorithms_request->header.spdm_version){
 		return RETURN_DEVICE_ERROR;
 	}
 	if (spdm_response.ext_asym_sel_count > 1) {
@@ -209,8 +243,8 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 	//
 	// Cache data
 	//
-	status = libspdm_append_message_a(spdm_context, &spdm_request,
-				       spdm_request.length);
+	status = libspdm_append_message_a(spdm_context, spdm_request,
+				       spdm_request_size);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
@@ -378,6 +412,50 @@ return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 	return RETURN_SUCCESS;
 }
 
+/**
+  This function sends NEGOTIATE_ALGORITHMS and receives ALGORITHMS.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The NEGOTIATE_ALGORITHMS is sent and the ALGORITHMS is received.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+**/
+return_status try_spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
+{
+	return_status status;
+	spdm_negotiate_algorithms_request_mine_t spdm_request;
+	uintn spdm_request_size;
+	spdm_algorithms_response_max_t spdm_response;
+	uintn spdm_response_size;
+
+	spdm_request_size = sizeof(spdm_request);
+	status = spdm_build_negotiate_algorithms_request(
+		spdm_context, &spdm_request_size, &spdm_request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = spdm_send_spdm_request(spdm_context, NULL, spdm_request_size,
+					&spdm_request);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_response_size = sizeof(spdm_response);
+	zero_mem(&spdm_response, sizeof(spdm_response));
+	status = spdm_receive_spdm_response(
+		spdm_context, NULL, &spdm_response_size, &spdm_response);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+
+	return spdm_process_algorithms_response(spdm_context,
+						spdm_request_size,
+						&spdm_request,
+						spdm_response_size,
+						&spdm_response);
+}
+
 /**
   This function sends NEGOTIATE_ALGORITHMS and receives ALGORITHMS.
 
@@ -397,6 +475,7 @@ return_status spdm_negotiate_algorithms(IN spdm_context_t *spdm_context)
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -0,0 +1,322 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "internal/libspdm_requester_lib.h"
+
+/**
+  Return the size in bytes of an SPDM attestation orchestrator.
+
+  @return the size in bytes of an SPDM attestation orchestrator.
+**/
+uintn libspdm_orchestrator_get_size(void)
+{
+	return sizeof(spdm_orchestrator_t);
+}
+
+/**
+  Initialize an SPDM attestation orchestrator to run a policy on a list of devices.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+  @param  policy                        The flows to run on each device.
+  @param  device                        The devices to attest. The results are stored in this array.
+  @param  device_count                  The number of entries in device.
+**/
+void libspdm_orchestrator_init(IN void *orchestrator,
+			       IN const spdm_orchestrator_policy_t *policy,
+			       IN OUT spdm_orchestrator_device_t *device,
+			       IN uintn device_count)
+{
+	spdm_orchestrator_t *spdm_orchestrator;
+	uintn index;
+
+	spdm_orchestrator = orchestrator;
+	zero_mem(spdm_orchestrator, sizeof(spdm_orchestrator_t));
+	copy_mem(&spdm_orchestrator->policy, policy,
+		 sizeof(spdm_orchestrator_policy_t));
+	spdm_orchestrator->device = device;
+	spdm_orchestrator->device_count = device_count;
+	libspdm_init_cert_chain_verify_cache(
+		&spdm_orchestrator->cert_chain_verify_cache, NULL, NULL, NULL);
+
+	for (index = 0; index < device_count; index++) {
+		zero_mem(&device[index].result,
+			 sizeof(spdm_orchestrator_result_t));
+		device[index].result.status = RETURN_NOT_STARTED;
+		libspdm_register_cert_chain_verify_cache(
+			device[index].spdm_context,
+			&spdm_orchestrator->cert_chain_verify_cache);
+	}
+}
+
+/**
+  Register the lock functions of an SPDM attestation orchestrator.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+  @param  acquire_lock                  The fuction to acquire the lock.
+  @param  release_lock                  The fuction to release the lock.
+  @param  lock                          A pointer to the lock passed to the lock functions.
+**/
+void libspdm_orchestrator_register_lock_func(IN void *orchestrator,
+					     IN libspdm_lock_func acquire_lock,
+					     IN libspdm_lock_func release_lock,
+					     IN void *lock)
+{
+	spdm_orchestrator_t *spdm_orchestrator;
+
+	spdm_orchestrator = orchestrator;
+	spdm_orchestrator->acquire_lock = acquire_lock;
+	spdm_orchestrator->release_lock = release_lock;
+	spdm_orchestrator->lock = lock;
+	spdm_orchestrator->cert_chain_verify_cache.acquire_lock = acquire_lock;
+	spdm_orchestrator->cert_chain_verify_cache.release_lock = release_lock;
+	spdm_orchestrator->cert_chain_verify_cache.lock = lock;
+}
+
+/**
+  Register the time function of an SPDM attestation orchestrator, to measure the latency.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+  @param  get_time                      The fuction to get the current time.
+**/
+void libspdm_orchestrator_register_get_time_func(IN void *orchestrator,
+						 IN libspdm_get_time_func get_time)
+{
+	spdm_orchestrator_t *spdm_orchestrator;
+
+	spdm_orchestrator = orchestrator;
+	spdm_orchestrator->get_time = get_time;
+}
+
+/**
+  Acquire the lock of an SPDM attestation orchestrator, if it is registered.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+**/
+static void spdm_orchestrator_acquire_lock(IN spdm_orchestrator_t *orchestrator)
+{
+	if (orchestrator->acquire_lock != NULL) {
+		orchestrator->acquire_lock(orchestrator->lock);
+	}
+}
+
+/**
+  Release the lock of an SPDM attestation orchestrator, if it is registered.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+**/
+static void spdm_orchestrator_release_lock(IN spdm_orchestrator_t *orchestrator)
+{
+	if (orchestrator->release_lock != NULL) {
+		orchestrator->release_lock(orchestrator->lock);
+	}
+}
+
+/**
+  Return the current time of an SPDM attestation orchestrator.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+
+  @return the current time, or 0 if the time function is not registered.
+**/
+static uint64 spdm_orchestrator_get_time(IN spdm_orchestrator_t *orchestrator)
+{
+	if (orchestrator->get_time == NULL) {
+		return 0;
+	}
+	return orchestrator->get_time();
+}
+
+/**
+  Run the policy of an SPDM attestation orchestrator on one device.
+
+  The result of each flow is stored in the device result, except the status.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+  @param  device                        A pointer to the device.
+
+  @return the status of the first flow which fails, or RETURN_SUCCESS.
+**/
+static return_status
+spdm_orchestrator_attest_device(IN spdm_orchestrator_t *orchestrator,
+				IN OUT spdm_orchestrator_device_t *device)
+{
+	spdm_orchestrator_policy_t *policy;
+	spdm_orchestrator_result_t *result;
+	return_status status;
+
+	policy = &orchestrator->policy;
+	result = &device->result;
+
+	result->failed_flow = SPDM_ORCHESTRATOR_FLOW_INIT_CONNECTION;
+	status = libspdm_init_connection(device->spdm_context, FALSE);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	if ((policy->flows & SPDM_ORCHESTRATOR_FLOW_GET_DIGEST) != 0) {
+		result->failed_flow = SPDM_ORCHESTRATOR_FLOW_GET_DIGEST;
+#if SPDM_ENABLE_CAPABILITY_CERT_CAP
+		status = libspdm_get_digest(device->spdm_context, NULL, NULL);
+#else
+		status = RETURN_UNSUPPORTED;
+#endif
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	}
+
+	if ((policy->flows & SPDM_ORCHESTRATOR_FLOW_GET_CERTIFICATE) != 0) {
+		result->failed_flow = SPDM_ORCHESTRATOR_FLOW_GET_CERTIFICATE;
+#if SPDM_ENABLE_CAPABILITY_CERT_CAP
+		status = libspdm_get_certificate(device->spdm_context,
+						 policy->slot_id, NULL, NULL);
+#else
+		status = RETURN_UNSUPPORTED;
+#endif
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	}
+
+	if ((policy->flows & SPDM_ORCHESTRATOR_FLOW_CHALLENGE) != 0) {
+		result->failed_flow = SPDM_ORCHESTRATOR_FLOW_CHALLENGE;
+#if SPDM_ENABLE_CAPABILITY_CHAL_CAP
+		status = libspdm_challenge(device->spdm_context,
+					   policy->slot_id,
+					   policy->measurement_hash_type,
+					   result->measurement_hash,
+					   &result->slot_mask);
+#else
+		status = RETURN_UNSUPPORTED;
+#endif
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	}
+
+	if ((policy->flows & SPDM_ORCHESTRATOR_FLOW_GET_MEASUREMENT) != 0) {
+		result->failed_flow = SPDM_ORCHESTRATOR_FLOW_GET_MEASUREMENT;
+#if SPDM_ENABLE_CAPABILITY_MEAS_CAP
+		result->measurement_record_length =
+			sizeof(result->measurement_record);
+		status = libspdm_get_measurement(
+			device->spdm_context, NULL, policy->request_attribute,
+			policy->measurement_operation, policy->slot_id,
+			&result->number_of_blocks,
+			&result->measurement_record_length,
+			result->measurement_record);
+#else
+		status = RETURN_UNSUPPORTED;
+#endif
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	}
+
+	result->failed_flow = 0;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Run a worker of an SPDM attestation orchestrator.
+
+  The worker takes the next device not yet started, runs the policy on it, records the result,
+  and repeats until every device is started. The lock is not held while communicating with a device.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+
+  @retval RETURN_SUCCESS               No device is left. The status of each device is in its result.
+**/
+return_status libspdm_orchestrator_run_worker(IN void *orchestrator)
+{
+	spdm_orchestrator_t *spdm_orchestrator;
+	spdm_orchestrator_device_t *device;
+	return_status status;
+	uint64 start_time;
+	uint64 end_time;
+
+	spdm_orchestrator = orchestrator;
+
+	while (TRUE) {
+		spdm_orchestrator_acquire_lock(spdm_orchestrator);
+		if (spdm_orchestrator->device_next >=
+		    spdm_orchestrator->device_count) {
+			spdm_orchestrator_release_lock(spdm_orchestrator);
+			break;
+		}
+		device = &spdm_orchestrator->device[spdm_orchestrator->device_next];
+		start_time = spdm_orchestrator_get_time(spdm_orchestrator);
+		if (spdm_orchestrator->device_next == 0) {
+			spdm_orchestrator->start_time = start_time;
+		}
+		spdm_orchestrator->device_next++;
+		spdm_orchestrator_release_lock(spdm_orchestrator);
+
+		status = spdm_orchestrator_attest_device(spdm_orchestrator,
+							 device);
+		end_time = spdm_orchestrator_get_time(spdm_orchestrator);
+		DEBUG((DEBUG_INFO, "SpdmOrchestrator - device %d status 0x%x\n",
+		       (uint32)(device - spdm_orchestrator->device),
+		       (uint32)status));
+
+		spdm_orchestrator_acquire_lock(spdm_orchestrator);
+		device->result.start_time = start_time;
+		device->result.latency = end_time - start_time;
+		device->result.status = status;
+		if (end_time > spdm_orchestrator->end_time) {
+			spdm_orchestrator->end_time = end_time;
+		}
+		spdm_orchestrator->device_finished++;
+		spdm_orchestrator_release_lock(spdm_orchestrator);
+	}
+
+	return RETURN_SUCCESS;
+}
+
+/**
+  Get the aggregate statistics of an SPDM attestation orchestrator.
+
+  @param  orchestrator                  A pointer to the SPDM attestation orchestrator.
+  @param  statistics                    The statistics of the finished devices.
+**/
+void libspdm_orchestrator_get_statistics(
+	IN void *orchestrator, OUT spdm_orchestrator_statistics_t *statistics)
+{
+	spdm_orchestrator_t *spdm_orchestrator;
+	spdm_orchestrator_result_t *result;
+	uintn index;
+
+	spdm_orchestrator = orchestrator;
+	zero_mem(statistics, sizeof(spdm_orchestrator_statistics_t));
+	statistics->device_count = spdm_orchestrator->device_count;
+
+	spdm_orchestrator_acquire_lock(spdm_orchestrator);
+	for (index = 0; index < spdm_orchestrator->device_count; index++) {
+		result = &spdm_orchestrator->device[index].result;
+		if (result->status == RETURN_NOT_STARTED) {
+			continue;
+		}
+		if (RETURN_ERROR(result->status)) {
+			statistics->failure_count++;
+		} else {
+			statistics->success_count++;
+		}
+		if ((statistics->finished_count == 0) ||
+		    (result->latency < statistics->min_latency)) {
+			statistics->min_latency = result->latency;
+		}
+		if (result->latency > statistics->max_latency) {
+			statistics->max_latency = result->latency;
+		}
+		statistics->total_latency += result->latency;
+		statistics->finished_count++;
+	}
+	if (statistics->finished_count != 0) {
+		statistics->elapsed_time = spdm_orchestrator->end_time -
+					   spdm_orchestrator->start_time;
+	}
+	spdm_orchestrator_release_lock(spdm_orchestrator);
+}
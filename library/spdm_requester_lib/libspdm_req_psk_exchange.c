@@ -236,6 +236,7 @@ return_status try_spdm_send_receive_psk_exchange(
 	if (session_info == NULL) {
 		return RETURN_DEVICE_ERROR;
 	}
+	spdm_trace_set_message(spdm_context, *session_id, SPDM_PSK_EXCHANGE);
 
 	measurement_summary_hash_size = spdm_get_measurement_summary_hash_size(
 		spdm_context, TRUE, measurement_hash_type);
@@ -313,8 +314,10 @@ return_status try_spdm_send_receive_psk_exchange(
 		libspdm_free_session_id(spdm_context, *session_id);
 		return RETURN_SECURITY_VIOLATION;
 	}
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	status = spdm_generate_session_handshake_key(
 		session_info->secured_message_context, th1_hash_data);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	if (RETURN_ERROR(status)) {
 		libspdm_free_session_id(spdm_context, *session_id);
 		return RETURN_SECURITY_VIOLATION;
@@ -360,8 +363,10 @@ return_status try_spdm_send_receive_psk_exchange(
 		if (RETURN_ERROR(status)) {
 			return RETURN_SECURITY_VIOLATION;
 		}
+		spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 		status = spdm_generate_session_data_key(
 			session_info->secured_message_context, th2_hash_data);
+		spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 		if (RETURN_ERROR(status)) {
 			return RETURN_SECURITY_VIOLATION;
 		}
@@ -404,6 +409,7 @@ return_status spdm_send_receive_psk_exchange(IN spdm_context_t *spdm_context,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -458,6 +464,7 @@ return_status spdm_send_receive_psk_exchange_ex(IN spdm_context_t *spdm_context,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
@@ -144,8 +144,10 @@ return_status try_spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	status = spdm_generate_session_data_key(
 		session_info->secured_message_context, th2_hash_data);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	if (RETURN_ERROR(status)) {
 		return RETURN_SECURITY_VIOLATION;
 	}
@@ -171,6 +173,7 @@ return_status spdm_send_receive_psk_finish(IN spdm_context_t *spdm_context,
 		if (RETURN_NO_RESPONSE != status) {
 			return status;
 		}
+		spdm_requester_busy_backoff(spdm_context, retry);
 	} while (retry-- != 0);
 
 	return status;
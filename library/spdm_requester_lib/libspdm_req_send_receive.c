@@ -20,6 +20,7 @@
                                        either implicit or explicit ownership of the buffer.
 
   @retval RETURN_SUCCESS               The SPDM request is sent successfully.
+  @retval RETURN_OUT_OF_RESOURCES      No sender buffer can be acquired.
   @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM request is sent to the device.
 **/
 return_status libspdm_send_request(IN void *context, IN uint32 *session_id,
@@ -28,8 +29,9 @@ return_status libspdm_send_request(IN void *context, IN uint32 *session_id,
 {
 	spdm_context_t *spdm_context;
 	return_status status;
-	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *message;
 	uintn message_size;
+	uint64 start_time;
 
 	spdm_context = context;
 
@@ -37,23 +39,52 @@ return_status libspdm_send_request(IN void *context, IN uint32 *session_id,
 	       (session_id != NULL) ? *session_id : 0x0, request_size));
 	internal_dump_hex(request, request_size);
 
-	message_size = sizeof(message);
+	//
+	// A buffer failure is not a device IO status, such as RETURN_NOT_READY.
+	//
+	status = libspdm_acquire_sender_buffer(spdm_context, &message_size,
+					       (void **)&message);
+	if (RETURN_ERROR(status)) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+
+	spdm_trace_set_message(
+		spdm_context,
+		(session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+		is_app_message ?
+			0 :
+			((spdm_message_header_t *)request)->request_response_code);
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_TRANSPORT_ENCODE);
 	status = spdm_context->transport_encode_message(
 		spdm_context, session_id, is_app_message, TRUE, request_size,
 		request, &message_size, message);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_TRANSPORT_ENCODE);
+	if (session_id != NULL) {
+		spdm_statistics_record_crypto(spdm_context,
+					      SPDM_STATISTICS_CRYPTO_AEAD,
+					      start_time);
+	}
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO, "transport_encode_message status - %p\n",
 		       status));
-		return status;
+		goto done;
 	}
 
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_SEND);
 	status = spdm_context->send_message(spdm_context, message_size, message,
 					    0);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_SEND);
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO, "spdm_send_spdm_request[%x] status - %p\n",
 		       (session_id != NULL) ? *session_id : 0x0, status));
+	} else {
+		SPDM_STATISTICS_ADD(spdm_context, messages_sent, 1);
+		SPDM_STATISTICS_ADD(spdm_context, bytes_sent, message_size);
 	}
 
+done:
+	libspdm_release_sender_buffer(spdm_context, message);
 	return status;
 }
 
@@ -71,6 +102,7 @@ return_status libspdm_send_request(IN void *context, IN uint32 *session_id,
                                        either implicit or explicit ownership of the buffer.
 
   @retval RETURN_SUCCESS               The SPDM response is received successfully.
+  @retval RETURN_OUT_OF_RESOURCES      No receiver buffer can be acquired.
   @retval RETURN_DEVICE_ERROR          A device error occurs when the SPDM response is received from the device.
 **/
 return_status libspdm_receive_response(IN void *context, IN uint32 *session_id,
@@ -80,44 +112,66 @@ return_status libspdm_receive_response(IN void *context, IN uint32 *session_id,
 {
 	spdm_context_t *spdm_context;
 	return_status status;
-	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *message;
 	uintn message_size;
 	uint32 *message_session_id;
 	boolean is_message_app_message;
+	uint64 start_time;
 
 	spdm_context = context;
 
-	ASSERT(*response_size <= MAX_SPDM_MESSAGE_BUFFER_SIZE);
+	status = libspdm_acquire_receiver_buffer(spdm_context, &message_size,
+						 (void **)&message);
+	if (RETURN_ERROR(status)) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
 
-	message_size = sizeof(message);
 	status = spdm_context->receive_message(spdm_context, &message_size,
 					       message, 0);
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO,
 		       "spdm_receive_spdm_response[%x] status - %p\n",
 		       (session_id != NULL) ? *session_id : 0x0, status));
-		return status;
+		goto done;
 	}
+	SPDM_STATISTICS_ADD(spdm_context, messages_received, 1);
+	SPDM_STATISTICS_ADD(spdm_context, bytes_received, message_size);
 
 	message_session_id = NULL;
 	is_message_app_message = FALSE;
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_TRANSPORT_DECODE);
 	status = spdm_context->transport_decode_message(
 		spdm_context, &message_session_id, &is_message_app_message,
 		FALSE, message_size, message, response_size, response);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_TRANSPORT_DECODE);
+	if (message_session_id != NULL) {
+		spdm_statistics_record_crypto(spdm_context,
+					      SPDM_STATISTICS_CRYPTO_AEAD,
+					      start_time);
+		if (RETURN_ERROR(status) &&
+		    (spdm_context->last_spdm_error.error_code ==
+		     SPDM_ERROR_CODE_DECRYPT_ERROR)) {
+			SPDM_STATISTICS_ADD(spdm_context, decrypt_failure_count,
+					    1);
+		}
+	}
 
 	if (session_id != NULL) {
 		if (message_session_id == NULL) {
 			DEBUG((DEBUG_INFO,
 			       "spdm_receive_spdm_response[%x] GetSessionId - NULL\n",
 			       (session_id != NULL) ? *session_id : 0x0));
-			return RETURN_DEVICE_ERROR;
+			status = RETURN_DEVICE_ERROR;
+			goto done;
 		}
 		if (*message_session_id != *session_id) {
 			DEBUG((DEBUG_INFO,
 			       "spdm_receive_spdm_response[%x] GetSessionId - %x\n",
 			       (session_id != NULL) ? *session_id : 0x0,
 			       *message_session_id));
-			return RETURN_DEVICE_ERROR;
+			status = RETURN_DEVICE_ERROR;
+			goto done;
 		}
 	} else {
 		if (message_session_id != NULL) {
@@ -125,7 +179,8 @@ return_status libspdm_receive_response(IN void *context, IN uint32 *session_id,
 			       "spdm_receive_spdm_response[%x] GetSessionId - %x\n",
 			       (session_id != NULL) ? *session_id : 0x0,
 			       *message_session_id));
-			return RETURN_DEVICE_ERROR;
+			status = RETURN_DEVICE_ERROR;
+			goto done;
 		}
 	}
 
@@ -134,7 +189,8 @@ return_status libspdm_receive_response(IN void *context, IN uint32 *session_id,
 		DEBUG((DEBUG_INFO,
 		       "spdm_receive_spdm_response[%x] app_message mismatch\n",
 		       (session_id != NULL) ? *session_id : 0x0));
-		return RETURN_DEVICE_ERROR;
+		status = RETURN_DEVICE_ERROR;
+		goto done;
 	}
 
 	DEBUG((DEBUG_INFO, "spdm_receive_spdm_response[%x] (0x%x): \n",
@@ -146,6 +202,9 @@ return_status libspdm_receive_response(IN void *context, IN uint32 *session_id,
 	} else {
 		internal_dump_hex(response, *response_size);
 	}
+
+done:
+	libspdm_release_receiver_buffer(spdm_context, message);
 	return status;
 }
 
@@ -190,6 +249,9 @@ return_status spdm_send_spdm_request(IN spdm_context_t *spdm_context,
 		}
 	}
 
+	spdm_statistics_start_request(
+		spdm_context,
+		((spdm_message_header_t *)request)->request_response_code);
 	return libspdm_send_request(spdm_context, session_id, FALSE, request_size,
 				 request);
 }
@@ -216,6 +278,7 @@ return_status spdm_receive_spdm_response(IN spdm_context_t *spdm_context,
 {
 	spdm_session_info_t *session_info;
 	spdm_session_state_t session_state;
+	return_status status;
 
 	if ((session_id != NULL) &&
 	    spdm_is_capabilities_flag_supported(
@@ -236,6 +299,10 @@ return_status spdm_receive_spdm_response(IN spdm_context_t *spdm_context,
 		}
 	}
 
-	return libspdm_receive_response(spdm_context, session_id, FALSE,
-				     response_size, response);
+	status = libspdm_receive_response(spdm_context, session_id, FALSE,
+					  response_size, response);
+	if (!RETURN_ERROR(status)) {
+		spdm_statistics_end_request(spdm_context);
+	}
+	return status;
 }
\ No newline at end of file
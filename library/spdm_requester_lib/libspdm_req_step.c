@@ -0,0 +1,276 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "internal/libspdm_requester_lib.h"
+
+/**
+  Prepare the next request of the non-blocking flow.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The SPDM request code.
+**/
+void spdm_step_start_request(IN spdm_context_t *spdm_context,
+			     IN uint8 request_code)
+{
+	spdm_step_context_t *step_context;
+
+	step_context = &spdm_context->step_context;
+	step_context->request_code = request_code;
+	step_context->request_sent = FALSE;
+	step_context->retry = spdm_context->retry_times;
+	step_context->request_size = 0;
+}
+
+/**
+  Return the request following the current request of the non-blocking flow.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @return The SPDM request code, or 0 if the flow is finished.
+**/
+uint8 spdm_step_get_next_request_code(IN spdm_context_t *spdm_context)
+{
+	spdm_step_context_t *step_context;
+
+	step_context = &spdm_context->step_context;
+	switch (step_context->flow) {
+	case SPDM_STEP_FLOW_INIT_CONNECTION:
+		switch (step_context->request_code) {
+		case SPDM_GET_VERSION:
+			if (step_context->get_version_only) {
+				return 0;
+			}
+			return SPDM_GET_CAPABILITIES;
+		case SPDM_GET_CAPABILITIES:
+			return SPDM_NEGOTIATE_ALGORITHMS;
+		default:
+			return 0;
+		}
+	default:
+		return 0;
+	}
+}
+
+/**
+  Build the current request of the non-blocking flow in the SPDM context.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The request is built.
+  @retval others                       The request cannot be built.
+**/
+return_status spdm_step_build_request(IN spdm_context_t *spdm_context)
+{
+	spdm_step_context_t *step_context;
+	return_status status;
+
+	step_context = &spdm_context->step_context;
+	step_context->request_size = sizeof(step_context->request);
+	switch (step_context->request_code) {
+	case SPDM_GET_VERSION:
+		status = spdm_build_get_version_request(
+			spdm_context, &step_context->request_size,
+			step_context->request);
+		break;
+	case SPDM_GET_CAPABILITIES:
+		status = spdm_build_get_capabilities_request(
+			spdm_context, &step_context->request_size,
+			step_context->request);
+		break;
+	case SPDM_NEGOTIATE_ALGORITHMS:
+		status = spdm_build_negotiate_algorithms_request(
+			spdm_context, &step_context->request_size,
+			step_context->request);
+		break;
+	default:
+		ASSERT(FALSE);
+		status = RETURN_UNSUPPORTED;
+		break;
+	}
+	if (RETURN_ERROR(status)) {
+		step_context->request_size = 0;
+	}
+	return status;
+}
+
+/**
+  Process the response to the current request of the non-blocking flow.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  response_size                 size in bytes of the response.
+  @param  response                     A pointer to the response.
+
+  @retval RETURN_SUCCESS               The response is processed.
+  @retval RETURN_NO_RESPONSE           The responder is busy, the request may be sent again.
+  @retval others                       The response is invalid.
+**/
+return_status spdm_step_process_response(IN spdm_context_t *spdm_context,
+					 IN uintn response_size,
+					 IN void *response)
+{
+	spdm_step_context_t *step_context;
+
+	step_context = &spdm_context->step_context;
+	switch (step_context->request_code) {
+	case SPDM_GET_VERSION:
+		return spdm_process_version_response(
+			spdm_context, step_context->request_size,
+			step_context->request, response_size, response);
+	case SPDM_GET_CAPABILITIES:
+		return spdm_process_capabilities_response(
+			spdm_context, step_context->request_size,
+			step_context->request, response_size, response);
+	case SPDM_NEGOTIATE_ALGORITHMS:
+		return spdm_process_algorithms_response(
+			spdm_context, step_context->request_size,
+			step_context->request, response_size, response);
+	default:
+		ASSERT(FALSE);
+		return RETURN_UNSUPPORTED;
+	}
+}
+
+/**
+  This function starts a non-blocking GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHMS flow
+  to initialize the connection with SPDM responder.
+
+  No message is sent by this function. The flow is driven by libspdm_step.
+  The result is the same as libspdm_init_connection.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  get_version_only               If the requester sends GET_VERSION only or not.
+
+  @retval RETURN_SUCCESS               The flow is started.
+  @retval RETURN_ALREADY_STARTED       Another flow is in progress.
+**/
+return_status libspdm_start_init_connection(IN void *context,
+					    IN boolean get_version_only)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = context;
+	if (spdm_context->step_context.flow != SPDM_STEP_FLOW_NONE) {
+		return RETURN_ALREADY_STARTED;
+	}
+
+	spdm_context->step_context.flow = SPDM_STEP_FLOW_INIT_CONNECTION;
+	spdm_context->step_context.get_version_only = get_version_only;
+	spdm_step_start_request(spdm_context, SPDM_GET_VERSION);
+	return RETURN_SUCCESS;
+}
+
+/**
+  This function drives the non-blocking flow started in the SPDM context.
+
+  In a non-blocking flow, the device IO functions must not wait. They return RETURN_NOT_READY
+  if the message cannot be sent, or no message is received. This function then returns
+  RETURN_SUCCESS with SPDM_STEP_STATE_NEEDS_SEND or SPDM_STEP_STATE_NEEDS_RECEIVE,
+  and the caller calls it again once the device is ready, for example after epoll().
+  This function never sleeps. If the responder is busy, it returns RETURN_SUCCESS with
+  SPDM_STEP_STATE_NEEDS_WAIT and the time the caller waits before the next call.
+  All state of the flow is kept in the SPDM context, so one thread can drive many contexts.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  step_state                    The state of the flow after this step.
+  @param  wait_time                     The time to wait before the next call, in microseconds.
+                                       It is 0 unless step_state is SPDM_STEP_STATE_NEEDS_WAIT.
+
+  @retval RETURN_SUCCESS               The flow is in progress, or it is finished successfully.
+  @retval RETURN_NOT_STARTED           No flow is started.
+  @retval RETURN_OUT_OF_RESOURCES      No sender or receiver buffer can be acquired. The flow is finished.
+  @retval others                       The flow is finished with error, as the blocking function.
+**/
+return_status libspdm_step(IN void *context, OUT spdm_step_state_t *step_state,
+			   OUT uint64 *wait_time)
+{
+	spdm_context_t *spdm_context;
+	spdm_step_context_t *step_context;
+	return_status status;
+	uint8 response[MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE];
+	uintn response_size;
+	uint8 next_request_code;
+
+	spdm_context = context;
+	step_context = &spdm_context->step_context;
+
+	*step_state = SPDM_STEP_STATE_DONE;
+	*wait_time = 0;
+	if (step_context->flow == SPDM_STEP_FLOW_NONE) {
+		return RETURN_NOT_STARTED;
+	}
+
+	while (TRUE) {
+		if (step_context->request_size == 0) {
+			status = spdm_step_build_request(spdm_context);
+			if (RETURN_ERROR(status)) {
+				break;
+			}
+		}
+
+		if (!step_context->request_sent) {
+			status = spdm_send_spdm_request(
+				spdm_context, NULL, step_context->request_size,
+				step_context->request);
+			if (status == RETURN_NOT_READY) {
+				*step_state = SPDM_STEP_STATE_NEEDS_SEND;
+				return RETURN_SUCCESS;
+			}
+			if (status == RETURN_OUT_OF_RESOURCES) {
+				break;
+			}
+			if (RETURN_ERROR(status)) {
+				status = RETURN_DEVICE_ERROR;
+				break;
+			}
+			step_context->request_sent = TRUE;
+		}
+
+		response_size = sizeof(response);
+		zero_mem(response, sizeof(response));
+		status = spdm_receive_spdm_response(spdm_context, NULL,
+						    &response_size, response);
+		if (status == RETURN_NOT_READY) {
+			*step_state = SPDM_STEP_STATE_NEEDS_RECEIVE;
+			return RETURN_SUCCESS;
+		}
+		if (status == RETURN_OUT_OF_RESOURCES) {
+			break;
+		}
+		if (RETURN_ERROR(status)) {
+			status = RETURN_DEVICE_ERROR;
+			break;
+		}
+
+		status = spdm_step_process_response(spdm_context, response_size,
+						    response);
+		if ((status == RETURN_NO_RESPONSE) &&
+		    (step_context->retry != 0)) {
+			//
+			// The caller waits, instead of the sleep function of the blocking flow.
+			//
+			SPDM_STATISTICS_ADD(spdm_context, retry_count, 1);
+			*wait_time = spdm_requester_get_busy_backoff_delay(
+				spdm_context, step_context->retry);
+			step_context->retry--;
+			step_context->request_size = 0;
+			step_context->request_sent = FALSE;
+			*step_state = SPDM_STEP_STATE_NEEDS_WAIT;
+			return RETURN_SUCCESS;
+		}
+		if (RETURN_ERROR(status)) {
+			break;
+		}
+
+		next_request_code = spdm_step_get_next_request_code(spdm_context);
+		if (next_request_code == 0) {
+			break;
+		}
+		spdm_step_start_request(spdm_context, next_request_code);
+	}
+
+	step_context->flow = SPDM_STEP_FLOW_NONE;
+	return status;
+}
@@ -75,30 +75,61 @@ return_status libspdm_responder_dispatch_message(IN void *context)
 {
 	return_status status;
 	spdm_context_t *spdm_context;
-	uint8 request[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *request;
 	uintn request_size;
-	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *response;
 	uintn response_size;
 	uint32 *session_id;
+	uint32 my_session_id;
+	boolean is_app_message;
 
 	spdm_context = context;
 
-	request_size = sizeof(request);
+	status = libspdm_acquire_receiver_buffer(spdm_context, &request_size,
+						 (void **)&request);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
 	status = spdm_context->receive_message(spdm_context, &request_size,
 					       request, 0);
+	if (!RETURN_ERROR(status)) {
+		status = libspdm_process_request(spdm_context, &session_id,
+						 &is_app_message, request_size,
+						 request);
+	}
+	//
+	// session_id may point into the received transport message.
+	//
+	if (!RETURN_ERROR(status) && (session_id != NULL)) {
+		my_session_id = *session_id;
+		session_id = &my_session_id;
+	}
+	libspdm_release_receiver_buffer(spdm_context, request);
 	if (RETURN_ERROR(status)) {
 		return status;
 	}
 
-	response_size = sizeof(response);
-	status = libspdm_process_message(spdm_context, &session_id, request,
-				      request_size, response, &response_size);
+	status = libspdm_acquire_sender_buffer(spdm_context, &response_size,
+					       (void **)&response);
 	if (RETURN_ERROR(status)) {
 		return status;
 	}
 
-	status = spdm_context->send_message(spdm_context, response_size,
-					    response, 0);
+	status = libspdm_build_response(spdm_context, session_id, is_app_message,
+					&response_size, response);
+	if (!RETURN_ERROR(status)) {
+		spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_SEND);
+		status = spdm_context->send_message(spdm_context, response_size,
+						    response, 0);
+		spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_SEND);
+		if (!RETURN_ERROR(status)) {
+			SPDM_STATISTICS_ADD(spdm_context, messages_sent, 1);
+			SPDM_STATISTICS_ADD(spdm_context, bytes_sent,
+					    response_size);
+		}
+	}
+	libspdm_release_sender_buffer(spdm_context, response);
 
 	return status;
 }
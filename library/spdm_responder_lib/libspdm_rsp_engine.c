@@ -0,0 +1,247 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "internal/libspdm_responder_lib.h"
+
+/**
+  Return the size in bytes of the SPDM responder engine.
+
+  @return the size in bytes of the SPDM responder engine.
+**/
+uintn libspdm_responder_engine_get_size(void)
+{
+	return sizeof(spdm_responder_engine_t);
+}
+
+/**
+  Initialize an SPDM responder engine.
+
+  A responder engine serves many SPDM contexts from one transport, one context per endpoint.
+  Each context keeps its own connection and session state, and is initialized and configured
+  by the caller as for libspdm_responder_dispatch_message, except for the device IO functions.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  send_message                  The fuction to send an SPDM transport layer message to an endpoint.
+  @param  receive_message               The fuction to receive an SPDM transport layer message from any endpoint.
+**/
+void libspdm_responder_engine_init(
+	IN void *spdm_responder_engine,
+	IN libspdm_responder_engine_send_message_func send_message,
+	IN libspdm_responder_engine_receive_message_func receive_message)
+{
+	spdm_responder_engine_t *engine;
+
+	engine = spdm_responder_engine;
+	zero_mem(engine, sizeof(spdm_responder_engine_t));
+	engine->send_message = send_message;
+	engine->receive_message = receive_message;
+}
+
+/**
+  Return the endpoint entry in an SPDM responder engine.
+
+  @param  engine                        A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint.
+
+  @return A pointer to the endpoint entry, or NULL if the endpoint is not registered.
+**/
+static spdm_responder_engine_endpoint_t *
+spdm_responder_engine_get_endpoint(IN spdm_responder_engine_t *engine,
+				   IN uint32 endpoint_id)
+{
+	uintn index;
+
+	for (index = 0; index < engine->endpoint_count; index++) {
+		if (engine->endpoint[index].endpoint_id == endpoint_id) {
+			return &engine->endpoint[index];
+		}
+	}
+	return NULL;
+}
+
+/**
+  Register the SPDM context serving an endpoint in an SPDM responder engine.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint.
+  @param  spdm_context                  A pointer to the SPDM context.
+
+  @retval RETURN_SUCCESS               The SPDM context is registered.
+  @retval RETURN_ALREADY_STARTED       The endpoint is already registered.
+  @retval RETURN_OUT_OF_RESOURCES      MAX_SPDM_RESPONDER_ENGINE_ENDPOINT_COUNT endpoints are registered.
+**/
+return_status libspdm_responder_engine_register_context(
+	IN void *spdm_responder_engine, IN uint32 endpoint_id,
+	IN void *spdm_context)
+{
+	spdm_responder_engine_t *engine;
+
+	engine = spdm_responder_engine;
+	if (spdm_responder_engine_get_endpoint(engine, endpoint_id) != NULL) {
+		return RETURN_ALREADY_STARTED;
+	}
+	if (engine->endpoint_count >=
+	    MAX_SPDM_RESPONDER_ENGINE_ENDPOINT_COUNT) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	engine->endpoint[engine->endpoint_count].endpoint_id = endpoint_id;
+	engine->endpoint[engine->endpoint_count].spdm_context = spdm_context;
+	engine->endpoint_count++;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Unregister the SPDM context serving an endpoint from an SPDM responder engine.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint.
+
+  @retval RETURN_SUCCESS               The SPDM context is unregistered.
+  @retval RETURN_NOT_FOUND             The endpoint is not registered.
+**/
+return_status libspdm_responder_engine_unregister_context(
+	IN void *spdm_responder_engine, IN uint32 endpoint_id)
+{
+	spdm_responder_engine_t *engine;
+	spdm_responder_engine_endpoint_t *endpoint;
+	spdm_responder_engine_endpoint_t *last_endpoint;
+
+	engine = spdm_responder_engine;
+	endpoint = spdm_responder_engine_get_endpoint(engine, endpoint_id);
+	if (endpoint == NULL) {
+		return RETURN_NOT_FOUND;
+	}
+	last_endpoint = &engine->endpoint[engine->endpoint_count - 1];
+	if (endpoint != last_endpoint) {
+		copy_mem(endpoint, last_endpoint,
+			 sizeof(spdm_responder_engine_endpoint_t));
+	}
+	zero_mem(last_endpoint, sizeof(spdm_responder_engine_endpoint_t));
+	engine->endpoint_count--;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Return the SPDM context serving an endpoint in an SPDM responder engine.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint.
+
+  @return A pointer to the SPDM context, or NULL if the endpoint is not registered.
+**/
+void *libspdm_responder_engine_get_context(IN void *spdm_responder_engine,
+					   IN uint32 endpoint_id)
+{
+	spdm_responder_engine_endpoint_t *endpoint;
+
+	endpoint = spdm_responder_engine_get_endpoint(spdm_responder_engine,
+						      endpoint_id);
+	if (endpoint == NULL) {
+		return NULL;
+	}
+	return endpoint->spdm_context;
+}
+
+/**
+  Process one SPDM transport layer request message from an endpoint and send the response message.
+
+  The response is built in the sender buffer of the SPDM context serving the endpoint.
+  This function may be called concurrently for different endpoints, for example from a worker pool.
+  libspdm does not modify any global state on this path, but the device secret library, the transport
+  send function and any registered callbacks are shared by all endpoints and must be thread safe too.
+  Requests from one endpoint must be processed in order, and contexts must not be registered or
+  unregistered concurrently.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+  @param  endpoint_id                   The transport endpoint the request is received from.
+  @param  request_size                  size in bytes of the request data.
+  @param  request                      A pointer to the request data.
+
+  @retval RETURN_SUCCESS               One SPDM request message is processed.
+  @retval RETURN_NOT_FOUND             The endpoint is not registered.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_UNSUPPORTED           One request message is not supported.
+**/
+return_status libspdm_responder_engine_process_message(
+	IN void *spdm_responder_engine, IN uint32 endpoint_id,
+	IN uintn request_size, IN void *request)
+{
+	return_status status;
+	spdm_responder_engine_t *engine;
+	spdm_context_t *spdm_context;
+	uint8 *response;
+	uintn response_size;
+	uint32 *session_id;
+
+	engine = spdm_responder_engine;
+	spdm_context = libspdm_responder_engine_get_context(engine, endpoint_id);
+	if (spdm_context == NULL) {
+		DEBUG((DEBUG_INFO, "SpdmResponderEngine - unknown endpoint 0x%x\n",
+		       endpoint_id));
+		return RETURN_NOT_FOUND;
+	}
+
+	status = libspdm_acquire_sender_buffer(spdm_context, &response_size,
+					       (void **)&response);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	status = libspdm_process_message(spdm_context, &session_id, request,
+					 request_size, response,
+					 &response_size);
+	if (!RETURN_ERROR(status)) {
+		spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_SEND);
+		status = engine->send_message(engine, endpoint_id,
+					      response_size, response, 0);
+		spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_SEND);
+		if (!RETURN_ERROR(status)) {
+			SPDM_STATISTICS_ADD(spdm_context, messages_sent, 1);
+			SPDM_STATISTICS_ADD(spdm_context, bytes_sent,
+					    response_size);
+		}
+	}
+	libspdm_release_sender_buffer(spdm_context, response);
+
+	return status;
+}
+
+/**
+  This is the main dispatch function in SPDM responder engine.
+
+  It receives one request message from any endpoint, processes it with the SPDM context
+  serving the endpoint and sends the response message back to the endpoint.
+
+  It should be called in an event loop when the transport has a pending message.
+
+  @param  spdm_responder_engine          A pointer to the SPDM responder engine.
+
+  @retval RETURN_SUCCESS               One SPDM request message is processed.
+  @retval RETURN_NOT_READY             No message is pending.
+  @retval RETURN_NOT_FOUND             The message is received from an unregistered endpoint.
+  @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+  @retval RETURN_UNSUPPORTED           One request message is not supported.
+**/
+return_status
+libspdm_responder_engine_dispatch_message(IN void *spdm_responder_engine)
+{
+	return_status status;
+	spdm_responder_engine_t *engine;
+	uint32 endpoint_id;
+	uintn request_size;
+
+	engine = spdm_responder_engine;
+
+	request_size = sizeof(engine->receiver_buffer);
+	status = engine->receive_message(engine, &endpoint_id, &request_size,
+					 engine->receiver_buffer, 0);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	return libspdm_responder_engine_process_message(
+		engine, endpoint_id, request_size, engine->receiver_buffer);
+}
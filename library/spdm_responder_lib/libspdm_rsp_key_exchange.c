@@ -43,6 +43,7 @@ return_status spdm_get_response_key_exchange(IN void *context,
 	uint8 slot_id;
 	uint32 session_id;
 	void *dhe_context;
+	uint64 start_time;
 	spdm_session_info_t *session_info;
 	uintn total_size;
 	spdm_context_t *spdm_context;
@@ -203,6 +204,8 @@ return_status spdm_get_response_key_exchange(IN void *context,
 			response_size, response);
 		return RETURN_SUCCESS;
 	}
+	spdm_trace_set_message(spdm_context, session_id,
+			       spdm_request->header.request_response_code);
 
 	spdm_response->rsp_session_id = rsp_session_id;
 
@@ -233,11 +236,16 @@ return_status spdm_get_response_key_exchange(IN void *context,
 			       spdm_response->random_data);
 
 	ptr = (void *)(spdm_response + 1);
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_DHE);
 	dhe_context = spdm_secured_message_dhe_new(
 		spdm_context->connection_info.algorithm.dhe_named_group);
 	spdm_secured_message_dhe_generate_key(
 		spdm_context->connection_info.algorithm.dhe_named_group,
 		dhe_context, ptr, &dhe_key_size);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_DHE);
+	spdm_statistics_record_crypto(spdm_context, SPDM_STATISTICS_CRYPTO_DHE,
+				      start_time);
 	DEBUG((DEBUG_INFO, "Calc SelfKey (0x%x):\n", dhe_key_size));
 	internal_dump_hex(ptr, dhe_key_size);
 
@@ -246,6 +254,8 @@ return_status spdm_get_response_key_exchange(IN void *context,
 				  sizeof(spdm_key_exchange_request_t),
 			  dhe_key_size);
 
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_DHE);
 	result = spdm_secured_message_dhe_compute_key(
 		spdm_context->connection_info.algorithm.dhe_named_group,
 		dhe_context,
@@ -254,6 +264,9 @@ return_status spdm_get_response_key_exchange(IN void *context,
 	spdm_secured_message_dhe_free(
 		spdm_context->connection_info.algorithm.dhe_named_group,
 		dhe_context);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_DHE);
+	spdm_statistics_record_crypto(spdm_context, SPDM_STATISTICS_CRYPTO_DHE,
+				      start_time);
 	if (!result) {
 		libspdm_free_session_id(spdm_context, session_id);
 		libspdm_generate_error_response(spdm_context,
@@ -336,8 +349,10 @@ return_status spdm_get_response_key_exchange(IN void *context,
 					     response_size, response);
 		return RETURN_SUCCESS;
 	}
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	status = spdm_generate_session_handshake_key(
 		session_info->secured_message_context, th1_hash_data);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	if (RETURN_ERROR(status)) {
 		libspdm_free_session_id(spdm_context, session_id);
 		libspdm_generate_error_response(spdm_context,
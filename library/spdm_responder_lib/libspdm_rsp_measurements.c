@@ -96,6 +96,213 @@ void spdm_create_measurement_opaque(IN spdm_context_t *spdm_context,
 	return;
 }
 
+#if LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT
+/**
+  This function checks if a cached unsigned MEASUREMENTS response was built for the request,
+  with the current measurement generation and the negotiated version and algorithms.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  cache                         A pointer to the cached response.
+  @param  spdm_request                  A pointer to the GET_MEASUREMENTS request.
+  @param  generation                    The current device measurement generation.
+
+  The opaque data is compared by content, because the integrator may update
+  the opaque data buffer in place.
+
+  @retval TRUE  the cached response matches.
+  @retval FALSE the cached response does not match.
+**/
+static boolean spdm_is_measurement_response_cache_match(
+	IN spdm_context_t *spdm_context,
+	IN spdm_measurement_response_cache_t *cache,
+	IN spdm_get_measurements_request_t *spdm_request, IN uint32 generation)
+{
+	spdm_measurements_response_t *spdm_response;
+	uint8 *opaque_data;
+
+	if (!cache->valid || (cache->generation != generation) ||
+	    (const_compare_mem(&cache->spdm_version,
+			       &spdm_context->connection_info.version,
+			       sizeof(spdm_version_number_t)) != 0) ||
+	    (cache->measurement_spec !=
+	     spdm_context->connection_info.algorithm.measurement_spec) ||
+	    (cache->measurement_hash_algo !=
+	     spdm_context->connection_info.algorithm.measurement_hash_algo) ||
+	    (cache->request_attribute != spdm_request->header.param1) ||
+	    (cache->measurement_operation != spdm_request->header.param2) ||
+	    (cache->opaque_measurement_rsp_size !=
+	     spdm_context->local_context.opaque_measurement_rsp_size)) {
+		return FALSE;
+	}
+	if (cache->opaque_measurement_rsp_size == 0) {
+		return TRUE;
+	}
+
+	spdm_response = (void *)cache->response;
+	opaque_data = (uint8 *)(spdm_response + 1) +
+		      libspdm_read_uint24(
+			      spdm_response->measurement_record_length) +
+		      SPDM_NONCE_SIZE + sizeof(uint16);
+	return const_compare_mem(
+		       opaque_data,
+		       spdm_context->local_context.opaque_measurement_rsp,
+		       cache->opaque_measurement_rsp_size) == 0;
+}
+
+/**
+  This function returns a cached unsigned MEASUREMENTS response for the request, with a fresh nonce.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request                  A pointer to the GET_MEASUREMENTS request.
+  @param  response_size                 On input, it means the size in bytes of response data buffer.
+                                       On output, it means the size in bytes of the cached response.
+  @param  response                     A pointer to the response data.
+
+  @retval TRUE  the cached response is returned.
+  @retval FALSE no cached response matches the request.
+**/
+static boolean spdm_get_cached_measurement_response(
+	IN spdm_context_t *spdm_context,
+	IN spdm_get_measurements_request_t *spdm_request,
+	IN OUT uintn *response_size, OUT void *response)
+{
+	spdm_measurement_response_cache_t *cache;
+	spdm_measurements_response_t *spdm_response;
+	uint32 generation;
+	uintn index;
+
+	generation = spdm_measurement_generation();
+	if (generation == 0) {
+		return FALSE;
+	}
+	for (index = 0; index < MAX_SPDM_MEASUREMENT_RESPONSE_CACHE_COUNT;
+	     index++) {
+		cache = &spdm_context->measurement_response_cache[index];
+		if (!spdm_is_measurement_response_cache_match(
+			    spdm_context, cache, spdm_request, generation)) {
+			continue;
+		}
+		if (cache->response_size > *response_size) {
+			return FALSE;
+		}
+		copy_mem(response, cache->response, cache->response_size);
+		*response_size = cache->response_size;
+
+		spdm_response = response;
+		spdm_get_random_number(
+			SPDM_NONCE_SIZE,
+			(uint8 *)(spdm_response + 1) +
+				libspdm_read_uint24(
+					spdm_response->measurement_record_length));
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/**
+  This function records an unsigned MEASUREMENTS response in the cache.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  spdm_request                  A pointer to the GET_MEASUREMENTS request.
+  @param  response_size                 The size in bytes of the response.
+  @param  response                     A pointer to the response data.
+**/
+static void spdm_cache_measurement_response(
+	IN spdm_context_t *spdm_context,
+	IN spdm_get_measurements_request_t *spdm_request,
+	IN uintn response_size, IN void *response)
+{
+	spdm_measurement_response_cache_t *cache;
+	uint32 generation;
+
+	generation = spdm_measurement_generation();
+	if ((generation == 0) || (response_size > sizeof(cache->response))) {
+		return;
+	}
+	cache = &spdm_context->measurement_response_cache
+			 [spdm_context->measurement_response_cache_next];
+	spdm_context->measurement_response_cache_next =
+		(spdm_context->measurement_response_cache_next + 1) %
+		MAX_SPDM_MEASUREMENT_RESPONSE_CACHE_COUNT;
+
+	cache->generation = generation;
+	copy_mem(&cache->spdm_version, &spdm_context->connection_info.version,
+		 sizeof(spdm_version_number_t));
+	cache->measurement_spec =
+		spdm_context->connection_info.algorithm.measurement_spec;
+	cache->measurement_hash_algo =
+		spdm_context->connection_info.algorithm.measurement_hash_algo;
+	cache->request_attribute = spdm_request->header.param1;
+	cache->measurement_operation = spdm_request->header.param2;
+	cache->opaque_measurement_rsp_size =
+		spdm_context->local_context.opaque_measurement_rsp_size;
+	cache->response_size = response_size;
+	copy_mem(cache->response, response, response_size);
+	cache->valid = TRUE;
+}
+#endif // LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT
+
+/**
+  This function builds the measurement record of all measurement blocks.
+
+  The blocks are collected one at a time and appended directly to the response,
+  so the size of the record is only limited by the response buffer.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  measurements_count            The count of the measurement blocks in the record.
+  @param  measurements                  A pointer to a destination buffer to store the measurement record.
+  @param  measurements_size             On input, indicates the size in bytes of the destination buffer.
+                                       On output, indicates the size in bytes of the measurement record.
+
+  @retval RETURN_SUCCESS               The measurement record is built.
+  @retval RETURN_BUFFER_TOO_SMALL      The destination buffer is too small for the measurement record.
+  @retval RETURN_***                   Any other RETURN_ error from spdm_measurement_collection.
+**/
+static return_status
+spdm_build_measurement_record(IN spdm_context_t *spdm_context,
+			      OUT uint8 *measurements_count,
+			      OUT uint8 *measurements,
+			      IN OUT uintn *measurements_size)
+{
+	uint8 measurement_index;
+	uint8 index;
+	uint8 total_count;
+	uintn record_size;
+	uintn block_size;
+	return_status status;
+
+	block_size = *measurements_size;
+	status = spdm_measurement_collection(
+		spdm_context->connection_info.version,
+		spdm_context->connection_info.algorithm.measurement_spec,
+		spdm_context->connection_info.algorithm.measurement_hash_algo,
+		SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS,
+		&total_count, measurements, &block_size);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	record_size = 0;
+	measurement_index = 0;
+	for (index = 0; index < total_count; index++) {
+		block_size = *measurements_size - record_size;
+		status = libspdm_get_next_measurement_block(
+			spdm_context, &measurement_index,
+			measurements + record_size, &block_size);
+		if (status == RETURN_NOT_FOUND) {
+			break;
+		}
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		record_size += block_size;
+	}
+
+	*measurements_count = index;
+	*measurements_size = record_size;
+	return RETURN_SUCCESS;
+}
+
 /**
   Process the SPDM GET_MEASUREMENT request and return the response.
 
@@ -245,6 +452,33 @@ return_status spdm_get_response_measurements(IN void *context,
 		}
 	}
 
+#if LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT
+	if (((spdm_request->header.param1 &
+	      SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) ==
+	     0) &&
+	    spdm_get_cached_measurement_response(spdm_context, spdm_request,
+						 response_size, response)) {
+		spdm_reset_message_buffer_via_request_code(
+			spdm_context, session_info,
+			spdm_request->header.request_response_code);
+
+		status = libspdm_append_message_m(spdm_context, session_info,
+						  spdm_request, request_size);
+		if (!RETURN_ERROR(status)) {
+			status = libspdm_append_message_m(spdm_context,
+							  session_info, response,
+							  *response_size);
+		}
+		if (RETURN_ERROR(status)) {
+			libspdm_generate_error_response(
+				spdm_context, SPDM_ERROR_CODE_UNSPECIFIED, 0,
+				response_size, response);
+			libspdm_reset_message_m(spdm_context, session_info);
+		}
+		return RETURN_SUCCESS;
+	}
+#endif
+
 	spdm_response_size = sizeof(spdm_measurements_response_t);
 
 	signature_size = spdm_get_asym_signature_size(
@@ -290,14 +524,22 @@ return_status spdm_get_response_measurements(IN void *context,
 
 	measurements = (uint8*)response + sizeof(spdm_measurements_response_t);
 
-	status = spdm_measurement_collection(
-		spdm_context->connection_info.version,
-		spdm_context->connection_info.algorithm.measurement_spec,
-		spdm_context->connection_info.algorithm.measurement_hash_algo,
-		measurements_index,
-		&measurements_count,
-		measurements,
-		&measurements_size);
+	if (measurements_index ==
+	    SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
+		status = spdm_build_measurement_record(spdm_context,
+						       &measurements_count,
+						       measurements,
+						       &measurements_size);
+	} else {
+		status = spdm_measurement_collection(
+			spdm_context->connection_info.version,
+			spdm_context->connection_info.algorithm.measurement_spec,
+			spdm_context->connection_info.algorithm.measurement_hash_algo,
+			measurements_index,
+			&measurements_count,
+			measurements,
+			&measurements_size);
+	}
 
 
 	if (RETURN_ERROR(status)) {
@@ -424,6 +666,11 @@ return_status spdm_get_response_measurements(IN void *context,
 	} else {
 		spdm_create_measurement_opaque(spdm_context, spdm_response,
 					       spdm_response_size);
+#if LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT
+		spdm_cache_measurement_response(spdm_context, spdm_request,
+						spdm_response_size,
+						spdm_response);
+#endif
 	}
 
 	spdm_reset_message_buffer_via_request_code(spdm_context, session_info,
@@ -230,6 +230,8 @@ return_status spdm_get_response_psk_exchange(IN void *context,
 			response_size, response);
 		return RETURN_SUCCESS;
 	}
+	spdm_trace_set_message(spdm_context, session_id,
+			       spdm_request->header.request_response_code);
 
 	spdm_reset_message_buffer_via_request_code(spdm_context, NULL,
 						spdm_request->header.request_response_code);
@@ -300,8 +302,10 @@ return_status spdm_get_response_psk_exchange(IN void *context,
 					     response_size, response);
 		return RETURN_SUCCESS;
 	}
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	status = spdm_generate_session_handshake_key(
 		session_info->secured_message_context, th1_hash_data);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	if (RETURN_ERROR(status)) {
 		libspdm_free_session_id(spdm_context, session_id);
 		libspdm_generate_error_response(spdm_context,
@@ -347,8 +351,10 @@ return_status spdm_get_response_psk_exchange(IN void *context,
 				0, response_size, response);
 			return RETURN_SUCCESS;
 		}
+		spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 		status = spdm_generate_session_data_key(
 			session_info->secured_message_context, th2_hash_data);
+		spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 		if (RETURN_ERROR(status)) {
 			libspdm_generate_error_response(
 				spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
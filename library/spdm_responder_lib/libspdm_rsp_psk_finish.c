@@ -162,8 +162,10 @@ return_status spdm_get_response_psk_finish(IN void *context,
 					     response_size, response);
 		return RETURN_SUCCESS;
 	}
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	status = spdm_generate_session_data_key(
 		session_info->secured_message_context, th2_hash_data);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_KEY_SCHEDULE);
 	if (RETURN_ERROR(status)) {
 		libspdm_generate_error_response(spdm_context,
 					     SPDM_ERROR_CODE_UNSPECIFIED, 0,
@@ -6,83 +6,82 @@
 
 #include "internal/libspdm_responder_lib.h"
 
-typedef struct {
-	uint8 request_response_code;
-	spdm_get_spdm_response_func get_response_func;
-} spdm_get_response_struct_t;
-
-spdm_get_response_struct_t mSpdmGetResponseStruct[] = {
-	{ SPDM_GET_VERSION, spdm_get_response_version },
-	{ SPDM_GET_CAPABILITIES, spdm_get_response_capabilities },
-	{ SPDM_NEGOTIATE_ALGORITHMS, spdm_get_response_algorithms },
+//
+// Direct-indexed GET_SPDM_RESPONSE function table.
+// It is constant, so it can be shared by all SPDM contexts without locking.
+//
+static const spdm_get_spdm_response_func
+	mSpdmGetResponseFuncTable[MAX_SPDM_REQUEST_RESPONSE_CODE_COUNT] = {
+	[SPDM_GET_VERSION] = spdm_get_response_version,
+	[SPDM_GET_CAPABILITIES] = spdm_get_response_capabilities,
+	[SPDM_NEGOTIATE_ALGORITHMS] = spdm_get_response_algorithms,
 
 	#if SPDM_ENABLE_CAPABILITY_CERT_CAP
-	{ SPDM_GET_DIGESTS, spdm_get_response_digests },
-	{ SPDM_GET_CERTIFICATE, spdm_get_response_certificate },
+	[SPDM_GET_DIGESTS] = spdm_get_response_digests,
+	[SPDM_GET_CERTIFICATE] = spdm_get_response_certificate,
 	#endif // SPDM_ENABLE_CAPABILITY_CERT_CAP
 
 	#if SPDM_ENABLE_CAPABILITY_CHAL_CAP
-	{ SPDM_CHALLENGE, spdm_get_response_challenge_auth },
+	[SPDM_CHALLENGE] = spdm_get_response_challenge_auth,
 	#endif // SPDM_ENABLE_CAPABILITY_CHAL_CAP
 
 	#if SPDM_ENABLE_CAPABILITY_MEAS_CAP
-	{ SPDM_GET_MEASUREMENTS, spdm_get_response_measurements },
+	[SPDM_GET_MEASUREMENTS] = spdm_get_response_measurements,
 	#endif // SPDM_ENABLE_CAPABILITY_MEAS_CAP
 
 	#if SPDM_ENABLE_CAPABILITY_KEY_EX_CAP
-	{ SPDM_KEY_EXCHANGE, spdm_get_response_key_exchange },
+	[SPDM_KEY_EXCHANGE] = spdm_get_response_key_exchange,
 	#endif // SPDM_ENABLE_CAPABILITY_KEY_EX_CAP
 
 	#if SPDM_ENABLE_CAPABILITY_PSK_EX_CAP
-	{ SPDM_PSK_EXCHANGE, spdm_get_response_psk_exchange },
+	[SPDM_PSK_EXCHANGE] = spdm_get_response_psk_exchange,
 	#endif // SPDM_ENABLE_CAPABILITY_PSK_EX_CAP
 
 	#if SPDM_ENABLE_CAPABILITY_KEY_EX_CAP || SPDM_ENABLE_CAPABILITY_PSK_EX_CAP
-	{ SPDM_GET_ENCAPSULATED_REQUEST,
-	  spdm_get_response_encapsulated_request },
-	{ SPDM_DELIVER_ENCAPSULATED_RESPONSE,
-	  spdm_get_response_encapsulated_response_ack },
+	[SPDM_GET_ENCAPSULATED_REQUEST] =
+		spdm_get_response_encapsulated_request,
+	[SPDM_DELIVER_ENCAPSULATED_RESPONSE] =
+		spdm_get_response_encapsulated_response_ack,
 	#endif // SPDM_ENABLE_CAPABILITY_KEY_EX_CAP || SPDM_ENABLE_CAPABILITY_PSK_EX_CAP
 
-	{ SPDM_RESPOND_IF_READY, spdm_get_response_respond_if_ready },
+	[SPDM_RESPOND_IF_READY] = spdm_get_response_respond_if_ready,
 
 	#if SPDM_ENABLE_CAPABILITY_KEY_EX_CAP
-	{ SPDM_FINISH, spdm_get_response_finish },
+	[SPDM_FINISH] = spdm_get_response_finish,
 	#endif // SPDM_ENABLE_CAPABILITY_KEY_EX_CAP
 
 	#if SPDM_ENABLE_CAPABILITY_PSK_EX_CAP
-	{ SPDM_PSK_FINISH, spdm_get_response_psk_finish },
+	[SPDM_PSK_FINISH] = spdm_get_response_psk_finish,
 	#endif // SPDM_ENABLE_CAPABILITY_PSK_EX_CAP
 
 	#if SPDM_ENABLE_CAPABILITY_KEY_EX_CAP || SPDM_ENABLE_CAPABILITY_PSK_EX_CAP
-	{ SPDM_END_SESSION, spdm_get_response_end_session },
-	{ SPDM_HEARTBEAT, spdm_get_response_heartbeat },
-	{ SPDM_KEY_UPDATE, spdm_get_response_key_update },
+	[SPDM_END_SESSION] = spdm_get_response_end_session,
+	[SPDM_HEARTBEAT] = spdm_get_response_heartbeat,
+	[SPDM_KEY_UPDATE] = spdm_get_response_key_update,
 	#endif // SPDM_ENABLE_CAPABILITY_KEY_EX_CAP || SPDM_ENABLE_CAPABILITY_PSK_EX_CAP
 };
 
 /**
   Return the GET_SPDM_RESPONSE function via request code.
 
+  A function registered in the SPDM context via libspdm_register_get_response_func_via_request_code
+  takes precedence over the default one.
+
+  @param  spdm_context                  The SPDM context for the device.
   @param  request_code                  The SPDM request code.
 
   @return GET_SPDM_RESPONSE function according to the request code.
 **/
 spdm_get_spdm_response_func
-spdm_get_response_func_via_request_code(IN uint8 request_code)
+spdm_get_response_func_via_request_code(IN spdm_context_t *spdm_context,
+					IN uint8 request_code)
 {
-	uintn index;
-
 	ASSERT(request_code != SPDM_RESPOND_IF_READY);
-	for (index = 0; index < sizeof(mSpdmGetResponseStruct) /
-					sizeof(mSpdmGetResponseStruct[0]);
-	     index++) {
-		if (request_code ==
-		    mSpdmGetResponseStruct[index].request_response_code) {
-			return mSpdmGetResponseStruct[index].get_response_func;
-		}
+	if (spdm_context->get_response_func_table[request_code] != 0) {
+		return (spdm_get_spdm_response_func)
+			spdm_context->get_response_func_table[request_code];
 	}
-	return NULL;
+	return mSpdmGetResponseFuncTable[request_code];
 }
 
 /**
@@ -99,7 +98,7 @@ spdm_get_response_func_via_last_request(IN spdm_context_t *spdm_context)
 
 	spdm_request = (void *)spdm_context->last_spdm_request;
 	return spdm_get_response_func_via_request_code(
-		spdm_request->request_response_code);
+		spdm_context, spdm_request->request_response_code);
 }
 
 /**
@@ -126,6 +125,7 @@ return_status libspdm_process_request(IN void *context, OUT uint32 **session_id,
 	return_status status;
 	spdm_session_info_t *session_info;
 	uint32 *message_session_id;
+	uint64 start_time;
 
 	spdm_context = context;
 
@@ -137,17 +137,43 @@ return_status libspdm_process_request(IN void *context, OUT uint32 **session_id,
 	}
 
 	DEBUG((DEBUG_INFO, "SpdmReceiveRequest[.] ...\n"));
+	SPDM_STATISTICS_ADD(spdm_context, messages_received, 1);
+	SPDM_STATISTICS_ADD(spdm_context, bytes_received, request_size);
 
 	message_session_id = NULL;
 	spdm_context->last_spdm_request_session_id_valid = FALSE;
 	spdm_context->last_spdm_request_size =
 		sizeof(spdm_context->last_spdm_request);
+	spdm_trace_set_message(spdm_context, INVALID_SESSION_ID, 0);
+	start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_TRANSPORT_DECODE);
 	status = spdm_context->transport_decode_message(
 		spdm_context, &message_session_id, is_app_message, TRUE,
 		request_size, request, &spdm_context->last_spdm_request_size,
 		spdm_context->last_spdm_request);
+	if (!RETURN_ERROR(status) && !*is_app_message &&
+	    (spdm_context->last_spdm_request_size >=
+	     sizeof(spdm_message_header_t))) {
+		spdm_trace_set_message(
+			spdm_context,
+			(message_session_id != NULL) ? *message_session_id :
+						       INVALID_SESSION_ID,
+			((spdm_message_header_t *)spdm_context->last_spdm_request)
+				->request_response_code);
+	}
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_TRANSPORT_DECODE);
+	if (message_session_id != NULL) {
+		spdm_statistics_record_crypto(spdm_context,
+					      SPDM_STATISTICS_CRYPTO_AEAD,
+					      start_time);
+	}
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO, "transport_decode_message : %p\n", status));
+		if (spdm_context->last_spdm_error.error_code ==
+		    SPDM_ERROR_CODE_DECRYPT_ERROR) {
+			SPDM_STATISTICS_ADD(spdm_context, decrypt_failure_count,
+					    1);
+		}
 		if (spdm_context->last_spdm_error.error_code != 0) {
 			//
 			// If the SPDM error code is Non-Zero, that means we need send the error message back to requester.
@@ -301,23 +327,44 @@ return_status libspdm_build_response(IN void *context, IN uint32 *session_id,
 				  OUT void *response)
 {
 	spdm_context_t *spdm_context;
-	uint8 my_response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *my_response;
 	uintn my_response_size;
+	uintn my_response_buffer_size;
+	uint32 my_session_id;
 	return_status status;
 	spdm_get_spdm_response_func get_response_func;
 	spdm_session_info_t *session_info;
 	spdm_message_header_t *spdm_request;
 	spdm_message_header_t *spdm_response;
+	uint64 start_time;
+	uint64 encode_start_time;
 
 	spdm_context = context;
 	status = RETURN_UNSUPPORTED;
+	start_time = spdm_statistics_get_time(spdm_context);
+
+	//
+	// The request has been consumed into last_spdm_request by libspdm_process_request(),
+	// so a receiver buffer is used to build the plain SPDM response.
+	// session_id may point into the received transport message, so keep a copy.
+	//
+	if (session_id != NULL) {
+		my_session_id = *session_id;
+		session_id = &my_session_id;
+	}
+	status = libspdm_acquire_receiver_buffer(spdm_context, &my_response_buffer_size,
+						 (void **)&my_response);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	ASSERT(response != my_response);
 
 	if (spdm_context->last_spdm_error.error_code != 0) {
 		//
 		// Error in libspdm_process_request(), and we need send error message directly.
 		//
-		my_response_size = sizeof(my_response);
-		zero_mem(my_response, sizeof(my_response));
+		my_response_size = my_response_buffer_size;
+		zero_mem(my_response, my_response_size);
 		switch (spdm_context->last_spdm_error.error_code) {
 		case SPDM_ERROR_CODE_DECRYPT_ERROR:
 			// session ID is valid. Use it to encrypt the error message.
@@ -335,7 +382,8 @@ return_status libspdm_build_response(IN void *context, IN uint32 *session_id,
 			break;
 		default:
 			ASSERT(FALSE);
-			return RETURN_UNSUPPORTED;
+			status = RETURN_UNSUPPORTED;
+			goto done;
 		}
 
 		DEBUG((DEBUG_INFO, "SpdmSendResponse[%x] (0x%x): \n",
@@ -343,18 +391,22 @@ return_status libspdm_build_response(IN void *context, IN uint32 *session_id,
 		       my_response_size));
 		internal_dump_hex(my_response, my_response_size);
 
+		spdm_trace_begin(spdm_context,
+				 SPDM_TRACE_PHASE_TRANSPORT_ENCODE);
 		status = spdm_context->transport_encode_message(
 			spdm_context, session_id, FALSE, FALSE,
 			my_response_size, my_response, response_size, response);
+		spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_TRANSPORT_ENCODE);
 		if (RETURN_ERROR(status)) {
 			DEBUG((DEBUG_INFO, "transport_encode_message : %p\n",
 			       status));
-			return status;
+			goto done;
 		}
 
 		zero_mem(&spdm_context->last_spdm_error,
 			 sizeof(spdm_context->last_spdm_error));
-		return RETURN_SUCCESS;
+		status = RETURN_SUCCESS;
+		goto done;
 	}
 
 	if (session_id != NULL) {
@@ -362,18 +414,15 @@ return_status libspdm_build_response(IN void *context, IN uint32 *session_id,
 			spdm_context, *session_id);
 		if (session_info == NULL) {
 			ASSERT(FALSE);
-			return RETURN_UNSUPPORTED;
+			status = RETURN_UNSUPPORTED;
+			goto done;
 		}
 	}
 
-	if (response == NULL) {
-		return RETURN_INVALID_PARAMETER;
-	}
-	if (response_size == NULL) {
-		return RETURN_INVALID_PARAMETER;
-	}
-	if (*response_size == 0) {
-		return RETURN_INVALID_PARAMETER;
+	if ((response == NULL) || (response_size == NULL) ||
+	    (*response_size == 0)) {
+		status = RETURN_INVALID_PARAMETER;
+		goto done;
 	}
 
 	DEBUG((DEBUG_INFO, "SpdmSendResponse[%x] ...\n",
@@ -381,12 +430,14 @@ return_status libspdm_build_response(IN void *context, IN uint32 *session_id,
 
 	spdm_request = (void *)spdm_context->last_spdm_request;
 	if (spdm_context->last_spdm_request_size == 0) {
-		return RETURN_NOT_READY;
+		status = RETURN_NOT_READY;
+		goto done;
 	}
 
-	my_response_size = sizeof(my_response);
-	zero_mem(my_response, sizeof(my_response));
+	my_response_size = my_response_buffer_size;
+	zero_mem(my_response, my_response_size);
 	get_response_func = NULL;
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_HANDLER);
 	if (!is_app_message) {
 		get_response_func =
 			spdm_get_response_func_via_last_request(spdm_context);
@@ -410,6 +461,7 @@ return_status libspdm_build_response(IN void *context, IN uint32 *session_id,
 			status = RETURN_NOT_FOUND;
 		}
 	}
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_HANDLER);
 	if (status != RETURN_SUCCESS) {
 		libspdm_generate_error_response(
 			spdm_context, SPDM_ERROR_CODE_UNSUPPORTED_REQUEST,
@@ -421,12 +473,25 @@ return_status libspdm_build_response(IN void *context, IN uint32 *session_id,
 	       (session_id != NULL) ? *session_id : 0, my_response_size));
 	internal_dump_hex(my_response, my_response_size);
 
+	encode_start_time = spdm_statistics_get_time(spdm_context);
+	spdm_trace_begin(spdm_context, SPDM_TRACE_PHASE_TRANSPORT_ENCODE);
 	status = spdm_context->transport_encode_message(
 		spdm_context, session_id, is_app_message, FALSE,
 		my_response_size, my_response, response_size, response);
+	spdm_trace_end(spdm_context, SPDM_TRACE_PHASE_TRANSPORT_ENCODE);
+	if (session_id != NULL) {
+		spdm_statistics_record_crypto(spdm_context,
+					      SPDM_STATISTICS_CRYPTO_AEAD,
+					      encode_start_time);
+	}
 	if (RETURN_ERROR(status)) {
 		DEBUG((DEBUG_INFO, "transport_encode_message : %p\n", status));
-		return status;
+		goto done;
+	}
+	if (!is_app_message) {
+		spdm_statistics_record_response(
+			spdm_context, spdm_request->request_response_code,
+			start_time);
 	}
 
 	spdm_response = (void *)my_response;
@@ -468,7 +533,11 @@ return_status libspdm_build_response(IN void *context, IN uint32 *session_id,
 		}
 	}
 
-	return RETURN_SUCCESS;
+	status = RETURN_SUCCESS;
+
+done:
+	libspdm_release_receiver_buffer(spdm_context, my_response);
+	return status;
 }
 
 /**
@@ -491,6 +560,38 @@ void libspdm_register_get_response_func(
 	return;
 }
 
+/**
+  Register an SPDM request process function for a request code.
+
+  The function is invoked for the request code instead of the default message process function.
+  It can be used to handle vendor defined requests or request codes unknown to libspdm.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  request_code                  The SPDM request code.
+  @param  get_response_func              The function to process the request.
+                                       NULL restores the default message process function.
+
+  @retval RETURN_SUCCESS               The function is registered.
+  @retval RETURN_INVALID_PARAMETER     The request code is not a registrable SPDM request code.
+**/
+return_status libspdm_register_get_response_func_via_request_code(
+	IN void *spdm_context, IN uint8 request_code,
+	IN libspdm_get_spdm_response_func get_response_func)
+{
+	spdm_context_t *context;
+
+	if (((request_code & 0x80) == 0) ||
+	    (request_code == SPDM_RESPOND_IF_READY)) {
+		return RETURN_INVALID_PARAMETER;
+	}
+
+	context = spdm_context;
+	context->get_response_func_table[request_code] =
+		(uintn)get_response_func;
+
+	return RETURN_SUCCESS;
+}
+
 /**
   Register an SPDM session state callback function.
 
@@ -73,7 +73,8 @@ return_status spdm_get_response_respond_if_ready(IN void *context,
 
 	get_response_func = NULL;
 	get_response_func =
-		spdm_get_response_func_via_request_code(spdm_request->param1);
+		spdm_get_response_func_via_request_code(spdm_context,
+							spdm_request->param1);
 	if (get_response_func == NULL) {
 		libspdm_generate_error_response(
 			spdm_context, SPDM_ERROR_CODE_UNSUPPORTED_REQUEST,
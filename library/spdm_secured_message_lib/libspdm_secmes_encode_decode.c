@@ -9,6 +9,9 @@
 /**
   Encode an application message to a secured message.
 
+  The application message may be in the secured message buffer, after the
+  position it is encoded to, so that a message can be encoded in place.
+
   @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
   @param  session_id                    The session ID of the SPDM session.
   @param  is_requester                  Indicates if it is a requester message.
@@ -280,6 +283,8 @@ return_status spdm_encode_secured_message(
 /**
   Decode an application message from a secured message.
 
+  The application message buffer may be the secured message buffer.
+
   @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
   @param  session_id                    The session ID of the SPDM session.
   @param  is_requester                  Indicates if it is a requester message.
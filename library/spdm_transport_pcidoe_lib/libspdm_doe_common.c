@@ -6,6 +6,7 @@
 
 #include <library/spdm_transport_pcidoe_lib.h>
 #include <library/spdm_secured_message_lib.h>
+#include <industry_standard/pcidoe.h>
 
 /**
   Encode a normal message or secured message to a transport message.
@@ -113,7 +114,7 @@ return_status spdm_transport_pci_doe_encode_message(
 {
 	return_status status;
 	transport_encode_message_func transport_encode_message;
-	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *secured_message;
 	uintn secured_message_size;
 	spdm_secured_message_callbacks_t spdm_secured_message_callbacks_t;
 	void *secured_message_context;
@@ -138,19 +139,32 @@ return_status spdm_transport_pci_doe_encode_message(
 			return RETURN_UNSUPPORTED;
 		}
 
-		// message to secured message
-		secured_message_size = sizeof(secured_message);
+		//
+		// message to secured message, in place after the transport header
+		//
+		if (*transport_message_size <=
+		    sizeof(pci_doe_data_object_header_t)) {
+			return RETURN_BUFFER_TOO_SMALL;
+		}
+		secured_message = (uint8 *)transport_message +
+				  sizeof(pci_doe_data_object_header_t);
+		secured_message_size = *transport_message_size -
+				       sizeof(pci_doe_data_object_header_t);
+		libspdm_trace(spdm_context, SPDM_TRACE_PHASE_SECURED_MESSAGE_ENCODE,
+			      SPDM_TRACE_EVENT_BEGIN);
 		status = spdm_encode_secured_message(
 			secured_message_context, *session_id, is_requester,
 			message_size, message, &secured_message_size,
 			secured_message, &spdm_secured_message_callbacks_t);
+		libspdm_trace(spdm_context, SPDM_TRACE_PHASE_SECURED_MESSAGE_ENCODE,
+			      SPDM_TRACE_EVENT_END);
 		if (RETURN_ERROR(status)) {
 			DEBUG((DEBUG_ERROR,
 			       "spdm_encode_secured_message - %p\n", status));
 			return status;
 		}
 
-		// secured message to secured PCI DOE message
+		// secured message to secured PCI DOE message, in place
 		status = transport_encode_message(
 			session_id, secured_message_size, secured_message,
 			transport_message_size, transport_message);
@@ -259,11 +273,15 @@ return_status spdm_transport_pci_doe_decode_message(
 		}
 
 		// Secured message to message
+		libspdm_trace(spdm_context, SPDM_TRACE_PHASE_SECURED_MESSAGE_DECODE,
+			      SPDM_TRACE_EVENT_BEGIN);
 		status = spdm_decode_secured_message(
 			secured_message_context, *SecuredMessageSessionId,
 			is_requester, secured_message_size, secured_message,
 			message_size, message,
 			&spdm_secured_message_callbacks_t);
+		libspdm_trace(spdm_context, SPDM_TRACE_PHASE_SECURED_MESSAGE_DECODE,
+			      SPDM_TRACE_EVENT_END);
 		if (RETURN_ERROR(status)) {
 			DEBUG((DEBUG_ERROR,
 			       "spdm_decode_secured_message - %p\n", status));
@@ -31,6 +31,11 @@
 #define DEBUG_LEVEL_CONFIG (DEBUG_INFO | DEBUG_ERROR)
 #endif
 
+//
+// The error levels enabled for debug_print(), initialized to DEBUG_LEVEL_CONFIG.
+//
+static uintn m_debug_print_error_level = DEBUG_LEVEL_CONFIG;
+
 void debug_assert(IN const char8 *file_name, IN uintn line_number,
 		  IN const char8 *description)
 {
@@ -60,7 +65,7 @@ void debug_print(IN uintn error_level, IN const char8 *format, ...)
 	char8 buffer[MAX_DEBUG_MESSAGE_LENGTH];
 	va_list marker;
 
-	if ((error_level & DEBUG_LEVEL_CONFIG) == 0) {
+	if ((error_level & m_debug_print_error_level) == 0) {
 		return;
 	}
 
@@ -72,3 +77,18 @@ void debug_print(IN uintn error_level, IN const char8 *format, ...)
 
 	printf("%s", buffer);
 }
+
+boolean debug_print_level_enabled(IN uintn error_level)
+{
+	return (boolean)((error_level & m_debug_print_error_level) != 0);
+}
+
+uintn get_debug_print_error_level(void)
+{
+	return m_debug_print_error_level;
+}
+
+void set_debug_print_error_level(IN uintn error_level)
+{
+	m_debug_print_error_level = error_level;
+}
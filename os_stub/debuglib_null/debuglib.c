@@ -14,3 +14,17 @@ void debug_assert(IN const char8 *file_name, IN uintn line_number,
 void debug_print(IN uintn error_level, IN const char8 *format, ...)
 {
 }
+
+boolean debug_print_level_enabled(IN uintn error_level)
+{
+	return FALSE;
+}
+
+uintn get_debug_print_error_level(void)
+{
+	return 0;
+}
+
+void set_debug_print_error_level(IN uintn error_level)
+{
+}
@@ -0,0 +1,788 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <base.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <assert.h>
+#include <stdarg.h>
+#include <time.h>
+#include <signal.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include <library/debuglib.h>
+#include <library/debuglib_ring.h>
+
+//
+// Define the maximum debug and assert message length that this library supports
+//
+#define MAX_DEBUG_MESSAGE_LENGTH 0x100
+
+#define DEBUG_ASSERT_NATIVE 0
+#define DEBUG_ASSERT_DEADLOOP 1
+#define DEBUG_ASSERT_BREAKPOINT 2
+
+#ifndef DEBUG_ASSERT_CONFIG
+#define DEBUG_ASSERT_CONFIG DEBUG_ASSERT_DEADLOOP
+#endif
+
+#ifndef DEBUG_LEVEL_CONFIG
+#define DEBUG_LEVEL_CONFIG (DEBUG_INFO | DEBUG_ERROR)
+#endif
+
+#define DEBUG_RING_RECORD_MASK (DEBUG_RING_RECORD_COUNT - 1)
+
+#if defined(_MSC_VER)
+#define DEBUG_RING_THREAD_LOCAL __declspec(thread)
+#else
+#define DEBUG_RING_THREAD_LOCAL __thread
+#endif
+
+//
+// The ring buffer is a bounded queue where each slot has a sequence number (D. Vyukov).
+// A slot is free for the writer at position pos if its sequence is pos,
+// and it holds a record for the reader at position pos if its sequence is pos + 1.
+// The sequence is stored relative to the slot index, so that the zero-initialized ring buffer is empty.
+//
+typedef struct {
+	volatile uintn sequence;
+	debug_ring_record_t record;
+} debug_ring_slot_t;
+
+typedef enum {
+	DEBUG_RING_ARG_NONE,
+	DEBUG_RING_ARG_INT,
+	DEBUG_RING_ARG_LONG,
+	DEBUG_RING_ARG_LONG_LONG,
+	DEBUG_RING_ARG_SIZE,
+	DEBUG_RING_ARG_INTMAX,
+	DEBUG_RING_ARG_PTRDIFF,
+	DEBUG_RING_ARG_DOUBLE,
+	DEBUG_RING_ARG_LONG_DOUBLE,
+	DEBUG_RING_ARG_POINTER,
+	DEBUG_RING_ARG_STRING,
+} debug_ring_arg_type_t;
+
+//
+// The error levels enabled for debug_print(), initialized to DEBUG_LEVEL_CONFIG.
+//
+static uintn m_debug_print_error_level = DEBUG_LEVEL_CONFIG;
+
+static debug_ring_slot_t m_debug_ring[DEBUG_RING_RECORD_COUNT];
+static volatile uintn m_debug_ring_write_position;
+static volatile uintn m_debug_ring_read_position;
+static volatile uintn m_debug_ring_overwritten_count;
+static volatile uintn m_debug_ring_dropped_count;
+static volatile uintn m_debug_ring_thread_count;
+static DEBUG_RING_THREAD_LOCAL uint32 m_debug_ring_thread_id;
+
+static uintn debug_ring_atomic_load(IN volatile uintn *value)
+{
+#if defined(_MSC_VER)
+	uintn result;
+
+	result = *value;
+	_ReadWriteBarrier();
+	return result;
+#else
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void debug_ring_atomic_store(IN volatile uintn *value,
+				    IN uintn new_value)
+{
+#if defined(_MSC_VER)
+	_ReadWriteBarrier();
+	*value = new_value;
+#else
+	__atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+#endif
+}
+
+static boolean debug_ring_atomic_compare_exchange(IN volatile uintn *value,
+						  IN uintn expected,
+						  IN uintn new_value)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+	return (boolean)((uintn)_InterlockedCompareExchange64(
+				 (volatile __int64 *)value, (__int64)new_value,
+				 (__int64)expected) == expected);
+#elif defined(_MSC_VER)
+	return (boolean)((uintn)_InterlockedCompareExchange(
+				 (volatile long *)value, (long)new_value,
+				 (long)expected) == expected);
+#else
+	return (boolean)__atomic_compare_exchange_n(value, &expected, new_value,
+						    FALSE, __ATOMIC_ACQ_REL,
+						    __ATOMIC_ACQUIRE);
+#endif
+}
+
+static uintn debug_ring_atomic_increment(IN volatile uintn *value)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+	return (uintn)_InterlockedExchangeAdd64((volatile __int64 *)value, 1) +
+	       1;
+#elif defined(_MSC_VER)
+	return (uintn)_InterlockedExchangeAdd((volatile long *)value, 1) + 1;
+#else
+	return __atomic_add_fetch(value, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+/**
+  Return the sequence of a slot for a position.
+**/
+static uintn debug_ring_get_sequence(IN uintn position)
+{
+	return debug_ring_atomic_load(
+		       &m_debug_ring[position & DEBUG_RING_RECORD_MASK].sequence) +
+	       (position & DEBUG_RING_RECORD_MASK);
+}
+
+/**
+  Set the sequence of a slot for a position.
+**/
+static void debug_ring_set_sequence(IN uintn position, IN uintn sequence)
+{
+	debug_ring_atomic_store(
+		&m_debug_ring[position & DEBUG_RING_RECORD_MASK].sequence,
+		sequence - (position & DEBUG_RING_RECORD_MASK));
+}
+
+/**
+  Reserve the slot at the write position. The oldest record is overwritten if the ring buffer is full.
+
+  It never waits for another thread. Each retry follows a position moved by another thread.
+  If the ring buffer is full and the oldest slot is still being written by another debug_print(),
+  or copied out by a reader, no slot is reserved.
+
+  @param  position                      The position of the reserved slot.
+
+  @return The record of the reserved slot, or NULL if the oldest slot is in use by another thread.
+**/
+static debug_ring_record_t *debug_ring_reserve(OUT uintn *position)
+{
+	uintn write_position;
+	uintn read_position;
+	intn difference;
+
+	while (TRUE) {
+		write_position = debug_ring_atomic_load(&m_debug_ring_write_position);
+		difference = (intn)(debug_ring_get_sequence(write_position) -
+				    write_position);
+		if (difference == 0) {
+			if (debug_ring_atomic_compare_exchange(
+				    &m_debug_ring_write_position, write_position,
+				    write_position + 1)) {
+				*position = write_position;
+				return &m_debug_ring[write_position &
+						     DEBUG_RING_RECORD_MASK]
+						.record;
+			}
+		} else if (difference < 0) {
+			read_position =
+				debug_ring_atomic_load(&m_debug_ring_read_position);
+			if (debug_ring_atomic_load(&m_debug_ring_write_position) !=
+			    write_position) {
+				continue;
+			}
+			if (read_position !=
+			    write_position - DEBUG_RING_RECORD_COUNT) {
+				//
+				// A reader is copying out the oldest record.
+				//
+				return NULL;
+			}
+			if (debug_ring_get_sequence(read_position) !=
+			    read_position + 1) {
+				//
+				// The oldest record is not committed yet.
+				//
+				return NULL;
+			}
+			//
+			// Full. Discard the oldest record.
+			//
+			if (debug_ring_atomic_compare_exchange(
+				    &m_debug_ring_read_position, read_position,
+				    read_position + 1)) {
+				debug_ring_set_sequence(
+					read_position,
+					read_position + DEBUG_RING_RECORD_COUNT);
+				debug_ring_atomic_increment(
+					&m_debug_ring_overwritten_count);
+			}
+		}
+	}
+}
+
+/**
+  Remove the oldest record from the ring buffer.
+
+  It may be called from any thread.
+
+  @param  record                        The record removed from the ring buffer.
+
+  @retval TRUE   A record is removed.
+  @retval FALSE  The ring buffer is empty.
+**/
+boolean debug_ring_read(OUT debug_ring_record_t *record)
+{
+	uintn read_position;
+	intn difference;
+
+	while (TRUE) {
+		read_position = debug_ring_atomic_load(&m_debug_ring_read_position);
+		difference = (intn)(debug_ring_get_sequence(read_position) -
+				    (read_position + 1));
+		if (difference < 0) {
+			return FALSE;
+		}
+		if ((difference == 0) &&
+		    debug_ring_atomic_compare_exchange(
+			    &m_debug_ring_read_position, read_position,
+			    read_position + 1)) {
+			memcpy(record,
+			       &m_debug_ring[read_position & DEBUG_RING_RECORD_MASK]
+					.record,
+			       sizeof(debug_ring_record_t));
+			debug_ring_set_sequence(read_position,
+						read_position +
+							DEBUG_RING_RECORD_COUNT);
+			return TRUE;
+		}
+	}
+}
+
+/**
+  Return the number of records overwritten before they are read.
+
+  @return The number of records overwritten before they are read.
+**/
+uint64 debug_ring_get_overwritten_count(void)
+{
+	return debug_ring_atomic_load(&m_debug_ring_overwritten_count);
+}
+
+/**
+  Return the number of messages dropped by debug_print() because the ring buffer is full and
+  its oldest record is in use by another thread.
+
+  @return The number of dropped messages.
+**/
+uint64 debug_ring_get_dropped_count(void)
+{
+	return debug_ring_atomic_load(&m_debug_ring_dropped_count);
+}
+
+static uint64 debug_ring_get_time_ns(void)
+{
+	struct timespec time_spec;
+
+#if defined(_MSC_VER)
+	timespec_get(&time_spec, TIME_UTC);
+#else
+	clock_gettime(CLOCK_MONOTONIC, &time_spec);
+#endif
+	return (uint64)time_spec.tv_sec * 1000000000 + (uint64)time_spec.tv_nsec;
+}
+
+/**
+  Parse a conversion specification of a format.
+
+  @param  format                        The format, after the '%'.
+  @param  star_count                    The number of '*' for the width and the precision.
+  @param  arg_type                      The type of the argument, DEBUG_RING_ARG_NONE for "%%".
+
+  @return The format after the conversion specification.
+**/
+static const char8 *
+debug_ring_parse_conversion(IN const char8 *format, OUT uintn *star_count,
+			    OUT debug_ring_arg_type_t *arg_type)
+{
+	debug_ring_arg_type_t integer_type;
+	boolean long_double;
+
+	*star_count = 0;
+	*arg_type = DEBUG_RING_ARG_NONE;
+	while ((*format != '\0') && (strchr("-+ #0", *format) != NULL)) {
+		format++;
+	}
+	if (*format == '*') {
+		(*star_count)++;
+		format++;
+	}
+	while ((*format >= '0') && (*format <= '9')) {
+		format++;
+	}
+	if (*format == '.') {
+		format++;
+		if (*format == '*') {
+			(*star_count)++;
+			format++;
+		}
+		while ((*format >= '0') && (*format <= '9')) {
+			format++;
+		}
+	}
+
+	integer_type = DEBUG_RING_ARG_INT;
+	long_double = FALSE;
+	switch (*format) {
+	case 'h':
+		format++;
+		if (*format == 'h') {
+			format++;
+		}
+		break;
+	case 'l':
+		format++;
+		integer_type = DEBUG_RING_ARG_LONG;
+		if (*format == 'l') {
+			format++;
+			integer_type = DEBUG_RING_ARG_LONG_LONG;
+		}
+		break;
+	case 'z':
+		format++;
+		integer_type = DEBUG_RING_ARG_SIZE;
+		break;
+	case 'j':
+		format++;
+		integer_type = DEBUG_RING_ARG_INTMAX;
+		break;
+	case 't':
+		format++;
+		integer_type = DEBUG_RING_ARG_PTRDIFF;
+		break;
+	case 'L':
+		format++;
+		long_double = TRUE;
+		break;
+	default:
+		break;
+	}
+
+	switch (*format) {
+	case '\0':
+		return format;
+	case 'd':
+	case 'i':
+	case 'u':
+	case 'o':
+	case 'x':
+	case 'X':
+	case 'c':
+		*arg_type = integer_type;
+		break;
+	case 'e':
+	case 'E':
+	case 'f':
+	case 'F':
+	case 'g':
+	case 'G':
+	case 'a':
+	case 'A':
+		*arg_type = long_double ? DEBUG_RING_ARG_LONG_DOUBLE :
+					  DEBUG_RING_ARG_DOUBLE;
+		break;
+	case 'p':
+		*arg_type = DEBUG_RING_ARG_POINTER;
+		break;
+	case 's':
+		*arg_type = DEBUG_RING_ARG_STRING;
+		break;
+	default:
+		break;
+	}
+	return format + 1;
+}
+
+/**
+  Copy the arguments of a format into a record.
+
+  @param  record                        The record, with the format set.
+  @param  marker                        The arguments of the format.
+**/
+static void debug_ring_capture_arguments(IN OUT debug_ring_record_t *record,
+					 IN va_list marker)
+{
+	const char8 *format;
+	uintn star_count;
+	debug_ring_arg_type_t arg_type;
+	uintn string_size;
+	uintn length;
+	const char8 *string;
+	double double_value;
+
+	record->arg_count = 0;
+	string_size = 0;
+	format = record->format;
+	while (*format != '\0') {
+		if (*format != '%') {
+			format++;
+			continue;
+		}
+		format = debug_ring_parse_conversion(format + 1, &star_count,
+						     &arg_type);
+		if (record->arg_count + star_count +
+			    ((arg_type != DEBUG_RING_ARG_NONE) ? 1 : 0) >
+		    DEBUG_RING_RECORD_ARG_COUNT) {
+			break;
+		}
+		for (; star_count > 0; star_count--) {
+			record->arg[record->arg_count++] =
+				(uint64)(int64)va_arg(marker, int);
+		}
+		switch (arg_type) {
+		case DEBUG_RING_ARG_NONE:
+			continue;
+		case DEBUG_RING_ARG_INT:
+			record->arg[record->arg_count] =
+				(uint64)(int64)va_arg(marker, int);
+			break;
+		case DEBUG_RING_ARG_LONG:
+			record->arg[record->arg_count] =
+				(uint64)(int64)va_arg(marker, long);
+			break;
+		case DEBUG_RING_ARG_LONG_LONG:
+			record->arg[record->arg_count] =
+				(uint64)va_arg(marker, long long);
+			break;
+		case DEBUG_RING_ARG_SIZE:
+			record->arg[record->arg_count] =
+				(uint64)va_arg(marker, size_t);
+			break;
+		case DEBUG_RING_ARG_INTMAX:
+			record->arg[record->arg_count] =
+				(uint64)va_arg(marker, intmax_t);
+			break;
+		case DEBUG_RING_ARG_PTRDIFF:
+			record->arg[record->arg_count] =
+				(uint64)va_arg(marker, ptrdiff_t);
+			break;
+		case DEBUG_RING_ARG_DOUBLE:
+		case DEBUG_RING_ARG_LONG_DOUBLE:
+			if (arg_type == DEBUG_RING_ARG_DOUBLE) {
+				double_value = va_arg(marker, double);
+			} else {
+				double_value = (double)va_arg(marker, long double);
+			}
+			memcpy(&record->arg[record->arg_count], &double_value,
+			       sizeof(double_value));
+			break;
+		case DEBUG_RING_ARG_POINTER:
+			record->arg[record->arg_count] =
+				(uint64)(uintn)va_arg(marker, void *);
+			break;
+		case DEBUG_RING_ARG_STRING:
+			string = va_arg(marker, const char8 *);
+			if (string == NULL) {
+				string = "(null)";
+			}
+			if (string_size >= sizeof(record->string)) {
+				record->arg[record->arg_count] =
+					sizeof(record->string) - 1;
+				break;
+			}
+			length = strlen(string);
+			if (length > sizeof(record->string) - 1 - string_size) {
+				length = sizeof(record->string) - 1 - string_size;
+			}
+			memcpy(record->string + string_size, string, length);
+			record->string[string_size + length] = '\0';
+			record->arg[record->arg_count] = string_size;
+			string_size += length + 1;
+			break;
+		}
+		record->arg_count++;
+	}
+}
+
+/**
+  Append a string to a message, truncated to the buffer.
+**/
+static void debug_ring_append(IN OUT char8 *buffer, IN uintn buffer_size,
+			      IN OUT uintn *length, IN const char8 *string,
+			      IN uintn string_length)
+{
+	if (*length + string_length > buffer_size - 1) {
+		string_length = buffer_size - 1 - *length;
+	}
+	memcpy(buffer + *length, string, string_length);
+	*length += string_length;
+	buffer[*length] = '\0';
+}
+
+/**
+  Format a record of the ring buffer as the message printed by debug_print().
+
+  @param  record                        The record.
+  @param  buffer                        The buffer of the message.
+  @param  buffer_size                   The size in bytes of the buffer.
+
+  @return The length of the message, truncated to buffer_size - 1.
+**/
+uintn debug_ring_format(IN const debug_ring_record_t *record,
+			OUT char8 *buffer, IN uintn buffer_size)
+{
+	const char8 *format;
+	const char8 *conversion;
+	uintn star_count;
+	debug_ring_arg_type_t arg_type;
+	uintn arg_index;
+	uintn length;
+	char8 specification[32];
+	uintn specification_length;
+	char8 value[MAX_DEBUG_MESSAGE_LENGTH];
+	int value_length;
+	uint64 arg;
+	double double_value;
+
+	if (buffer_size == 0) {
+		return 0;
+	}
+	buffer[0] = '\0';
+	length = 0;
+	arg_index = 0;
+	format = record->format;
+	while (*format != '\0') {
+		if (*format != '%') {
+			conversion = strchr(format, '%');
+			if (conversion == NULL) {
+				conversion = format + strlen(format);
+			}
+			debug_ring_append(buffer, buffer_size, &length, format,
+					  conversion - format);
+			format = conversion;
+			continue;
+		}
+		conversion = format;
+		format = debug_ring_parse_conversion(format + 1, &star_count,
+						     &arg_type);
+		if (arg_type == DEBUG_RING_ARG_NONE) {
+			debug_ring_append(buffer, buffer_size, &length,
+					  (format[-1] == '%') ? "%" : conversion,
+					  (format[-1] == '%') ? 1 :
+							       format - conversion);
+			continue;
+		}
+		if (arg_index + star_count + 1 > record->arg_count) {
+			//
+			// The argument is not recorded.
+			//
+			debug_ring_append(buffer, buffer_size, &length,
+					  conversion, format - conversion);
+			continue;
+		}
+
+		//
+		// Build the conversion specification of one argument, with the values of '*'.
+		// A long double is recorded as a double.
+		//
+		specification_length = 0;
+		for (; conversion < format; conversion++) {
+			if (specification_length + 12 > sizeof(specification)) {
+				break;
+			}
+			if (*conversion == '*') {
+				specification_length += snprintf(
+					specification + specification_length,
+					sizeof(specification) - specification_length,
+					"%d", (int)(int64)record->arg[arg_index++]);
+			} else if ((*conversion != 'L') ||
+				   (arg_type != DEBUG_RING_ARG_LONG_DOUBLE)) {
+				specification[specification_length++] = *conversion;
+			}
+		}
+		specification[specification_length] = '\0';
+
+		arg = record->arg[arg_index++];
+		switch (arg_type) {
+		case DEBUG_RING_ARG_INT:
+			value_length = snprintf(value, sizeof(value), specification,
+						(int)(int64)arg);
+			break;
+		case DEBUG_RING_ARG_LONG:
+			value_length = snprintf(value, sizeof(value), specification,
+						(long)(int64)arg);
+			break;
+		case DEBUG_RING_ARG_LONG_LONG:
+			value_length = snprintf(value, sizeof(value), specification,
+						(long long)arg);
+			break;
+		case DEBUG_RING_ARG_SIZE:
+			value_length = snprintf(value, sizeof(value), specification,
+						(size_t)arg);
+			break;
+		case DEBUG_RING_ARG_INTMAX:
+			value_length = snprintf(value, sizeof(value), specification,
+						(intmax_t)arg);
+			break;
+		case DEBUG_RING_ARG_PTRDIFF:
+			value_length = snprintf(value, sizeof(value), specification,
+						(ptrdiff_t)arg);
+			break;
+		case DEBUG_RING_ARG_DOUBLE:
+		case DEBUG_RING_ARG_LONG_DOUBLE:
+			memcpy(&double_value, &arg, sizeof(double_value));
+			value_length = snprintf(value, sizeof(value), specification,
+						double_value);
+			break;
+		case DEBUG_RING_ARG_POINTER:
+			value_length = snprintf(value, sizeof(value), specification,
+						(void *)(uintn)arg);
+			break;
+		case DEBUG_RING_ARG_STRING:
+			value_length = snprintf(value, sizeof(value), specification,
+						record->string + (uintn)arg);
+			break;
+		default:
+			value_length = 0;
+			break;
+		}
+		if (value_length < 0) {
+			value_length = 0;
+		} else if ((uintn)value_length > sizeof(value) - 1) {
+			value_length = sizeof(value) - 1;
+		}
+		debug_ring_append(buffer, buffer_size, &length, value,
+				  value_length);
+	}
+	return length;
+}
+
+/**
+  Remove all the records from the ring buffer, and print them to stdout.
+
+  Each message is prefixed by its time stamp in microseconds and its thread.
+
+  @return The number of printed records.
+**/
+uintn debug_ring_flush(void)
+{
+	debug_ring_record_t record;
+	char8 buffer[MAX_DEBUG_MESSAGE_LENGTH];
+	uintn count;
+
+	count = 0;
+	while (debug_ring_read(&record)) {
+		debug_ring_format(&record, buffer, sizeof(buffer));
+		printf("[%llu.%06llu T%u] %s",
+		       (unsigned long long)(record.timestamp / 1000000000),
+		       (unsigned long long)(record.timestamp / 1000 % 1000000),
+		       record.thread_id, buffer);
+		count++;
+	}
+	fflush(stdout);
+	return count;
+}
+
+/**
+  Print the ring buffer when a crash signal is raised, then terminate with the default action.
+**/
+static void debug_ring_crash_handler(int signal_number)
+{
+	signal(signal_number, SIG_DFL);
+	printf("CRASH: signal %d\n", signal_number);
+	debug_ring_flush();
+	raise(signal_number);
+}
+
+/**
+  Register the handlers of SIGABRT, SIGFPE, SIGILL and SIGSEGV, to print the ring buffer on a crash.
+
+  The handlers print with stdio, which is not async-signal-safe, so the dump is best effort.
+  They replace the handlers registered by the application for these signals.
+**/
+void debug_ring_register_crash_dump(void)
+{
+	signal(SIGABRT, debug_ring_crash_handler);
+	signal(SIGFPE, debug_ring_crash_handler);
+	signal(SIGILL, debug_ring_crash_handler);
+	signal(SIGSEGV, debug_ring_crash_handler);
+}
+
+void debug_assert(IN const char8 *file_name, IN uintn line_number,
+		  IN const char8 *description)
+{
+	debug_ring_flush();
+	printf("ASSERT: %s(%d): %s\n", file_name, (int32)(uint32)line_number,
+	       description);
+
+#if (DEBUG_ASSERT_CONFIG == DEBUG_ASSERT_DEADLOOP)
+	{
+		volatile intn ___i = 1;
+		while (___i)
+			;
+	}
+#elif (DEBUG_ASSERT_CONFIG == DEBUG_ASSERT_BREAKPOINT)
+#if defined(_MSC_EXTENSIONS)
+	__debugbreak();
+#endif
+#if defined(__GNUC__)
+	__asm__ __volatile__("int $3");
+#endif
+#endif
+
+	assert(FALSE);
+}
+
+void debug_print(IN uintn error_level, IN const char8 *format, ...)
+{
+	debug_ring_record_t *record;
+	uintn position;
+	va_list marker;
+
+	if ((error_level & m_debug_print_error_level) == 0) {
+		return;
+	}
+
+	if (m_debug_ring_thread_id == 0) {
+		m_debug_ring_thread_id = (uint32)debug_ring_atomic_increment(
+			&m_debug_ring_thread_count);
+	}
+
+	record = debug_ring_reserve(&position);
+	if (record == NULL) {
+		debug_ring_atomic_increment(&m_debug_ring_dropped_count);
+		return;
+	}
+	record->timestamp = debug_ring_get_time_ns();
+	record->sequence = position;
+	record->thread_id = m_debug_ring_thread_id;
+	record->error_level = error_level;
+	record->format = format;
+
+	va_start(marker, format);
+	debug_ring_capture_arguments(record, marker);
+	va_end(marker);
+
+	debug_ring_set_sequence(position, position + 1);
+}
+
+boolean debug_print_level_enabled(IN uintn error_level)
+{
+	return (boolean)((error_level & m_debug_print_error_level) != 0);
+}
+
+uintn get_debug_print_error_level(void)
+{
+	return m_debug_print_error_level;
+}
+
+void set_debug_print_error_level(IN uintn error_level)
+{
+	m_debug_print_error_level = error_level;
+}
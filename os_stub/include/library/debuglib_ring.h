@@ -0,0 +1,108 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  Provides the services of the ring buffer debug library.
+
+  The ring buffer debug library implements debuglib without formatting or printing in debug_print().
+  debug_print() writes a binary record with the format pointer, the arguments, the thread and a time stamp
+  to a lock-free ring buffer shared by all threads. The records are formatted and printed later by
+  debug_ring_flush(), for example from a background thread of the application, at exit, or on a crash.
+  debug_assert() flushes the ring buffer before printing the assert message, and
+  debug_ring_register_crash_dump() lets the crash signals flush it too.
+
+  When the ring buffer is full, the oldest record is overwritten, so that the ring buffer always keeps
+  the latest messages for a crash dump. debug_print() never waits for another thread: if the oldest
+  record is still being written or read by another thread, the new message is dropped and counted.
+
+  The format must be a string literal, as in the DEBUG macro, because only its pointer is recorded.
+  The %s arguments are copied into the record, truncated to DEBUG_RING_RECORD_STRING_SIZE in total.
+**/
+
+#ifndef __DEBUG_RING_LIB_H__
+#define __DEBUG_RING_LIB_H__
+
+#ifndef DEBUG_RING_RECORD_COUNT
+// The number of records of the ring buffer. It must be a power of 2.
+#define DEBUG_RING_RECORD_COUNT 1024
+#endif
+
+#define DEBUG_RING_RECORD_ARG_COUNT 8
+#define DEBUG_RING_RECORD_STRING_SIZE 128
+
+typedef struct {
+	// Monotonic time stamp in nanoseconds.
+	uint64 timestamp;
+	// Sequence number of the record, to detect the overwritten records.
+	uint64 sequence;
+	// Small integer identifying the thread calling debug_print(), starting from 1.
+	uint32 thread_id;
+	// The number of arguments used in arg.
+	uint32 arg_count;
+	uintn error_level;
+	const char8 *format;
+	// The arguments of the format. A %s argument is the offset of the string copied in string.
+	uint64 arg[DEBUG_RING_RECORD_ARG_COUNT];
+	char8 string[DEBUG_RING_RECORD_STRING_SIZE];
+} debug_ring_record_t;
+
+/**
+  Remove the oldest record from the ring buffer.
+
+  It may be called from any thread.
+
+  @param  record                        The record removed from the ring buffer.
+
+  @retval TRUE   A record is removed.
+  @retval FALSE  The ring buffer is empty.
+**/
+boolean debug_ring_read(OUT debug_ring_record_t *record);
+
+/**
+  Format a record of the ring buffer as the message printed by debug_print().
+
+  @param  record                        The record.
+  @param  buffer                        The buffer of the message.
+  @param  buffer_size                   The size in bytes of the buffer.
+
+  @return The length of the message, truncated to buffer_size - 1.
+**/
+uintn debug_ring_format(IN const debug_ring_record_t *record,
+			OUT char8 *buffer, IN uintn buffer_size);
+
+/**
+  Remove all the records from the ring buffer, and print them to stdout.
+
+  Each message is prefixed by its time stamp in microseconds and its thread.
+
+  @return The number of printed records.
+**/
+uintn debug_ring_flush(void);
+
+/**
+  Return the number of records overwritten before they are read.
+
+  @return The number of records overwritten before they are read.
+**/
+uint64 debug_ring_get_overwritten_count(void);
+
+/**
+  Return the number of messages dropped by debug_print() because the ring buffer is full and
+  its oldest record is in use by another thread.
+
+  @return The number of dropped messages.
+**/
+uint64 debug_ring_get_dropped_count(void);
+
+/**
+  Register the handlers of SIGABRT, SIGFPE, SIGILL and SIGSEGV, to print the ring buffer on a crash.
+
+  The handlers print with stdio, which is not async-signal-safe, so the dump is best effort.
+  They replace the handlers registered by the application for these signals.
+**/
+void debug_ring_register_crash_dump(void);
+
+#endif // __DEBUG_RING_LIB_H__
@@ -0,0 +1,47 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+/** @file
+  Provides the statistics of the instrumented memory allocation library.
+
+  The instrumented memory allocation library implements malloclib on top of malloc() and free(),
+  and keeps a header with the size in front of each buffer, so that free_pool() knows the size
+  of the freed buffer. It counts the allocations, their total size, and the current and peak size
+  of the buffers not freed yet, so that a tool can measure the heap used by an SPDM flow.
+
+  The statistics are not protected by a lock. The library is intended for single-threaded tools.
+**/
+
+#ifndef __MALLOC_STAT_LIB_H__
+#define __MALLOC_STAT_LIB_H__
+
+typedef struct {
+	// The number of successful allocations.
+	uint64 allocation_count;
+	// The total size in bytes of the successful allocations.
+	uint64 total_size;
+	// The size in bytes of the buffers not freed yet.
+	uintn current_size;
+	// The highest current_size since the last malloc_stat_reset_peak().
+	uintn peak_size;
+} malloc_stat_t;
+
+/**
+  Get the statistics of the memory allocation library.
+
+  allocation_count and total_size only increase, so the allocations of an operation are
+  the difference of the statistics before and after it.
+
+  @param  stat                          The statistics.
+**/
+void malloc_stat_get(OUT malloc_stat_t *stat);
+
+/**
+  Set the peak size to the current size, to measure the peak of the following operation.
+**/
+void malloc_stat_reset_peak(void);
+
+#endif // __MALLOC_STAT_LIB_H__
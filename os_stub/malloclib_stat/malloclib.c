@@ -0,0 +1,84 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <base.h>
+#include <library/malloclib_stat.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+//
+// The header in front of each buffer. It is 16 bytes, to keep the alignment of malloc().
+//
+typedef struct {
+	uint64 size;
+	uint64 reserved;
+} malloc_stat_header_t;
+
+malloc_stat_t m_malloc_stat;
+
+void *allocate_pool(IN uintn AllocationSize)
+{
+	malloc_stat_header_t *header;
+
+	if (AllocationSize > (uintn)-1 - sizeof(malloc_stat_header_t)) {
+		return NULL;
+	}
+	header = malloc(sizeof(malloc_stat_header_t) + AllocationSize);
+	if (header == NULL) {
+		return NULL;
+	}
+	header->size = AllocationSize;
+
+	m_malloc_stat.allocation_count++;
+	m_malloc_stat.total_size += AllocationSize;
+	m_malloc_stat.current_size += AllocationSize;
+	if (m_malloc_stat.current_size > m_malloc_stat.peak_size) {
+		m_malloc_stat.peak_size = m_malloc_stat.current_size;
+	}
+	return header + 1;
+}
+
+void *allocate_zero_pool(IN uintn AllocationSize)
+{
+	void *buffer;
+	buffer = allocate_pool(AllocationSize);
+	if (buffer == NULL) {
+		return NULL;
+	}
+	memset(buffer, 0, AllocationSize);
+	return buffer;
+}
+
+void free_pool(IN void *buffer)
+{
+	malloc_stat_header_t *header;
+
+	if (buffer == NULL) {
+		return;
+	}
+	header = (malloc_stat_header_t *)buffer - 1;
+	m_malloc_stat.current_size -= (uintn)header->size;
+	free(header);
+}
+
+/**
+  Get the statistics of the memory allocation library.
+
+  @param  stat                          The statistics.
+**/
+void malloc_stat_get(OUT malloc_stat_t *stat)
+{
+	*stat = m_malloc_stat;
+}
+
+/**
+  Set the peak size to the current size, to measure the peak of the following operation.
+**/
+void malloc_stat_reset_peak(void)
+{
+	m_malloc_stat.peak_size = m_malloc_stat.current_size;
+}
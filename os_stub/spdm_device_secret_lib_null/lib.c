@@ -38,6 +38,16 @@ return_status spdm_measurement_collection(
 	return RETURN_UNSUPPORTED;
 }
 
+/**
+  Return the device measurement generation.
+
+  @return the current measurement generation. 0 means unknown.
+**/
+uint32 spdm_measurement_generation(void)
+{
+	return 0;
+}
+
 /**
   Sign an SPDM message data.
 
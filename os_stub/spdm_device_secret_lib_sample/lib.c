@@ -95,6 +95,262 @@ boolean read_requester_private_certificate(IN uint16 req_base_asym_alg,
 	return res;
 }
 
+//
+// Measurement provider context.
+// Each block is measured from a (possibly memory mapped) region. The digest is
+// calculated on first request and cached until the block is invalidated.
+//
+static spdm_measurement_provider_context_t m_measurement_provider_context;
+
+/**
+  Set up the default measurement regions on first use.
+
+  In this example, the regions are filled with repeating values of 1 for
+  measurement index 1, repeating values of 2 for measurement index 2, and so on.
+
+  @param  context                      A pointer to the measurement provider context.
+
+  @return the measurement provider context.
+**/
+static spdm_measurement_provider_context_t *
+spdm_measurement_init(IN OUT spdm_measurement_provider_context_t *context)
+{
+	uint8 index;
+
+	if (context->initialized) {
+		return context;
+	}
+	for (index = 0; index < MEASUREMENT_BLOCK_NUMBER; index++) {
+		set_mem(context->data[index], MEASUREMENT_MANIFEST_SIZE,
+			(uint8)(index + 1));
+		context->block[index].region = context->data[index];
+		context->block[index].region_size = MEASUREMENT_MANIFEST_SIZE;
+		context->block[index].hash_algo = 0;
+	}
+	context->generation = 1;
+	context->initialized = TRUE;
+	return context;
+}
+
+/**
+  Return the base hash algorithm which implements a measurement hash algorithm.
+
+  @param  measurement_hash_algo          Indicates the measurement hash algorithm.
+
+  @return the base hash algorithm, or 0 if it is not supported.
+**/
+static uint32 spdm_measurement_get_base_hash_algo(IN uint32 measurement_hash_algo)
+{
+	switch (measurement_hash_algo) {
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256:
+		return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384:
+		return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384;
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512:
+		return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512;
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_256:
+		return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256;
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_384:
+		return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384;
+	case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_512:
+		return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512;
+	}
+	return 0;
+}
+
+/**
+  Hash a measurement region as a stream, MEASUREMENT_STREAM_CHUNK_SIZE bytes at a time,
+  so that a large memory mapped region never needs to be copied.
+
+  @param  measurement_hash_algo          Indicates the measurement hash algorithm.
+  @param  region                       A pointer to the measured region.
+  @param  region_size                   The size in bytes of the measured region.
+  @param  hash_value                    A pointer to a destination buffer to store the digest.
+
+  @retval TRUE  the region is hashed.
+  @retval FALSE the region is not hashed.
+**/
+static boolean spdm_measurement_hash_region(IN uint32 measurement_hash_algo,
+					    IN const uint8 *region,
+					    IN uintn region_size,
+					    OUT uint8 *hash_value)
+{
+	uint32 base_hash_algo;
+	void *hash_context;
+	uintn offset;
+	uintn chunk_size;
+	boolean result;
+
+	base_hash_algo = spdm_measurement_get_base_hash_algo(measurement_hash_algo);
+	if (base_hash_algo == 0) {
+		return FALSE;
+	}
+	hash_context = spdm_hash_new(base_hash_algo);
+	if (hash_context == NULL) {
+		return FALSE;
+	}
+	result = spdm_hash_init(base_hash_algo, hash_context);
+	for (offset = 0; result && (offset < region_size); offset += chunk_size) {
+		chunk_size = region_size - offset;
+		if (chunk_size > MEASUREMENT_STREAM_CHUNK_SIZE) {
+			chunk_size = MEASUREMENT_STREAM_CHUNK_SIZE;
+		}
+		result = spdm_hash_update(base_hash_algo, hash_context,
+					  region + offset, chunk_size);
+	}
+	if (result) {
+		result = spdm_hash_final(base_hash_algo, hash_context, hash_value);
+	}
+	spdm_hash_free(base_hash_algo, hash_context);
+	return result;
+}
+
+/**
+  Build one measurement block.
+
+  The first N-1 blocks may be hash values, while the last one is always a raw bitstream.
+  The digest of a block is calculated on first request and then reused.
+
+  @param  context                      A pointer to the measurement provider context.
+  @param  measurement_hash_algo          Indicates the measurement hash algorithm.
+  @param  measurement_index             The index of the measurement block, 1 based.
+  @param  measurement_block             A pointer to a destination buffer to store the measurement block.
+  @param  measurement_block_size         On input, indicates the size in bytes of the destination buffer.
+                                       On output, indicates the size in bytes of the measurement block.
+
+  @retval RETURN_SUCCESS             The measurement block is built.
+  @retval RETURN_BUFFER_TOO_SMALL    The destination buffer is too small.
+  @retval RETURN_DEVICE_ERROR        The measurement cannot be hashed.
+**/
+static return_status spdm_measurement_build_block(
+	IN OUT spdm_measurement_provider_context_t *context,
+	IN uint32 measurement_hash_algo, IN uint8 measurement_index,
+	OUT spdm_measurement_block_dmtf_t *measurement_block,
+	IN OUT uintn *measurement_block_size)
+{
+	spdm_measurement_block_source_t *source;
+	uintn hash_size;
+	uintn value_size;
+	boolean is_hash;
+
+	source = &context->block[measurement_index - 1];
+	is_hash = (measurement_index < MEASUREMENT_BLOCK_NUMBER) &&
+		  (measurement_hash_algo !=
+		   SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY);
+	if (is_hash) {
+		hash_size = spdm_get_measurement_hash_size(measurement_hash_algo);
+		ASSERT(hash_size != 0);
+		value_size = hash_size;
+	} else {
+		hash_size = 0;
+		value_size = source->region_size;
+	}
+	if (sizeof(spdm_measurement_block_dmtf_header_t) + value_size > 0xFFFF) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	if (sizeof(spdm_measurement_block_dmtf_t) + value_size >
+	    *measurement_block_size) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+
+	measurement_block->Measurement_block_common_header.index =
+		measurement_index;
+	measurement_block->Measurement_block_common_header
+		.measurement_specification =
+		SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+	measurement_block->Measurement_block_dmtf_header
+		.dmtf_spec_measurement_value_type = measurement_index - 1;
+	if (!is_hash) {
+		measurement_block->Measurement_block_dmtf_header
+			.dmtf_spec_measurement_value_type |=
+			SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM;
+	}
+	measurement_block->Measurement_block_dmtf_header
+		.dmtf_spec_measurement_value_size = (uint16)value_size;
+	measurement_block->Measurement_block_common_header.measurement_size =
+		(uint16)(sizeof(spdm_measurement_block_dmtf_header_t) +
+			 value_size);
+
+	if (is_hash) {
+		if (source->hash_algo != measurement_hash_algo) {
+			source->hash_algo = 0;
+			if (!spdm_measurement_hash_region(measurement_hash_algo,
+							  source->region,
+							  source->region_size,
+							  source->hash)) {
+				return RETURN_DEVICE_ERROR;
+			}
+			source->hash_algo = measurement_hash_algo;
+		}
+		copy_mem((void *)(measurement_block + 1), source->hash,
+			 hash_size);
+	} else {
+		copy_mem((void *)(measurement_block + 1), source->region,
+			 value_size);
+	}
+
+	*measurement_block_size = sizeof(spdm_measurement_block_dmtf_t) +
+				  value_size;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Set the region measured by a measurement block.
+
+  The region may be a memory mapped firmware region. It is not copied, and must
+  remain valid until it is replaced. The cached digest of the block is dropped.
+
+  @param  measurement_index             The index of the measurement block, 1 based.
+  @param  region                       A pointer to the measured region.
+  @param  region_size                   The size in bytes of the measured region.
+
+  @retval RETURN_SUCCESS             The region is set.
+  @retval RETURN_INVALID_PARAMETER   The index or the region is invalid.
+**/
+return_status spdm_measurement_set_region(IN uint8 measurement_index,
+					  IN const void *region,
+					  IN uintn region_size)
+{
+	spdm_measurement_provider_context_t *context;
+
+	if ((measurement_index == 0) ||
+	    (measurement_index > MEASUREMENT_BLOCK_NUMBER) ||
+	    (region == NULL) || (region_size == 0)) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	context = spdm_measurement_init(&m_measurement_provider_context);
+	context->block[measurement_index - 1].region = region;
+	context->block[measurement_index - 1].region_size = region_size;
+	spdm_measurement_invalidate(measurement_index);
+	return RETURN_SUCCESS;
+}
+
+/**
+  Invalidate the cached digest of a measurement block, after the measured
+  component is updated. The measurement generation is advanced.
+
+  @param  measurement_index             The index of the measurement block, 1 based.
+                                       0xFF invalidates all blocks.
+**/
+void spdm_measurement_invalidate(IN uint8 measurement_index)
+{
+	spdm_measurement_provider_context_t *context;
+	uint8 index;
+
+	context = spdm_measurement_init(&m_measurement_provider_context);
+	for (index = 1; index <= MEASUREMENT_BLOCK_NUMBER; index++) {
+		if ((measurement_index == index) ||
+		    (measurement_index ==
+		     SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS)) {
+			context->block[index - 1].hash_algo = 0;
+		}
+	}
+	context->generation++;
+	if (context->generation == 0) {
+		context->generation = 1;
+	}
+}
+
 /**
   Collect the device measurement.
 
@@ -124,6 +380,8 @@ boolean read_requester_private_certificate(IN uint16 req_base_asym_alg,
   If a hash is requested, the first 4 buffers will be hashed and the hash
   values will be returned for those measurements. The 5 buffer is always a raw
   bitstream and returned as such.
+  Only the requested blocks are built, and the digest of each block is cached
+  until spdm_measurement_set_region() or spdm_measurement_invalidate() is called.
 **/
 
 return_status spdm_measurement_collection(
@@ -135,11 +393,12 @@ return_status spdm_measurement_collection(
 				    OUT void *measurements,
 				    IN OUT uintn *measurements_size)
 {
-	spdm_measurement_block_dmtf_t *measurement_block;
-	uintn hash_size;
+	spdm_measurement_provider_context_t *context;
+	uint8 *measurement_block;
+	uintn measurement_block_size;
+	uintn total_size;
 	uint8 index;
-	uint8 data[MEASUREMENT_MANIFEST_SIZE];
-	uintn total_size_needed;
+	return_status status;
 
 	ASSERT(measurement_specification ==
 	       SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF);
@@ -149,8 +408,9 @@ return_status spdm_measurement_collection(
 		return RETURN_INVALID_PARAMETER;
 	}
 
-	hash_size = spdm_get_measurement_hash_size(measurement_hash_algo);
-	ASSERT(hash_size != 0);
+	ASSERT(spdm_get_measurement_hash_size(measurement_hash_algo) != 0);
+
+	context = spdm_measurement_init(&m_measurement_provider_context);
 
 	if (measurements_index ==
 		SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
@@ -158,92 +418,24 @@ return_status spdm_measurement_collection(
 		return RETURN_SUCCESS;
 	} else if (measurements_index ==
 			SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
-
-		// Calculate total_size_needed based on hash algo selected.
-		// If we have an hash algo, then the first N-1 elements will be
-		// hash values, otherwise N-1 raw bitstream values.
-		// Last one (N) is always raw bitstream data.
-		if (measurement_hash_algo
-			!= SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY) {
-			total_size_needed = // N-1 hash_size + 1 raw data
-				(MEASUREMENT_BLOCK_NUMBER - 1) *
-					(sizeof(spdm_measurement_block_dmtf_t) + hash_size) +
-				(sizeof(spdm_measurement_block_dmtf_t) + sizeof(data));
-		} else {
-			total_size_needed = // All N items raw data
-				(MEASUREMENT_BLOCK_NUMBER *
-				 (sizeof(spdm_measurement_block_dmtf_t) +
-				  sizeof(data)));
-		}
-		ASSERT(total_size_needed <= *measurements_size);
-		if (total_size_needed > *measurements_size) {
-			return RETURN_BUFFER_TOO_SMALL;
-		}
-
-		*measurements_size = total_size_needed;
-		*measurements_count = MEASUREMENT_BLOCK_NUMBER;
 		measurement_block = measurements;
-
+		total_size = 0;
 		for (index = 1; index <= MEASUREMENT_BLOCK_NUMBER; index++) {
-			measurement_block->Measurement_block_common_header
-				.index = index;
-			measurement_block->Measurement_block_common_header
-				.measurement_specification =
-				SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
-
-			set_mem(data, sizeof(data), (uint8)(index + 1));
-
-			// The first N-1 blocks may be hash values,
-			// while the last one is always a raw bitstream.
-			if ((index < MEASUREMENT_BLOCK_NUMBER) &&
-			    measurement_hash_algo !=
-				    SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY) {
-				measurement_block->Measurement_block_dmtf_header
-					.dmtf_spec_measurement_value_type =
-					(index - 1);
-				measurement_block->Measurement_block_dmtf_header
-					.dmtf_spec_measurement_value_size =
-					(uint16)hash_size;
-
-				measurement_block->Measurement_block_common_header
-					.measurement_size =
-					(uint16)(sizeof(spdm_measurement_block_dmtf_header_t) +
-						 (uint16)hash_size);
-
-				spdm_measurement_hash_all(
-					measurement_hash_algo, data,
-					sizeof(data),
-					(void *)(measurement_block + 1));
-
-				measurement_block =
-					(void *)((uint8 *)measurement_block +
-						 sizeof(spdm_measurement_block_dmtf_t) +
-						 hash_size);
-
-			} else {
-				measurement_block->Measurement_block_dmtf_header
-					.dmtf_spec_measurement_value_type =
-					(index - 1) |
-					SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM;
-				measurement_block->Measurement_block_dmtf_header
-					.dmtf_spec_measurement_value_size =
-					(uint16)sizeof(data);
-
-				measurement_block->Measurement_block_common_header
-					.measurement_size =
-					(uint16)(sizeof(spdm_measurement_block_dmtf_header_t) +
-						 (uint16)sizeof(data));
-
-				copy_mem((void *)(measurement_block + 1), data, sizeof(data));
-
-				measurement_block =
-					(void *)((uint8 *)measurement_block +
-						 sizeof(spdm_measurement_block_dmtf_t) +
-						 sizeof(data));
-
+			measurement_block_size = *measurements_size - total_size;
+			status = spdm_measurement_build_block(
+				context, measurement_hash_algo, index,
+				(void *)measurement_block,
+				&measurement_block_size);
+			ASSERT_RETURN_ERROR(status);
+			if (RETURN_ERROR(status)) {
+				return status;
 			}
+			measurement_block += measurement_block_size;
+			total_size += measurement_block_size;
 		}
 
+		*measurements_size = total_size;
+		*measurements_count = MEASUREMENT_BLOCK_NUMBER;
 		return RETURN_SUCCESS;
 	} else {
 		if (measurements_index > MEASUREMENT_BLOCK_NUMBER) {
@@ -251,76 +443,39 @@ return_status spdm_measurement_collection(
 			return RETURN_NOT_FOUND;
 		}
 
-		if (measurements_index < MEASUREMENT_BLOCK_NUMBER &&
-		    measurement_hash_algo !=
-			    SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY) {
-			total_size_needed =
-				sizeof(spdm_measurement_block_dmtf_t) +
-				hash_size;
-		} else {
-			total_size_needed =
-				sizeof(spdm_measurement_block_dmtf_t) +
-				sizeof(data);
-		}
-		ASSERT(total_size_needed <= *measurements_size);
-		if (total_size_needed > *measurements_size) {
-			return RETURN_BUFFER_TOO_SMALL;
+		measurement_block_size = *measurements_size;
+		status = spdm_measurement_build_block(context,
+						      measurement_hash_algo,
+						      measurements_index,
+						      measurements,
+						      &measurement_block_size);
+		ASSERT_RETURN_ERROR(status);
+		if (RETURN_ERROR(status)) {
+			return status;
 		}
 
-		set_mem(data, sizeof(data), (uint8)(measurements_index));
-
 		*measurements_count = 1;
-		*measurements_size = total_size_needed;
-
-		measurement_block = measurements;
-
-		measurement_block->Measurement_block_common_header.index =
-			measurements_index;
-
-		measurement_block->Measurement_block_common_header
-			.measurement_specification =
-			SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
-
-		if (measurements_index < MEASUREMENT_BLOCK_NUMBER &&
-		    measurement_hash_algo !=
-			    SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY) {
-			measurement_block->Measurement_block_dmtf_header
-				.dmtf_spec_measurement_value_type =
-				measurements_index - 1;
-			measurement_block->Measurement_block_dmtf_header
-				.dmtf_spec_measurement_value_size =
-				(uint16)hash_size;
-			measurement_block->Measurement_block_common_header
-				.measurement_size =
-				(uint16)(sizeof(spdm_measurement_block_dmtf_header_t) +
-					 (uint16)hash_size);
-
-			// Hash directly to buffer after measurement block.
-			spdm_measurement_hash_all(
-				measurement_hash_algo, data, sizeof(data),
-				(void *)(measurement_block + 1));
-
-		} else {
-			measurement_block->Measurement_block_dmtf_header
-				.dmtf_spec_measurement_value_type =
-				(measurements_index - 1) |
-				SPDM_MEASUREMENT_BLOCK_MEASUREMENT_TYPE_RAW_BIT_STREAM;
-			measurement_block->Measurement_block_dmtf_header
-				.dmtf_spec_measurement_value_size =
-				(uint16)sizeof(data);
-
-			measurement_block->Measurement_block_common_header
-				.measurement_size =
-				(uint16)(sizeof(spdm_measurement_block_dmtf_header_t) +
-					 (uint16)sizeof(data));
-
-			copy_mem((void *)(measurement_block + 1), data,
-				 sizeof(data));
-		}
+		*measurements_size = measurement_block_size;
 	}
 	return RETURN_SUCCESS;
 }
 
+/**
+  Return the device measurement generation.
+
+  Please see a more detailed description of this function in spdm_device_secret_lib.h
+
+  In this example, the generation is advanced whenever a measurement block is
+  invalidated or its measured region is replaced.
+
+  @return the current measurement generation.
+**/
+uint32 spdm_measurement_generation(void)
+{
+	return spdm_measurement_init(&m_measurement_provider_context)
+		->generation;
+}
+
 /**
   Sign an SPDM message data.
 
@@ -16,6 +16,8 @@
 
 #define MEASUREMENT_BLOCK_NUMBER 5
 #define MEASUREMENT_MANIFEST_SIZE 128
+// Measured regions are hashed in chunks of this size.
+#define MEASUREMENT_STREAM_CHUNK_SIZE 0x1000
 
 #define TEST_PSK_DATA_STRING "TestPskData"
 #define TEST_PSK_HINT_STRING "TestPskHint"
@@ -58,6 +60,33 @@ boolean read_responder_root_public_certificate_by_size(
 	OUT void **data, OUT uintn *size, OUT void **hash,
 	OUT uintn *hash_size);
 
+//
+// Measurement provider
+//
+typedef struct {
+	// Measured region, may be memory mapped.
+	const uint8 *region;
+	uintn region_size;
+	// Measurement hash algo of the cached digest, 0 if no digest is cached.
+	uint32 hash_algo;
+	uint8 hash[MAX_HASH_SIZE];
+} spdm_measurement_block_source_t;
+
+typedef struct {
+	boolean initialized;
+	// Advanced whenever a block is invalidated, never 0 once initialized.
+	uint32 generation;
+	spdm_measurement_block_source_t block[MEASUREMENT_BLOCK_NUMBER];
+	// Default measured regions.
+	uint8 data[MEASUREMENT_BLOCK_NUMBER][MEASUREMENT_MANIFEST_SIZE];
+} spdm_measurement_provider_context_t;
+
+return_status spdm_measurement_set_region(IN uint8 measurement_index,
+					  IN const void *region,
+					  IN uintn region_size);
+
+void spdm_measurement_invalidate(IN uint8 measurement_index);
+
 //
 // External
 //
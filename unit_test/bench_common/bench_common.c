@@ -0,0 +1,319 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "bench_common.h"
+
+#include <time.h>
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+void bench_print_usage(IN char *tool_name)
+{
+	printf("Usage: %s [-n <iterations>] [-o <file>] [-f <filter>]\n",
+	       tool_name);
+	printf("  -n <iterations>   Number of timed iterations of each benchmark (default %d).\n",
+	       BENCH_DEFAULT_ITERATIONS);
+	printf("  -o <file>         Write the JSON report to file, \"-\" for stdout (default <tool>.json).\n");
+	printf("  -f <filter>       Only run the benchmarks whose name contains filter.\n");
+}
+
+/**
+  Parse the command line shared by the benchmark tools.
+
+  @param  argc                          The number of arguments.
+  @param  argv                          The arguments.
+  @param  options                       The parsed options.
+
+  @retval TRUE   The command line is valid.
+  @retval FALSE  The command line is invalid. The usage is printed.
+**/
+boolean bench_parse_arguments(IN int argc, IN char **argv,
+			      OUT bench_options_t *options)
+{
+	int index;
+
+	options->iterations = BENCH_DEFAULT_ITERATIONS;
+	options->output_file = NULL;
+	options->filter = NULL;
+
+	for (index = 1; index < argc; index++) {
+		if (index + 1 >= argc) {
+			bench_print_usage(argv[0]);
+			return FALSE;
+		}
+		if (strcmp(argv[index], "-n") == 0) {
+			options->iterations = (uintn)strtoul(argv[index + 1], NULL, 0);
+			if (options->iterations == 0) {
+				bench_print_usage(argv[0]);
+				return FALSE;
+			}
+		} else if (strcmp(argv[index], "-o") == 0) {
+			options->output_file = argv[index + 1];
+		} else if (strcmp(argv[index], "-f") == 0) {
+			options->filter = argv[index + 1];
+		} else {
+			bench_print_usage(argv[0]);
+			return FALSE;
+		}
+		index++;
+	}
+	return TRUE;
+}
+
+/**
+  Return whether a benchmark is selected by the filter of the command line.
+
+  @param  options                       The parsed options.
+  @param  name                          The benchmark name.
+**/
+boolean bench_is_selected(IN bench_options_t *options, IN const char8 *name)
+{
+	if (options->filter == NULL) {
+		return TRUE;
+	}
+	return (boolean)(strstr(name, options->filter) != NULL);
+}
+
+/**
+  Return a monotonic time stamp in nanoseconds.
+**/
+uint64 bench_get_time_ns(void)
+{
+	struct timespec time_spec;
+
+#ifdef _MSC_VER
+	timespec_get(&time_spec, TIME_UTC);
+#else
+	clock_gettime(CLOCK_MONOTONIC, &time_spec);
+#endif
+	return (uint64)time_spec.tv_sec * 1000000000 + (uint64)time_spec.tv_nsec;
+}
+
+/**
+  Return the CPU time stamp counter, or 0 if it is not available on this architecture.
+**/
+uint64 bench_get_cycles(void)
+{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	return (uint64)__rdtsc();
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+	return (uint64)__builtin_ia32_rdtsc();
+#else
+	return 0;
+#endif
+}
+
+int bench_compare_sample(IN const void *sample1, IN const void *sample2)
+{
+	uint64 value1;
+	uint64 value2;
+
+	value1 = *(const uint64 *)sample1;
+	value2 = *(const uint64 *)sample2;
+	if (value1 < value2) {
+		return -1;
+	}
+	if (value1 > value2) {
+		return 1;
+	}
+	return 0;
+}
+
+/**
+  Return the nearest-rank percentile of sorted samples.
+**/
+uint64 bench_get_percentile(IN uint64 *sample, IN uintn count,
+			    IN uintn percentile)
+{
+	uintn rank;
+
+	rank = (count * percentile + 99) / 100;
+	if (rank == 0) {
+		rank = 1;
+	}
+	return sample[rank - 1];
+}
+
+/**
+  Compute the statistics of the samples of a benchmark.
+
+  @param  sample                        The latency of each iteration in nanoseconds. It is sorted on return.
+  @param  count                         The number of samples.
+  @param  statistics                    The statistics.
+**/
+void bench_compute_statistics(IN OUT uint64 *sample, IN uintn count,
+			      OUT bench_statistics_t *statistics)
+{
+	uintn index;
+
+	zero_mem(statistics, sizeof(bench_statistics_t));
+	statistics->count = count;
+	if (count == 0) {
+		return;
+	}
+
+	qsort(sample, count, sizeof(uint64), bench_compare_sample);
+	for (index = 0; index < count; index++) {
+		statistics->total += sample[index];
+	}
+	statistics->min = sample[0];
+	statistics->max = sample[count - 1];
+	statistics->p50 = bench_get_percentile(sample, count, 50);
+	statistics->p99 = bench_get_percentile(sample, count, 99);
+	if (statistics->total != 0) {
+		statistics->ops_per_second =
+			(uint64)count * 1000000000 / statistics->total;
+	}
+}
+
+/**
+  Open the JSON report of a benchmark tool.
+
+  The report is written to a file by default, because the sample device secret library
+  and the os_stub libraries may print to stdout.
+
+  @param  report                        The report.
+  @param  options                       The parsed options.
+  @param  tool_name                     The name of the benchmark tool.
+
+  @retval TRUE   The report is opened.
+  @retval FALSE  The report file cannot be created.
+**/
+boolean bench_report_open(OUT bench_report_t *report,
+			  IN bench_options_t *options,
+			  IN const char8 *tool_name)
+{
+	char8 file_name[256];
+
+	report->result_count = 0;
+	if ((options->output_file != NULL) &&
+	    (strcmp(options->output_file, "-") == 0)) {
+		report->file = stdout;
+	} else {
+		if (options->output_file != NULL) {
+			snprintf(file_name, sizeof(file_name), "%s",
+				 options->output_file);
+		} else {
+			snprintf(file_name, sizeof(file_name), "%s.json",
+				 tool_name);
+		}
+		report->file = fopen(file_name, "w");
+		if (report->file == NULL) {
+			printf("Unable to create file %s\n", file_name);
+			return FALSE;
+		}
+	}
+
+	fprintf(report->file, "{\n");
+	fprintf(report->file, "  \"tool\": \"%s\",\n", tool_name);
+	fprintf(report->file, "  \"crypto\": \"%s\",\n", BENCH_CRYPTO_NAME);
+	fprintf(report->file, "  \"iterations\": %llu,\n",
+		(unsigned long long)options->iterations);
+	fprintf(report->file, "  \"results\": [");
+	return TRUE;
+}
+
+/**
+  Add the result of a benchmark to the JSON report.
+
+  The latencies are reported in nanoseconds.
+  If the statistics have a size, the result also reports the size and the cycles per byte.
+
+  @param  report                        The report.
+  @param  name                          The benchmark configuration, such as the algorithms.
+  @param  operation                     The measured operation.
+  @param  status                        The status of the operation. The statistics cover the successful iterations.
+  @param  statistics                    The statistics.
+**/
+void bench_report_add_result(IN bench_report_t *report, IN const char8 *name,
+			     IN const char8 *operation,
+			     IN return_status status,
+			     IN bench_statistics_t *statistics)
+{
+	FILE *file;
+	uint64 centi_cycles_per_byte;
+
+	file = report->file;
+	fprintf(file, "%s\n    {", (report->result_count == 0) ? "" : ",");
+	fprintf(file, "\"name\": \"%s\", ", name);
+	fprintf(file, "\"operation\": \"%s\", ", operation);
+	fprintf(file, "\"status\": \"0x%llx\", ", (unsigned long long)status);
+	fprintf(file, "\"count\": %llu, ",
+		(unsigned long long)statistics->count);
+	fprintf(file, "\"min_ns\": %llu, ", (unsigned long long)statistics->min);
+	fprintf(file, "\"p50_ns\": %llu, ", (unsigned long long)statistics->p50);
+	fprintf(file, "\"p99_ns\": %llu, ", (unsigned long long)statistics->p99);
+	fprintf(file, "\"max_ns\": %llu, ", (unsigned long long)statistics->max);
+	fprintf(file, "\"ops_per_sec\": %llu",
+		(unsigned long long)statistics->ops_per_second);
+	if (statistics->size != 0) {
+		centi_cycles_per_byte = 0;
+		if (statistics->count != 0) {
+			centi_cycles_per_byte = statistics->cycles * 100 /
+						((uint64)statistics->count *
+						 statistics->size);
+		}
+		fprintf(file, ", \"size\": %llu, ",
+			(unsigned long long)statistics->size);
+		fprintf(file, "\"cycles_per_byte\": %llu.%02llu",
+			(unsigned long long)(centi_cycles_per_byte / 100),
+			(unsigned long long)(centi_cycles_per_byte % 100));
+	}
+	fprintf(file, "}");
+	fflush(file);
+	report->result_count++;
+}
+
+/**
+  Close the JSON report of a benchmark tool.
+
+  @param  report                        The report.
+**/
+void bench_report_close(IN bench_report_t *report)
+{
+	fprintf(report->file, "\n  ]\n}\n");
+	if (report->file != stdout) {
+		fclose(report->file);
+	}
+	report->file = NULL;
+}
+
+boolean read_input_file(IN char8 *file_name, OUT void **file_data,
+			OUT uintn *file_size)
+{
+	FILE *fp_in;
+	uintn temp_result;
+
+	if ((fp_in = fopen(file_name, "rb")) == NULL) {
+		printf("Unable to open file %s\n", file_name);
+		*file_data = NULL;
+		return FALSE;
+	}
+
+	fseek(fp_in, 0, SEEK_END);
+	*file_size = ftell(fp_in);
+
+	*file_data = (void *)malloc(*file_size);
+	if (NULL == *file_data) {
+		printf("No sufficient memory to allocate %s\n", file_name);
+		fclose(fp_in);
+		return FALSE;
+	}
+
+	fseek(fp_in, 0, SEEK_SET);
+	temp_result = fread(*file_data, 1, *file_size, fp_in);
+	if (temp_result != *file_size) {
+		printf("Read input file error %s", file_name);
+		free((void *)*file_data);
+		fclose(fp_in);
+		return FALSE;
+	}
+
+	fclose(fp_in);
+
+	return TRUE;
+}
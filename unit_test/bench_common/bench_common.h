@@ -0,0 +1,148 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#ifndef __BENCH_COMMON_H__
+#define __BENCH_COMMON_H__
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#undef NULL
+
+#include <hal/base.h>
+#include <hal/library/memlib.h>
+
+//
+// The crypto backend is selected at build time, one benchmark binary per backend.
+// The build passes its name as LIBSPDM_BENCH_CRYPTO, so that reports of different backends can be compared.
+//
+#define BENCH_STRINGIFY_VALUE(x) #x
+#define BENCH_STRINGIFY(x) BENCH_STRINGIFY_VALUE(x)
+#ifdef LIBSPDM_BENCH_CRYPTO
+#define BENCH_CRYPTO_NAME BENCH_STRINGIFY(LIBSPDM_BENCH_CRYPTO)
+#else
+#define BENCH_CRYPTO_NAME "unknown"
+#endif
+
+#define BENCH_DEFAULT_ITERATIONS 100
+
+typedef struct {
+	// Number of timed iterations of each benchmark.
+	uintn iterations;
+	// Report file, NULL for <tool>.json, "-" for stdout.
+	char8 *output_file;
+	// Only the benchmarks whose name contains the filter are run, NULL for all.
+	char8 *filter;
+} bench_options_t;
+
+typedef struct {
+	uintn count;
+	// Bytes processed by each iteration, 0 if the operation is not sized.
+	uintn size;
+	// Total cycle count of the iterations, 0 if no cycle counter is available.
+	uint64 cycles;
+	uint64 total;
+	uint64 min;
+	uint64 max;
+	uint64 p50;
+	uint64 p99;
+	uint64 ops_per_second;
+} bench_statistics_t;
+
+typedef struct {
+	FILE *file;
+	uintn result_count;
+} bench_report_t;
+
+/**
+  Parse the command line shared by the benchmark tools.
+
+    -n <iterations>   Number of timed iterations of each benchmark.
+    -o <file>         Write the JSON report to file, "-" for stdout. The default is <tool>.json.
+    -f <filter>       Only run the benchmarks whose name contains filter.
+
+  @param  argc                          The number of arguments.
+  @param  argv                          The arguments.
+  @param  options                       The parsed options.
+
+  @retval TRUE   The command line is valid.
+  @retval FALSE  The command line is invalid. The usage is printed.
+**/
+boolean bench_parse_arguments(IN int argc, IN char **argv,
+			      OUT bench_options_t *options);
+
+/**
+  Return whether a benchmark is selected by the filter of the command line.
+
+  @param  options                       The parsed options.
+  @param  name                          The benchmark name.
+**/
+boolean bench_is_selected(IN bench_options_t *options, IN const char8 *name);
+
+/**
+  Return a monotonic time stamp in nanoseconds.
+**/
+uint64 bench_get_time_ns(void);
+
+/**
+  Return the CPU time stamp counter, or 0 if it is not available on this architecture.
+**/
+uint64 bench_get_cycles(void);
+
+/**
+  Compute the statistics of the samples of a benchmark.
+
+  @param  sample                        The latency of each iteration in nanoseconds. It is sorted on return.
+  @param  count                         The number of samples.
+  @param  statistics                    The statistics.
+**/
+void bench_compute_statistics(IN OUT uint64 *sample, IN uintn count,
+			      OUT bench_statistics_t *statistics);
+
+/**
+  Open the JSON report of a benchmark tool.
+
+  @param  report                        The report.
+  @param  options                       The parsed options.
+  @param  tool_name                     The name of the benchmark tool.
+
+  @retval TRUE   The report is opened.
+  @retval FALSE  The report file cannot be created.
+**/
+boolean bench_report_open(OUT bench_report_t *report,
+			  IN bench_options_t *options,
+			  IN const char8 *tool_name);
+
+/**
+  Add the result of a benchmark to the JSON report.
+
+  If the statistics have a size, the result also reports the size and the cycles per byte.
+
+  @param  report                        The report.
+  @param  name                          The benchmark configuration, such as the algorithms.
+  @param  operation                     The measured operation.
+  @param  status                        The status of the operation. The statistics cover the successful iterations.
+  @param  statistics                    The statistics.
+**/
+void bench_report_add_result(IN bench_report_t *report, IN const char8 *name,
+			     IN const char8 *operation,
+			     IN return_status status,
+			     IN bench_statistics_t *statistics);
+
+/**
+  Close the JSON report of a benchmark tool.
+
+  @param  report                        The report.
+**/
+void bench_report_close(IN bench_report_t *report);
+
+boolean read_input_file(IN char8 *file_name, OUT void **file_data,
+			OUT uintn *file_size);
+
+#endif
@@ -0,0 +1,471 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "bench_spdm_common.h"
+
+void *m_bench_spdm_responder_engine;
+
+uint8 m_bench_spdm_requester_sender_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+uint8 m_bench_spdm_requester_receiver_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+uint8 m_bench_spdm_responder_sender_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+uint8 m_bench_spdm_responder_receiver_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+void dump_hex_str(IN uint8 *buffer, IN uintn buffer_size)
+{
+}
+
+boolean bench_spdm_init_responder_engine(void)
+{
+	m_bench_spdm_responder_engine =
+		(void *)malloc(libspdm_responder_engine_get_size());
+	if (m_bench_spdm_responder_engine == NULL) {
+		return FALSE;
+	}
+	libspdm_responder_engine_init(m_bench_spdm_responder_engine,
+				      test_loopback_responder_send_message,
+				      test_loopback_responder_receive_message);
+	return TRUE;
+}
+
+void bench_spdm_free_responder_engine(void)
+{
+	free(m_bench_spdm_responder_engine);
+	m_bench_spdm_responder_engine = NULL;
+}
+
+return_status bench_spdm_send_message(IN void *spdm_context,
+				      IN uintn request_size, IN void *request,
+				      IN uint64 timeout)
+{
+	return test_loopback_send_request(BENCH_SPDM_ENDPOINT_ID, request_size,
+					  request);
+}
+
+return_status bench_spdm_receive_message(IN void *spdm_context,
+					 IN OUT uintn *response_size,
+					 IN OUT void *response,
+					 IN uint64 timeout)
+{
+	return_status status;
+
+	status = libspdm_responder_engine_dispatch_message(
+		m_bench_spdm_responder_engine);
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return test_loopback_receive_response(BENCH_SPDM_ENDPOINT_ID,
+					      response_size, response);
+}
+
+/**
+  Echo the APP messages in the responder.
+**/
+return_status bench_spdm_get_response(IN void *spdm_context,
+				      IN uint32 *session_id,
+				      IN boolean is_app_message,
+				      IN uintn request_size, IN void *request,
+				      IN OUT uintn *response_size,
+				      OUT void *response)
+{
+	if (!is_app_message) {
+		return RETURN_NOT_FOUND;
+	}
+	if (*response_size < request_size) {
+		*response_size = request_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	copy_mem(response, request, request_size);
+	*response_size = request_size;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Set the local capabilities and algorithms of an SPDM context.
+**/
+void bench_spdm_set_local_data(IN void *spdm_context, IN uint32 capability_flags,
+			       IN bench_spdm_algo_set_t *algo_set)
+{
+	spdm_data_parameter_t parameter;
+	uint8 data8;
+	uint16 data16;
+	uint32 data32;
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+
+	data8 = 0;
+	libspdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_CT_EXPONENT,
+			 &parameter, &data8, sizeof(data8));
+	libspdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_FLAGS, &parameter,
+			 &capability_flags, sizeof(capability_flags));
+
+	data8 = SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+	libspdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_SPEC, &parameter,
+			 &data8, sizeof(data8));
+	data32 = algo_set->measurement_hash_algo;
+	libspdm_set_data(spdm_context, SPDM_DATA_MEASUREMENT_HASH_ALGO,
+			 &parameter, &data32, sizeof(data32));
+	data32 = algo_set->base_asym_algo;
+	libspdm_set_data(spdm_context, SPDM_DATA_BASE_ASYM_ALGO, &parameter,
+			 &data32, sizeof(data32));
+	data32 = algo_set->base_hash_algo;
+	libspdm_set_data(spdm_context, SPDM_DATA_BASE_HASH_ALGO, &parameter,
+			 &data32, sizeof(data32));
+	data16 = algo_set->dhe_named_group;
+	libspdm_set_data(spdm_context, SPDM_DATA_DHE_NAME_GROUP, &parameter,
+			 &data16, sizeof(data16));
+	data16 = algo_set->aead_cipher_suite;
+	libspdm_set_data(spdm_context, SPDM_DATA_AEAD_CIPHER_SUITE, &parameter,
+			 &data16, sizeof(data16));
+	data16 = SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048;
+	libspdm_set_data(spdm_context, SPDM_DATA_REQ_BASE_ASYM_ALG, &parameter,
+			 &data16, sizeof(data16));
+	data16 = SPDM_ALGORITHMS_KEY_SCHEDULE_HMAC_HASH;
+	libspdm_set_data(spdm_context, SPDM_DATA_KEY_SCHEDULE, &parameter,
+			 &data16, sizeof(data16));
+}
+
+return_status bench_spdm_setup_requester(
+	IN OUT bench_spdm_context_t *context,
+	IN libspdm_device_send_message_func send_message,
+	IN libspdm_device_receive_message_func receive_message)
+{
+	void *spdm_context;
+	spdm_data_parameter_t parameter;
+	void *root_cert_hash;
+	uintn root_cert_hash_size;
+	boolean res;
+
+	res = read_responder_root_public_certificate(
+		context->algo_set->base_hash_algo,
+		context->algo_set->base_asym_algo, &context->root_cert_chain,
+		&context->root_cert_chain_size, &root_cert_hash,
+		&root_cert_hash_size);
+	if (!res) {
+		return RETURN_NOT_FOUND;
+	}
+
+	context->requester_context = (void *)malloc(libspdm_get_context_size());
+	if (context->requester_context == NULL) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	context->session_started = FALSE;
+
+	spdm_context = context->requester_context;
+	libspdm_init_context(spdm_context);
+	libspdm_register_device_io_func(spdm_context, send_message,
+					receive_message);
+	libspdm_register_device_buffer(
+		spdm_context, m_bench_spdm_requester_sender_buffer,
+		sizeof(m_bench_spdm_requester_sender_buffer),
+		m_bench_spdm_requester_receiver_buffer,
+		sizeof(m_bench_spdm_requester_receiver_buffer));
+	libspdm_register_transport_layer_func(
+		spdm_context, spdm_transport_test_encode_message,
+		spdm_transport_test_decode_message);
+	bench_spdm_set_local_data(
+		spdm_context,
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+			SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP |
+			SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP |
+			SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP_REQUESTER |
+			SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP |
+			SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_UPD_CAP,
+		context->algo_set);
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	// The root certificate follows the root hash in the certificate chain.
+	libspdm_set_data(spdm_context, SPDM_DATA_PEER_PUBLIC_ROOT_CERT,
+			 &parameter, (uint8 *)root_cert_hash + root_cert_hash_size,
+			 context->root_cert_chain_size -
+				 sizeof(spdm_cert_chain_t) -
+				 root_cert_hash_size);
+	return RETURN_SUCCESS;
+}
+
+return_status bench_spdm_setup_responder(IN OUT bench_spdm_context_t *context)
+{
+	void *spdm_context;
+	spdm_data_parameter_t parameter;
+	uint8 slot_count;
+	boolean res;
+
+	res = read_responder_public_certificate_chain(
+		context->algo_set->base_hash_algo,
+		context->algo_set->base_asym_algo, &context->cert_chain,
+		&context->cert_chain_size, NULL, NULL);
+	if (!res) {
+		return RETURN_NOT_FOUND;
+	}
+
+	context->responder_context = (void *)malloc(libspdm_get_context_size());
+	if (context->responder_context == NULL) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	test_loopback_reset();
+
+	spdm_context = context->responder_context;
+	libspdm_init_context(spdm_context);
+	libspdm_register_device_buffer(
+		spdm_context, m_bench_spdm_responder_sender_buffer,
+		sizeof(m_bench_spdm_responder_sender_buffer),
+		m_bench_spdm_responder_receiver_buffer,
+		sizeof(m_bench_spdm_responder_receiver_buffer));
+	libspdm_register_transport_layer_func(
+		spdm_context, spdm_transport_test_encode_message,
+		spdm_transport_test_decode_message);
+	libspdm_register_get_response_func(spdm_context,
+					   bench_spdm_get_response);
+	bench_spdm_set_local_data(
+		spdm_context,
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG |
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_FRESH_CAP |
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP |
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP |
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP_RESPONDER |
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP |
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_UPD_CAP,
+		context->algo_set);
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	slot_count = 1;
+	libspdm_set_data(spdm_context, SPDM_DATA_LOCAL_SLOT_COUNT, &parameter,
+			 &slot_count, sizeof(slot_count));
+	parameter.additional_data[0] = 0;
+	libspdm_set_data(spdm_context, SPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+			 &parameter, context->cert_chain,
+			 context->cert_chain_size);
+
+	return libspdm_responder_engine_register_context(
+		m_bench_spdm_responder_engine, BENCH_SPDM_ENDPOINT_ID,
+		spdm_context);
+}
+
+void bench_spdm_teardown(IN OUT bench_spdm_context_t *context)
+{
+	if (context->session_started) {
+		libspdm_stop_session(context->requester_context,
+				     context->session_id, 0);
+		context->session_started = FALSE;
+	}
+	if (context->responder_context != NULL) {
+		libspdm_responder_engine_unregister_context(
+			m_bench_spdm_responder_engine, BENCH_SPDM_ENDPOINT_ID);
+		free(context->responder_context);
+		context->responder_context = NULL;
+	}
+	if (context->requester_context != NULL) {
+		free(context->requester_context);
+		context->requester_context = NULL;
+	}
+	if (context->root_cert_chain != NULL) {
+		free(context->root_cert_chain);
+		context->root_cert_chain = NULL;
+	}
+	if (context->cert_chain != NULL) {
+		free(context->cert_chain);
+		context->cert_chain = NULL;
+	}
+}
+
+/**
+  Free the transcript hashes of the previous connection of an SPDM context.
+
+  libspdm_init_connection clears the negotiated algorithms before the transcripts are reset,
+  so the hashes of a previous connection must be freed before negotiating again.
+**/
+void bench_spdm_reset_transcript(IN void *spdm_context)
+{
+	libspdm_reset_message_b(spdm_context);
+	libspdm_reset_message_c(spdm_context);
+	libspdm_reset_message_mut_b(spdm_context);
+	libspdm_reset_message_mut_c(spdm_context);
+}
+
+return_status bench_spdm_init_connection(IN bench_spdm_context_t *context)
+{
+	bench_spdm_reset_transcript(context->requester_context);
+	if (context->responder_context != NULL) {
+		bench_spdm_reset_transcript(context->responder_context);
+	}
+	return libspdm_init_connection(context->requester_context, FALSE);
+}
+
+return_status bench_spdm_get_digest(IN bench_spdm_context_t *context)
+{
+	uint8 slot_mask;
+	uint8 total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+
+	return libspdm_get_digest(context->requester_context, &slot_mask,
+				  total_digest_buffer);
+}
+
+return_status bench_spdm_get_certificate(IN bench_spdm_context_t *context)
+{
+	return libspdm_get_certificate(context->requester_context, 0, NULL,
+				       NULL);
+}
+
+return_status bench_spdm_prepare_certificate(IN bench_spdm_context_t *context)
+{
+	return_status status;
+
+	status = bench_spdm_init_connection(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	status = bench_spdm_get_digest(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	return bench_spdm_get_certificate(context);
+}
+
+return_status bench_spdm_prepare_authentication(IN bench_spdm_context_t *context)
+{
+	return_status status;
+
+	status = bench_spdm_prepare_certificate(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	return bench_spdm_challenge(context);
+}
+
+return_status bench_spdm_prepare_session(IN bench_spdm_context_t *context)
+{
+	return_status status;
+
+	if (context->session_started) {
+		return RETURN_SUCCESS;
+	}
+	status = bench_spdm_init_connection(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	return bench_spdm_psk_exchange(context);
+}
+
+return_status bench_spdm_challenge(IN bench_spdm_context_t *context)
+{
+	uint8 slot_mask;
+	uint8 measurement_hash[MAX_HASH_SIZE];
+
+	return libspdm_challenge(context->requester_context, 0,
+				 SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+				 measurement_hash, &slot_mask);
+}
+
+return_status bench_spdm_get_measurement(IN bench_spdm_context_t *context)
+{
+	uint8 number_of_blocks;
+	uint32 measurement_record_length;
+	uint8 measurement_record[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+
+	measurement_record_length = sizeof(measurement_record);
+	return libspdm_get_measurement(
+		context->requester_context, NULL,
+		SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+		SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+		0, &number_of_blocks, &measurement_record_length,
+		measurement_record);
+}
+
+return_status bench_spdm_start_session(IN bench_spdm_context_t *context,
+				       IN boolean use_psk)
+{
+	return_status status;
+	uint8 heartbeat_period;
+	uint8 measurement_hash[MAX_HASH_SIZE];
+
+	status = libspdm_start_session(
+		context->requester_context, use_psk,
+		SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH, 0,
+		&context->session_id, &heartbeat_period, measurement_hash);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	context->session_started = TRUE;
+	return RETURN_SUCCESS;
+}
+
+return_status bench_spdm_key_exchange(IN bench_spdm_context_t *context)
+{
+	return bench_spdm_start_session(context, FALSE);
+}
+
+return_status bench_spdm_psk_exchange(IN bench_spdm_context_t *context)
+{
+	return bench_spdm_start_session(context, TRUE);
+}
+
+return_status bench_spdm_stop_session(IN bench_spdm_context_t *context)
+{
+	return_status status;
+
+	status = libspdm_stop_session(context->requester_context,
+				      context->session_id, 0);
+	context->session_started = FALSE;
+	return status;
+}
+
+return_status bench_spdm_key_update(IN bench_spdm_context_t *context)
+{
+	return libspdm_key_update(context->requester_context,
+				  context->session_id, FALSE);
+}
+
+return_status bench_spdm_send_receive_data(IN bench_spdm_context_t *context)
+{
+	return_status status;
+	uint8 request[BENCH_SPDM_APP_MESSAGE_SIZE];
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+
+	set_mem(request, sizeof(request), 0x5A);
+	request[0] = BENCH_SPDM_APP_MESSAGE_TYPE;
+	response_size = sizeof(response);
+	status = libspdm_send_receive_data(context->requester_context,
+					   &context->session_id, TRUE, request,
+					   sizeof(request), response,
+					   &response_size);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	if ((response_size != sizeof(request)) ||
+	    (const_compare_mem(response, request, sizeof(request)) != 0)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return RETURN_SUCCESS;
+}
+
+bench_spdm_operation_t m_bench_spdm_operation[] = {
+	{ "init_connection", 0, NULL, bench_spdm_init_connection, NULL },
+	{ "get_certificate", BENCH_SPDM_AXIS_ASYM, bench_spdm_init_connection,
+	  bench_spdm_get_certificate, NULL },
+	{ "challenge", BENCH_SPDM_AXIS_ASYM, bench_spdm_prepare_certificate,
+	  bench_spdm_challenge, NULL },
+	{ "get_measurement_signed", BENCH_SPDM_AXIS_ASYM,
+	  bench_spdm_prepare_authentication, bench_spdm_get_measurement,
+	  NULL },
+	{ "key_exchange_finish",
+	  BENCH_SPDM_AXIS_ASYM | BENCH_SPDM_AXIS_DHE | BENCH_SPDM_AXIS_AEAD,
+	  bench_spdm_prepare_certificate, bench_spdm_key_exchange,
+	  bench_spdm_stop_session },
+	// The PSK session only depends on the hash, which follows the asym algorithm.
+	{ "psk_exchange_finish", BENCH_SPDM_AXIS_ASYM | BENCH_SPDM_AXIS_AEAD,
+	  bench_spdm_init_connection, bench_spdm_psk_exchange,
+	  bench_spdm_stop_session },
+	{ "key_update", BENCH_SPDM_AXIS_ASYM | BENCH_SPDM_AXIS_AEAD,
+	  bench_spdm_prepare_session, bench_spdm_key_update, NULL },
+	{ "send_receive_data", BENCH_SPDM_AXIS_ASYM | BENCH_SPDM_AXIS_AEAD,
+	  bench_spdm_prepare_session, bench_spdm_send_receive_data, NULL },
+};
+
+uintn m_bench_spdm_operation_count = ARRAY_SIZE(m_bench_spdm_operation);
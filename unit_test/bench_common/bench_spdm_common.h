@@ -0,0 +1,178 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#ifndef __BENCH_SPDM_COMMON_H__
+#define __BENCH_SPDM_COMMON_H__
+
+#include "bench_common.h"
+#include <library/spdm_requester_lib.h>
+#include <library/spdm_responder_lib.h>
+#include <library/spdm_transport_test_lib.h>
+#include <spdm_device_secret_lib_internal.h>
+
+//
+// The SPDM tools run a requester and a responder back to back in one process.
+// The requester sends to the loopback transport of spdm_transport_test_lib, and receiving
+// the response dispatches the pending request in m_bench_spdm_responder_engine.
+//
+#define BENCH_SPDM_ENDPOINT_ID 0x08
+
+//
+// An APP message of the test transport is any message which is not a test transport message.
+// The responder echoes the APP messages.
+//
+#define BENCH_SPDM_APP_MESSAGE_TYPE 0xFF
+#define BENCH_SPDM_APP_MESSAGE_SIZE 64
+
+//
+// The algorithm axes an operation depends on.
+// bench_spdm only runs an operation for the first entry of the axes it does not depend on.
+//
+#define BENCH_SPDM_AXIS_ASYM BIT0
+#define BENCH_SPDM_AXIS_DHE BIT1
+#define BENCH_SPDM_AXIS_AEAD BIT2
+
+typedef struct {
+	char8 *name;
+	uint32 base_asym_algo;
+	uint32 base_hash_algo;
+	uint32 measurement_hash_algo;
+	uint16 dhe_named_group;
+	uint16 aead_cipher_suite;
+} bench_spdm_algo_set_t;
+
+typedef struct {
+	void *requester_context;
+	void *responder_context;
+	bench_spdm_algo_set_t *algo_set;
+	void *root_cert_chain;
+	uintn root_cert_chain_size;
+	void *cert_chain;
+	uintn cert_chain_size;
+	boolean session_started;
+	uint32 session_id;
+} bench_spdm_context_t;
+
+typedef return_status (*bench_spdm_func)(IN bench_spdm_context_t *context);
+
+typedef struct {
+	char8 *name;
+	uint32 axes;
+	// Not measured, run before each measured run.
+	bench_spdm_func prepare;
+	// Measured.
+	bench_spdm_func run;
+	// Not measured, run after each successful run.
+	bench_spdm_func finish;
+} bench_spdm_operation_t;
+
+extern void *m_bench_spdm_responder_engine;
+
+extern bench_spdm_operation_t m_bench_spdm_operation[];
+extern uintn m_bench_spdm_operation_count;
+
+/**
+  Allocate and initialize m_bench_spdm_responder_engine, which serves the loopback transport.
+
+  @retval TRUE   The responder engine is ready.
+  @retval FALSE  The responder engine cannot be allocated.
+**/
+boolean bench_spdm_init_responder_engine(void);
+
+/**
+  Free m_bench_spdm_responder_engine.
+**/
+void bench_spdm_free_responder_engine(void);
+
+/**
+  Send a request to the loopback transport.
+
+  This is the send function of the device IO of the requester.
+**/
+return_status bench_spdm_send_message(IN void *spdm_context,
+				      IN uintn request_size, IN void *request,
+				      IN uint64 timeout);
+
+/**
+  Dispatch the pending request in m_bench_spdm_responder_engine, and receive its response.
+
+  This is the receive function of the device IO of the requester.
+**/
+return_status bench_spdm_receive_message(IN void *spdm_context,
+					 IN OUT uintn *response_size,
+					 IN OUT void *response,
+					 IN uint64 timeout);
+
+/**
+  Create the requester of an algorithm set.
+
+  The requester negotiates the algorithms of context->algo_set, and trusts the sample root certificate.
+
+  @param  context                       The context. context->algo_set is set by the caller.
+  @param  send_message                  The send function of the device IO of the requester.
+  @param  receive_message               The receive function of the device IO of the requester.
+
+  @retval RETURN_SUCCESS               The requester is created.
+  @retval RETURN_NOT_FOUND             The root certificate cannot be read.
+  @retval RETURN_OUT_OF_RESOURCES      The requester cannot be allocated.
+**/
+return_status bench_spdm_setup_requester(
+	IN OUT bench_spdm_context_t *context,
+	IN libspdm_device_send_message_func send_message,
+	IN libspdm_device_receive_message_func receive_message);
+
+/**
+  Create the responder of an algorithm set, and register it in m_bench_spdm_responder_engine.
+
+  The responder provisions the sample certificate chain in slot 0, and echoes the APP messages.
+
+  @param  context                       The context. context->algo_set is set by the caller.
+
+  @retval RETURN_SUCCESS               The responder is created.
+  @retval RETURN_NOT_FOUND             The certificate chain cannot be read.
+  @retval RETURN_OUT_OF_RESOURCES      The responder cannot be allocated.
+**/
+return_status bench_spdm_setup_responder(IN OUT bench_spdm_context_t *context);
+
+/**
+  Stop the session, and free the requester and the responder created by the setup functions.
+
+  @param  context                       The context.
+**/
+void bench_spdm_teardown(IN OUT bench_spdm_context_t *context);
+
+//
+// The SPDM operations of the requester.
+//
+return_status bench_spdm_init_connection(IN bench_spdm_context_t *context);
+return_status bench_spdm_get_digest(IN bench_spdm_context_t *context);
+return_status bench_spdm_get_certificate(IN bench_spdm_context_t *context);
+return_status bench_spdm_challenge(IN bench_spdm_context_t *context);
+return_status bench_spdm_get_measurement(IN bench_spdm_context_t *context);
+return_status bench_spdm_key_exchange(IN bench_spdm_context_t *context);
+return_status bench_spdm_psk_exchange(IN bench_spdm_context_t *context);
+return_status bench_spdm_stop_session(IN bench_spdm_context_t *context);
+return_status bench_spdm_key_update(IN bench_spdm_context_t *context);
+return_status bench_spdm_send_receive_data(IN bench_spdm_context_t *context);
+
+/**
+  Negotiate the connection and get the certificate chain.
+**/
+return_status bench_spdm_prepare_certificate(IN bench_spdm_context_t *context);
+
+/**
+  Negotiate the connection, get the certificate chain and authenticate the responder with CHALLENGE.
+
+  A signed GET_MEASUREMENTS requires the requester to be authenticated.
+**/
+return_status bench_spdm_prepare_authentication(IN bench_spdm_context_t *context);
+
+/**
+  Start a PSK session once, which is kept for the following runs.
+**/
+return_status bench_spdm_prepare_session(IN bench_spdm_context_t *context);
+
+#endif
@@ -0,0 +1,888 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "bench_common.h"
+#include <hal/library/cryptlib.h>
+
+//
+// The bulk operations are measured on each size, from one small message to the largest SPDM record.
+// Each timed iteration repeats the operation on about BENCH_CRYPT_BATCH_BYTES, so that the timer
+// overhead is negligible for the small sizes.
+//
+#define BENCH_CRYPT_MAX_DATA_SIZE 16384
+#define BENCH_CRYPT_BATCH_BYTES 65536
+
+#define BENCH_CRYPT_KEY_SIZE 64
+#define BENCH_CRYPT_IV_SIZE 12
+#define BENCH_CRYPT_TAG_SIZE 16
+#define BENCH_CRYPT_AAD_SIZE 16
+#define BENCH_CRYPT_HKDF_INFO_SIZE 16
+#define BENCH_CRYPT_HKDF_OUT_SIZE 64
+
+#define BENCH_CRYPT_MAX_SIGNATURE_SIZE 512
+#define BENCH_CRYPT_MAX_DHE_KEY_SIZE 512
+
+#define BENCH_CRYPT_SM2_ID "1234567812345678"
+
+typedef boolean (*bench_crypt_func)(IN void *context);
+
+typedef boolean (*bench_crypt_hash_all_func)(IN const void *data,
+					     IN uintn data_size,
+					     OUT uint8 *hash_value);
+
+typedef boolean (*bench_crypt_hmac_all_func)(IN const void *data,
+					     IN uintn data_size,
+					     IN const uint8 *key,
+					     IN uintn key_size,
+					     OUT uint8 *hmac_value);
+
+typedef boolean (*bench_crypt_hkdf_func)(IN const uint8 *key, IN uintn key_size,
+					 IN const uint8 *salt,
+					 IN uintn salt_size,
+					 IN const uint8 *info,
+					 IN uintn info_size, OUT uint8 *out,
+					 IN uintn out_size);
+
+typedef boolean (*bench_crypt_aead_encrypt_func)(
+	IN const uint8 *key, IN uintn key_size, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, OUT uint8 *tag_out,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
+typedef boolean (*bench_crypt_aead_decrypt_func)(
+	IN const uint8 *key, IN uintn key_size, IN const uint8 *iv,
+	IN uintn iv_size, IN const uint8 *a_data, IN uintn a_data_size,
+	IN const uint8 *data_in, IN uintn data_in_size, IN const uint8 *tag,
+	IN uintn tag_size, OUT uint8 *data_out, OUT uintn *data_out_size);
+
+typedef void *(*bench_crypt_dhe_new_func)(IN uintn nid);
+typedef boolean (*bench_crypt_dhe_generate_key_func)(IN OUT void *context,
+						     OUT uint8 *public_key,
+						     IN OUT uintn *public_key_size);
+typedef boolean (*bench_crypt_dhe_compute_key_func)(
+	IN OUT void *context, IN const uint8 *peer_public_key,
+	IN uintn peer_public_key_size, OUT uint8 *key, IN OUT uintn *key_size);
+typedef void (*bench_crypt_dhe_free_func)(IN void *context);
+
+typedef struct {
+	char8 *name;
+	bench_crypt_hash_all_func hash_all;
+} bench_crypt_hash_t;
+
+typedef struct {
+	char8 *name;
+	bench_crypt_hmac_all_func hmac_all;
+	bench_crypt_hkdf_func hkdf;
+	uintn key_size;
+} bench_crypt_mac_t;
+
+typedef struct {
+	char8 *name;
+	bench_crypt_aead_encrypt_func encrypt;
+	bench_crypt_aead_decrypt_func decrypt;
+	uintn key_size;
+} bench_crypt_aead_t;
+
+typedef enum {
+	BENCH_CRYPT_ASYM_RSA_PKCS1,
+	BENCH_CRYPT_ASYM_RSA_PSS,
+	BENCH_CRYPT_ASYM_ECDSA,
+	BENCH_CRYPT_ASYM_EDDSA,
+	BENCH_CRYPT_ASYM_SM2,
+} bench_crypt_asym_type_t;
+
+typedef struct {
+	char8 *name;
+	bench_crypt_asym_type_t type;
+	// The directory of the sample keys.
+	char8 *key_dir;
+	// The hash of the signed digest, CRYPTO_NID_NULL for the pure EdDSA.
+	uintn hash_nid;
+	uintn hash_size;
+} bench_crypt_asym_t;
+
+typedef struct {
+	char8 *name;
+	uintn nid;
+	bench_crypt_dhe_new_func new_by_nid;
+	bench_crypt_dhe_generate_key_func generate_key;
+	bench_crypt_dhe_compute_key_func compute_key;
+	bench_crypt_dhe_free_func free;
+} bench_crypt_dhe_t;
+
+bench_crypt_hash_t m_bench_crypt_hash[] = {
+	{ "sha256", sha256_hash_all },	   { "sha384", sha384_hash_all },
+	{ "sha512", sha512_hash_all },	   { "sha3_256", sha3_256_hash_all },
+	{ "sha3_384", sha3_384_hash_all }, { "sha3_512", sha3_512_hash_all },
+	{ "sm3_256", sm3_256_hash_all },
+};
+
+bench_crypt_mac_t m_bench_crypt_mac[] = {
+	{ "sha256", hmac_sha256_all, hkdf_sha256_extract_and_expand, 32 },
+	{ "sha384", hmac_sha384_all, hkdf_sha384_extract_and_expand, 48 },
+	{ "sha512", hmac_sha512_all, hkdf_sha512_extract_and_expand, 64 },
+	{ "sha3_256", hmac_sha3_256_all, hkdf_sha3_256_extract_and_expand,
+	  32 },
+	{ "sha3_384", hmac_sha3_384_all, hkdf_sha3_384_extract_and_expand,
+	  48 },
+	{ "sha3_512", hmac_sha3_512_all, hkdf_sha3_512_extract_and_expand,
+	  64 },
+	{ "sm3_256", hmac_sm3_256_all, hkdf_sm3_256_extract_and_expand, 32 },
+};
+
+bench_crypt_aead_t m_bench_crypt_aead[] = {
+	{ "aes_128_gcm", aead_aes_gcm_encrypt, aead_aes_gcm_decrypt, 16 },
+	{ "aes_256_gcm", aead_aes_gcm_encrypt, aead_aes_gcm_decrypt, 32 },
+	{ "chacha20_poly1305", aead_chacha20_poly1305_encrypt,
+	  aead_chacha20_poly1305_decrypt, 32 },
+	{ "sm4_128_gcm", aead_sm4_gcm_encrypt, aead_sm4_gcm_decrypt, 16 },
+};
+
+bench_crypt_asym_t m_bench_crypt_asym[] = {
+	{ "rsassa_2048", BENCH_CRYPT_ASYM_RSA_PKCS1, "rsa2048",
+	  CRYPTO_NID_SHA256, 32 },
+	{ "rsassa_3072", BENCH_CRYPT_ASYM_RSA_PKCS1, "rsa3072",
+	  CRYPTO_NID_SHA384, 48 },
+	{ "rsapss_2048", BENCH_CRYPT_ASYM_RSA_PSS, "rsa2048", CRYPTO_NID_SHA256,
+	  32 },
+	{ "rsapss_3072", BENCH_CRYPT_ASYM_RSA_PSS, "rsa3072", CRYPTO_NID_SHA384,
+	  48 },
+	{ "ecdsa_p256", BENCH_CRYPT_ASYM_ECDSA, "ecp256", CRYPTO_NID_SHA256,
+	  32 },
+	{ "ecdsa_p384", BENCH_CRYPT_ASYM_ECDSA, "ecp384", CRYPTO_NID_SHA384,
+	  48 },
+	{ "ecdsa_p521", BENCH_CRYPT_ASYM_ECDSA, "ecp521", CRYPTO_NID_SHA512,
+	  64 },
+	{ "eddsa_ed25519", BENCH_CRYPT_ASYM_EDDSA, "ed25519", CRYPTO_NID_NULL,
+	  32 },
+	{ "eddsa_ed448", BENCH_CRYPT_ASYM_EDDSA, "ed448", CRYPTO_NID_NULL, 64 },
+	{ "sm2_dsa", BENCH_CRYPT_ASYM_SM2, "sm2", CRYPTO_NID_SM3_256, 32 },
+};
+
+bench_crypt_dhe_t m_bench_crypt_dhe[] = {
+	{ "ffdhe_2048", CRYPTO_NID_FFDHE2048, dh_new_by_nid, dh_generate_key,
+	  dh_compute_key, dh_free },
+	{ "ffdhe_3072", CRYPTO_NID_FFDHE3072, dh_new_by_nid, dh_generate_key,
+	  dh_compute_key, dh_free },
+	{ "ffdhe_4096", CRYPTO_NID_FFDHE4096, dh_new_by_nid, dh_generate_key,
+	  dh_compute_key, dh_free },
+	{ "secp_256_r1", CRYPTO_NID_SECP256R1, ec_new_by_nid, ec_generate_key,
+	  ec_compute_key, ec_free },
+	{ "secp_384_r1", CRYPTO_NID_SECP384R1, ec_new_by_nid, ec_generate_key,
+	  ec_compute_key, ec_free },
+	{ "secp_521_r1", CRYPTO_NID_SECP521R1, ec_new_by_nid, ec_generate_key,
+	  ec_compute_key, ec_free },
+	{ "x25519", CRYPTO_NID_CURVE_X25519, ecx_new_by_nid, ecx_generate_key,
+	  ecx_compute_key, ecx_free },
+	{ "x448", CRYPTO_NID_CURVE_X448, ecx_new_by_nid, ecx_generate_key,
+	  ecx_compute_key, ecx_free },
+};
+
+//
+// The certificates of the sample keys, for the X.509 operations.
+//
+char8 *m_bench_crypt_cert_dir[] = {
+	"rsa2048", "rsa3072", "ecp256",	 "ecp384",
+	"ecp521",  "ed25519", "ed448", "sm2",
+};
+
+uintn m_bench_crypt_data_size[] = { 16, 64, 256, 1024, 4096, 16384 };
+
+uint8 m_bench_crypt_data[BENCH_CRYPT_MAX_DATA_SIZE];
+uint8 m_bench_crypt_encrypted_data[BENCH_CRYPT_MAX_DATA_SIZE];
+uint8 m_bench_crypt_output[BENCH_CRYPT_MAX_DATA_SIZE];
+uint8 m_bench_crypt_key[BENCH_CRYPT_KEY_SIZE];
+uint8 m_bench_crypt_iv[BENCH_CRYPT_IV_SIZE];
+uint8 m_bench_crypt_aad[BENCH_CRYPT_AAD_SIZE];
+uint8 m_bench_crypt_tag[BENCH_CRYPT_TAG_SIZE];
+uint8 m_bench_crypt_encrypted_tag[BENCH_CRYPT_TAG_SIZE];
+uint8 m_bench_crypt_hkdf_info[BENCH_CRYPT_HKDF_INFO_SIZE];
+
+typedef struct {
+	void *algo;
+	uintn size;
+} bench_crypt_data_context_t;
+
+typedef struct {
+	bench_crypt_asym_t *asym;
+	void *private_key;
+	void *public_key;
+	uint8 signature[BENCH_CRYPT_MAX_SIGNATURE_SIZE];
+	uintn signature_size;
+} bench_crypt_asym_context_t;
+
+typedef struct {
+	bench_crypt_dhe_t *dhe;
+	uint8 peer_public_key[BENCH_CRYPT_MAX_DHE_KEY_SIZE];
+	uintn peer_public_key_size;
+} bench_crypt_dhe_context_t;
+
+typedef struct {
+	uint8 *cert;
+	uintn cert_size;
+	uint8 *root_cert;
+	uintn root_cert_size;
+	uint8 *cert_chain;
+	uintn cert_chain_size;
+} bench_crypt_x509_context_t;
+
+/**
+  Measure an operation and add the result to the report.
+
+  One untimed batch warms up the caches before the timed iterations.
+  The measurement stops at the first failure.
+
+  @param  options                       The parsed options.
+  @param  report                        The report.
+  @param  name                          The algorithm name.
+  @param  operation                     The operation name.
+  @param  size                          The bytes processed by the operation, 0 if the operation is not sized.
+  @param  batch                         The number of operations timed together in one iteration.
+  @param  run                           The operation.
+  @param  context                       The context of the operation.
+  @param  sample                        The buffer of the samples, options->iterations entries.
+**/
+void bench_crypt_measure(IN bench_options_t *options, IN bench_report_t *report,
+			 IN char8 *name, IN char8 *operation, IN uintn size,
+			 IN uintn batch, IN bench_crypt_func run,
+			 IN void *context, IN uint64 *sample)
+{
+	bench_statistics_t statistics;
+	return_status status;
+	uintn count;
+	uintn index;
+	uintn batch_index;
+	uint64 start_time;
+	uint64 start_cycles;
+	uint64 cycles;
+
+	status = RETURN_SUCCESS;
+	count = 0;
+	cycles = 0;
+	for (index = 0; index <= options->iterations; index++) {
+		start_cycles = bench_get_cycles();
+		start_time = bench_get_time_ns();
+		for (batch_index = 0; batch_index < batch; batch_index++) {
+			if (!run(context)) {
+				status = RETURN_DEVICE_ERROR;
+				break;
+			}
+		}
+		if (RETURN_ERROR(status)) {
+			break;
+		}
+		if (index != 0) {
+			sample[count] = (bench_get_time_ns() - start_time) / batch;
+			cycles += (bench_get_cycles() - start_cycles) / batch;
+			count++;
+		}
+	}
+
+	bench_compute_statistics(sample, count, &statistics);
+	statistics.size = size;
+	statistics.cycles = cycles;
+	bench_report_add_result(report, name, operation, status, &statistics);
+	printf("%-20s %-20s %6llu status 0x%llx p50 %llu ns p99 %llu ns %llu ops/s\n",
+	       name, operation, (unsigned long long)size,
+	       (unsigned long long)status, (unsigned long long)statistics.p50,
+	       (unsigned long long)statistics.p99,
+	       (unsigned long long)statistics.ops_per_second);
+}
+
+/**
+  Report an operation which cannot be set up.
+**/
+void bench_crypt_report_failure(IN bench_report_t *report, IN char8 *name,
+				IN char8 *operation, IN uintn size)
+{
+	bench_statistics_t statistics;
+
+	zero_mem(&statistics, sizeof(statistics));
+	statistics.size = size;
+	bench_report_add_result(report, name, operation, RETURN_DEVICE_ERROR,
+				&statistics);
+	printf("%-20s %-20s %6llu status 0x%llx\n", name, operation,
+	       (unsigned long long)size,
+	       (unsigned long long)RETURN_DEVICE_ERROR);
+}
+
+/**
+  Read a sample key file of an algorithm.
+
+  The benchmark is run in the directory of the sample keys, see "make copy_sample_key".
+**/
+boolean bench_crypt_read_key_file(IN char8 *key_dir, IN char8 *file,
+				  OUT void **file_data, OUT uintn *file_size)
+{
+	char8 file_name[256];
+
+	snprintf(file_name, sizeof(file_name), "%s/%s", key_dir, file);
+	return read_input_file(file_name, file_data, file_size);
+}
+
+boolean bench_crypt_hash(IN void *context)
+{
+	bench_crypt_data_context_t *data_context;
+	bench_crypt_hash_t *hash;
+
+	data_context = context;
+	hash = data_context->algo;
+	return hash->hash_all(m_bench_crypt_data, data_context->size,
+			      m_bench_crypt_output);
+}
+
+boolean bench_crypt_hmac(IN void *context)
+{
+	bench_crypt_data_context_t *data_context;
+	bench_crypt_mac_t *mac;
+
+	data_context = context;
+	mac = data_context->algo;
+	return mac->hmac_all(m_bench_crypt_data, data_context->size,
+			     m_bench_crypt_key, mac->key_size,
+			     m_bench_crypt_output);
+}
+
+/**
+  Derive a key from the data as input keying material, as the SPDM key schedule does with the shared secret.
+**/
+boolean bench_crypt_hkdf(IN void *context)
+{
+	bench_crypt_data_context_t *data_context;
+	bench_crypt_mac_t *mac;
+
+	data_context = context;
+	mac = data_context->algo;
+	return mac->hkdf(m_bench_crypt_data, data_context->size,
+			 m_bench_crypt_key, mac->key_size,
+			 m_bench_crypt_hkdf_info, sizeof(m_bench_crypt_hkdf_info),
+			 m_bench_crypt_output, BENCH_CRYPT_HKDF_OUT_SIZE);
+}
+
+boolean bench_crypt_aead_encrypt(IN void *context)
+{
+	bench_crypt_data_context_t *data_context;
+	bench_crypt_aead_t *aead;
+	uintn output_size;
+
+	data_context = context;
+	aead = data_context->algo;
+	output_size = sizeof(m_bench_crypt_output);
+	return aead->encrypt(m_bench_crypt_key, aead->key_size,
+			     m_bench_crypt_iv, sizeof(m_bench_crypt_iv),
+			     m_bench_crypt_aad, sizeof(m_bench_crypt_aad),
+			     m_bench_crypt_data, data_context->size,
+			     m_bench_crypt_tag, sizeof(m_bench_crypt_tag),
+			     m_bench_crypt_output, &output_size);
+}
+
+/**
+  Decrypt the data encrypted by bench_crypt_prepare_aead_decrypt.
+**/
+boolean bench_crypt_aead_decrypt(IN void *context)
+{
+	bench_crypt_data_context_t *data_context;
+	bench_crypt_aead_t *aead;
+	uintn output_size;
+
+	data_context = context;
+	aead = data_context->algo;
+	output_size = sizeof(m_bench_crypt_output);
+	return aead->decrypt(m_bench_crypt_key, aead->key_size,
+			     m_bench_crypt_iv, sizeof(m_bench_crypt_iv),
+			     m_bench_crypt_aad, sizeof(m_bench_crypt_aad),
+			     m_bench_crypt_encrypted_data, data_context->size,
+			     m_bench_crypt_encrypted_tag,
+			     sizeof(m_bench_crypt_encrypted_tag),
+			     m_bench_crypt_output, &output_size);
+}
+
+boolean bench_crypt_prepare_aead_decrypt(IN bench_crypt_data_context_t *context)
+{
+	bench_crypt_aead_t *aead;
+	uintn output_size;
+
+	aead = context->algo;
+	output_size = sizeof(m_bench_crypt_encrypted_data);
+	return aead->encrypt(m_bench_crypt_key, aead->key_size,
+			     m_bench_crypt_iv, sizeof(m_bench_crypt_iv),
+			     m_bench_crypt_aad, sizeof(m_bench_crypt_aad),
+			     m_bench_crypt_data, context->size,
+			     m_bench_crypt_encrypted_tag,
+			     sizeof(m_bench_crypt_encrypted_tag),
+			     m_bench_crypt_encrypted_data, &output_size);
+}
+
+/**
+  Measure a bulk operation on each data size.
+**/
+void bench_crypt_run_data(IN bench_options_t *options, IN bench_report_t *report,
+			  IN char8 *name, IN char8 *operation, IN void *algo,
+			  IN bench_crypt_func run, IN uint64 *sample)
+{
+	bench_crypt_data_context_t context;
+	char8 full_name[128];
+	uintn index;
+	uintn batch;
+
+	snprintf(full_name, sizeof(full_name), "%s/%s", name, operation);
+	if (!bench_is_selected(options, full_name)) {
+		return;
+	}
+
+	context.algo = algo;
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_data_size); index++) {
+		context.size = m_bench_crypt_data_size[index];
+		if ((run == bench_crypt_aead_decrypt) &&
+		    !bench_crypt_prepare_aead_decrypt(&context)) {
+			bench_crypt_report_failure(report, name, operation,
+						   context.size);
+			continue;
+		}
+		batch = BENCH_CRYPT_BATCH_BYTES / context.size;
+		bench_crypt_measure(options, report, name, operation,
+				    context.size, batch, run, &context, sample);
+	}
+}
+
+boolean bench_crypt_sign(IN void *context)
+{
+	bench_crypt_asym_context_t *asym_context;
+	bench_crypt_asym_t *asym;
+
+	asym_context = context;
+	asym = asym_context->asym;
+	asym_context->signature_size = sizeof(asym_context->signature);
+	switch (asym->type) {
+	case BENCH_CRYPT_ASYM_RSA_PKCS1:
+		return rsa_pkcs1_sign_with_nid(asym_context->private_key,
+					       asym->hash_nid,
+					       m_bench_crypt_data,
+					       asym->hash_size,
+					       asym_context->signature,
+					       &asym_context->signature_size);
+	case BENCH_CRYPT_ASYM_RSA_PSS:
+		return rsa_pss_sign(asym_context->private_key, asym->hash_nid,
+				    m_bench_crypt_data, asym->hash_size,
+				    asym_context->signature,
+				    &asym_context->signature_size);
+	case BENCH_CRYPT_ASYM_ECDSA:
+		return ecdsa_sign(asym_context->private_key, asym->hash_nid,
+				  m_bench_crypt_data, asym->hash_size,
+				  asym_context->signature,
+				  &asym_context->signature_size);
+	case BENCH_CRYPT_ASYM_EDDSA:
+		return eddsa_sign(asym_context->private_key, asym->hash_nid,
+				  NULL, 0, m_bench_crypt_data, asym->hash_size,
+				  asym_context->signature,
+				  &asym_context->signature_size);
+	case BENCH_CRYPT_ASYM_SM2:
+		return sm2_dsa_sign(asym_context->private_key, asym->hash_nid,
+				    (uint8 *)BENCH_CRYPT_SM2_ID,
+				    sizeof(BENCH_CRYPT_SM2_ID) - 1,
+				    m_bench_crypt_data, asym->hash_size,
+				    asym_context->signature,
+				    &asym_context->signature_size);
+	default:
+		return FALSE;
+	}
+}
+
+boolean bench_crypt_verify(IN void *context)
+{
+	bench_crypt_asym_context_t *asym_context;
+	bench_crypt_asym_t *asym;
+
+	asym_context = context;
+	asym = asym_context->asym;
+	switch (asym->type) {
+	case BENCH_CRYPT_ASYM_RSA_PKCS1:
+		return rsa_pkcs1_verify_with_nid(
+			asym_context->public_key, asym->hash_nid,
+			m_bench_crypt_data, asym->hash_size,
+			asym_context->signature, asym_context->signature_size);
+	case BENCH_CRYPT_ASYM_RSA_PSS:
+		return rsa_pss_verify(asym_context->public_key, asym->hash_nid,
+				      m_bench_crypt_data, asym->hash_size,
+				      asym_context->signature,
+				      asym_context->signature_size);
+	case BENCH_CRYPT_ASYM_ECDSA:
+		return ecdsa_verify(asym_context->public_key, asym->hash_nid,
+				    m_bench_crypt_data, asym->hash_size,
+				    asym_context->signature,
+				    asym_context->signature_size);
+	case BENCH_CRYPT_ASYM_EDDSA:
+		return eddsa_verify(asym_context->public_key, asym->hash_nid,
+				    NULL, 0, m_bench_crypt_data,
+				    asym->hash_size, asym_context->signature,
+				    asym_context->signature_size);
+	case BENCH_CRYPT_ASYM_SM2:
+		return sm2_dsa_verify(asym_context->public_key, asym->hash_nid,
+				      (uint8 *)BENCH_CRYPT_SM2_ID,
+				      sizeof(BENCH_CRYPT_SM2_ID) - 1,
+				      m_bench_crypt_data, asym->hash_size,
+				      asym_context->signature,
+				      asym_context->signature_size);
+	default:
+		return FALSE;
+	}
+}
+
+/**
+  Load the private key and the public key of the sample responder certificate.
+**/
+boolean bench_crypt_load_asym_key(IN OUT bench_crypt_asym_context_t *context)
+{
+	bench_crypt_asym_t *asym;
+	void *pem;
+	uintn pem_size;
+	void *cert;
+	uintn cert_size;
+	boolean result;
+
+	asym = context->asym;
+	if (!bench_crypt_read_key_file(asym->key_dir, "end_responder.key", &pem,
+				       &pem_size)) {
+		return FALSE;
+	}
+	if (!bench_crypt_read_key_file(asym->key_dir, "end_responder.cert.der",
+				       &cert, &cert_size)) {
+		free(pem);
+		return FALSE;
+	}
+
+	switch (asym->type) {
+	case BENCH_CRYPT_ASYM_RSA_PKCS1:
+	case BENCH_CRYPT_ASYM_RSA_PSS:
+		result = rsa_get_private_key_from_pem(pem, pem_size, NULL,
+						      &context->private_key) &&
+			 rsa_get_public_key_from_x509(cert, cert_size,
+						      &context->public_key);
+		break;
+	case BENCH_CRYPT_ASYM_ECDSA:
+		result = ec_get_private_key_from_pem(pem, pem_size, NULL,
+						     &context->private_key) &&
+			 ec_get_public_key_from_x509(cert, cert_size,
+						     &context->public_key);
+		break;
+	case BENCH_CRYPT_ASYM_EDDSA:
+		result = ecd_get_private_key_from_pem(pem, pem_size, NULL,
+						      &context->private_key) &&
+			 ecd_get_public_key_from_x509(cert, cert_size,
+						      &context->public_key);
+		break;
+	case BENCH_CRYPT_ASYM_SM2:
+		result = sm2_get_private_key_from_pem(pem, pem_size, NULL,
+						      &context->private_key) &&
+			 sm2_get_public_key_from_x509(cert, cert_size,
+						      &context->public_key);
+		break;
+	default:
+		result = FALSE;
+		break;
+	}
+
+	free(pem);
+	free(cert);
+	return result;
+}
+
+void bench_crypt_free_asym_key(IN OUT bench_crypt_asym_context_t *context)
+{
+	void (*free_key)(IN void *key);
+
+	switch (context->asym->type) {
+	case BENCH_CRYPT_ASYM_RSA_PKCS1:
+	case BENCH_CRYPT_ASYM_RSA_PSS:
+		free_key = rsa_free;
+		break;
+	case BENCH_CRYPT_ASYM_ECDSA:
+		free_key = ec_free;
+		break;
+	case BENCH_CRYPT_ASYM_EDDSA:
+		free_key = ecd_free;
+		break;
+	case BENCH_CRYPT_ASYM_SM2:
+		free_key = sm2_dsa_free;
+		break;
+	default:
+		return;
+	}
+	if (context->private_key != NULL) {
+		free_key(context->private_key);
+		context->private_key = NULL;
+	}
+	if (context->public_key != NULL) {
+		free_key(context->public_key);
+		context->public_key = NULL;
+	}
+}
+
+/**
+  Measure the signature generation and the signature verification of an algorithm.
+**/
+void bench_crypt_run_asym(IN bench_options_t *options, IN bench_report_t *report,
+			  IN bench_crypt_asym_t *asym, IN uint64 *sample)
+{
+	bench_crypt_asym_context_t context;
+	char8 full_name[128];
+	boolean sign_selected;
+	boolean verify_selected;
+
+	snprintf(full_name, sizeof(full_name), "%s/sign", asym->name);
+	sign_selected = bench_is_selected(options, full_name);
+	snprintf(full_name, sizeof(full_name), "%s/verify", asym->name);
+	verify_selected = bench_is_selected(options, full_name);
+	if (!sign_selected && !verify_selected) {
+		return;
+	}
+
+	zero_mem(&context, sizeof(context));
+	context.asym = asym;
+	if (!bench_crypt_load_asym_key(&context)) {
+		if (sign_selected) {
+			bench_crypt_report_failure(report, asym->name, "sign", 0);
+		}
+		if (verify_selected) {
+			bench_crypt_report_failure(report, asym->name, "verify",
+						   0);
+		}
+		bench_crypt_free_asym_key(&context);
+		return;
+	}
+
+	if (sign_selected) {
+		bench_crypt_measure(options, report, asym->name, "sign", 0, 1,
+				    bench_crypt_sign, &context, sample);
+	}
+	if (verify_selected) {
+		// The signature to verify is generated untimed.
+		if (bench_crypt_sign(&context)) {
+			bench_crypt_measure(options, report, asym->name,
+					    "verify", 0, 1, bench_crypt_verify,
+					    &context, sample);
+		} else {
+			bench_crypt_report_failure(report, asym->name, "verify",
+						   0);
+		}
+	}
+	bench_crypt_free_asym_key(&context);
+}
+
+/**
+  Generate a key pair and compute the shared secret with the peer public key,
+  as one side of the SPDM KEY_EXCHANGE does.
+**/
+boolean bench_crypt_dhe_exchange(IN void *context)
+{
+	bench_crypt_dhe_context_t *dhe_context;
+	bench_crypt_dhe_t *dhe;
+	void *dhe_key;
+	uint8 public_key[BENCH_CRYPT_MAX_DHE_KEY_SIZE];
+	uintn public_key_size;
+	uint8 shared_secret[BENCH_CRYPT_MAX_DHE_KEY_SIZE];
+	uintn shared_secret_size;
+	boolean result;
+
+	dhe_context = context;
+	dhe = dhe_context->dhe;
+	dhe_key = dhe->new_by_nid(dhe->nid);
+	if (dhe_key == NULL) {
+		return FALSE;
+	}
+	public_key_size = sizeof(public_key);
+	shared_secret_size = sizeof(shared_secret);
+	result = dhe->generate_key(dhe_key, public_key, &public_key_size) &&
+		 dhe->compute_key(dhe_key, dhe_context->peer_public_key,
+				  dhe_context->peer_public_key_size,
+				  shared_secret, &shared_secret_size);
+	dhe->free(dhe_key);
+	return result;
+}
+
+/**
+  Measure the key exchange of a DHE group.
+**/
+void bench_crypt_run_dhe(IN bench_options_t *options, IN bench_report_t *report,
+			 IN bench_crypt_dhe_t *dhe, IN uint64 *sample)
+{
+	bench_crypt_dhe_context_t context;
+	char8 full_name[128];
+	void *peer_key;
+	boolean result;
+
+	snprintf(full_name, sizeof(full_name), "%s/key_exchange", dhe->name);
+	if (!bench_is_selected(options, full_name)) {
+		return;
+	}
+
+	// The peer public key is generated untimed.
+	context.dhe = dhe;
+	context.peer_public_key_size = sizeof(context.peer_public_key);
+	peer_key = dhe->new_by_nid(dhe->nid);
+	result = (peer_key != NULL) &&
+		 dhe->generate_key(peer_key, context.peer_public_key,
+				   &context.peer_public_key_size);
+	if (peer_key != NULL) {
+		dhe->free(peer_key);
+	}
+	if (!result) {
+		bench_crypt_report_failure(report, dhe->name, "key_exchange", 0);
+		return;
+	}
+	bench_crypt_measure(options, report, dhe->name, "key_exchange", 0, 1,
+			    bench_crypt_dhe_exchange, &context, sample);
+}
+
+boolean bench_crypt_x509_parse(IN void *context)
+{
+	bench_crypt_x509_context_t *x509_context;
+	uint8 *x509_cert;
+
+	x509_context = context;
+	if (!x509_construct_certificate(x509_context->cert,
+					x509_context->cert_size, &x509_cert)) {
+		return FALSE;
+	}
+	x509_free(x509_cert);
+	return TRUE;
+}
+
+boolean bench_crypt_x509_verify_chain(IN void *context)
+{
+	bench_crypt_x509_context_t *x509_context;
+
+	x509_context = context;
+	return x509_verify_cert_chain(x509_context->root_cert,
+				      x509_context->root_cert_size,
+				      x509_context->cert_chain,
+				      x509_context->cert_chain_size);
+}
+
+/**
+  Measure the certificate parsing and the certificate chain verification of the sample certificates.
+**/
+void bench_crypt_run_x509(IN bench_options_t *options, IN bench_report_t *report,
+			  IN char8 *cert_dir, IN uint64 *sample)
+{
+	bench_crypt_x509_context_t context;
+	char8 name[64];
+	char8 full_name[128];
+
+	snprintf(name, sizeof(name), "x509_%s", cert_dir);
+	zero_mem(&context, sizeof(context));
+
+	snprintf(full_name, sizeof(full_name), "%s/parse", name);
+	if (bench_is_selected(options, full_name)) {
+		if (bench_crypt_read_key_file(cert_dir, "end_responder.cert.der",
+					      (void **)&context.cert,
+					      &context.cert_size)) {
+			bench_crypt_measure(options, report, name, "parse", 0, 1,
+					    bench_crypt_x509_parse, &context,
+					    sample);
+			free(context.cert);
+		} else {
+			bench_crypt_report_failure(report, name, "parse", 0);
+		}
+	}
+
+	snprintf(full_name, sizeof(full_name), "%s/verify_chain", name);
+	if (bench_is_selected(options, full_name)) {
+		if (bench_crypt_read_key_file(cert_dir, "ca.cert.der",
+					      (void **)&context.root_cert,
+					      &context.root_cert_size) &&
+		    bench_crypt_read_key_file(cert_dir,
+					      "bundle_responder.certchain.der",
+					      (void **)&context.cert_chain,
+					      &context.cert_chain_size)) {
+			bench_crypt_measure(options, report, name,
+					    "verify_chain", 0, 1,
+					    bench_crypt_x509_verify_chain,
+					    &context, sample);
+		} else {
+			bench_crypt_report_failure(report, name, "verify_chain",
+						   0);
+		}
+		if (context.root_cert != NULL) {
+			free(context.root_cert);
+		}
+		if (context.cert_chain != NULL) {
+			free(context.cert_chain);
+		}
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	bench_options_t options;
+	bench_report_t report;
+	uint64 *sample;
+	uintn index;
+
+	if (!bench_parse_arguments(argc, argv, &options)) {
+		return 1;
+	}
+
+	sample = (void *)malloc(options.iterations * sizeof(uint64));
+	if (sample == NULL) {
+		return 1;
+	}
+
+	random_seed(NULL, 0);
+	random_bytes(m_bench_crypt_data, sizeof(m_bench_crypt_data));
+	random_bytes(m_bench_crypt_key, sizeof(m_bench_crypt_key));
+	random_bytes(m_bench_crypt_iv, sizeof(m_bench_crypt_iv));
+	random_bytes(m_bench_crypt_aad, sizeof(m_bench_crypt_aad));
+	random_bytes(m_bench_crypt_hkdf_info, sizeof(m_bench_crypt_hkdf_info));
+
+	if (!bench_report_open(&report, &options, "bench_crypt")) {
+		free(sample);
+		return 1;
+	}
+
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_hash); index++) {
+		bench_crypt_run_data(&options, &report,
+				     m_bench_crypt_hash[index].name, "hash",
+				     &m_bench_crypt_hash[index],
+				     bench_crypt_hash, sample);
+	}
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_mac); index++) {
+		bench_crypt_run_data(&options, &report,
+				     m_bench_crypt_mac[index].name, "hmac",
+				     &m_bench_crypt_mac[index],
+				     bench_crypt_hmac, sample);
+		bench_crypt_run_data(&options, &report,
+				     m_bench_crypt_mac[index].name, "hkdf",
+				     &m_bench_crypt_mac[index],
+				     bench_crypt_hkdf, sample);
+	}
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_aead); index++) {
+		bench_crypt_run_data(&options, &report,
+				     m_bench_crypt_aead[index].name, "encrypt",
+				     &m_bench_crypt_aead[index],
+				     bench_crypt_aead_encrypt, sample);
+		bench_crypt_run_data(&options, &report,
+				     m_bench_crypt_aead[index].name, "decrypt",
+				     &m_bench_crypt_aead[index],
+				     bench_crypt_aead_decrypt, sample);
+	}
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_asym); index++) {
+		bench_crypt_run_asym(&options, &report,
+				     &m_bench_crypt_asym[index], sample);
+	}
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_dhe); index++) {
+		bench_crypt_run_dhe(&options, &report, &m_bench_crypt_dhe[index],
+				    sample);
+	}
+	for (index = 0; index < ARRAY_SIZE(m_bench_crypt_cert_dir); index++) {
+		bench_crypt_run_x509(&options, &report,
+				     m_bench_crypt_cert_dir[index], sample);
+	}
+
+	bench_report_close(&report);
+	free(sample);
+	return 0;
+}
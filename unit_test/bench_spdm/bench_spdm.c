@@ -0,0 +1,342 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "bench_spdm_common.h"
+
+typedef struct {
+	char8 *name;
+	uint32 base_asym_algo;
+	uint32 base_hash_algo;
+	uint32 measurement_hash_algo;
+} bench_spdm_asym_t;
+
+typedef struct {
+	char8 *name;
+	uint16 value;
+} bench_spdm_algo_t;
+
+//
+// SPDM 1.1 does not define EdDSA, SM2 or SM4, so only the algorithms of the SPDM
+// specification are in the matrix. The base hash follows the strength of the asym algorithm.
+//
+bench_spdm_asym_t m_bench_spdm_asym[] = {
+	{ "rsassa_3072", SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384 },
+	{ "rsapss_3072", SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_3072,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384 },
+	{ "ecdsa_p256", SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256 },
+	{ "ecdsa_p384", SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384 },
+	{ "ecdsa_p521", SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P521,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512 },
+};
+
+bench_spdm_algo_t m_bench_spdm_dhe[] = {
+	{ "secp_256_r1", SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1 },
+	{ "secp_384_r1", SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1 },
+	{ "secp_521_r1", SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_521_R1 },
+	{ "ffdhe_2048", SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_2048 },
+	{ "ffdhe_3072", SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072 },
+};
+
+bench_spdm_algo_t m_bench_spdm_aead[] = {
+	{ "aes_256_gcm", SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+	{ "aes_128_gcm", SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM },
+	{ "chacha20_poly1305",
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305 },
+};
+
+typedef struct {
+	bench_spdm_context_t spdm;
+	bench_spdm_algo_set_t algo_set;
+	char8 name[128];
+	// Snapshots of the requester and the responder after the prepare function snapshot_prepare.
+	void *requester_snapshot;
+	void *responder_snapshot;
+	uintn snapshot_prepare;
+} bench_spdm_config_t;
+
+/**
+  Create the requester and the responder of an algorithm configuration, and their snapshots.
+**/
+return_status bench_spdm_setup(IN OUT bench_spdm_config_t *config)
+{
+	return_status status;
+
+	status = bench_spdm_setup_requester(&config->spdm,
+					    bench_spdm_send_message,
+					    bench_spdm_receive_message);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	status = bench_spdm_setup_responder(&config->spdm);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	config->requester_snapshot =
+		(void *)malloc(libspdm_get_context_snapshot_size());
+	config->responder_snapshot =
+		(void *)malloc(libspdm_get_context_snapshot_size());
+	config->snapshot_prepare = 0;
+	if ((config->requester_snapshot == NULL) ||
+	    (config->responder_snapshot == NULL)) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  Free the snapshots, the requester and the responder of an algorithm configuration.
+**/
+void bench_spdm_teardown_config(IN OUT bench_spdm_config_t *config)
+{
+	if (config->snapshot_prepare != 0) {
+		libspdm_free_context_snapshot(config->requester_snapshot);
+		libspdm_free_context_snapshot(config->responder_snapshot);
+		config->snapshot_prepare = 0;
+	}
+	if (config->requester_snapshot != NULL) {
+		free(config->requester_snapshot);
+		config->requester_snapshot = NULL;
+	}
+	if (config->responder_snapshot != NULL) {
+		free(config->responder_snapshot);
+		config->responder_snapshot = NULL;
+	}
+	bench_spdm_teardown(&config->spdm);
+}
+
+/**
+  Bring the requester and the responder to the state of the prepare function of an operation.
+
+  The prepare function runs once. The requester and the responder are saved to snapshots after it,
+  and the next calls restore them, instead of negotiating the connection again.
+**/
+return_status bench_spdm_prepare(IN bench_spdm_config_t *config,
+				 IN bench_spdm_func prepare)
+{
+	return_status status;
+	uintn snapshot_size;
+
+	if (config->snapshot_prepare == (uintn)prepare) {
+		status = libspdm_restore_context(config->spdm.requester_context,
+						 config->requester_snapshot,
+						 libspdm_get_context_snapshot_size());
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		return libspdm_restore_context(config->spdm.responder_context,
+					       config->responder_snapshot,
+					       libspdm_get_context_snapshot_size());
+	}
+
+	if (config->snapshot_prepare != 0) {
+		libspdm_free_context_snapshot(config->requester_snapshot);
+		libspdm_free_context_snapshot(config->responder_snapshot);
+		config->snapshot_prepare = 0;
+	}
+	status = prepare(&config->spdm);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	snapshot_size = libspdm_get_context_snapshot_size();
+	status = libspdm_snapshot_context(config->spdm.requester_context,
+					  config->requester_snapshot,
+					  &snapshot_size);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	snapshot_size = libspdm_get_context_snapshot_size();
+	status = libspdm_snapshot_context(config->spdm.responder_context,
+					  config->responder_snapshot,
+					  &snapshot_size);
+	if (RETURN_ERROR(status)) {
+		libspdm_free_context_snapshot(config->requester_snapshot);
+		return status;
+	}
+	config->snapshot_prepare = (uintn)prepare;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Run one operation of an algorithm configuration and report it.
+
+  One untimed iteration warms up the caches before the timed iterations.
+  The measurement stops at the first failure.
+**/
+void bench_spdm_run_operation(IN bench_spdm_config_t *config,
+			      IN bench_spdm_operation_t *operation,
+			      IN bench_options_t *options,
+			      IN bench_report_t *report, IN uint64 *sample)
+{
+	return_status status;
+	bench_statistics_t statistics;
+	uintn count;
+	uintn index;
+	uint64 start_time;
+
+	test_loopback_reset();
+	count = 0;
+	status = RETURN_SUCCESS;
+	for (index = 0; index <= options->iterations; index++) {
+		if (operation->prepare != NULL) {
+			status = bench_spdm_prepare(config, operation->prepare);
+			if (RETURN_ERROR(status)) {
+				break;
+			}
+		}
+		start_time = bench_get_time_ns();
+		status = operation->run(&config->spdm);
+		if (index != 0) {
+			sample[count] = bench_get_time_ns() - start_time;
+		}
+		if (RETURN_ERROR(status)) {
+			break;
+		}
+		if (index != 0) {
+			count++;
+		}
+		if (operation->finish != NULL) {
+			status = operation->finish(&config->spdm);
+			if (RETURN_ERROR(status)) {
+				break;
+			}
+		}
+	}
+
+	bench_compute_statistics(sample, count, &statistics);
+	bench_report_add_result(report, config->name, operation->name, status,
+				&statistics);
+	printf("%-48s %-24s status 0x%llx p50 %llu ns p99 %llu ns %llu ops/s\n",
+	       config->name, operation->name, (unsigned long long)status,
+	       (unsigned long long)statistics.p50,
+	       (unsigned long long)statistics.p99,
+	       (unsigned long long)statistics.ops_per_second);
+}
+
+/**
+  Run the selected operations of an algorithm configuration.
+**/
+void bench_spdm_run_config(IN bench_spdm_asym_t *asym,
+			   IN bench_spdm_algo_t *dhe,
+			   IN bench_spdm_algo_t *aead, IN uint32 axes,
+			   IN bench_options_t *options,
+			   IN bench_report_t *report, IN uint64 *sample)
+{
+	bench_spdm_config_t config;
+	bench_spdm_operation_t *operation;
+	bench_statistics_t statistics;
+	char8 full_name[192];
+	return_status status;
+	uintn index;
+	boolean setup_done;
+
+	zero_mem(&config, sizeof(config));
+	snprintf(config.name, sizeof(config.name), "%s/%s/%s", asym->name,
+		 dhe->name, aead->name);
+	config.algo_set.name = config.name;
+	config.algo_set.base_asym_algo = asym->base_asym_algo;
+	config.algo_set.base_hash_algo = asym->base_hash_algo;
+	config.algo_set.measurement_hash_algo = asym->measurement_hash_algo;
+	config.algo_set.dhe_named_group = dhe->value;
+	config.algo_set.aead_cipher_suite = aead->value;
+	config.spdm.algo_set = &config.algo_set;
+
+	setup_done = FALSE;
+	status = RETURN_SUCCESS;
+	for (index = 0; index < m_bench_spdm_operation_count; index++) {
+		operation = &m_bench_spdm_operation[index];
+		// Skip the duplicated runs on the axes which the operation does not depend on.
+		if ((~operation->axes & axes) != 0) {
+			continue;
+		}
+		snprintf(full_name, sizeof(full_name), "%s/%s", config.name,
+			 operation->name);
+		if (!bench_is_selected(options, full_name)) {
+			continue;
+		}
+
+		if (!setup_done) {
+			status = bench_spdm_setup(&config);
+			setup_done = TRUE;
+		}
+		if (RETURN_ERROR(status)) {
+			zero_mem(&statistics, sizeof(statistics));
+			bench_report_add_result(report, config.name,
+						operation->name, status,
+						&statistics);
+			continue;
+		}
+		bench_spdm_run_operation(&config, operation, options, report,
+					 sample);
+	}
+
+	if (setup_done) {
+		bench_spdm_teardown_config(&config);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	bench_options_t options;
+	bench_report_t report;
+	uint64 *sample;
+	uintn asym_index;
+	uintn dhe_index;
+	uintn aead_index;
+	uint32 axes;
+
+	if (!bench_parse_arguments(argc, argv, &options)) {
+		return 1;
+	}
+
+	sample = (void *)malloc(options.iterations * sizeof(uint64));
+	if ((sample == NULL) || !bench_spdm_init_responder_engine()) {
+		return 1;
+	}
+
+	if (!bench_report_open(&report, &options, "bench_spdm")) {
+		return 1;
+	}
+
+	for (asym_index = 0; asym_index < ARRAY_SIZE(m_bench_spdm_asym);
+	     asym_index++) {
+		for (dhe_index = 0; dhe_index < ARRAY_SIZE(m_bench_spdm_dhe);
+		     dhe_index++) {
+			for (aead_index = 0;
+			     aead_index < ARRAY_SIZE(m_bench_spdm_aead);
+			     aead_index++) {
+				axes = 0;
+				if (asym_index != 0) {
+					axes |= BENCH_SPDM_AXIS_ASYM;
+				}
+				if (dhe_index != 0) {
+					axes |= BENCH_SPDM_AXIS_DHE;
+				}
+				if (aead_index != 0) {
+					axes |= BENCH_SPDM_AXIS_AEAD;
+				}
+				bench_spdm_run_config(
+					&m_bench_spdm_asym[asym_index],
+					&m_bench_spdm_dhe[dhe_index],
+					&m_bench_spdm_aead[aead_index], axes,
+					&options, &report, sample);
+			}
+		}
+	}
+
+	bench_report_close(&report);
+	bench_spdm_free_responder_engine();
+	free(sample);
+	return 0;
+}
@@ -5,9 +5,18 @@
 **/
 
 #include "spdm_unit_fuzzing.h"
+#include <internal/libspdm_secured_message_lib.h>
 
 spdm_test_context_t *m_spdm_test_context;
 
+static uint8 m_spdm_sender_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+static uint8 m_spdm_receiver_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+//
+// Snapshot of the SPDM context of a persistent harness, taken after its setup.
+//
+static void *m_spdm_context_snapshot;
+
 spdm_test_context_t *get_spdm_test_context(void)
 {
 	return m_spdm_test_context;
@@ -35,6 +44,10 @@ uintn spdm_unit_test_group_setup(void **State)
 	libspdm_register_device_io_func(spdm_context,
 				     spdm_test_context->send_message,
 				     spdm_test_context->receive_message);
+	libspdm_register_device_buffer(spdm_context, m_spdm_sender_buffer,
+				       sizeof(m_spdm_sender_buffer),
+				       m_spdm_receiver_buffer,
+				       sizeof(m_spdm_receiver_buffer));
 	libspdm_register_transport_layer_func(spdm_context,
 					   spdm_transport_test_encode_message,
 					   spdm_transport_test_decode_message);
@@ -52,3 +65,206 @@ uintn spdm_unit_test_group_teardown(void **State)
 	spdm_test_context->spdm_context = NULL;
 	return 0;
 }
+
+uintn spdm_unit_test_group_setup_persistent(
+	void **State, IN spdm_unit_test_context_setup_func setup_func OPTIONAL)
+{
+	spdm_test_context_t *spdm_test_context;
+	uintn snapshot_size;
+	return_status status;
+
+	spdm_test_context = m_spdm_test_context;
+	snapshot_size = libspdm_get_context_snapshot_size();
+
+	if (m_spdm_context_snapshot != NULL) {
+		status = libspdm_restore_context(spdm_test_context->spdm_context,
+						 m_spdm_context_snapshot,
+						 snapshot_size);
+		if (RETURN_ERROR(status)) {
+			return (uintn)-1;
+		}
+		*State = spdm_test_context;
+		return 0;
+	}
+
+	if (spdm_unit_test_group_setup(State) != 0) {
+		return (uintn)-1;
+	}
+	if ((setup_func != NULL) && !setup_func(spdm_test_context)) {
+		spdm_unit_test_group_teardown(State);
+		return (uintn)-1;
+	}
+
+	m_spdm_context_snapshot = malloc(snapshot_size);
+	if (m_spdm_context_snapshot == NULL) {
+		spdm_unit_test_group_teardown(State);
+		return (uintn)-1;
+	}
+	status = libspdm_snapshot_context(spdm_test_context->spdm_context,
+					  m_spdm_context_snapshot,
+					  &snapshot_size);
+	if (RETURN_ERROR(status)) {
+		free(m_spdm_context_snapshot);
+		m_spdm_context_snapshot = NULL;
+		spdm_unit_test_group_teardown(State);
+		return (uintn)-1;
+	}
+	return 0;
+}
+
+void spdm_unit_test_set_negotiated_state(IN spdm_context_t *spdm_context,
+					 IN boolean is_requester)
+{
+	uint32 requester_flags;
+	uint32 responder_flags;
+
+	requester_flags = SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CERT_CAP |
+			  SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP |
+			  SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+			  SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP |
+			  SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MUT_AUTH_CAP |
+			  SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP |
+			  SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP_REQUESTER |
+			  SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCAP_CAP |
+			  SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP |
+			  SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_UPD_CAP;
+	responder_flags = SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+			  SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |
+			  SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG |
+			  SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |
+			  SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP |
+			  SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MUT_AUTH_CAP |
+			  SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP |
+			  SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP_RESPONDER |
+			  SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCAP_CAP |
+			  SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP |
+			  SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_UPD_CAP;
+
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.version.major_version = 1;
+	spdm_context->connection_info.version.minor_version = 1;
+	spdm_context->local_context.capability.flags =
+		is_requester ? requester_flags : responder_flags;
+	spdm_context->connection_info.capability.flags =
+		is_requester ? responder_flags : requester_flags;
+	spdm_context->connection_info.algorithm.measurement_spec =
+		SPDM_UNIT_TEST_MEASUREMENT_SPEC;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		SPDM_UNIT_TEST_MEASUREMENT_HASH_ALGO;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		SPDM_UNIT_TEST_HASH_ALGO;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		SPDM_UNIT_TEST_ASYM_ALGO;
+	spdm_context->connection_info.algorithm.req_base_asym_alg =
+		SPDM_UNIT_TEST_REQ_ASYM_ALGO;
+	spdm_context->connection_info.algorithm.dhe_named_group =
+		SPDM_UNIT_TEST_DHE_ALGO;
+	spdm_context->connection_info.algorithm.aead_cipher_suite =
+		SPDM_UNIT_TEST_AEAD_ALGO;
+	spdm_context->connection_info.algorithm.key_schedule =
+		SPDM_UNIT_TEST_KEY_SCHEDULE_ALGO;
+	libspdm_reset_message_a(spdm_context);
+}
+
+spdm_session_info_t *
+spdm_unit_test_set_session(IN spdm_context_t *spdm_context, IN boolean use_psk,
+			   IN spdm_session_state_t session_state)
+{
+	spdm_session_info_t *session_info;
+
+	spdm_context->latest_session_id = SPDM_UNIT_TEST_SESSION_ID;
+	spdm_context->last_spdm_request_session_id_valid = TRUE;
+	spdm_context->last_spdm_request_session_id = SPDM_UNIT_TEST_SESSION_ID;
+	session_info = &spdm_context->session_info[0];
+	spdm_session_info_init(spdm_context, session_info,
+			       SPDM_UNIT_TEST_SESSION_ID, use_psk);
+	spdm_secured_message_set_session_state(
+		session_info->secured_message_context, session_state);
+	return session_info;
+}
+
+return_status spdm_unit_test_encode_secured_response(
+	IN spdm_context_t *spdm_context, IN uintn message_size, IN void *message,
+	IN OUT uintn *transport_message_size, OUT void *transport_message)
+{
+	spdm_secured_message_context_t *secured_message_context;
+	uint32 session_id;
+	return_status status;
+
+	session_id = SPDM_UNIT_TEST_SESSION_ID;
+	status = spdm_transport_test_encode_message(spdm_context, &session_id,
+						    FALSE, FALSE, message_size,
+						    message, transport_message_size,
+						    transport_message);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+
+	//
+	// The same SPDM context encodes and decodes the message,
+	// so rewind the sequence number that the encode advanced.
+	//
+	secured_message_context =
+		spdm_context->session_info[0].secured_message_context;
+	if (secured_message_context->session_state ==
+	    SPDM_SESSION_STATE_HANDSHAKING) {
+		secured_message_context->handshake_secret
+			.response_handshake_sequence_number--;
+	} else {
+		secured_message_context->application_secret
+			.response_data_sequence_number--;
+	}
+	return RETURN_SUCCESS;
+}
+
+return_status spdm_unit_test_encode_encap_response(
+	IN spdm_context_t *spdm_context, IN boolean is_secured,
+	IN uintn response_index, IN uintn encap_request_size,
+	IN void *encap_request, IN OUT uintn *transport_message_size,
+	OUT void *transport_message)
+{
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	spdm_encapsulated_request_response_t *encap_request_response;
+	spdm_encapsulated_response_ack_response_t *encap_response_ack;
+	uintn message_size;
+
+	if (response_index == 0) {
+		encap_request_response = (void *)message;
+		encap_request_response->header.spdm_version =
+			SPDM_MESSAGE_VERSION_11;
+		encap_request_response->header.request_response_code =
+			SPDM_ENCAPSULATED_REQUEST;
+		encap_request_response->header.param1 = 1;
+		encap_request_response->header.param2 = 0;
+		if (encap_request_size >
+		    sizeof(message) - sizeof(*encap_request_response)) {
+			encap_request_size = sizeof(message) -
+					     sizeof(*encap_request_response);
+		}
+		copy_mem(encap_request_response + 1, encap_request,
+			 encap_request_size);
+		message_size =
+			sizeof(*encap_request_response) + encap_request_size;
+	} else {
+		encap_response_ack = (void *)message;
+		encap_response_ack->header.spdm_version =
+			SPDM_MESSAGE_VERSION_11;
+		encap_response_ack->header.request_response_code =
+			SPDM_ENCAPSULATED_RESPONSE_ACK;
+		encap_response_ack->header.param1 = 0;
+		encap_response_ack->header.param2 =
+			SPDM_ENCAPSULATED_RESPONSE_ACK_RESPONSE_PAYLOAD_TYPE_ABSENT;
+		message_size = sizeof(*encap_response_ack);
+	}
+
+	if (is_secured) {
+		return spdm_unit_test_encode_secured_response(
+			spdm_context, message_size, message,
+			transport_message_size, transport_message);
+	}
+	return spdm_transport_test_encode_message(spdm_context, NULL, FALSE,
+						  FALSE, message_size, message,
+						  transport_message_size,
+						  transport_message);
+}
@@ -23,6 +23,24 @@
 
 #define SPDM_TEST_CONTEXT_SIGNATURE SIGNATURE_32('S', 'T', 'C', 'S')
 
+//
+// Connection negotiated by spdm_unit_test_set_negotiated_state.
+//
+#define SPDM_UNIT_TEST_MEASUREMENT_SPEC                                        \
+	SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF
+#define SPDM_UNIT_TEST_MEASUREMENT_HASH_ALGO                                   \
+	SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256
+#define SPDM_UNIT_TEST_HASH_ALGO SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256
+#define SPDM_UNIT_TEST_ASYM_ALGO                                               \
+	SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256
+#define SPDM_UNIT_TEST_REQ_ASYM_ALGO                                           \
+	SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048
+#define SPDM_UNIT_TEST_DHE_ALGO SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1
+#define SPDM_UNIT_TEST_AEAD_ALGO SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM
+#define SPDM_UNIT_TEST_KEY_SCHEDULE_ALGO SPDM_ALGORITHMS_KEY_SCHEDULE_HMAC_HASH
+
+#define SPDM_UNIT_TEST_SESSION_ID 0xFFFFFFFF
+
 typedef struct {
 	uint32 signature;
 	boolean is_requester;
@@ -42,6 +60,112 @@ uintn spdm_unit_test_group_setup(void **State);
 
 uintn spdm_unit_test_group_teardown(void **State);
 
+typedef boolean (*spdm_unit_test_context_setup_func)(
+	IN spdm_test_context_t *spdm_test_context);
+
+/**
+  Set up the SPDM context of a persistent harness.
+
+  The first call initializes the SPDM context, calls setup_func to bring it to the state under test,
+  and takes a snapshot of it with libspdm_snapshot_context. The next calls restore the SPDM context
+  with libspdm_restore_context, so that an iteration costs a copy instead of libspdm_init_context
+  and the provisioning of the context. The transcripts, including their hash contexts, are part of
+  the snapshot. The SPDM context and the snapshot are kept until the process exits.
+
+  @param  State                         The state of the test, set to the test context.
+  @param  setup_func                    The function to set up the SPDM context, or NULL.
+
+  @retval 0   The SPDM context is ready.
+  @retval -1  The SPDM context or the snapshot cannot be allocated, setup_func fails,
+              or the SPDM context cannot be restored.
+**/
+uintn spdm_unit_test_group_setup_persistent(
+	void **State, IN spdm_unit_test_context_setup_func setup_func OPTIONAL);
+
+/**
+  Set the SPDM context to the NEGOTIATED state, with the SPDM_UNIT_TEST algorithms
+  and the capabilities of all the messages on both sides.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  is_requester                  Indicate if the SPDM context is a requester.
+**/
+void spdm_unit_test_set_negotiated_state(IN spdm_context_t *spdm_context,
+					 IN boolean is_requester);
+
+/**
+  Provision the SPDM context with the sample certificate chains and PSK hint.
+
+  The certificate chain of the side of the SPDM context is provisioned in slot 0,
+  and the certificate chain of the other side is used as the peer certificate chain.
+  It is implemented in support.c, with the sample device secret library,
+  and it reads the certificate chains from the sample_key directory.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  is_requester                  Indicate if the SPDM context is a requester.
+
+  @retval TRUE   The SPDM context is provisioned.
+  @retval FALSE  The certificate chains cannot be read.
+**/
+boolean spdm_unit_test_provision(IN spdm_context_t *spdm_context,
+				 IN boolean is_requester);
+
+/**
+  Start the session SPDM_UNIT_TEST_SESSION_ID in the SPDM context, and make it the current session.
+
+  The session keys are all zero, for both sides.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  use_psk                       Indicate if the session is a PSK session.
+  @param  session_state                 The state of the session.
+
+  @return The session info.
+**/
+spdm_session_info_t *
+spdm_unit_test_set_session(IN spdm_context_t *spdm_context, IN boolean use_psk,
+			   IN spdm_session_state_t session_state);
+
+/**
+  Encode a response of the session SPDM_UNIT_TEST_SESSION_ID as a secured message,
+  so that the requester of the same SPDM context can decode it.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  message_size                  The size in bytes of the response.
+  @param  message                       The response.
+  @param  transport_message_size        The size in bytes of the secured message buffer.
+                                       On output, the size in bytes of the secured message.
+  @param  transport_message             The secured message.
+
+  @return The status of spdm_transport_test_encode_message.
+**/
+return_status spdm_unit_test_encode_secured_response(
+	IN spdm_context_t *spdm_context, IN uintn message_size, IN void *message,
+	IN OUT uintn *transport_message_size, OUT void *transport_message);
+
+/**
+  Encode a response of the encapsulated request flow of a requester harness.
+
+  The first response is an ENCAPSULATED_REQUEST that carries the encapsulated request under test,
+  so that the requester processes it with its encapsulated response handler. The next responses are
+  an ENCAPSULATED_RESPONSE_ACK without any further encapsulated request, which ends the flow.
+
+  @param  spdm_context                  A pointer to the SPDM context.
+  @param  is_secured                    Indicate if the response is a secured message
+                                       of the session SPDM_UNIT_TEST_SESSION_ID.
+  @param  response_index                The index of the response in the flow, 0 for the first one.
+  @param  encap_request_size            The size in bytes of the encapsulated request.
+  @param  encap_request                 The encapsulated request.
+  @param  transport_message_size        The size in bytes of the transport message buffer.
+                                       On output, the size in bytes of the transport message.
+  @param  transport_message             The transport message.
+
+  @return The status of spdm_transport_test_encode_message.
+**/
+return_status spdm_unit_test_encode_encap_response(
+	IN spdm_context_t *spdm_context, IN boolean is_secured,
+	IN uintn response_index, IN uintn encap_request_size,
+	IN void *encap_request, IN OUT uintn *transport_message_size,
+	OUT void *transport_message);
+
 void setup_spdm_test_context(IN spdm_test_context_t *spdm_test_context);
 
 spdm_test_context_t *get_spdm_test_context(void);
@@ -0,0 +1,185 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_fuzzing.h"
+#include <stdio.h>
+#include <string.h>
+#include <spdm_device_secret_lib_internal.h>
+
+//
+// The sample device secret library reads the private key from a file for each signature.
+// The files do not change during a fuzzing session, so they are read once and cached.
+//
+#define MAX_CACHED_INPUT_FILE_COUNT 16
+
+typedef struct {
+	char8 *file_name;
+	void *file_data;
+	uintn file_size;
+} cached_input_file_t;
+
+static cached_input_file_t m_cached_input_file[MAX_CACHED_INPUT_FILE_COUNT];
+static uintn m_cached_input_file_count;
+
+void dump_hex_str(IN uint8 *buffer, IN uintn buffer_size)
+{
+	uintn index;
+
+	for (index = 0; index < buffer_size; index++) {
+		printf("%02x", buffer[index]);
+	}
+}
+
+boolean read_file(IN char8 *file_name, OUT void **file_data,
+		  OUT uintn *file_size)
+{
+	FILE *fp_in;
+	uintn temp_result;
+
+	if ((fp_in = fopen(file_name, "rb")) == NULL) {
+		printf("Unable to open file %s\n", file_name);
+		*file_data = NULL;
+		return FALSE;
+	}
+
+	fseek(fp_in, 0, SEEK_END);
+	*file_size = ftell(fp_in);
+
+	*file_data = (void *)malloc(*file_size);
+	if (NULL == *file_data) {
+		printf("No sufficient memory to allocate %s\n", file_name);
+		fclose(fp_in);
+		return FALSE;
+	}
+
+	fseek(fp_in, 0, SEEK_SET);
+	temp_result = fread(*file_data, 1, *file_size, fp_in);
+	if (temp_result != *file_size) {
+		printf("Read input file error %s", file_name);
+		free((void *)*file_data);
+		fclose(fp_in);
+		return FALSE;
+	}
+
+	fclose(fp_in);
+
+	return TRUE;
+}
+
+boolean read_input_file(IN char8 *file_name, OUT void **file_data,
+			OUT uintn *file_size)
+{
+	cached_input_file_t *cached_input_file;
+	uintn index;
+
+	cached_input_file = NULL;
+	for (index = 0; index < m_cached_input_file_count; index++) {
+		if (strcmp(m_cached_input_file[index].file_name, file_name) ==
+		    0) {
+			cached_input_file = &m_cached_input_file[index];
+			break;
+		}
+	}
+
+	if (cached_input_file == NULL) {
+		if (m_cached_input_file_count == MAX_CACHED_INPUT_FILE_COUNT) {
+			return read_file(file_name, file_data, file_size);
+		}
+		cached_input_file =
+			&m_cached_input_file[m_cached_input_file_count];
+		cached_input_file->file_name = malloc(strlen(file_name) + 1);
+		if (cached_input_file->file_name == NULL) {
+			return FALSE;
+		}
+		if (!read_file(file_name, &cached_input_file->file_data,
+			       &cached_input_file->file_size)) {
+			free(cached_input_file->file_name);
+			*file_data = NULL;
+			return FALSE;
+		}
+		strcpy(cached_input_file->file_name, file_name);
+		m_cached_input_file_count++;
+	}
+
+	//
+	// The caller frees the file data.
+	//
+	*file_data = malloc(cached_input_file->file_size);
+	if (*file_data == NULL) {
+		return FALSE;
+	}
+	memcpy(*file_data, cached_input_file->file_data,
+	       cached_input_file->file_size);
+	*file_size = cached_input_file->file_size;
+	return TRUE;
+}
+
+boolean spdm_unit_test_provision(IN spdm_context_t *spdm_context,
+				 IN boolean is_requester)
+{
+	void *responder_cert_chain;
+	uintn responder_cert_chain_size;
+	void *requester_cert_chain;
+	uintn requester_cert_chain_size;
+	void *local_cert_chain;
+	uintn local_cert_chain_size;
+	void *peer_cert_chain;
+	uintn peer_cert_chain_size;
+
+	if (!read_responder_public_certificate_chain(
+		    SPDM_UNIT_TEST_HASH_ALGO, SPDM_UNIT_TEST_ASYM_ALGO,
+		    &responder_cert_chain, &responder_cert_chain_size, NULL,
+		    NULL)) {
+		return FALSE;
+	}
+	if (!read_requester_public_certificate_chain(
+		    SPDM_UNIT_TEST_HASH_ALGO, SPDM_UNIT_TEST_REQ_ASYM_ALGO,
+		    &requester_cert_chain, &requester_cert_chain_size, NULL,
+		    NULL)) {
+		free(responder_cert_chain);
+		return FALSE;
+	}
+	if (is_requester) {
+		local_cert_chain = requester_cert_chain;
+		local_cert_chain_size = requester_cert_chain_size;
+		peer_cert_chain = responder_cert_chain;
+		peer_cert_chain_size = responder_cert_chain_size;
+	} else {
+		local_cert_chain = responder_cert_chain;
+		local_cert_chain_size = responder_cert_chain_size;
+		peer_cert_chain = requester_cert_chain;
+		peer_cert_chain_size = requester_cert_chain_size;
+	}
+	if (peer_cert_chain_size >
+	    sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer)) {
+		free(responder_cert_chain);
+		free(requester_cert_chain);
+		return FALSE;
+	}
+
+	//
+	// The local certificate chain is kept until the process exits, with the SPDM context.
+	//
+	spdm_context->local_context.local_cert_chain_provision[0] =
+		local_cert_chain;
+	spdm_context->local_context.local_cert_chain_provision_size[0] =
+		local_cert_chain_size;
+	spdm_context->local_context.slot_count = 1;
+	spdm_context->connection_info.local_used_cert_chain_buffer =
+		local_cert_chain;
+	spdm_context->connection_info.local_used_cert_chain_buffer_size =
+		local_cert_chain_size;
+	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 peer_cert_chain, peer_cert_chain_size);
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+		peer_cert_chain_size;
+	free(peer_cert_chain);
+
+	spdm_context->local_context.psk_hint = (void *)TEST_PSK_HINT_STRING;
+	spdm_context->local_context.psk_hint_size =
+		sizeof(TEST_PSK_HINT_STRING);
+	return TRUE;
+}
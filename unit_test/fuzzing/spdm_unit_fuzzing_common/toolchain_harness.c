@@ -12,6 +12,7 @@
 #undef NULL
 #include <hal/base.h>
 #include <hal/library/memlib.h>
+#include <hal/library/debuglib.h>
 #include "toolchain_harness.h"
 
 #ifdef TEST_WITH_LIBFUZZER
@@ -77,29 +78,44 @@ boolean init_test_buffer(IN char8 *file_name, IN uintn max_buffer_size,
 }
 
 #ifdef TEST_WITH_LIBFUZZER
+//
+// The test buffer is reused by all the inputs of the fuzzing session.
+//
+static void *m_test_buffer;
+
+int LLVMFuzzerInitialize(int *argc, char ***argv)
+{
+	//
+	// Printing the messages of each input would dominate the fuzzing time.
+	//
+	set_debug_print_error_level(0);
+	return 0;
+}
+
 #ifdef TEST_WITH_LIBFUZZERWIN
 int LLVMFuzzerTestOneInput(const wint_t *data, size_t size)
 #else
 int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
 #endif
 {
-	void *test_buffer;
 	uintn max_buffer_size;
 
 	// 1. Initialize test_buffer
 	max_buffer_size = get_max_buffer_size();
-	test_buffer = allocate_zero_pool(max_buffer_size);
-	if (test_buffer == NULL) {
-		return 0;
+	if (m_test_buffer == NULL) {
+		m_test_buffer = calloc(1, max_buffer_size);
+		if (m_test_buffer == NULL) {
+			return 0;
+		}
 	}
 	if (size > max_buffer_size) {
 		size = max_buffer_size;
 	}
-	copy_mem(test_buffer, data, size);
+	copy_mem(m_test_buffer, data, size);
+	// Clear the previous input, so that a crash reproduces from its input alone.
+	zero_mem((uint8 *)m_test_buffer + size, max_buffer_size - size);
 	// 2. Run test
-	run_test_harness(test_buffer, size);
-	// 3. Clean up
-	free(test_buffer);
+	run_test_harness(m_test_buffer, size);
 	return 0;
 }
 #else
@@ -0,0 +1,88 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_fuzzing.h"
+#include "toolchain_harness.h"
+#include <internal/libspdm_requester_lib.h>
+#include <spdm_device_secret_lib_internal.h>
+
+uintn get_max_buffer_size(void)
+{
+	return MAX_SPDM_MESSAGE_BUFFER_SIZE;
+}
+
+return_status spdm_device_send_message(IN void *spdm_context,
+				       IN uintn request_size, IN void *request,
+				       IN uint64 timeout)
+{
+	return RETURN_SUCCESS;
+}
+
+return_status spdm_device_receive_message(IN void *spdm_context,
+					  IN OUT uintn *response_size,
+					  IN OUT void *response,
+					  IN uint64 timeout)
+{
+	spdm_test_context_t *spdm_test_context;
+
+	spdm_test_context = get_spdm_test_context();
+	*response_size = spdm_test_context->test_buffer_size;
+	copy_mem(response, spdm_test_context->test_buffer,
+		 spdm_test_context->test_buffer_size);
+
+	return RETURN_SUCCESS;
+}
+
+boolean
+setup_spdm_requester_challenge_context(IN spdm_test_context_t *spdm_test_context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_unit_test_set_negotiated_state(spdm_context, TRUE);
+	return spdm_unit_test_provision(spdm_context, TRUE);
+}
+
+void test_spdm_requester_challenge(void **State)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 measurement_hash[MAX_HASH_SIZE];
+	uint8 slot_mask;
+
+	spdm_test_context = *State;
+	spdm_context = spdm_test_context->spdm_context;
+
+	libspdm_challenge(spdm_context, 0,
+			  SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH,
+			  measurement_hash, &slot_mask);
+}
+
+spdm_test_context_t m_spdm_requester_challenge_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	TRUE,
+	spdm_device_send_message,
+	spdm_device_receive_message,
+};
+
+void run_test_harness(IN void *test_buffer, IN uintn test_buffer_size)
+{
+	void *State;
+
+	setup_spdm_test_context(&m_spdm_requester_challenge_test_context);
+
+	m_spdm_requester_challenge_test_context.test_buffer = test_buffer;
+	m_spdm_requester_challenge_test_context.test_buffer_size =
+		test_buffer_size;
+
+	if (spdm_unit_test_group_setup_persistent(
+		    &State, setup_spdm_requester_challenge_context) != 0) {
+		printf("error - fail to set up the SPDM context\n");
+		exit(1);
+	}
+
+	test_spdm_requester_challenge(&State);
+}
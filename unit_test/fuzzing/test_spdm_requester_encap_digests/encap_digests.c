@@ -0,0 +1,93 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_fuzzing.h"
+#include "toolchain_harness.h"
+#include <internal/libspdm_requester_lib.h>
+#include <spdm_device_secret_lib_internal.h>
+
+//
+// The fuzzed GET_DIGESTS request is delivered in the first ENCAPSULATED_REQUEST.
+//
+static uintn m_receive_count;
+
+uintn get_max_buffer_size(void)
+{
+	return MAX_SPDM_MESSAGE_BUFFER_SIZE -
+	       sizeof(spdm_encapsulated_request_response_t);
+}
+
+return_status spdm_device_send_message(IN void *spdm_context,
+				       IN uintn request_size, IN void *request,
+				       IN uint64 timeout)
+{
+	return RETURN_SUCCESS;
+}
+
+return_status spdm_device_receive_message(IN void *spdm_context,
+					  IN OUT uintn *response_size,
+					  IN OUT void *response,
+					  IN uint64 timeout)
+{
+	spdm_test_context_t *spdm_test_context;
+
+	spdm_test_context = get_spdm_test_context();
+	return spdm_unit_test_encode_encap_response(
+		spdm_context, FALSE, m_receive_count++,
+		spdm_test_context->test_buffer_size,
+		spdm_test_context->test_buffer, response_size, response);
+}
+
+boolean setup_spdm_requester_encap_digests_context(
+	IN spdm_test_context_t *spdm_test_context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_unit_test_set_negotiated_state(spdm_context, TRUE);
+	if (!spdm_unit_test_provision(spdm_context, TRUE)) {
+		return FALSE;
+	}
+	return TRUE;
+}
+
+void test_spdm_requester_encap_digests(void **State)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+
+	spdm_test_context = *State;
+	spdm_context = spdm_test_context->spdm_context;
+
+	m_receive_count = 0;
+	libspdm_send_receive_encap_request(spdm_context, NULL);
+}
+
+spdm_test_context_t m_spdm_requester_encap_digests_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	TRUE,
+	spdm_device_send_message,
+	spdm_device_receive_message,
+};
+
+void run_test_harness(IN void *test_buffer, IN uintn test_buffer_size)
+{
+	void *State;
+
+	setup_spdm_test_context(&m_spdm_requester_encap_digests_test_context);
+
+	m_spdm_requester_encap_digests_test_context.test_buffer = test_buffer;
+	m_spdm_requester_encap_digests_test_context.test_buffer_size =
+		test_buffer_size;
+
+	if (spdm_unit_test_group_setup_persistent(
+		    &State, setup_spdm_requester_encap_digests_context) != 0) {
+		printf("error - fail to set up the SPDM context\n");
+		exit(1);
+	}
+
+	test_spdm_requester_encap_digests(&State);
+}
@@ -0,0 +1,100 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_fuzzing.h"
+#include "toolchain_harness.h"
+#include <internal/libspdm_requester_lib.h>
+#include <spdm_device_secret_lib_internal.h>
+
+//
+// Placeholder of message K, the KEY_EXCHANGE or PSK_EXCHANGE request and response of the session.
+//
+static uint8 m_spdm_message_k[0x80];
+
+uintn get_max_buffer_size(void)
+{
+	return MAX_SPDM_MESSAGE_BUFFER_SIZE;
+}
+
+return_status spdm_device_send_message(IN void *spdm_context,
+				       IN uintn request_size, IN void *request,
+				       IN uint64 timeout)
+{
+	return RETURN_SUCCESS;
+}
+
+return_status spdm_device_receive_message(IN void *spdm_context,
+					  IN OUT uintn *response_size,
+					  IN OUT void *response,
+					  IN uint64 timeout)
+{
+	spdm_test_context_t *spdm_test_context;
+
+	spdm_test_context = get_spdm_test_context();
+	return spdm_unit_test_encode_secured_response(
+		spdm_context, spdm_test_context->test_buffer_size,
+		spdm_test_context->test_buffer, response_size, response);
+}
+
+boolean
+setup_spdm_requester_finish_context(IN spdm_test_context_t *spdm_test_context)
+{
+	spdm_context_t *spdm_context;
+	return_status status;
+
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_unit_test_set_negotiated_state(spdm_context, TRUE);
+	if (!spdm_unit_test_provision(spdm_context, TRUE)) {
+		return FALSE;
+	}
+	spdm_unit_test_set_session(spdm_context, FALSE,
+				   SPDM_SESSION_STATE_HANDSHAKING);
+	status = libspdm_append_message_k(spdm_context,
+					  &spdm_context->session_info[0], TRUE,
+					  m_spdm_message_k,
+					  sizeof(m_spdm_message_k));
+	if (RETURN_ERROR(status)) {
+		return FALSE;
+	}
+	return TRUE;
+}
+
+void test_spdm_requester_finish(void **State)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+
+	spdm_test_context = *State;
+	spdm_context = spdm_test_context->spdm_context;
+
+	spdm_send_receive_finish(spdm_context, SPDM_UNIT_TEST_SESSION_ID, 0);
+}
+
+spdm_test_context_t m_spdm_requester_finish_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	TRUE,
+	spdm_device_send_message,
+	spdm_device_receive_message,
+};
+
+void run_test_harness(IN void *test_buffer, IN uintn test_buffer_size)
+{
+	void *State;
+
+	setup_spdm_test_context(&m_spdm_requester_finish_test_context);
+
+	m_spdm_requester_finish_test_context.test_buffer = test_buffer;
+	m_spdm_requester_finish_test_context.test_buffer_size =
+		test_buffer_size;
+
+	if (spdm_unit_test_group_setup_persistent(
+		    &State, setup_spdm_requester_finish_context) != 0) {
+		printf("error - fail to set up the SPDM context\n");
+		exit(1);
+	}
+
+	test_spdm_requester_finish(&State);
+}
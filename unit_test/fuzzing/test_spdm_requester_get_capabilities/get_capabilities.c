@@ -35,6 +35,19 @@ return_status spdm_device_receive_message(IN void *spdm_context,
 	return RETURN_SUCCESS;
 }
 
+boolean
+setup_spdm_requester_get_capabilities_context(IN spdm_test_context_t *spdm_test_context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AFTER_VERSION;
+	spdm_context->connection_info.version.major_version = 1;
+	spdm_context->connection_info.version.minor_version = 1;
+	return TRUE;
+}
+
 void test_spdm_requester_get_capabilities(void **State)
 {
 	spdm_test_context_t *spdm_test_context;
@@ -46,7 +59,7 @@ void test_spdm_requester_get_capabilities(void **State)
 	spdm_get_capabilities(spdm_context);
 }
 
-spdm_test_context_t test_spdm_requester_context = {
+spdm_test_context_t m_spdm_requester_get_capabilities_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
 	spdm_device_send_message,
@@ -57,14 +70,17 @@ void run_test_harness(IN void *test_buffer, IN uintn test_buffer_size)
 {
 	void *State;
 
-	setup_spdm_test_context(&test_spdm_requester_context);
+	setup_spdm_test_context(&m_spdm_requester_get_capabilities_test_context);
 
-	test_spdm_requester_context.test_buffer = test_buffer;
-	test_spdm_requester_context.test_buffer_size = test_buffer_size;
+	m_spdm_requester_get_capabilities_test_context.test_buffer = test_buffer;
+	m_spdm_requester_get_capabilities_test_context.test_buffer_size =
+		test_buffer_size;
 
-	spdm_unit_test_group_setup(&State);
+	if (spdm_unit_test_group_setup_persistent(
+		    &State, setup_spdm_requester_get_capabilities_context) != 0) {
+		printf("error - fail to set up the SPDM context\n");
+		exit(1);
+	}
 
 	test_spdm_requester_get_capabilities(&State);
-
-	spdm_unit_test_group_teardown(&State);
 }
@@ -13,24 +13,37 @@ uintn get_max_buffer_size(void)
 	return MAX_SPDM_MESSAGE_BUFFER_SIZE;
 }
 
+boolean
+setup_spdm_responder_algorithms_context(IN spdm_test_context_t *spdm_test_context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
+	spdm_context->connection_info.version.major_version = 1;
+	spdm_context->connection_info.version.minor_version = 1;
+	return TRUE;
+}
+
 void test_spdm_responder_algorithms(void **State)
 {
 	spdm_test_context_t *spdm_test_context;
 	spdm_context_t *spdm_context;
 	uintn response_size;
 	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	response_size = sizeof(response);
 
 	spdm_test_context = *State;
 	spdm_context = spdm_test_context->spdm_context;
 
+	response_size = sizeof(response);
 	spdm_get_response_algorithms(spdm_context,
-				       spdm_test_context->test_buffer_size,
-				       spdm_test_context->test_buffer,
-				       &response_size, response);
+				     spdm_test_context->test_buffer_size,
+				     spdm_test_context->test_buffer,
+				     &response_size, response);
 }
 
-spdm_test_context_t test_spdm_responder_context = {
+spdm_test_context_t m_spdm_responder_algorithms_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	FALSE,
 };
@@ -38,14 +51,18 @@ spdm_test_context_t test_spdm_responder_context = {
 void run_test_harness(IN void *test_buffer, IN uintn test_buffer_size)
 {
 	void *State;
-	setup_spdm_test_context(&test_spdm_responder_context);
 
-	test_spdm_responder_context.test_buffer = test_buffer;
-	test_spdm_responder_context.test_buffer_size = test_buffer_size;
+	setup_spdm_test_context(&m_spdm_responder_algorithms_test_context);
 
-	spdm_unit_test_group_setup(&State);
+	m_spdm_responder_algorithms_test_context.test_buffer = test_buffer;
+	m_spdm_responder_algorithms_test_context.test_buffer_size =
+		test_buffer_size;
 
-	test_spdm_responder_algorithms(&State);
+	if (spdm_unit_test_group_setup_persistent(
+		    &State, setup_spdm_responder_algorithms_context) != 0) {
+		printf("error - fail to set up the SPDM context\n");
+		exit(1);
+	}
 
-	spdm_unit_test_group_teardown(&State);
+	test_spdm_responder_algorithms(&State);
 }
@@ -13,6 +13,17 @@ uintn get_max_buffer_size(void)
 	return MAX_SPDM_MESSAGE_BUFFER_SIZE;
 }
 
+boolean
+setup_spdm_responder_capabilities_context(IN spdm_test_context_t *spdm_test_context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AFTER_VERSION;
+	return TRUE;
+}
+
 void test_spdm_responder_capabilities(void **State)
 {
 	spdm_test_context_t *spdm_test_context;
@@ -30,7 +41,7 @@ void test_spdm_responder_capabilities(void **State)
 				       &response_size, response);
 }
 
-spdm_test_context_t test_spdm_responder_context = {
+spdm_test_context_t m_spdm_responder_capabilities_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	FALSE,
 };
@@ -38,15 +49,18 @@ spdm_test_context_t test_spdm_responder_context = {
 void run_test_harness(IN void *test_buffer, IN uintn test_buffer_size)
 {
 	void *State;
-	setup_spdm_test_context(&test_spdm_responder_context);
 
-	test_spdm_responder_context.test_buffer = test_buffer;
-	test_spdm_responder_context.test_buffer_size =
+	setup_spdm_test_context(&m_spdm_responder_capabilities_test_context);
+
+	m_spdm_responder_capabilities_test_context.test_buffer = test_buffer;
+	m_spdm_responder_capabilities_test_context.test_buffer_size =
 		test_buffer_size;
 
-	spdm_unit_test_group_setup(&State);
+	if (spdm_unit_test_group_setup_persistent(
+		    &State, setup_spdm_responder_capabilities_context) != 0) {
+		printf("error - fail to set up the SPDM context\n");
+		exit(1);
+	}
 
 	test_spdm_responder_capabilities(&State);
-
-	spdm_unit_test_group_teardown(&State);
 }
@@ -0,0 +1,75 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_fuzzing.h"
+#include "toolchain_harness.h"
+#include <internal/libspdm_responder_lib.h>
+#include <spdm_device_secret_lib_internal.h>
+
+uintn get_max_buffer_size(void)
+{
+	return MAX_SPDM_MESSAGE_BUFFER_SIZE;
+}
+
+boolean
+setup_spdm_responder_encapsulated_request_context(IN spdm_test_context_t *spdm_test_context)
+{
+	spdm_context_t *spdm_context;
+
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_unit_test_set_negotiated_state(spdm_context, FALSE);
+	if (!spdm_unit_test_provision(spdm_context, FALSE)) {
+		return FALSE;
+	}
+	spdm_unit_test_set_session(spdm_context, FALSE,
+				   SPDM_SESSION_STATE_HANDSHAKING);
+	spdm_context->encap_context.req_slot_id = 0;
+	spdm_init_mut_auth_encap_state(
+		spdm_context,
+		SPDM_KEY_EXCHANGE_RESPONSE_MUT_AUTH_REQUESTED_WITH_ENCAP_REQUEST);
+	return TRUE;
+}
+
+void test_spdm_responder_encapsulated_request(void **State)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+	spdm_test_context = *State;
+	spdm_context = spdm_test_context->spdm_context;
+
+	response_size = sizeof(response);
+	spdm_get_response_encapsulated_request(spdm_context,
+					       spdm_test_context->test_buffer_size,
+					       spdm_test_context->test_buffer,
+					       &response_size, response);
+}
+
+spdm_test_context_t m_spdm_responder_encapsulated_request_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	FALSE,
+};
+
+void run_test_harness(IN void *test_buffer, IN uintn test_buffer_size)
+{
+	void *State;
+
+	setup_spdm_test_context(&m_spdm_responder_encapsulated_request_test_context);
+
+	m_spdm_responder_encapsulated_request_test_context.test_buffer = test_buffer;
+	m_spdm_responder_encapsulated_request_test_context.test_buffer_size =
+		test_buffer_size;
+
+	if (spdm_unit_test_group_setup_persistent(
+		    &State, setup_spdm_responder_encapsulated_request_context) != 0) {
+		printf("error - fail to set up the SPDM context\n");
+		exit(1);
+	}
+
+	test_spdm_responder_encapsulated_request(&State);
+}
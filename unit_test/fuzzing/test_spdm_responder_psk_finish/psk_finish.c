@@ -0,0 +1,84 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_fuzzing.h"
+#include "toolchain_harness.h"
+#include <internal/libspdm_responder_lib.h>
+#include <spdm_device_secret_lib_internal.h>
+
+//
+// Placeholder of message K, the KEY_EXCHANGE or PSK_EXCHANGE request and response of the session.
+//
+static uint8 m_spdm_message_k[0x80];
+
+uintn get_max_buffer_size(void)
+{
+	return MAX_SPDM_MESSAGE_BUFFER_SIZE;
+}
+
+boolean
+setup_spdm_responder_psk_finish_context(IN spdm_test_context_t *spdm_test_context)
+{
+	spdm_context_t *spdm_context;
+	return_status status;
+
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_unit_test_set_negotiated_state(spdm_context, FALSE);
+	if (!spdm_unit_test_provision(spdm_context, FALSE)) {
+		return FALSE;
+	}
+	spdm_unit_test_set_session(spdm_context, TRUE,
+				   SPDM_SESSION_STATE_HANDSHAKING);
+	status = libspdm_append_message_k(spdm_context,
+					  &spdm_context->session_info[0], FALSE,
+					  m_spdm_message_k,
+					  sizeof(m_spdm_message_k));
+	if (RETURN_ERROR(status)) {
+		return FALSE;
+	}
+	return TRUE;
+}
+
+void test_spdm_responder_psk_finish(void **State)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+	spdm_test_context = *State;
+	spdm_context = spdm_test_context->spdm_context;
+
+	response_size = sizeof(response);
+	spdm_get_response_psk_finish(spdm_context,
+				     spdm_test_context->test_buffer_size,
+				     spdm_test_context->test_buffer,
+				     &response_size, response);
+}
+
+spdm_test_context_t m_spdm_responder_psk_finish_test_context = {
+	SPDM_TEST_CONTEXT_SIGNATURE,
+	FALSE,
+};
+
+void run_test_harness(IN void *test_buffer, IN uintn test_buffer_size)
+{
+	void *State;
+
+	setup_spdm_test_context(&m_spdm_responder_psk_finish_test_context);
+
+	m_spdm_responder_psk_finish_test_context.test_buffer = test_buffer;
+	m_spdm_responder_psk_finish_test_context.test_buffer_size =
+		test_buffer_size;
+
+	if (spdm_unit_test_group_setup_persistent(
+		    &State, setup_spdm_responder_psk_finish_context) != 0) {
+		printf("error - fail to set up the SPDM context\n");
+		exit(1);
+	}
+
+	test_spdm_responder_psk_finish(&State);
+}
@@ -45,9 +45,10 @@ void run_test_harness(IN void *test_buffer, IN uintn test_buffer_size)
 	m_spdm_responder_version_test_context.test_buffer_size =
 		test_buffer_size;
 
-	spdm_unit_test_group_setup(&State);
+	if (spdm_unit_test_group_setup_persistent(&State, NULL) != 0) {
+		printf("error - fail to set up the SPDM context\n");
+		exit(1);
+	}
 
 	test_spdm_responder_version(&State);
-
-	spdm_unit_test_group_teardown(&State);
 }
@@ -12,6 +12,8 @@
 #define TEST_MESSAGE_TYPE_SPDM 0x01
 #define TEST_MESSAGE_TYPE_SECURED_TEST 0x02
 
+#define TEST_ALIGNMENT 4
+
 typedef struct {
 	uint8 message_type;
 } test_message_header_t;
@@ -104,4 +106,237 @@ uint8 test_get_sequence_number(IN uint64 sequence_number,
 **/
 uint32 test_get_max_random_number_count(void);
 
+//
+// The loopback transport is a local stand-in of a transport serving many endpoints, such as MCTP.
+// Requests and responses are queued in memory, and the endpoint of each message is kept.
+// The responder side matches libspdm_responder_engine_send/receive_message_func.
+//
+
+/**
+  Drop all queued messages of the loopback transport.
+**/
+void test_loopback_reset(void);
+
+/**
+  Send a transport layer request message from an endpoint to the loopback responder.
+
+  @param  endpoint_id                   The requester endpoint.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to the message data buffer.
+
+  @retval RETURN_SUCCESS               The message is queued.
+  @retval RETURN_OUT_OF_RESOURCES      Too many messages are queued.
+**/
+return_status test_loopback_send_request(IN uint32 endpoint_id,
+					 IN uintn message_size,
+					 IN void *message);
+
+/**
+  Receive a transport layer response message sent by the loopback responder to an endpoint.
+
+  @param  endpoint_id                   The requester endpoint.
+  @param  message_size                  size in bytes of the message data buffer.
+                                       On input, it means the size in bytes of message data buffer.
+                                       On output, it means the size in bytes of the message.
+  @param  message                      A pointer to a destination buffer to store the message.
+
+  @retval RETURN_SUCCESS               The message is received.
+  @retval RETURN_NOT_READY             No message is queued for the endpoint.
+**/
+return_status test_loopback_receive_response(IN uint32 endpoint_id,
+					     IN OUT uintn *message_size,
+					     OUT void *message);
+
+/**
+  Send a transport layer response message from the loopback responder to an endpoint.
+**/
+return_status test_loopback_responder_send_message(IN void *spdm_responder_engine,
+						   IN uint32 endpoint_id,
+						   IN uintn message_size,
+						   IN void *message,
+						   IN uint64 timeout);
+
+/**
+  Receive the oldest transport layer request message of any endpoint in the loopback responder.
+  RETURN_NOT_READY is returned if no message is queued.
+**/
+return_status test_loopback_responder_receive_message(
+	IN void *spdm_responder_engine, OUT uint32 *endpoint_id,
+	IN OUT uintn *message_size, OUT void *message, IN uint64 timeout);
+
+//
+// The record transport wraps the device IO functions of an SPDM context. It records the transport
+// layer messages, as encoded by spdm_transport_test_encode_message, in a compact binary trace. The
+// trace also holds their time stamps and the random numbers drawn by the SPDM context.
+// The replay transport feeds the received messages and the random numbers of a trace back to an SPDM
+// context with the same configuration. It checks that the sent messages are the recorded ones, so that
+// the run is reproduced exactly without the peer. rnglib_record records and replays the random numbers.
+//
+// Only one SPDM context can be recorded or replayed at a time.
+//
+// The trace is a test_record_header_t, then the configuration blob of the caller, then the records.
+// Each record is the record type (uint8), then two unsigned LEB128 values: the time elapsed since the
+// previous record and the size of the data. The data follows.
+//
+#define TEST_RECORD_SIGNATURE SIGNATURE_32('S', 'T', 'R', 'C')
+#define TEST_RECORD_VERSION 1
+
+// The transport layer message sent by the recorded SPDM context.
+#define TEST_RECORD_TYPE_SEND 0x01
+// The transport layer message received by the recorded SPDM context.
+#define TEST_RECORD_TYPE_RECEIVE 0x02
+// The failure of receive_message, the data is the return_status (uint64).
+#define TEST_RECORD_TYPE_RECEIVE_ERROR 0x03
+// Random bytes drawn by the recorded SPDM context. Consecutive draws are merged.
+#define TEST_RECORD_TYPE_RANDOM 0x04
+
+#pragma pack(1)
+typedef struct {
+	uint32 signature;
+	uint16 version;
+	uint16 config_size;
+	// The time of the start of the recording. The time of each record is relative to the previous one.
+	uint64 start_time;
+} test_record_header_t;
+#pragma pack()
+
+/**
+  Start recording the device IO of an SPDM context to a trace.
+
+  The SPDM context registers test_record_send_message and test_record_receive_message as device IO
+  functions, which record the messages and call send_message and receive_message.
+  The random numbers drawn in send_message and receive_message are not recorded, as they belong to the
+  peer or to the transport.
+
+  @param  trace                         The buffer of the trace.
+  @param  trace_size                    The size in bytes of the buffer of the trace.
+  @param  config                        The configuration of the SPDM context, returned by test_replay_start.
+  @param  config_size                   The size in bytes of the configuration.
+  @param  get_time                      The function returning the time stamps, or NULL to record no time.
+  @param  send_message                  The device send function of the SPDM context.
+  @param  receive_message               The device receive function of the SPDM context.
+
+  @retval RETURN_SUCCESS               The recording is started.
+  @retval RETURN_INVALID_PARAMETER     The configuration is larger than 0xFFFF bytes.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer cannot hold the configuration.
+**/
+return_status test_record_start(OUT void *trace, IN uintn trace_size,
+				IN const void *config OPTIONAL,
+				IN uintn config_size,
+				IN libspdm_get_time_func get_time OPTIONAL,
+				IN libspdm_device_send_message_func send_message,
+				IN libspdm_device_receive_message_func receive_message);
+
+/**
+  Stop recording.
+
+  @param  trace_size                    The size in bytes of the trace.
+
+  @retval RETURN_SUCCESS               The trace is complete.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer of the trace was full, and the trace is truncated.
+**/
+return_status test_record_stop(OUT uintn *trace_size);
+
+/**
+  Record a message sent by the recorded SPDM context, and send it.
+
+  It matches libspdm_device_send_message_func.
+**/
+return_status test_record_send_message(IN void *spdm_context,
+				       IN uintn request_size, IN void *request,
+				       IN uint64 timeout);
+
+/**
+  Receive a message for the recorded SPDM context, and record it.
+
+  It matches libspdm_device_receive_message_func.
+**/
+return_status test_record_receive_message(IN void *spdm_context,
+					  IN OUT uintn *response_size,
+					  IN OUT void *response,
+					  IN uint64 timeout);
+
+/**
+  Record random bytes drawn by the recorded SPDM context.
+
+  It does nothing if no recording is started.
+
+  @param  data                          The random bytes.
+  @param  size                          The size in bytes of the random bytes.
+**/
+void test_record_random(IN const void *data, IN uintn size);
+
+/**
+  Start replaying a trace.
+
+  The SPDM context registers test_replay_send_message and test_replay_receive_message as device IO
+  functions. It must have the recorded configuration, and be in the state of the start of the recording.
+
+  @param  trace                         The trace. It must be kept until test_replay_stop.
+  @param  trace_size                    The size in bytes of the trace.
+  @param  config                        The configuration of the recorded SPDM context in the trace.
+  @param  config_size                   The size in bytes of the configuration.
+
+  @retval RETURN_SUCCESS               The replay is started.
+  @retval RETURN_UNSUPPORTED           The trace is not a trace of this version.
+  @retval RETURN_BAD_BUFFER_SIZE       The trace is truncated.
+**/
+return_status test_replay_start(IN const void *trace, IN uintn trace_size,
+				OUT const void **config OPTIONAL,
+				OUT uintn *config_size OPTIONAL);
+
+/**
+  Stop replaying a trace.
+
+  @retval RETURN_SUCCESS               The whole trace is replayed.
+  @retval RETURN_DEVICE_ERROR          The SPDM context diverged from the trace.
+  @retval RETURN_ABORTED               The replay stopped before the end of the trace.
+**/
+return_status test_replay_stop(void);
+
+/**
+  Check that a message sent by the replayed SPDM context is the recorded one.
+
+  It matches libspdm_device_send_message_func.
+  RETURN_DEVICE_ERROR is returned if the SPDM context diverged from the trace.
+**/
+return_status test_replay_send_message(IN void *spdm_context,
+				       IN uintn request_size, IN void *request,
+				       IN uint64 timeout);
+
+/**
+  Receive the recorded message for the replayed SPDM context.
+
+  It matches libspdm_device_receive_message_func.
+  A recorded failure of receive_message is returned as it was recorded.
+  RETURN_DEVICE_ERROR is returned if the SPDM context diverged from the trace.
+**/
+return_status test_replay_receive_message(IN void *spdm_context,
+					  IN OUT uintn *response_size,
+					  IN OUT void *response,
+					  IN uint64 timeout);
+
+/**
+  Return whether a trace is being replayed.
+**/
+boolean test_replay_is_active(void);
+
+/**
+  Get the recorded random bytes for the replayed SPDM context.
+
+  @param  data                          The random bytes.
+  @param  size                          The size in bytes of the random bytes.
+
+  @retval TRUE   The random bytes are returned.
+  @retval FALSE  The SPDM context diverged from the trace.
+**/
+boolean test_replay_random(OUT void *data, IN uintn size);
+
+/**
+  Return the recorded time of the last replayed record.
+
+  It matches libspdm_get_time_func, and stands for the clock of the recorded SPDM context.
+**/
+uint64 test_replay_get_time(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,424 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "bench_spdm_common.h"
+
+//
+// In record mode, the requester runs a flow against a responder in the same process, as in bench_spdm,
+// and its device IO is recorded to a trace. In replay mode, the requester runs the flow again from the
+// trace alone, with the random numbers and the clock of the trace, so that the run is reproduced exactly.
+//
+#define REPLAY_SPDM_MAX_TRACE_SIZE 0x100000
+
+#define REPLAY_SPDM_MAX_NAME_SIZE 48
+
+bench_spdm_algo_set_t m_replay_spdm_algo_set[] = {
+	{ "ecdsa_p384/secp_384_r1/aes_256_gcm",
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+	{ "ecdsa_p256/secp_256_r1/aes_128_gcm",
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM },
+	{ "rsassa_3072/ffdhe_3072/aes_256_gcm",
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+};
+
+//
+// The configuration of the recorded requester, saved in the trace.
+//
+typedef struct {
+	char8 algo_set[REPLAY_SPDM_MAX_NAME_SIZE];
+	char8 flow[REPLAY_SPDM_MAX_NAME_SIZE];
+} replay_spdm_config_t;
+
+typedef struct {
+	char8 *name;
+	bench_spdm_func run;
+} replay_spdm_flow_t;
+
+/**
+  Create the requester, with the device IO of the record or the replay transport.
+
+  In record mode, the responder is created too.
+**/
+return_status replay_spdm_setup(IN OUT bench_spdm_context_t *context,
+				IN boolean record)
+{
+	return_status status;
+
+	if (!record) {
+		status = bench_spdm_setup_requester(context,
+						    test_replay_send_message,
+						    test_replay_receive_message);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+		libspdm_register_get_time_func(context->requester_context,
+					       test_replay_get_time);
+		return RETURN_SUCCESS;
+	}
+
+	status = bench_spdm_setup_requester(context, test_record_send_message,
+					    test_record_receive_message);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	libspdm_register_get_time_func(context->requester_context,
+				       bench_get_time_ns);
+	return bench_spdm_setup_responder(context);
+}
+
+return_status replay_spdm_measurement(IN bench_spdm_context_t *context)
+{
+	return_status status;
+
+	status = bench_spdm_prepare_authentication(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	return bench_spdm_get_measurement(context);
+}
+
+/**
+  Exchange an APP message in the session, update the keys and stop the session.
+**/
+return_status replay_spdm_session(IN bench_spdm_context_t *context)
+{
+	return_status status;
+
+	status = bench_spdm_send_receive_data(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	status = bench_spdm_key_update(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	return bench_spdm_stop_session(context);
+}
+
+return_status replay_spdm_key_exchange(IN bench_spdm_context_t *context)
+{
+	return_status status;
+
+	status = bench_spdm_prepare_certificate(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	status = bench_spdm_key_exchange(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	return replay_spdm_session(context);
+}
+
+return_status replay_spdm_psk_exchange(IN bench_spdm_context_t *context)
+{
+	return_status status;
+
+	status = bench_spdm_init_connection(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	status = bench_spdm_psk_exchange(context);
+	if (RETURN_ERROR(status)) {
+		return status;
+	}
+	return replay_spdm_session(context);
+}
+
+replay_spdm_flow_t m_replay_spdm_flow[] = {
+	{ "init_connection", bench_spdm_init_connection },
+	{ "authentication", bench_spdm_prepare_authentication },
+	{ "measurement", replay_spdm_measurement },
+	{ "key_exchange_session", replay_spdm_key_exchange },
+	{ "psk_exchange_session", replay_spdm_psk_exchange },
+};
+
+void replay_spdm_print_usage(IN char *tool_name)
+{
+	uintn index;
+
+	printf("Usage: %s record <trace> <flow> [<algo_set>]\n", tool_name);
+	printf("       %s replay <trace> [-n <iterations>] [-o <file>]\n",
+	       tool_name);
+	printf("  record   Run a flow against the responder, and record the requester to the trace.\n");
+	printf("  replay   Run the requester of the trace from the trace alone, and report its latency.\n");
+	printf("  -n <iterations>   Number of timed replays (default %d).\n",
+	       BENCH_DEFAULT_ITERATIONS);
+	printf("  -o <file>         Write the JSON report to file, \"-\" for stdout (default <tool>.json).\n");
+	printf("Flows:");
+	for (index = 0; index < ARRAY_SIZE(m_replay_spdm_flow); index++) {
+		printf(" %s", m_replay_spdm_flow[index].name);
+	}
+	printf("\nAlgorithm sets:");
+	for (index = 0; index < ARRAY_SIZE(m_replay_spdm_algo_set); index++) {
+		printf(" %s", m_replay_spdm_algo_set[index].name);
+	}
+	printf("\n");
+}
+
+replay_spdm_flow_t *replay_spdm_find_flow(IN const char8 *name)
+{
+	uintn index;
+
+	for (index = 0; index < ARRAY_SIZE(m_replay_spdm_flow); index++) {
+		if (strcmp(m_replay_spdm_flow[index].name, name) == 0) {
+			return &m_replay_spdm_flow[index];
+		}
+	}
+	return NULL;
+}
+
+bench_spdm_algo_set_t *replay_spdm_find_algo_set(IN const char8 *name)
+{
+	uintn index;
+
+	for (index = 0; index < ARRAY_SIZE(m_replay_spdm_algo_set); index++) {
+		if (strcmp(m_replay_spdm_algo_set[index].name, name) == 0) {
+			return &m_replay_spdm_algo_set[index];
+		}
+	}
+	return NULL;
+}
+
+/**
+  Run a flow against the responder, and write the trace of the requester to a file.
+**/
+int replay_spdm_record(IN char8 *trace_file, IN replay_spdm_flow_t *flow,
+		       IN bench_spdm_algo_set_t *algo_set)
+{
+	bench_spdm_context_t context;
+	replay_spdm_config_t config;
+	uint8 *trace;
+	uintn trace_size;
+	return_status status;
+	return_status record_status;
+	FILE *file;
+
+	trace = (void *)malloc(REPLAY_SPDM_MAX_TRACE_SIZE);
+	if ((trace == NULL) || !bench_spdm_init_responder_engine()) {
+		return 1;
+	}
+
+	zero_mem(&context, sizeof(context));
+	context.algo_set = algo_set;
+	status = replay_spdm_setup(&context, TRUE);
+	if (!RETURN_ERROR(status)) {
+		zero_mem(&config, sizeof(config));
+		strncpy(config.algo_set, algo_set->name,
+			sizeof(config.algo_set) - 1);
+		strncpy(config.flow, flow->name, sizeof(config.flow) - 1);
+		status = test_record_start(trace, REPLAY_SPDM_MAX_TRACE_SIZE,
+					   &config, sizeof(config),
+					   bench_get_time_ns,
+					   bench_spdm_send_message,
+					   bench_spdm_receive_message);
+	}
+	if (!RETURN_ERROR(status)) {
+		status = flow->run(&context);
+		record_status = test_record_stop(&trace_size);
+		if (!RETURN_ERROR(status)) {
+			status = record_status;
+		}
+	}
+	bench_spdm_teardown(&context);
+	bench_spdm_free_responder_engine();
+	if (RETURN_ERROR(status)) {
+		printf("%s %s failed - status 0x%llx\n", algo_set->name,
+		       flow->name, (unsigned long long)status);
+		free(trace);
+		return 1;
+	}
+
+	file = fopen(trace_file, "wb");
+	if (file == NULL) {
+		printf("Unable to create file %s\n", trace_file);
+		free(trace);
+		return 1;
+	}
+	if (fwrite(trace, 1, trace_size, file) != trace_size) {
+		printf("Write output file error %s\n", trace_file);
+		fclose(file);
+		free(trace);
+		return 1;
+	}
+	fclose(file);
+	free(trace);
+	printf("%s %s recorded to %s (%llu bytes)\n", algo_set->name,
+	       flow->name, trace_file, (unsigned long long)trace_size);
+	return 0;
+}
+
+/**
+  Replay the requester of a trace, and report the latency of the replays.
+
+  The first replay is not timed, and warms up the caches.
+**/
+int replay_spdm_replay(IN char8 *trace_file, IN bench_options_t *options)
+{
+	bench_spdm_context_t context;
+	replay_spdm_config_t config;
+	replay_spdm_flow_t *flow;
+	const void *config_data;
+	uintn config_size;
+	void *trace;
+	uintn trace_size;
+	uint64 *sample;
+	uint64 start_time;
+	uint64 recorded_time;
+	uintn count;
+	uintn index;
+	bench_statistics_t statistics;
+	bench_report_t report;
+	return_status status;
+	return_status replay_status;
+
+	if (!read_input_file(trace_file, &trace, &trace_size)) {
+		return 1;
+	}
+	sample = (void *)malloc(options->iterations * sizeof(uint64));
+	if (sample == NULL) {
+		free(trace);
+		return 1;
+	}
+
+	zero_mem(&context, sizeof(context));
+	status = test_replay_start(trace, trace_size, &config_data,
+				   &config_size);
+	if (!RETURN_ERROR(status)) {
+		test_replay_stop();
+		if (config_size != sizeof(config)) {
+			status = RETURN_UNSUPPORTED;
+		}
+	}
+	if (RETURN_ERROR(status)) {
+		printf("Invalid trace %s - status 0x%llx\n", trace_file,
+		       (unsigned long long)status);
+		free(sample);
+		free(trace);
+		return 1;
+	}
+	copy_mem(&config, config_data, sizeof(config));
+	config.algo_set[sizeof(config.algo_set) - 1] = 0;
+	config.flow[sizeof(config.flow) - 1] = 0;
+	context.algo_set = replay_spdm_find_algo_set(config.algo_set);
+	flow = replay_spdm_find_flow(config.flow);
+	if ((context.algo_set == NULL) || (flow == NULL)) {
+		printf("Unknown configuration %s %s in %s\n", config.algo_set,
+		       config.flow, trace_file);
+		free(sample);
+		free(trace);
+		return 1;
+	}
+
+	count = 0;
+	recorded_time = 0;
+	for (index = 0; index <= options->iterations; index++) {
+		status = replay_spdm_setup(&context, FALSE);
+		if (RETURN_ERROR(status)) {
+			bench_spdm_teardown(&context);
+			break;
+		}
+		start_time = bench_get_time_ns();
+		status = test_replay_start(trace, trace_size, NULL, NULL);
+		recorded_time = test_replay_get_time();
+		if (!RETURN_ERROR(status)) {
+			status = flow->run(&context);
+			replay_status = test_replay_stop();
+			if (!RETURN_ERROR(status)) {
+				status = replay_status;
+			}
+		}
+		if (index != 0) {
+			sample[count] = bench_get_time_ns() - start_time;
+		}
+		recorded_time = test_replay_get_time() - recorded_time;
+		bench_spdm_teardown(&context);
+		if (RETURN_ERROR(status)) {
+			break;
+		}
+		if (index != 0) {
+			count++;
+		}
+	}
+
+	if (!bench_report_open(&report, options, "replay_spdm")) {
+		free(sample);
+		free(trace);
+		return 1;
+	}
+	bench_compute_statistics(sample, count, &statistics);
+	bench_report_add_result(&report, config.algo_set, config.flow, status,
+				&statistics);
+	bench_report_close(&report);
+	printf("%-48s %-24s status 0x%llx recorded %llu ns replay p50 %llu ns p99 %llu ns\n",
+	       config.algo_set, config.flow, (unsigned long long)status,
+	       (unsigned long long)recorded_time,
+	       (unsigned long long)statistics.p50,
+	       (unsigned long long)statistics.p99);
+
+	free(sample);
+	free(trace);
+	return RETURN_ERROR(status) ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+	bench_options_t options;
+	replay_spdm_flow_t *flow;
+	bench_spdm_algo_set_t *algo_set;
+	int index;
+
+	if ((argc >= 4) && (argc <= 5) && (strcmp(argv[1], "record") == 0)) {
+		flow = replay_spdm_find_flow(argv[3]);
+		algo_set = (argc == 5) ? replay_spdm_find_algo_set(argv[4]) :
+					 &m_replay_spdm_algo_set[0];
+		if ((flow == NULL) || (algo_set == NULL)) {
+			replay_spdm_print_usage(argv[0]);
+			return 1;
+		}
+		return replay_spdm_record(argv[2], flow, algo_set);
+	}
+
+	if ((argc < 3) || (strcmp(argv[1], "replay") != 0)) {
+		replay_spdm_print_usage(argv[0]);
+		return 1;
+	}
+	options.iterations = BENCH_DEFAULT_ITERATIONS;
+	options.output_file = NULL;
+	options.filter = NULL;
+	for (index = 3; index < argc; index += 2) {
+		if (index + 1 >= argc) {
+			replay_spdm_print_usage(argv[0]);
+			return 1;
+		}
+		if (strcmp(argv[index], "-n") == 0) {
+			options.iterations =
+				(uintn)strtoul(argv[index + 1], NULL, 0);
+			if (options.iterations == 0) {
+				replay_spdm_print_usage(argv[0]);
+				return 1;
+			}
+		} else if (strcmp(argv[index], "-o") == 0) {
+			options.output_file = argv[index + 1];
+		} else {
+			replay_spdm_print_usage(argv[0]);
+			return 1;
+		}
+	}
+	return replay_spdm_replay(argv[2], &options);
+}
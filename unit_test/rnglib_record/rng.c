@@ -0,0 +1,44 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <library/spdm_transport_test_lib.h>
+
+#include <stdlib.h>
+
+/**
+  Generates a 64-bit random number.
+
+  When a trace is replayed, the random number is the recorded one.
+  Otherwise it is generated as by rnglib_std, and recorded if a recording is started.
+
+  if rand is NULL, then ASSERT().
+
+  @param[out] rand_data     buffer pointer to store the 64-bit random value.
+
+  @retval TRUE         Random number generated successfully.
+  @retval FALSE        Failed to generate the random number.
+**/
+boolean get_random_number_64(OUT uint64 *rand_data)
+{
+	uint8 *ptr;
+
+	if (test_replay_is_active()) {
+		return test_replay_random(rand_data, sizeof(*rand_data));
+	}
+
+	ptr = (uint8 *)rand_data;
+	ptr[0] = (uint8)rand();
+	ptr[1] = (uint8)rand();
+	ptr[2] = (uint8)rand();
+	ptr[3] = (uint8)rand();
+	ptr[4] = (uint8)rand();
+	ptr[5] = (uint8)rand();
+	ptr[6] = (uint8)rand();
+	ptr[7] = (uint8)rand();
+
+	test_record_random(rand_data, sizeof(*rand_data));
+	return TRUE;
+}
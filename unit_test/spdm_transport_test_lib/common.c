@@ -113,10 +113,9 @@ return_status spdm_transport_test_encode_message(
 {
 	return_status status;
 	transport_encode_message_func transport_encode_message;
-	uint8 app_message_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
-	void *app_message;
+	uint8 *app_message;
 	uintn app_message_size;
-	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *secured_message;
 	uintn secured_message_size;
 	spdm_secured_message_callbacks_t spdm_secured_message_callbacks_t;
 	void *secured_message_context;
@@ -141,14 +140,34 @@ return_status spdm_transport_test_encode_message(
 			return RETURN_UNSUPPORTED;
 		}
 
+		//
+		// The secured message is encoded in place, after the transport header.
+		//
+		if (*transport_message_size <= sizeof(test_message_header_t)) {
+			return RETURN_BUFFER_TOO_SMALL;
+		}
+		secured_message = (uint8 *)transport_message +
+				  sizeof(test_message_header_t);
+		secured_message_size =
+			*transport_message_size - sizeof(test_message_header_t);
+
 		if (!is_app_message) {
-			// SPDM message to APP message
-			app_message = app_message_buffer;
-			app_message_size = sizeof(app_message_buffer);
+			//
+			// SPDM message to APP message, at the end of the transport message.
+			// It only moves forward when it is encoded to the secured message.
+			//
+			app_message_size = sizeof(test_message_header_t) +
+					   ((message_size + (TEST_ALIGNMENT - 1)) &
+					    ~(TEST_ALIGNMENT - 1));
+			if (app_message_size > secured_message_size) {
+				return RETURN_BUFFER_TOO_SMALL;
+			}
+			app_message = secured_message + secured_message_size -
+				      app_message_size;
 			status = transport_encode_message(NULL, message_size,
 							  message,
 							  &app_message_size,
-							  app_message_buffer);
+							  app_message);
 			if (RETURN_ERROR(status)) {
 				DEBUG((DEBUG_ERROR,
 				       "transport_encode_message - %p\n",
@@ -160,18 +179,21 @@ return_status spdm_transport_test_encode_message(
 			app_message_size = message_size;
 		}
 		// APP message to secured message
-		secured_message_size = sizeof(secured_message);
+		libspdm_trace(spdm_context, SPDM_TRACE_PHASE_SECURED_MESSAGE_ENCODE,
+			      SPDM_TRACE_EVENT_BEGIN);
 		status = spdm_encode_secured_message(
 			secured_message_context, *session_id, is_requester,
 			app_message_size, app_message, &secured_message_size,
 			secured_message, &spdm_secured_message_callbacks_t);
+		libspdm_trace(spdm_context, SPDM_TRACE_PHASE_SECURED_MESSAGE_ENCODE,
+			      SPDM_TRACE_EVENT_END);
 		if (RETURN_ERROR(status)) {
 			DEBUG((DEBUG_ERROR,
 			       "spdm_encode_secured_message - %p\n", status));
 			return status;
 		}
 
-		// secured message to secured MCTP message
+		// secured message to secured MCTP message, in place
 		status = transport_encode_message(
 			session_id, secured_message_size, secured_message,
 			transport_message_size, transport_message);
@@ -230,9 +252,10 @@ return_status spdm_transport_test_decode_message(
 	return_status status;
 	transport_decode_message_func transport_decode_message;
 	uint32 *SecuredMessageSessionId;
-	uint8 secured_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 message_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *secured_message;
 	uintn secured_message_size;
-	uint8 app_message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uint8 *app_message;
 	uintn app_message_size;
 	spdm_secured_message_callbacks_t spdm_secured_message_callbacks_t;
 	void *secured_message_context;
@@ -255,9 +278,16 @@ return_status spdm_transport_test_decode_message(
 
 	transport_decode_message = test_decode_message;
 
+	//
+	// The secured message is copied out of the transport message,
+	// then it is decrypted to the APP message in the same buffer.
+	//
+	secured_message = message_buffer;
+	app_message = message_buffer;
+
 	SecuredMessageSessionId = NULL;
 	// Detect received message
-	secured_message_size = sizeof(secured_message);
+	secured_message_size = sizeof(message_buffer);
 	status = transport_decode_message(
 		&SecuredMessageSessionId, transport_message_size,
 		transport_message, &secured_message_size, secured_message);
@@ -281,12 +311,16 @@ return_status spdm_transport_test_decode_message(
 		}
 
 		// Secured message to APP message
-		app_message_size = sizeof(app_message);
+		app_message_size = sizeof(message_buffer);
+		libspdm_trace(spdm_context, SPDM_TRACE_PHASE_SECURED_MESSAGE_DECODE,
+			      SPDM_TRACE_EVENT_BEGIN);
 		status = spdm_decode_secured_message(
 			secured_message_context, *SecuredMessageSessionId,
 			is_requester, secured_message_size, secured_message,
 			&app_message_size, app_message,
 			&spdm_secured_message_callbacks_t);
+		libspdm_trace(spdm_context, SPDM_TRACE_PHASE_SECURED_MESSAGE_DECODE,
+			      SPDM_TRACE_EVENT_END);
 		if (RETURN_ERROR(status)) {
 			DEBUG((DEBUG_ERROR,
 			       "spdm_decode_secured_message - %p\n", status));
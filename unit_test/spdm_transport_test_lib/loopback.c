@@ -0,0 +1,183 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <library/spdm_transport_test_lib.h>
+
+#define TEST_LOOPBACK_MAX_MESSAGE_COUNT 8
+
+typedef struct {
+	uint32 endpoint_id;
+	uintn message_size;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+} test_loopback_message_t;
+
+typedef struct {
+	uintn message_count;
+	test_loopback_message_t message[TEST_LOOPBACK_MAX_MESSAGE_COUNT];
+} test_loopback_queue_t;
+
+static test_loopback_queue_t m_test_loopback_request_queue;
+static test_loopback_queue_t m_test_loopback_response_queue;
+
+/**
+  Append a message to the tail of a loopback queue.
+
+  @param  queue                        The loopback queue.
+  @param  endpoint_id                   The endpoint of the message.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to the message data buffer.
+
+  @retval RETURN_SUCCESS               The message is queued.
+  @retval RETURN_BUFFER_TOO_SMALL      The message is too large.
+  @retval RETURN_OUT_OF_RESOURCES      The queue is full.
+**/
+static return_status test_loopback_push(IN test_loopback_queue_t *queue,
+					IN uint32 endpoint_id,
+					IN uintn message_size,
+					IN void *message)
+{
+	test_loopback_message_t *entry;
+
+	if (message_size > MAX_SPDM_MESSAGE_BUFFER_SIZE) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	if (queue->message_count >= TEST_LOOPBACK_MAX_MESSAGE_COUNT) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	entry = &queue->message[queue->message_count];
+	entry->endpoint_id = endpoint_id;
+	entry->message_size = message_size;
+	copy_mem(entry->message, message, message_size);
+	queue->message_count++;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Remove the oldest message from a loopback queue.
+
+  @param  queue                        The loopback queue.
+  @param  any_endpoint                  TRUE to remove the oldest message of any endpoint.
+  @param  endpoint_id                   On input, the endpoint of the message if any_endpoint is FALSE.
+                                       On output, the endpoint of the message.
+  @param  message_size                  size in bytes of the message data buffer.
+                                       On input, it means the size in bytes of message data buffer.
+                                       On output, it means the size in bytes of the message.
+  @param  message                      A pointer to a destination buffer to store the message.
+
+  @retval RETURN_SUCCESS               The message is removed.
+  @retval RETURN_NOT_READY             No message is queued.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small to hold the message.
+**/
+static return_status test_loopback_pop(IN test_loopback_queue_t *queue,
+				       IN boolean any_endpoint,
+				       IN OUT uint32 *endpoint_id,
+				       IN OUT uintn *message_size,
+				       OUT void *message)
+{
+	uintn index;
+	test_loopback_message_t *entry;
+
+	for (index = 0; index < queue->message_count; index++) {
+		entry = &queue->message[index];
+		if (any_endpoint || (entry->endpoint_id == *endpoint_id)) {
+			break;
+		}
+	}
+	if (index == queue->message_count) {
+		return RETURN_NOT_READY;
+	}
+	if (*message_size < entry->message_size) {
+		*message_size = entry->message_size;
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	*endpoint_id = entry->endpoint_id;
+	*message_size = entry->message_size;
+	copy_mem(message, entry->message, entry->message_size);
+
+	queue->message_count--;
+	copy_mem(entry, entry + 1,
+		 (queue->message_count - index) *
+			 sizeof(test_loopback_message_t));
+	return RETURN_SUCCESS;
+}
+
+/**
+  Drop all queued messages of the loopback transport.
+**/
+void test_loopback_reset(void)
+{
+	zero_mem(&m_test_loopback_request_queue,
+		 sizeof(m_test_loopback_request_queue));
+	zero_mem(&m_test_loopback_response_queue,
+		 sizeof(m_test_loopback_response_queue));
+}
+
+/**
+  Send a transport layer request message from an endpoint to the loopback responder.
+
+  @param  endpoint_id                   The requester endpoint.
+  @param  message_size                  size in bytes of the message data buffer.
+  @param  message                      A pointer to the message data buffer.
+
+  @retval RETURN_SUCCESS               The message is queued.
+  @retval RETURN_OUT_OF_RESOURCES      Too many messages are queued.
+**/
+return_status test_loopback_send_request(IN uint32 endpoint_id,
+					 IN uintn message_size,
+					 IN void *message)
+{
+	return test_loopback_push(&m_test_loopback_request_queue, endpoint_id,
+				  message_size, message);
+}
+
+/**
+  Receive a transport layer response message sent by the loopback responder to an endpoint.
+
+  @param  endpoint_id                   The requester endpoint.
+  @param  message_size                  size in bytes of the message data buffer.
+                                       On input, it means the size in bytes of message data buffer.
+                                       On output, it means the size in bytes of the message.
+  @param  message                      A pointer to a destination buffer to store the message.
+
+  @retval RETURN_SUCCESS               The message is received.
+  @retval RETURN_NOT_READY             No message is queued for the endpoint.
+**/
+return_status test_loopback_receive_response(IN uint32 endpoint_id,
+					     IN OUT uintn *message_size,
+					     OUT void *message)
+{
+	return test_loopback_pop(&m_test_loopback_response_queue, FALSE,
+				 &endpoint_id, message_size, message);
+}
+
+/**
+  Send a transport layer response message from the loopback responder to an endpoint.
+
+  This function matches libspdm_responder_engine_send_message_func.
+**/
+return_status test_loopback_responder_send_message(IN void *spdm_responder_engine,
+						   IN uint32 endpoint_id,
+						   IN uintn message_size,
+						   IN void *message,
+						   IN uint64 timeout)
+{
+	return test_loopback_push(&m_test_loopback_response_queue, endpoint_id,
+				  message_size, message);
+}
+
+/**
+  Receive the oldest transport layer request message of any endpoint in the loopback responder.
+
+  This function matches libspdm_responder_engine_receive_message_func.
+  It does not wait, RETURN_NOT_READY is returned if no message is queued.
+**/
+return_status test_loopback_responder_receive_message(
+	IN void *spdm_responder_engine, OUT uint32 *endpoint_id,
+	IN OUT uintn *message_size, OUT void *message, IN uint64 timeout)
+{
+	return test_loopback_pop(&m_test_loopback_request_queue, TRUE,
+				 endpoint_id, message_size, message);
+}
@@ -0,0 +1,571 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <library/spdm_transport_test_lib.h>
+
+// Consecutive random draws are merged in one record of up to this size.
+#define TEST_RECORD_RANDOM_BUFFER_SIZE 256
+
+// The maximum size in bytes of an unsigned LEB128 encoded uint64.
+#define TEST_RECORD_MAX_VARINT_SIZE 10
+
+typedef struct {
+	boolean active;
+	// The buffer of the trace was full, and a record was dropped.
+	boolean overflow;
+	// Set while the device IO functions run, whose random draws are not recorded.
+	boolean in_device_io;
+	uint8 *trace;
+	uintn trace_size;
+	uintn offset;
+	libspdm_get_time_func get_time;
+	uint64 last_time;
+	libspdm_device_send_message_func send_message;
+	libspdm_device_receive_message_func receive_message;
+	// The pending random record.
+	uint64 random_time;
+	uintn random_size;
+	uint8 random[TEST_RECORD_RANDOM_BUFFER_SIZE];
+} test_record_state_t;
+
+typedef struct {
+	boolean active;
+	// The SPDM context diverged from the trace.
+	boolean diverged;
+	const uint8 *trace;
+	uintn trace_size;
+	uintn offset;
+	uint64 time;
+	// The rest of the random record being replayed.
+	const uint8 *random;
+	uintn random_size;
+} test_replay_state_t;
+
+static test_record_state_t m_test_record;
+static test_replay_state_t m_test_replay;
+
+/**
+  Encode a value as unsigned LEB128.
+
+  @param  value                         The value.
+  @param  buffer                        The buffer of TEST_RECORD_MAX_VARINT_SIZE bytes.
+
+  @return The size in bytes of the encoded value.
+**/
+static uintn test_record_encode_varint(IN uint64 value, OUT uint8 *buffer)
+{
+	uintn size;
+
+	size = 0;
+	while (value >= 0x80) {
+		buffer[size++] = (uint8)(value | 0x80);
+		value >>= 7;
+	}
+	buffer[size++] = (uint8)value;
+	return size;
+}
+
+static uint64 test_record_get_time(void)
+{
+	if (m_test_record.get_time == NULL) {
+		return 0;
+	}
+	return m_test_record.get_time();
+}
+
+/**
+  Append a record to the trace.
+
+  If the buffer of the trace cannot hold the record, it is dropped and the trace is marked as truncated.
+
+  @param  type                          The record type.
+  @param  time                          The time stamp of the record.
+  @param  data                          The data of the record.
+  @param  size                          The size in bytes of the data.
+**/
+static void test_record_append(IN uint8 type, IN uint64 time,
+			       IN const void *data, IN uintn size)
+{
+	uint8 time_buffer[TEST_RECORD_MAX_VARINT_SIZE];
+	uint8 size_buffer[TEST_RECORD_MAX_VARINT_SIZE];
+	uintn time_size;
+	uintn size_size;
+	uint8 *pointer;
+
+	if (m_test_record.overflow) {
+		return;
+	}
+	time_size = test_record_encode_varint(
+		(time > m_test_record.last_time) ?
+			time - m_test_record.last_time : 0,
+		time_buffer);
+	size_size = test_record_encode_varint(size, size_buffer);
+	if (m_test_record.trace_size - m_test_record.offset <
+	    sizeof(type) + time_size + size_size + size) {
+		m_test_record.overflow = TRUE;
+		return;
+	}
+
+	pointer = m_test_record.trace + m_test_record.offset;
+	*pointer = type;
+	pointer += sizeof(type);
+	copy_mem(pointer, time_buffer, time_size);
+	pointer += time_size;
+	copy_mem(pointer, size_buffer, size_size);
+	pointer += size_size;
+	copy_mem(pointer, data, size);
+	pointer += size;
+	m_test_record.offset = pointer - m_test_record.trace;
+	if (time > m_test_record.last_time) {
+		m_test_record.last_time = time;
+	}
+}
+
+/**
+  Append the pending random record to the trace.
+**/
+static void test_record_flush_random(void)
+{
+	if (m_test_record.random_size == 0) {
+		return;
+	}
+	test_record_append(TEST_RECORD_TYPE_RANDOM, m_test_record.random_time,
+			   m_test_record.random, m_test_record.random_size);
+	m_test_record.random_size = 0;
+}
+
+/**
+  Start recording the device IO of an SPDM context to a trace.
+
+  @param  trace                         The buffer of the trace.
+  @param  trace_size                    The size in bytes of the buffer of the trace.
+  @param  config                        The configuration of the SPDM context, returned by test_replay_start.
+  @param  config_size                   The size in bytes of the configuration.
+  @param  get_time                      The function returning the time stamps, or NULL to record no time.
+  @param  send_message                  The device send function of the SPDM context.
+  @param  receive_message               The device receive function of the SPDM context.
+
+  @retval RETURN_SUCCESS               The recording is started.
+  @retval RETURN_INVALID_PARAMETER     The configuration is larger than 0xFFFF bytes.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer cannot hold the configuration.
+**/
+return_status test_record_start(OUT void *trace, IN uintn trace_size,
+				IN const void *config OPTIONAL,
+				IN uintn config_size,
+				IN libspdm_get_time_func get_time OPTIONAL,
+				IN libspdm_device_send_message_func send_message,
+				IN libspdm_device_receive_message_func receive_message)
+{
+	test_record_header_t header;
+
+	if (config_size > 0xFFFF) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	if (trace_size < sizeof(header) + config_size) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+
+	zero_mem(&m_test_record, sizeof(m_test_record));
+	m_test_record.trace = trace;
+	m_test_record.trace_size = trace_size;
+	m_test_record.get_time = get_time;
+	m_test_record.send_message = send_message;
+	m_test_record.receive_message = receive_message;
+	m_test_record.last_time = test_record_get_time();
+
+	header.signature = TEST_RECORD_SIGNATURE;
+	header.version = TEST_RECORD_VERSION;
+	header.config_size = (uint16)config_size;
+	header.start_time = m_test_record.last_time;
+	copy_mem(m_test_record.trace, &header, sizeof(header));
+	if (config_size != 0) {
+		copy_mem(m_test_record.trace + sizeof(header), config,
+			 config_size);
+	}
+	m_test_record.offset = sizeof(header) + config_size;
+	m_test_record.active = TRUE;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Stop recording.
+
+  @param  trace_size                    The size in bytes of the trace.
+
+  @retval RETURN_SUCCESS               The trace is complete.
+  @retval RETURN_BUFFER_TOO_SMALL      The buffer of the trace was full, and the trace is truncated.
+**/
+return_status test_record_stop(OUT uintn *trace_size)
+{
+	test_record_flush_random();
+	m_test_record.active = FALSE;
+	*trace_size = m_test_record.offset;
+	if (m_test_record.overflow) {
+		return RETURN_BUFFER_TOO_SMALL;
+	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  Record a message sent by the recorded SPDM context, and send it.
+
+  It matches libspdm_device_send_message_func.
+**/
+return_status test_record_send_message(IN void *spdm_context,
+				       IN uintn request_size, IN void *request,
+				       IN uint64 timeout)
+{
+	return_status status;
+
+	if (m_test_record.active) {
+		test_record_flush_random();
+		test_record_append(TEST_RECORD_TYPE_SEND,
+				   test_record_get_time(), request,
+				   request_size);
+	}
+	m_test_record.in_device_io = TRUE;
+	status = m_test_record.send_message(spdm_context, request_size,
+					    request, timeout);
+	m_test_record.in_device_io = FALSE;
+	return status;
+}
+
+/**
+  Receive a message for the recorded SPDM context, and record it.
+
+  It matches libspdm_device_receive_message_func.
+**/
+return_status test_record_receive_message(IN void *spdm_context,
+					  IN OUT uintn *response_size,
+					  IN OUT void *response,
+					  IN uint64 timeout)
+{
+	return_status status;
+	uint64 data64;
+
+	if (m_test_record.active) {
+		test_record_flush_random();
+	}
+	m_test_record.in_device_io = TRUE;
+	status = m_test_record.receive_message(spdm_context, response_size,
+					       response, timeout);
+	m_test_record.in_device_io = FALSE;
+	if (!m_test_record.active) {
+		return status;
+	}
+
+	if (RETURN_ERROR(status)) {
+		data64 = (uint64)status;
+		test_record_append(TEST_RECORD_TYPE_RECEIVE_ERROR,
+				   test_record_get_time(), &data64,
+				   sizeof(data64));
+	} else {
+		test_record_append(TEST_RECORD_TYPE_RECEIVE,
+				   test_record_get_time(), response,
+				   *response_size);
+	}
+	return status;
+}
+
+/**
+  Record random bytes drawn by the recorded SPDM context.
+
+  It does nothing if no recording is started.
+
+  @param  data                          The random bytes.
+  @param  size                          The size in bytes of the random bytes.
+**/
+void test_record_random(IN const void *data, IN uintn size)
+{
+	const uint8 *pointer;
+	uintn copy_size;
+
+	if (!m_test_record.active || m_test_record.in_device_io) {
+		return;
+	}
+	pointer = data;
+	while (size != 0) {
+		if (m_test_record.random_size == 0) {
+			m_test_record.random_time = test_record_get_time();
+		}
+		copy_size = MIN(size, TEST_RECORD_RANDOM_BUFFER_SIZE -
+					      m_test_record.random_size);
+		copy_mem(m_test_record.random + m_test_record.random_size,
+			 pointer, copy_size);
+		m_test_record.random_size += copy_size;
+		pointer += copy_size;
+		size -= copy_size;
+		if (m_test_record.random_size == TEST_RECORD_RANDOM_BUFFER_SIZE) {
+			test_record_flush_random();
+		}
+	}
+}
+
+/**
+  Decode an unsigned LEB128 value of the replayed trace.
+
+  @param  value                         The value.
+
+  @retval TRUE   The value is decoded.
+  @retval FALSE  The trace is truncated, or the value is too large.
+**/
+static boolean test_replay_decode_varint(OUT uint64 *value)
+{
+	uint8 data;
+	uintn shift;
+
+	*value = 0;
+	for (shift = 0; shift < 64; shift += 7) {
+		if (m_test_replay.offset >= m_test_replay.trace_size) {
+			return FALSE;
+		}
+		data = m_test_replay.trace[m_test_replay.offset++];
+		*value |= (uint64)(data & 0x7F) << shift;
+		if ((data & 0x80) == 0) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/**
+  Read the next record of the replayed trace.
+
+  The replay diverges if the next record is not of the expected type.
+
+  @param  type                          The expected type.
+  @param  other_type                    Another accepted type, or 0.
+  @param  record_type                   The type of the record.
+  @param  data                          The data of the record.
+  @param  size                          The size in bytes of the data.
+
+  @retval TRUE   The record is read.
+  @retval FALSE  The replay diverged.
+**/
+static boolean test_replay_read(IN uint8 type, IN uint8 other_type,
+				OUT uint8 *record_type,
+				OUT const uint8 **data, OUT uintn *size)
+{
+	uint64 delta;
+	uint64 data_size;
+
+	if (m_test_replay.diverged ||
+	    (m_test_replay.offset >= m_test_replay.trace_size)) {
+		m_test_replay.diverged = TRUE;
+		return FALSE;
+	}
+	*record_type = m_test_replay.trace[m_test_replay.offset];
+	if ((*record_type != type) &&
+	    ((other_type == 0) || (*record_type != other_type))) {
+		m_test_replay.diverged = TRUE;
+		return FALSE;
+	}
+	m_test_replay.offset++;
+	if (!test_replay_decode_varint(&delta) ||
+	    !test_replay_decode_varint(&data_size) ||
+	    (data_size > m_test_replay.trace_size - m_test_replay.offset)) {
+		m_test_replay.diverged = TRUE;
+		return FALSE;
+	}
+	m_test_replay.time += delta;
+	*data = m_test_replay.trace + m_test_replay.offset;
+	*size = (uintn)data_size;
+	m_test_replay.offset += (uintn)data_size;
+	return TRUE;
+}
+
+/**
+  Start replaying a trace.
+
+  @param  trace                         The trace. It must be kept until test_replay_stop.
+  @param  trace_size                    The size in bytes of the trace.
+  @param  config                        The configuration of the recorded SPDM context in the trace.
+  @param  config_size                   The size in bytes of the configuration.
+
+  @retval RETURN_SUCCESS               The replay is started.
+  @retval RETURN_UNSUPPORTED           The trace is not a trace of this version.
+  @retval RETURN_BAD_BUFFER_SIZE       The trace is truncated.
+**/
+return_status test_replay_start(IN const void *trace, IN uintn trace_size,
+				OUT const void **config OPTIONAL,
+				OUT uintn *config_size OPTIONAL)
+{
+	test_record_header_t header;
+
+	if (trace_size < sizeof(header)) {
+		return RETURN_BAD_BUFFER_SIZE;
+	}
+	copy_mem(&header, trace, sizeof(header));
+	if ((header.signature != TEST_RECORD_SIGNATURE) ||
+	    (header.version != TEST_RECORD_VERSION)) {
+		return RETURN_UNSUPPORTED;
+	}
+	if (trace_size - sizeof(header) < header.config_size) {
+		return RETURN_BAD_BUFFER_SIZE;
+	}
+
+	zero_mem(&m_test_replay, sizeof(m_test_replay));
+	m_test_replay.trace = trace;
+	m_test_replay.trace_size = trace_size;
+	m_test_replay.offset = sizeof(header) + header.config_size;
+	m_test_replay.time = header.start_time;
+	if (config != NULL) {
+		*config = m_test_replay.trace + sizeof(header);
+	}
+	if (config_size != NULL) {
+		*config_size = header.config_size;
+	}
+	m_test_replay.active = TRUE;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Stop replaying a trace.
+
+  @retval RETURN_SUCCESS               The whole trace is replayed.
+  @retval RETURN_DEVICE_ERROR          The SPDM context diverged from the trace.
+  @retval RETURN_ABORTED               The replay stopped before the end of the trace.
+**/
+return_status test_replay_stop(void)
+{
+	m_test_replay.active = FALSE;
+	if (m_test_replay.diverged) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if ((m_test_replay.offset != m_test_replay.trace_size) ||
+	    (m_test_replay.random_size != 0)) {
+		return RETURN_ABORTED;
+	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  Check that a message sent by the replayed SPDM context is the recorded one.
+
+  It matches libspdm_device_send_message_func.
+  RETURN_DEVICE_ERROR is returned if the SPDM context diverged from the trace.
+**/
+return_status test_replay_send_message(IN void *spdm_context,
+				       IN uintn request_size, IN void *request,
+				       IN uint64 timeout)
+{
+	uint8 record_type;
+	const uint8 *data;
+	uintn size;
+
+	// The SPDM context drew less random bytes than the recorded one.
+	if (m_test_replay.random_size != 0) {
+		m_test_replay.diverged = TRUE;
+		return RETURN_DEVICE_ERROR;
+	}
+	if (!test_replay_read(TEST_RECORD_TYPE_SEND, 0, &record_type, &data,
+			      &size)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if ((size != request_size) ||
+	    (const_compare_mem(data, request, size) != 0)) {
+		m_test_replay.diverged = TRUE;
+		return RETURN_DEVICE_ERROR;
+	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  Receive the recorded message for the replayed SPDM context.
+
+  It matches libspdm_device_receive_message_func.
+  A recorded failure of receive_message is returned as it was recorded.
+  RETURN_DEVICE_ERROR is returned if the SPDM context diverged from the trace.
+**/
+return_status test_replay_receive_message(IN void *spdm_context,
+					  IN OUT uintn *response_size,
+					  IN OUT void *response,
+					  IN uint64 timeout)
+{
+	uint8 record_type;
+	const uint8 *data;
+	uintn size;
+	uint64 data64;
+
+	if (m_test_replay.random_size != 0) {
+		m_test_replay.diverged = TRUE;
+		return RETURN_DEVICE_ERROR;
+	}
+	if (!test_replay_read(TEST_RECORD_TYPE_RECEIVE,
+			      TEST_RECORD_TYPE_RECEIVE_ERROR, &record_type,
+			      &data, &size)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	if (record_type == TEST_RECORD_TYPE_RECEIVE_ERROR) {
+		if (size != sizeof(data64)) {
+			m_test_replay.diverged = TRUE;
+			return RETURN_DEVICE_ERROR;
+		}
+		copy_mem(&data64, data, sizeof(data64));
+		return (return_status)data64;
+	}
+	if (size > *response_size) {
+		m_test_replay.diverged = TRUE;
+		return RETURN_DEVICE_ERROR;
+	}
+	copy_mem(response, data, size);
+	*response_size = size;
+	return RETURN_SUCCESS;
+}
+
+/**
+  Return whether a trace is being replayed.
+**/
+boolean test_replay_is_active(void)
+{
+	return m_test_replay.active;
+}
+
+/**
+  Get the recorded random bytes for the replayed SPDM context.
+
+  @param  data                          The random bytes.
+  @param  size                          The size in bytes of the random bytes.
+
+  @retval TRUE   The random bytes are returned.
+  @retval FALSE  The SPDM context diverged from the trace.
+**/
+boolean test_replay_random(OUT void *data, IN uintn size)
+{
+	uint8 record_type;
+	uint8 *pointer;
+	uintn copy_size;
+
+	pointer = data;
+	while (size != 0) {
+		if (m_test_replay.random_size == 0) {
+			if (!test_replay_read(TEST_RECORD_TYPE_RANDOM, 0,
+					      &record_type,
+					      &m_test_replay.random,
+					      &m_test_replay.random_size)) {
+				return FALSE;
+			}
+			continue;
+		}
+		copy_size = MIN(size, m_test_replay.random_size);
+		copy_mem(pointer, m_test_replay.random, copy_size);
+		m_test_replay.random += copy_size;
+		m_test_replay.random_size -= copy_size;
+		pointer += copy_size;
+		size -= copy_size;
+	}
+	return TRUE;
+}
+
+/**
+  Return the recorded time of the last replayed record.
+
+  It matches libspdm_get_time_func, and stands for the clock of the recorded SPDM context.
+**/
+uint64 test_replay_get_time(void)
+{
+	return m_test_replay.time;
+}
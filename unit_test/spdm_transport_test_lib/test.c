@@ -6,7 +6,6 @@
 
 #include <library/spdm_transport_test_lib.h>
 
-#define TEST_ALIGNMENT 4
 #define TEST_SEQUENCE_NUMBER_COUNT 2
 #define TEST_MAX_RANDOM_NUMBER_COUNT 32
 
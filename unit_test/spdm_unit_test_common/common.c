@@ -8,6 +8,9 @@
 
 spdm_test_context_t *m_spdm_test_context;
 
+static uint8 m_spdm_sender_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+static uint8 m_spdm_receiver_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
 spdm_test_context_t *get_spdm_test_context(void)
 {
 	return m_spdm_test_context;
@@ -36,6 +39,10 @@ int spdm_unit_test_group_setup(void **state)
 	libspdm_register_device_io_func(spdm_context,
 				     spdm_test_context->send_message,
 				     spdm_test_context->receive_message);
+	libspdm_register_device_buffer(spdm_context, m_spdm_sender_buffer,
+				       sizeof(m_spdm_sender_buffer),
+				       m_spdm_receiver_buffer,
+				       sizeof(m_spdm_receiver_buffer));
 	libspdm_register_transport_layer_func(spdm_context,
 					   spdm_transport_test_encode_message,
 					   spdm_transport_test_decode_message);
@@ -0,0 +1,296 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#if defined(_MSC_VER)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#undef NULL
+#include <base.h>
+#include <library/debuglib.h>
+#include <library/debuglib_ring.h>
+
+#define TEST_PRODUCER_COUNT 4
+#define TEST_PRODUCER_MESSAGE_COUNT 20000
+
+typedef struct {
+	uint32 index;
+	volatile boolean done;
+} debug_ring_test_producer_t;
+
+#if defined(_MSC_VER)
+typedef HANDLE debug_ring_test_thread_t;
+#else
+typedef pthread_t debug_ring_test_thread_t;
+#endif
+
+static debug_ring_test_producer_t m_producer[TEST_PRODUCER_COUNT];
+
+/**
+  Remove all the records from the ring buffer.
+
+  @return The number of removed records.
+**/
+static uintn debug_ring_test_drain(void)
+{
+	debug_ring_record_t record;
+	uintn count;
+
+	count = 0;
+	while (debug_ring_read(&record)) {
+		count++;
+	}
+	return count;
+}
+
+/**
+  Print TEST_PRODUCER_MESSAGE_COUNT messages with the producer index and a counter.
+**/
+static void debug_ring_test_produce(IN debug_ring_test_producer_t *producer)
+{
+	uint32 counter;
+
+	for (counter = 0; counter < TEST_PRODUCER_MESSAGE_COUNT; counter++) {
+		debug_print(DEBUG_INFO, "producer %u message %u\n",
+			    producer->index, counter);
+	}
+	producer->done = TRUE;
+}
+
+#if defined(_MSC_VER)
+static DWORD WINAPI debug_ring_test_producer_thread(IN LPVOID parameter)
+{
+	debug_ring_test_produce(parameter);
+	return 0;
+}
+
+static boolean debug_ring_test_create_thread(OUT debug_ring_test_thread_t *thread,
+					     IN debug_ring_test_producer_t *producer)
+{
+	*thread = CreateThread(NULL, 0, debug_ring_test_producer_thread,
+			       producer, 0, NULL);
+	return (boolean)(*thread != NULL);
+}
+
+static void debug_ring_test_join_thread(IN debug_ring_test_thread_t thread)
+{
+	WaitForSingleObject(thread, INFINITE);
+	CloseHandle(thread);
+}
+#else
+static void *debug_ring_test_producer_thread(IN void *parameter)
+{
+	debug_ring_test_produce(parameter);
+	return NULL;
+}
+
+static boolean debug_ring_test_create_thread(OUT debug_ring_test_thread_t *thread,
+					     IN debug_ring_test_producer_t *producer)
+{
+	return (boolean)(pthread_create(thread, NULL,
+					debug_ring_test_producer_thread,
+					producer) == 0);
+}
+
+static void debug_ring_test_join_thread(IN debug_ring_test_thread_t thread)
+{
+	pthread_join(thread, NULL);
+}
+#endif
+
+/**
+  Test 1: messages with integer, string, double, pointer, '*' and "%%" conversions are recorded.
+  Expected behavior: debug_ring_format returns the message printed by snprintf, the conversions
+  after DEBUG_RING_RECORD_ARG_COUNT arguments are kept as is, the message is truncated to the
+  buffer, and a message of a disabled level is not recorded.
+**/
+static void test_debug_ring_case1(void **state)
+{
+	debug_ring_record_t record;
+	char8 buffer[0x100];
+	char8 expected[0x100];
+	uintn length;
+	int value;
+
+	set_debug_print_error_level(DEBUG_INFO | DEBUG_ERROR);
+	debug_ring_test_drain();
+
+	debug_print(DEBUG_INFO, "int %d %5u %-3x| %llx %zu %c %%\n", -12, 34u,
+		    0xab, 0x123456789abcull, (size_t)56, 'z');
+	assert_true(debug_ring_read(&record));
+	assert_int_equal(record.error_level, DEBUG_INFO);
+	assert_true(record.thread_id != 0);
+	length = debug_ring_format(&record, buffer, sizeof(buffer));
+	snprintf(expected, sizeof(expected), "int %d %5u %-3x| %llx %zu %c %%\n",
+		 -12, 34u, 0xab, 0x123456789abcull, (size_t)56, 'z');
+	assert_string_equal(buffer, expected);
+	assert_int_equal(length, strlen(expected));
+
+	debug_print(DEBUG_ERROR, "str %s %.3s %8s %*d %5.2f %p\n", "abc",
+		    "truncated", (char8 *)NULL, 6, 78, 3.14159, (void *)&value);
+	assert_true(debug_ring_read(&record));
+	assert_int_equal(record.error_level, DEBUG_ERROR);
+	debug_ring_format(&record, buffer, sizeof(buffer));
+	snprintf(expected, sizeof(expected), "str %s %.3s %8s %*d %5.2f %p\n",
+		 "abc", "truncated", "(null)", 6, 78, 3.14159, (void *)&value);
+	assert_string_equal(buffer, expected);
+
+	debug_print(DEBUG_INFO, "%d %d %d %d %d %d %d %d %d %s\n", 1, 2, 3, 4,
+		    5, 6, 7, 8, 9, "extra");
+	assert_true(debug_ring_read(&record));
+	assert_int_equal(record.arg_count, DEBUG_RING_RECORD_ARG_COUNT);
+	debug_ring_format(&record, buffer, sizeof(buffer));
+	assert_string_equal(buffer, "1 2 3 4 5 6 7 8 %d %s\n");
+
+	length = debug_ring_format(&record, buffer, 8);
+	assert_int_equal(length, 7);
+	assert_string_equal(buffer, "1 2 3 4");
+
+	debug_print(DEBUG_VERBOSE, "not recorded\n");
+	assert_false(debug_ring_read(&record));
+}
+
+/**
+  Test 2: DEBUG_RING_RECORD_COUNT + 10 messages are printed without reading the ring buffer.
+  Expected behavior: the 10 oldest records are overwritten and counted, and the latest
+  DEBUG_RING_RECORD_COUNT records are read in order.
+**/
+static void test_debug_ring_case2(void **state)
+{
+	debug_ring_record_t record;
+	uint64 overwritten_count;
+	uint64 sequence;
+	uint32 counter;
+
+	set_debug_print_error_level(DEBUG_INFO | DEBUG_ERROR);
+	debug_ring_test_drain();
+	overwritten_count = debug_ring_get_overwritten_count();
+
+	for (counter = 0; counter < DEBUG_RING_RECORD_COUNT + 10; counter++) {
+		debug_print(DEBUG_INFO, "message %u\n", counter);
+	}
+	assert_int_equal(debug_ring_get_overwritten_count(),
+			 overwritten_count + 10);
+
+	assert_true(debug_ring_read(&record));
+	assert_int_equal(record.arg[0], 10);
+	sequence = record.sequence;
+	for (counter = 11; counter < DEBUG_RING_RECORD_COUNT + 10; counter++) {
+		assert_true(debug_ring_read(&record));
+		assert_int_equal(record.arg[0], counter);
+		assert_int_equal(record.sequence, sequence + 1);
+		sequence = record.sequence;
+	}
+	assert_false(debug_ring_read(&record));
+}
+
+/**
+  Test 3: TEST_PRODUCER_COUNT threads print messages while the main thread drains the ring buffer.
+  Expected behavior: the records are read in sequence order, the messages of each producer are
+  read in order with its own thread ID, and every message is either read, overwritten or dropped.
+**/
+static void test_debug_ring_case3(void **state)
+{
+	debug_ring_test_thread_t thread[TEST_PRODUCER_COUNT];
+	debug_ring_record_t record;
+	uint64 overwritten_count;
+	uint64 dropped_count;
+	uint64 last_counter[TEST_PRODUCER_COUNT];
+	uint32 thread_id[TEST_PRODUCER_COUNT];
+	uint64 sequence;
+	uintn read_count;
+	uintn index;
+	uintn producer_index;
+	boolean done;
+
+	set_debug_print_error_level(DEBUG_INFO | DEBUG_ERROR);
+	debug_ring_test_drain();
+	overwritten_count = debug_ring_get_overwritten_count();
+	dropped_count = debug_ring_get_dropped_count();
+
+	for (index = 0; index < TEST_PRODUCER_COUNT; index++) {
+		m_producer[index].index = (uint32)index;
+		m_producer[index].done = FALSE;
+		last_counter[index] = (uint64)-1;
+		thread_id[index] = 0;
+	}
+	for (index = 0; index < TEST_PRODUCER_COUNT; index++) {
+		assert_true(debug_ring_test_create_thread(&thread[index],
+							  &m_producer[index]));
+	}
+
+	read_count = 0;
+	sequence = 0;
+	do {
+		done = TRUE;
+		for (index = 0; index < TEST_PRODUCER_COUNT; index++) {
+			if (!m_producer[index].done) {
+				done = FALSE;
+			}
+		}
+		while (debug_ring_read(&record)) {
+			if (read_count != 0) {
+				assert_true(record.sequence > sequence);
+			}
+			sequence = record.sequence;
+			producer_index = (uintn)record.arg[0];
+			assert_true(producer_index < TEST_PRODUCER_COUNT);
+			if (thread_id[producer_index] == 0) {
+				thread_id[producer_index] = record.thread_id;
+			}
+			assert_int_equal(record.thread_id,
+					 thread_id[producer_index]);
+			assert_true(last_counter[producer_index] == (uint64)-1 ||
+				    record.arg[1] > last_counter[producer_index]);
+			last_counter[producer_index] = record.arg[1];
+			read_count++;
+		}
+	} while (!done);
+
+	for (index = 0; index < TEST_PRODUCER_COUNT; index++) {
+		debug_ring_test_join_thread(thread[index]);
+	}
+	assert_false(debug_ring_read(&record));
+
+	for (index = 0; index < TEST_PRODUCER_COUNT; index++) {
+		for (producer_index = index + 1;
+		     producer_index < TEST_PRODUCER_COUNT; producer_index++) {
+			assert_true(thread_id[index] == 0 ||
+				    thread_id[index] != thread_id[producer_index]);
+		}
+	}
+	assert_int_equal(read_count +
+				 (debug_ring_get_overwritten_count() -
+				  overwritten_count) +
+				 (debug_ring_get_dropped_count() - dropped_count),
+			 TEST_PRODUCER_COUNT * TEST_PRODUCER_MESSAGE_COUNT);
+}
+
+int main(void)
+{
+	const struct CMUnitTest debug_ring_tests[] = {
+		// Format of the records
+		cmocka_unit_test(test_debug_ring_case1),
+		// Overwrite of the oldest records
+		cmocka_unit_test(test_debug_ring_case2),
+		// Multiple producers with a concurrent drain
+		cmocka_unit_test(test_debug_ring_case3),
+	};
+
+	return cmocka_run_group_tests(debug_ring_tests, NULL, NULL);
+}
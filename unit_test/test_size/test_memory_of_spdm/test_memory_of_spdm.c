@@ -0,0 +1,412 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "bench_spdm_common.h"
+#include <library/malloclib_stat.h>
+
+//
+// The stack is painted with TEST_MEMORY_STACK_PATTERN below the frame measuring a flow,
+// and the deepest byte which is not the pattern any more gives the peak stack of the flow.
+// The stack is assumed to grow down, as on all the supported architectures.
+//
+#define TEST_MEMORY_STACK_PAINT_SIZE 0x80000
+// The bytes skipped below the frame of the painting function.
+#define TEST_MEMORY_STACK_PAINT_MARGIN 0x100
+#define TEST_MEMORY_STACK_PATTERN 0xA5
+
+#if defined(_MSC_VER)
+#define TEST_MEMORY_NOINLINE __declspec(noinline)
+#else
+#define TEST_MEMORY_NOINLINE __attribute__((noinline))
+#endif
+
+//
+// Each algorithm set pairs the asym algorithm with the hash, DHE and AEAD of the same strength.
+//
+bench_spdm_algo_set_t m_test_memory_algo_set[] = {
+	{ "ecdsa_p256/secp_256_r1/aes_128_gcm",
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM },
+	{ "ecdsa_p384/secp_384_r1/aes_256_gcm",
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+	{ "ecdsa_p521/secp_521_r1/chacha20_poly1305",
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P521,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_521_R1,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305 },
+	{ "rsassa_3072/ffdhe_3072/aes_256_gcm",
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+	{ "rsapss_3072/ffdhe_3072/aes_256_gcm",
+	  SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_3072,
+	  SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+	  SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072,
+	  SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM },
+};
+
+typedef struct {
+	// Peak stack in bytes of the requester, below the frame calling the flow.
+	uintn requester_stack;
+	// Peak stack in bytes of the responder, below the frame dispatching the request.
+	uintn responder_stack;
+	// Peak heap in bytes of the requester and the responder, above the heap at the start of the flow.
+	uintn heap_peak;
+	// Peak heap in bytes of the responder, above the heap at the start of the dispatch.
+	uintn responder_heap_peak;
+	// The total size in bytes and the number of the allocations of the flow.
+	uint64 heap_total;
+	uint64 heap_allocations;
+} test_memory_usage_t;
+
+//
+// The painted stack is [m_test_memory_stack_bottom, m_test_memory_stack_top).
+// m_test_memory_usage is the usage of the measured flow, NULL out of a measured run.
+//
+uintn m_test_memory_stack_top;
+uintn m_test_memory_stack_bottom;
+test_memory_usage_t *m_test_memory_usage;
+uintn m_test_memory_heap_base;
+
+/**
+  Paint the unused stack below the frame of this function down to m_test_memory_stack_bottom.
+
+  The stack is painted from the top down, so that the guard pages are touched in order.
+**/
+TEST_MEMORY_NOINLINE void test_memory_paint_stack(void)
+{
+	volatile uint8 marker;
+	volatile uint8 *pointer;
+
+	marker = 0;
+	pointer = (volatile uint8 *)((uintn)&marker -
+				     TEST_MEMORY_STACK_PAINT_MARGIN);
+	while ((uintn)pointer > m_test_memory_stack_bottom) {
+		pointer--;
+		*pointer = TEST_MEMORY_STACK_PATTERN;
+	}
+}
+
+/**
+  Return the address of the deepest byte of the painted stack which was used since it was painted.
+
+  A used byte equal to the pattern is not detected, so the result may miss a few bytes.
+**/
+TEST_MEMORY_NOINLINE uintn test_memory_get_stack_low(void)
+{
+	volatile uint8 *pointer;
+
+	pointer = (volatile uint8 *)m_test_memory_stack_bottom;
+	while (((uintn)pointer < m_test_memory_stack_top) &&
+	       (*pointer == TEST_MEMORY_STACK_PATTERN)) {
+		pointer++;
+	}
+	return (uintn)pointer;
+}
+
+/**
+  Record the heap peak of the measured flow since the last reset of the peak.
+**/
+void test_memory_update_heap_peak(void)
+{
+	malloc_stat_t stat;
+
+	malloc_stat_get(&stat);
+	if ((stat.peak_size > m_test_memory_heap_base) &&
+	    (stat.peak_size - m_test_memory_heap_base >
+	     m_test_memory_usage->heap_peak)) {
+		m_test_memory_usage->heap_peak =
+			stat.peak_size - m_test_memory_heap_base;
+	}
+}
+
+/**
+  Dispatch the pending request in the responder, and receive its response.
+
+  In a measured run, the stack and the heap used by the requester so far are recorded first.
+  The stack below this frame is painted again before and after the dispatch, so that the
+  responder is measured alone, and does not count in the stack of the requester.
+**/
+TEST_MEMORY_NOINLINE return_status
+test_memory_receive_message(IN void *spdm_context, IN OUT uintn *response_size,
+			    IN OUT void *response, IN uint64 timeout)
+{
+	volatile uint8 marker;
+	test_memory_usage_t *usage;
+	malloc_stat_t stat;
+	uintn stack_low;
+	uintn responder_heap_base;
+	return_status status;
+
+	usage = m_test_memory_usage;
+	if (usage == NULL) {
+		status = libspdm_responder_engine_dispatch_message(
+			m_bench_spdm_responder_engine);
+	} else {
+		marker = 0;
+		stack_low = test_memory_get_stack_low();
+		if (m_test_memory_stack_top - stack_low >
+		    usage->requester_stack) {
+			usage->requester_stack =
+				m_test_memory_stack_top - stack_low;
+		}
+		test_memory_update_heap_peak();
+		malloc_stat_get(&stat);
+		responder_heap_base = stat.current_size;
+		malloc_stat_reset_peak();
+
+		test_memory_paint_stack();
+		status = libspdm_responder_engine_dispatch_message(
+			m_bench_spdm_responder_engine);
+		stack_low = test_memory_get_stack_low();
+		if ((uintn)&marker - stack_low > usage->responder_stack) {
+			usage->responder_stack = (uintn)&marker - stack_low;
+		}
+		test_memory_paint_stack();
+
+		malloc_stat_get(&stat);
+		if ((stat.peak_size > responder_heap_base) &&
+		    (stat.peak_size - responder_heap_base >
+		     usage->responder_heap_peak)) {
+			usage->responder_heap_peak =
+				stat.peak_size - responder_heap_base;
+		}
+		test_memory_update_heap_peak();
+	}
+	if (RETURN_ERROR(status)) {
+		return RETURN_DEVICE_ERROR;
+	}
+	return test_loopback_receive_response(BENCH_SPDM_ENDPOINT_ID,
+					      response_size, response);
+}
+
+/**
+  Run a flow with the stack painted below this frame, and measure its stack and heap.
+
+  This function is not inlined, so that the painting and the measurement are relative to its frame.
+**/
+TEST_MEMORY_NOINLINE return_status
+test_memory_measure_flow(IN bench_spdm_context_t *context,
+			 IN bench_spdm_operation_t *flow,
+			 OUT test_memory_usage_t *usage)
+{
+	volatile uint8 marker;
+	malloc_stat_t start_stat;
+	malloc_stat_t stat;
+	uintn stack_low;
+	return_status status;
+
+	marker = 0;
+	zero_mem(usage, sizeof(*usage));
+	m_test_memory_stack_top = (uintn)&marker;
+	m_test_memory_stack_bottom =
+		m_test_memory_stack_top - TEST_MEMORY_STACK_PAINT_SIZE;
+	test_memory_paint_stack();
+
+	malloc_stat_reset_peak();
+	malloc_stat_get(&start_stat);
+	m_test_memory_heap_base = start_stat.current_size;
+	m_test_memory_usage = usage;
+
+	status = flow->run(context);
+
+	stack_low = test_memory_get_stack_low();
+	if (m_test_memory_stack_top - stack_low > usage->requester_stack) {
+		usage->requester_stack = m_test_memory_stack_top - stack_low;
+	}
+	test_memory_update_heap_peak();
+	m_test_memory_usage = NULL;
+
+	malloc_stat_get(&stat);
+	usage->heap_total = stat.total_size - start_stat.total_size;
+	usage->heap_allocations =
+		stat.allocation_count - start_stat.allocation_count;
+	return status;
+}
+
+/**
+  Add the memory usage of a flow to the JSON report.
+**/
+void test_memory_report_add_result(IN bench_report_t *report,
+				   IN const char8 *name,
+				   IN const char8 *flow,
+				   IN return_status status,
+				   IN test_memory_usage_t *usage)
+{
+	FILE *file;
+
+	file = report->file;
+	fprintf(file, "%s\n    {", (report->result_count == 0) ? "" : ",");
+	fprintf(file, "\"name\": \"%s\", ", name);
+	fprintf(file, "\"operation\": \"%s\", ", flow);
+	fprintf(file, "\"status\": \"0x%llx\", ", (unsigned long long)status);
+	fprintf(file, "\"requester_stack\": %llu, ",
+		(unsigned long long)usage->requester_stack);
+	fprintf(file, "\"responder_stack\": %llu, ",
+		(unsigned long long)usage->responder_stack);
+	fprintf(file, "\"heap_peak\": %llu, ",
+		(unsigned long long)usage->heap_peak);
+	fprintf(file, "\"responder_heap_peak\": %llu, ",
+		(unsigned long long)usage->responder_heap_peak);
+	fprintf(file, "\"heap_total\": %llu, ",
+		(unsigned long long)usage->heap_total);
+	fprintf(file, "\"heap_allocations\": %llu}",
+		(unsigned long long)usage->heap_allocations);
+	fflush(file);
+	report->result_count++;
+}
+
+/**
+  Run one flow of an algorithm set and report the maximum usage of its runs.
+
+  The measurement stops at the first failure.
+**/
+void test_memory_run_flow(IN bench_spdm_context_t *context,
+			  IN bench_spdm_operation_t *flow,
+			  IN bench_options_t *options,
+			  IN bench_report_t *report)
+{
+	test_memory_usage_t usage;
+	test_memory_usage_t max_usage;
+	return_status status;
+	uintn index;
+
+	test_loopback_reset();
+	zero_mem(&max_usage, sizeof(max_usage));
+	status = RETURN_SUCCESS;
+	for (index = 0; index < options->iterations; index++) {
+		if (flow->prepare != NULL) {
+			status = flow->prepare(context);
+			if (RETURN_ERROR(status)) {
+				break;
+			}
+		}
+		status = test_memory_measure_flow(context, flow, &usage);
+		if (RETURN_ERROR(status)) {
+			break;
+		}
+		max_usage.requester_stack = MAX(max_usage.requester_stack,
+						usage.requester_stack);
+		max_usage.responder_stack = MAX(max_usage.responder_stack,
+						usage.responder_stack);
+		max_usage.heap_peak = MAX(max_usage.heap_peak, usage.heap_peak);
+		max_usage.responder_heap_peak =
+			MAX(max_usage.responder_heap_peak,
+			    usage.responder_heap_peak);
+		max_usage.heap_total = MAX(max_usage.heap_total,
+					   usage.heap_total);
+		max_usage.heap_allocations = MAX(max_usage.heap_allocations,
+						 usage.heap_allocations);
+		if (flow->finish != NULL) {
+			status = flow->finish(context);
+			if (RETURN_ERROR(status)) {
+				break;
+			}
+		}
+	}
+
+	test_memory_report_add_result(report, context->algo_set->name,
+				      flow->name, status, &max_usage);
+	printf("%-40s %-24s status 0x%llx stack %llu/%llu heap peak %llu/%llu total %llu (%llu allocations)\n",
+	       context->algo_set->name, flow->name, (unsigned long long)status,
+	       (unsigned long long)max_usage.requester_stack,
+	       (unsigned long long)max_usage.responder_stack,
+	       (unsigned long long)max_usage.heap_peak,
+	       (unsigned long long)max_usage.responder_heap_peak,
+	       (unsigned long long)max_usage.heap_total,
+	       (unsigned long long)max_usage.heap_allocations);
+}
+
+/**
+  Run the selected flows of an algorithm set.
+**/
+void test_memory_run_algo_set(IN bench_spdm_context_t *context,
+			      IN bench_options_t *options,
+			      IN bench_report_t *report)
+{
+	bench_spdm_operation_t *flow;
+	test_memory_usage_t usage;
+	char8 full_name[192];
+	return_status status;
+	uintn index;
+	boolean setup_done;
+
+	setup_done = FALSE;
+	status = RETURN_SUCCESS;
+	// Every flow is measured on every algorithm set, so the axes of the operations are ignored.
+	for (index = 0; index < m_bench_spdm_operation_count; index++) {
+		flow = &m_bench_spdm_operation[index];
+		snprintf(full_name, sizeof(full_name), "%s/%s",
+			 context->algo_set->name, flow->name);
+		if (!bench_is_selected(options, full_name)) {
+			continue;
+		}
+
+		if (!setup_done) {
+			status = bench_spdm_setup_requester(
+				context, bench_spdm_send_message,
+				test_memory_receive_message);
+			if (!RETURN_ERROR(status)) {
+				status = bench_spdm_setup_responder(context);
+			}
+			setup_done = TRUE;
+		}
+		if (RETURN_ERROR(status)) {
+			zero_mem(&usage, sizeof(usage));
+			test_memory_report_add_result(report,
+						      context->algo_set->name,
+						      flow->name, status,
+						      &usage);
+			continue;
+		}
+		test_memory_run_flow(context, flow, options, report);
+	}
+
+	if (setup_done) {
+		bench_spdm_teardown(context);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	bench_options_t options;
+	bench_report_t report;
+	bench_spdm_context_t context;
+	uintn index;
+
+	if (!bench_parse_arguments(argc, argv, &options)) {
+		return 1;
+	}
+
+	if (!bench_spdm_init_responder_engine()) {
+		return 1;
+	}
+
+	if (!bench_report_open(&report, &options, "test_memory_of_spdm")) {
+		return 1;
+	}
+
+	zero_mem(&context, sizeof(context));
+	for (index = 0; index < ARRAY_SIZE(m_test_memory_algo_set); index++) {
+		context.algo_set = &m_test_memory_algo_set[index];
+		test_memory_run_algo_set(&context, &options, &report);
+	}
+
+	bench_report_close(&report);
+	bench_spdm_free_responder_engine();
+	return 0;
+}
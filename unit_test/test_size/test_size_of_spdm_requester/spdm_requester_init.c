@@ -6,6 +6,9 @@
 
 #include "spdm_requester.h"
 
+uint8 m_spdm_sender_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+uint8 m_spdm_receiver_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
 return_status SpdmRequesterSendMessage(IN void *spdm_context,
 				       IN uintn message_size, IN void *message,
 				       IN uint64 timeout)
@@ -40,6 +43,10 @@ void *spdm_client_init(void)
 	libspdm_init_context(spdm_context);
 	libspdm_register_device_io_func(spdm_context, SpdmRequesterSendMessage,
 				     SpdmRequesterReceiveMessage);
+	libspdm_register_device_buffer(spdm_context, m_spdm_sender_buffer,
+				       sizeof(m_spdm_sender_buffer),
+				       m_spdm_receiver_buffer,
+				       sizeof(m_spdm_receiver_buffer));
 	libspdm_register_transport_layer_func(spdm_context,
 					   spdm_transport_mctp_encode_message,
 					   spdm_transport_mctp_decode_message);
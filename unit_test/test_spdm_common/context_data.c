@@ -184,6 +184,978 @@ static void test_spdm_common_context_data_case4(void **state)
 	assert_int_equal(opaque_data, 0xDEADBEEF);
 }
 
+static uint8 m_transcript_record[MAX_SPDM_MESSAGE_SMALL_BUFFER_SIZE];
+static uintn m_transcript_record_size;
+static uintn m_transcript_reset_count;
+
+static return_status spdm_transcript_record_append(
+	IN void *spdm_context, IN uint32 *session_id OPTIONAL,
+	IN spdm_transcript_message_t message_type, IN void *message,
+	IN uintn message_size)
+{
+	if (message_type != SPDM_TRANSCRIPT_MESSAGE_A || session_id != NULL) {
+		return RETURN_INVALID_PARAMETER;
+	}
+	if (message_size > sizeof(m_transcript_record) - m_transcript_record_size) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	copy_mem(m_transcript_record + m_transcript_record_size, message,
+		 message_size);
+	m_transcript_record_size += message_size;
+	return RETURN_SUCCESS;
+}
+
+static void spdm_transcript_record_reset(
+	IN void *spdm_context, IN uint32 *session_id OPTIONAL,
+	IN spdm_transcript_message_t message_type)
+{
+	if (message_type == SPDM_TRANSCRIPT_MESSAGE_A) {
+		m_transcript_record_size = 0;
+		m_transcript_reset_count++;
+	}
+}
+
+static return_status spdm_transcript_reject_append(
+	IN void *spdm_context, IN uint32 *session_id OPTIONAL,
+	IN spdm_transcript_message_t message_type, IN void *message,
+	IN uintn message_size)
+{
+	return RETURN_ACCESS_DENIED;
+}
+
+/**
+  Test 5: An external transcript backend sees every append and reset of
+  message A, and an append rejected by it fails.
+**/
+static void test_spdm_common_context_data_case5(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 message[] = { 0x11, 0x84, 0x00, 0x00 };
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x5;
+
+	m_transcript_record_size = 0;
+	m_transcript_reset_count = 0;
+	libspdm_register_transcript_func(spdm_context,
+					 spdm_transcript_record_append,
+					 spdm_transcript_record_reset, NULL);
+
+	libspdm_reset_message_a(spdm_context);
+	assert_int_equal(m_transcript_reset_count, 1);
+
+	status = libspdm_append_message_a(spdm_context, message, sizeof(message));
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = libspdm_append_message_a(spdm_context, message, sizeof(message));
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_transcript_record_size, sizeof(message) * 2);
+	assert_memory_equal(m_transcript_record, message, sizeof(message));
+	assert_int_equal(spdm_context->transcript.message_a.buffer_size,
+			 sizeof(message) * 2);
+
+	libspdm_reset_message_a(spdm_context);
+	assert_int_equal(m_transcript_reset_count, 2);
+	assert_int_equal(m_transcript_record_size, 0);
+
+	libspdm_register_transcript_func(spdm_context,
+					 spdm_transcript_reject_append,
+					 NULL, NULL);
+	status = libspdm_append_message_a(spdm_context, message, sizeof(message));
+	assert_int_equal(status, RETURN_ACCESS_DENIED);
+
+	libspdm_register_transcript_func(spdm_context, NULL, NULL, NULL);
+	libspdm_reset_message_a(spdm_context);
+}
+
+#if LIBSPDM_STATISTICS_SUPPORT
+static uint64 m_statistics_time;
+
+static uint64 spdm_statistics_test_get_time(void)
+{
+	return m_statistics_time;
+}
+
+/**
+  Test 6: The statistics record the count, total and max time per request code,
+  are returned by libspdm_get_data, and are cleared by libspdm_reset_statistics.
+**/
+static void test_spdm_common_context_data_case6(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_data_parameter_t parameter;
+	spdm_statistics_t statistics;
+	spdm_statistics_timer_t *timer;
+	uintn data_size;
+	uint64 start_time;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x6;
+
+	libspdm_register_get_time_func(spdm_context,
+				       spdm_statistics_test_get_time);
+	libspdm_reset_statistics(spdm_context);
+
+	m_statistics_time = 100;
+	start_time = spdm_statistics_get_time(spdm_context);
+	m_statistics_time = 130;
+	spdm_statistics_record_response(spdm_context, SPDM_GET_VERSION,
+					start_time);
+	start_time = spdm_statistics_get_time(spdm_context);
+	m_statistics_time = 140;
+	spdm_statistics_record_response(spdm_context, SPDM_GET_VERSION,
+					start_time);
+	spdm_statistics_start_request(spdm_context, SPDM_GET_CAPABILITIES);
+	m_statistics_time = 190;
+	spdm_statistics_end_request(spdm_context);
+	SPDM_STATISTICS_ADD(spdm_context, retry_count, 1);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	data_size = sizeof(statistics);
+	status = libspdm_get_data(spdm_context, SPDM_DATA_STATISTICS,
+				  &parameter, &statistics, &data_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(data_size, sizeof(statistics));
+
+	timer = &statistics.response[SPDM_GET_VERSION -
+				     SPDM_STATISTICS_REQUEST_CODE_BASE];
+	assert_int_equal(timer->count, 2);
+	assert_int_equal(timer->total_time, 40);
+	assert_int_equal(timer->max_time, 30);
+	timer = &statistics.request[SPDM_GET_CAPABILITIES -
+				    SPDM_STATISTICS_REQUEST_CODE_BASE];
+	assert_int_equal(timer->count, 1);
+	assert_int_equal(timer->total_time, 50);
+	assert_int_equal(statistics.retry_count, 1);
+
+	libspdm_reset_statistics(spdm_context);
+	data_size = sizeof(statistics);
+	status = libspdm_get_data(spdm_context, SPDM_DATA_STATISTICS,
+				  &parameter, &statistics, &data_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(statistics.response[SPDM_GET_VERSION -
+					     SPDM_STATISTICS_REQUEST_CODE_BASE]
+				 .count,
+			 0);
+	assert_int_equal(statistics.retry_count, 0);
+
+	libspdm_register_get_time_func(spdm_context, NULL);
+}
+#endif
+
+#if LIBSPDM_TRACE_SUPPORT
+static spdm_trace_phase_t m_trace_phase[4];
+static spdm_trace_event_t m_trace_event[4];
+static uint32 m_trace_session_id;
+static uint8 m_trace_request_code;
+static uintn m_trace_count;
+
+static void spdm_trace_record(IN void *spdm_context,
+			      IN spdm_trace_phase_t phase,
+			      IN spdm_trace_event_t event,
+			      IN uint32 session_id, IN uint8 request_code)
+{
+	if (m_trace_count < ARRAY_SIZE(m_trace_phase)) {
+		m_trace_phase[m_trace_count] = phase;
+		m_trace_event[m_trace_count] = event;
+	}
+	m_trace_session_id = session_id;
+	m_trace_request_code = request_code;
+	m_trace_count++;
+}
+
+/**
+  Test 7: The trace callback sees the begin and the end of a transcript append,
+  with the session ID and the request code of the message being processed.
+**/
+static void test_spdm_common_context_data_case7(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 message[] = { 0x11, 0x84, 0x00, 0x00 };
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x7;
+
+	status = libspdm_register_trace_callback_func(spdm_context,
+						      spdm_trace_record);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	m_trace_count = 0;
+	libspdm_reset_message_a(spdm_context);
+	spdm_trace_set_message(spdm_context, 0x12345678, SPDM_GET_VERSION);
+	status = libspdm_append_message_a(spdm_context, message, sizeof(message));
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	assert_int_equal(m_trace_count, 2);
+	assert_int_equal(m_trace_phase[0], SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	assert_int_equal(m_trace_event[0], SPDM_TRACE_EVENT_BEGIN);
+	assert_int_equal(m_trace_phase[1], SPDM_TRACE_PHASE_TRANSCRIPT_APPEND);
+	assert_int_equal(m_trace_event[1], SPDM_TRACE_EVENT_END);
+	assert_int_equal(m_trace_session_id, 0x12345678);
+	assert_int_equal(m_trace_request_code, SPDM_GET_VERSION);
+
+	libspdm_reset_message_a(spdm_context);
+	zero_mem(spdm_context->spdm_trace_callback,
+		 sizeof(spdm_context->spdm_trace_callback));
+	spdm_trace_set_message(spdm_context, INVALID_SESSION_ID, 0);
+}
+#endif
+
+/**
+  Test 8: Test that a restored SPDM context has the state of the SPDM context when its snapshot
+  was saved, including the transcript, and that a snapshot can be restored several times.
+**/
+static void test_spdm_common_context_data_case8(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	void *snapshot;
+	uintn snapshot_size;
+	uintn index;
+	uint8 message_a[] = { 0x11, 0x84, 0x00, 0x00 };
+	uint8 message_b[] = { 0x11, 0x81, 0x00, 0x00 };
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	uint8 message_m1m2[sizeof(message_a) + sizeof(message_b)];
+	uint8 expected_hash[MAX_HASH_SIZE];
+	uint8 hash[MAX_HASH_SIZE];
+#endif
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x8;
+
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	libspdm_reset_message_a(spdm_context);
+	libspdm_reset_message_b(spdm_context);
+	status = libspdm_append_message_a(spdm_context, message_a,
+					  sizeof(message_a));
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = libspdm_append_message_b(spdm_context, message_b,
+					  sizeof(message_b));
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	snapshot_size = 0;
+	status = libspdm_snapshot_context(spdm_context, NULL, &snapshot_size);
+	assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+	assert_int_equal(snapshot_size, libspdm_get_context_snapshot_size());
+	snapshot = malloc(snapshot_size);
+	assert_non_null(snapshot);
+	status = libspdm_snapshot_context(spdm_context, snapshot,
+					  &snapshot_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	status = libspdm_restore_context(spdm_context, snapshot,
+					 snapshot_size - 1);
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	copy_mem(message_m1m2, message_a, sizeof(message_a));
+	copy_mem(message_m1m2 + sizeof(message_a), message_b,
+		 sizeof(message_b));
+	spdm_hash_all(m_use_hash_algo, message_m1m2, sizeof(message_m1m2),
+		      expected_hash);
+#endif
+
+	for (index = 0; index < 2; index++) {
+		spdm_context->connection_info.connection_state =
+			SPDM_CONNECTION_STATE_NOT_STARTED;
+		libspdm_reset_message_a(spdm_context);
+		libspdm_reset_message_b(spdm_context);
+
+		status = libspdm_restore_context(spdm_context, snapshot,
+						 snapshot_size);
+		assert_int_equal(status, RETURN_SUCCESS);
+
+		assert_int_equal(spdm_context->connection_info.connection_state,
+				 SPDM_CONNECTION_STATE_NEGOTIATED);
+		assert_int_equal(get_managed_buffer_size(
+					 &spdm_context->transcript.message_a),
+				 sizeof(message_a));
+		assert_memory_equal(
+			get_managed_buffer(&spdm_context->transcript.message_a),
+			message_a, sizeof(message_a));
+		assert_ptr_equal(spdm_context->session_info[1]
+					 .secured_message_context,
+				 (uint8 *)(spdm_context + 1) +
+					 spdm_secured_message_get_context_size());
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+		assert_int_equal(get_managed_buffer_size(
+					 &spdm_context->transcript.message_b),
+				 sizeof(message_b));
+		assert_memory_equal(
+			get_managed_buffer(&spdm_context->transcript.message_b),
+			message_b, sizeof(message_b));
+#else
+		//
+		// The hash context is finalized, so the next restore checks that the snapshot keeps its own copy.
+		//
+		assert_non_null(spdm_context->transcript.digest_context_m1m2);
+		spdm_hash_final(m_use_hash_algo,
+				spdm_context->transcript.digest_context_m1m2,
+				hash);
+		assert_memory_equal(hash, expected_hash,
+				    spdm_get_hash_size(m_use_hash_algo));
+#endif
+	}
+
+	libspdm_reset_message_a(spdm_context);
+	libspdm_reset_message_b(spdm_context);
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NOT_STARTED;
+	libspdm_free_context_snapshot(snapshot);
+	free(snapshot);
+}
+
+typedef struct {
+	spdm_transcript_message_t message_type;
+	boolean in_session;
+	uint32 session_id;
+	uintn message_size;
+} spdm_transcript_log_entry_t;
+
+static spdm_transcript_log_entry_t m_transcript_log[8];
+static uintn m_transcript_log_count;
+static spdm_transcript_digest_t m_transcript_digest_type;
+static uint32 m_transcript_digest_session_id;
+static uint8 m_transcript_digest[MAX_HASH_SIZE];
+static uintn m_transcript_digest_count;
+
+static return_status spdm_transcript_log_append(
+	IN void *spdm_context, IN uint32 *session_id OPTIONAL,
+	IN spdm_transcript_message_t message_type, IN void *message,
+	IN uintn message_size)
+{
+	spdm_transcript_log_entry_t *entry;
+
+	if (m_transcript_log_count >= ARRAY_SIZE(m_transcript_log)) {
+		return RETURN_OUT_OF_RESOURCES;
+	}
+	entry = &m_transcript_log[m_transcript_log_count++];
+	entry->message_type = message_type;
+	entry->in_session = (session_id != NULL);
+	entry->session_id = (session_id != NULL) ? *session_id : 0;
+	entry->message_size = message_size;
+	return RETURN_SUCCESS;
+}
+
+static void spdm_transcript_log_extend(
+	IN void *spdm_context, IN uint32 *session_id OPTIONAL,
+	IN spdm_transcript_digest_t digest_type, IN void *digest,
+	IN uintn digest_size)
+{
+	m_transcript_digest_type = digest_type;
+	m_transcript_digest_session_id =
+		(session_id != NULL) ? *session_id : INVALID_SESSION_ID;
+	copy_mem(m_transcript_digest, digest,
+		 MIN(digest_size, sizeof(m_transcript_digest)));
+	m_transcript_digest_count++;
+}
+
+static void spdm_transcript_log_check(IN uintn index,
+				      IN spdm_transcript_message_t message_type,
+				      IN uint32 *session_id OPTIONAL,
+				      IN uintn message_size)
+{
+	assert_true(index < m_transcript_log_count);
+	assert_int_equal(m_transcript_log[index].message_type, message_type);
+	assert_int_equal(m_transcript_log[index].in_session, session_id != NULL);
+	if (session_id != NULL) {
+		assert_int_equal(m_transcript_log[index].session_id, *session_id);
+	}
+	assert_int_equal(m_transcript_log[index].message_size, message_size);
+}
+
+/**
+  Test 9: An external transcript backend sees messages B, C and M of the connection,
+  messages M, K and F of a session with its session ID, and the TH1 and TH2 digests
+  of the session. A message the internal transcript cannot hold is not passed to it.
+**/
+static void test_spdm_common_context_data_case9(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_session_info_t *session_info;
+	uint32 session_id;
+	uint8 message[] = { 0x11, 0x81, 0x00, 0x00 };
+	uint8 th_hash[MAX_HASH_SIZE];
+	uintn hash_size;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x9;
+
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	hash_size = spdm_get_hash_size(m_use_hash_algo);
+	libspdm_reset_message_a(spdm_context);
+	libspdm_reset_message_b(spdm_context);
+	libspdm_reset_message_c(spdm_context);
+	libspdm_reset_message_m(spdm_context, NULL);
+
+	m_transcript_log_count = 0;
+	m_transcript_digest_count = 0;
+	libspdm_register_transcript_func(spdm_context,
+					 spdm_transcript_log_append, NULL,
+					 spdm_transcript_log_extend);
+
+	status = libspdm_append_message_b(spdm_context, message, sizeof(message));
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = libspdm_append_message_c(spdm_context, message, sizeof(message));
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = libspdm_append_message_m(spdm_context, NULL, message,
+					  sizeof(message));
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_transcript_log_count, 3);
+	spdm_transcript_log_check(0, SPDM_TRANSCRIPT_MESSAGE_B, NULL,
+				  sizeof(message));
+	spdm_transcript_log_check(1, SPDM_TRANSCRIPT_MESSAGE_C, NULL,
+				  sizeof(message));
+	spdm_transcript_log_check(2, SPDM_TRANSCRIPT_MESSAGE_M, NULL,
+				  sizeof(message));
+
+	session_id = 0xFFFFFFFE;
+	session_info = libspdm_assign_session_id(spdm_context, session_id, TRUE);
+	assert_non_null(session_info);
+
+	m_transcript_log_count = 0;
+	status = libspdm_append_message_m(spdm_context, session_info, message,
+					  sizeof(message));
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = libspdm_append_message_k(spdm_context, session_info, TRUE,
+					  message, sizeof(message));
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_transcript_log_count, 2);
+	spdm_transcript_log_check(0, SPDM_TRANSCRIPT_MESSAGE_M, &session_id,
+				  sizeof(message));
+	spdm_transcript_log_check(1, SPDM_TRANSCRIPT_MESSAGE_K, &session_id,
+				  sizeof(message));
+
+	status = libspdm_calculate_th1_hash(spdm_context, session_info, TRUE,
+					    th_hash);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_transcript_digest_count, 1);
+	assert_int_equal(m_transcript_digest_type, SPDM_TRANSCRIPT_DIGEST_TH1);
+	assert_int_equal(m_transcript_digest_session_id, session_id);
+	assert_memory_equal(m_transcript_digest, th_hash, hash_size);
+
+	status = libspdm_append_message_f(spdm_context, session_info, TRUE,
+					  message, sizeof(message));
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_transcript_log_count, 3);
+	spdm_transcript_log_check(2, SPDM_TRANSCRIPT_MESSAGE_F, &session_id,
+				  sizeof(message));
+
+	status = libspdm_calculate_th2_hash(spdm_context, session_info, TRUE,
+					    th_hash);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_transcript_digest_count, 2);
+	assert_int_equal(m_transcript_digest_type, SPDM_TRANSCRIPT_DIGEST_TH2);
+	assert_int_equal(m_transcript_digest_session_id, session_id);
+	assert_memory_equal(m_transcript_digest, th_hash, hash_size);
+
+	//
+	// The internal message A cannot hold this, so the backend does not see it.
+	//
+	m_transcript_log_count = 0;
+	status = libspdm_append_message_a(
+		spdm_context, message,
+		spdm_context->transcript.message_a.max_buffer_size + 1);
+	assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+	assert_int_equal(m_transcript_log_count, 0);
+
+	libspdm_register_transcript_func(spdm_context, NULL, NULL, NULL);
+	libspdm_reset_message_m(spdm_context, session_info);
+	libspdm_reset_message_k(spdm_context, session_info);
+	libspdm_reset_message_f(spdm_context, session_info);
+	libspdm_free_session_id(spdm_context, session_id);
+	libspdm_reset_message_a(spdm_context);
+	libspdm_reset_message_b(spdm_context);
+	libspdm_reset_message_c(spdm_context);
+	libspdm_reset_message_m(spdm_context, NULL);
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NOT_STARTED;
+}
+
+static void *m_device_message;
+static uintn m_device_message_size;
+static uintn m_device_send_count;
+
+static return_status spdm_device_record_send_message(IN void *spdm_context,
+						    IN uintn request_size,
+						    IN void *request,
+						    IN uint64 timeout)
+{
+	m_device_message = request;
+	m_device_message_size = request_size;
+	m_device_send_count++;
+	return RETURN_SUCCESS;
+}
+
+static return_status spdm_device_record_receive_message(
+	IN void *spdm_context, IN OUT uintn *response_size,
+	IN OUT void *response, IN uint64 timeout)
+{
+	m_device_message = response;
+	m_device_message_size = *response_size;
+	return RETURN_DEVICE_ERROR;
+}
+
+/**
+  Test 10: the sender and receiver buffers registered by the integrator are
+  handed to the device IO functions, and without a registered buffer the
+  default one in the context is used, or the call fails if there is none.
+**/
+static void test_spdm_common_context_data_case10(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_get_version_request_t request;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+	static uint8 sender_buffer[0x100];
+	static uint8 receiver_buffer[0x200];
+	void *group_sender_buffer;
+	uintn group_sender_buffer_size;
+	void *group_receiver_buffer;
+	uintn group_receiver_buffer_size;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0xA;
+
+	group_sender_buffer = spdm_context->sender_buffer;
+	group_sender_buffer_size = spdm_context->sender_buffer_size;
+	group_receiver_buffer = spdm_context->receiver_buffer;
+	group_receiver_buffer_size = spdm_context->receiver_buffer_size;
+	libspdm_register_device_io_func(spdm_context,
+					spdm_device_record_send_message,
+					spdm_device_record_receive_message);
+
+	zero_mem(&request, sizeof(request));
+	request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	request.header.request_response_code = SPDM_GET_VERSION;
+
+	//
+	// Registered buffers
+	//
+	libspdm_register_device_buffer(spdm_context, sender_buffer,
+				       sizeof(sender_buffer), receiver_buffer,
+				       sizeof(receiver_buffer));
+	m_device_send_count = 0;
+	status = libspdm_send_request(spdm_context, NULL, FALSE,
+				      sizeof(request), &request);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_device_send_count, 1);
+	assert_ptr_equal(m_device_message, sender_buffer);
+
+	response_size = sizeof(response);
+	status = libspdm_receive_response(spdm_context, NULL, FALSE,
+					  &response_size, response);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+	assert_ptr_equal(m_device_message, receiver_buffer);
+	assert_int_equal(m_device_message_size, sizeof(receiver_buffer));
+
+	//
+	// No registered buffers
+	//
+	libspdm_register_device_buffer(spdm_context, NULL, 0, NULL, 0);
+	m_device_send_count = 0;
+	m_device_message = NULL;
+	status = libspdm_send_request(spdm_context, NULL, FALSE,
+				      sizeof(request), &request);
+	response_size = sizeof(response);
+#if LIBSPDM_DEFAULT_DEVICE_BUFFER_SUPPORT
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_device_send_count, 1);
+	assert_ptr_equal(m_device_message, spdm_context->default_sender_buffer);
+
+	status = libspdm_receive_response(spdm_context, NULL, FALSE,
+					  &response_size, response);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+	assert_ptr_equal(m_device_message,
+			 spdm_context->default_receiver_buffer);
+	assert_int_equal(m_device_message_size,
+			 sizeof(spdm_context->default_receiver_buffer));
+#else
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+	assert_int_equal(m_device_send_count, 0);
+
+	status = libspdm_receive_response(spdm_context, NULL, FALSE,
+					  &response_size, response);
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+	assert_null(m_device_message);
+#endif
+
+	libspdm_register_device_buffer(spdm_context, group_sender_buffer,
+				       group_sender_buffer_size,
+				       group_receiver_buffer,
+				       group_receiver_buffer_size);
+	libspdm_register_device_io_func(spdm_context, NULL, NULL);
+}
+
+static uint8 m_device_acquired_buffer[0x200];
+static boolean m_device_acquire_fail;
+static uintn m_device_acquire_count;
+static uintn m_device_release_count;
+static void *m_device_released_buffer;
+
+static return_status spdm_device_acquire_buffer(IN void *spdm_context,
+					       OUT uintn *max_msg_size,
+					       OUT void **msg_buf_ptr)
+{
+	if (m_device_acquire_fail) {
+		return RETURN_NOT_READY;
+	}
+	assert_int_equal(m_device_acquire_count, m_device_release_count);
+	m_device_acquire_count++;
+	*max_msg_size = sizeof(m_device_acquired_buffer);
+	*msg_buf_ptr = m_device_acquired_buffer;
+	return RETURN_SUCCESS;
+}
+
+static void spdm_device_release_buffer(IN void *spdm_context,
+				       IN void *msg_buf_ptr)
+{
+	m_device_release_count++;
+	m_device_released_buffer = msg_buf_ptr;
+}
+
+/**
+  Test 11: the registered acquire and release functions provide the buffer
+  for each message, every acquired buffer is released once, and a failed
+  acquire stops the message before the device IO functions are called.
+  The failure is RETURN_OUT_OF_RESOURCES, so it is not taken for would-block IO.
+**/
+static void test_spdm_common_context_data_case11(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_get_version_request_t request;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0xB;
+
+	libspdm_register_device_io_func(spdm_context,
+					spdm_device_record_send_message,
+					spdm_device_record_receive_message);
+	libspdm_register_device_buffer_func(
+		spdm_context, spdm_device_acquire_buffer,
+		spdm_device_release_buffer, spdm_device_acquire_buffer,
+		spdm_device_release_buffer);
+
+	zero_mem(&request, sizeof(request));
+	request.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	request.header.request_response_code = SPDM_GET_VERSION;
+
+	m_device_acquire_fail = FALSE;
+	m_device_acquire_count = 0;
+	m_device_release_count = 0;
+	m_device_send_count = 0;
+	status = libspdm_send_request(spdm_context, NULL, FALSE,
+				      sizeof(request), &request);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_device_send_count, 1);
+	assert_ptr_equal(m_device_message, m_device_acquired_buffer);
+	assert_int_equal(m_device_acquire_count, 1);
+	assert_int_equal(m_device_release_count, 1);
+	assert_ptr_equal(m_device_released_buffer, m_device_acquired_buffer);
+
+	//
+	// The receiver buffer is released on the error path too.
+	//
+	response_size = sizeof(response);
+	status = libspdm_receive_response(spdm_context, NULL, FALSE,
+					  &response_size, response);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+	assert_ptr_equal(m_device_message, m_device_acquired_buffer);
+	assert_int_equal(m_device_message_size,
+			 sizeof(m_device_acquired_buffer));
+	assert_int_equal(m_device_acquire_count, 2);
+	assert_int_equal(m_device_release_count, 2);
+
+	m_device_acquire_fail = TRUE;
+	m_device_send_count = 0;
+	status = libspdm_send_request(spdm_context, NULL, FALSE,
+				      sizeof(request), &request);
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+	assert_int_equal(m_device_send_count, 0);
+	m_device_message = NULL;
+	response_size = sizeof(response);
+	status = libspdm_receive_response(spdm_context, NULL, FALSE,
+					  &response_size, response);
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+	assert_null(m_device_message);
+	assert_int_equal(m_device_release_count, 2);
+
+	libspdm_register_device_buffer_func(spdm_context, NULL, NULL, NULL,
+					    NULL);
+	libspdm_register_device_io_func(spdm_context, NULL, NULL);
+}
+
+/**
+  Test 12: The measurement summary hash is cached per measurement generation,
+  and recalculated when the generation or the negotiated algorithms change.
+**/
+static void test_spdm_common_context_data_case12(void **state)
+{
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_measurement_summary_hash_cache_t *cache;
+	uint8 expected_hash[MAX_HASH_SIZE];
+	uint8 measurement_summary_hash[MAX_HASH_SIZE];
+	uint8 stale_hash[MAX_HASH_SIZE];
+	uintn hash_size;
+	boolean result;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0xC;
+
+	spdm_context->local_context.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+	spdm_context->connection_info.version.major_version = 1;
+	spdm_context->connection_info.version.minor_version = 1;
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	zero_mem(spdm_context->measurement_summary_hash_cache,
+		 sizeof(spdm_context->measurement_summary_hash_cache));
+	cache = &spdm_context->measurement_summary_hash_cache
+			 [SPDM_MEASUREMENT_SUMMARY_HASH_CACHE_ALL];
+	hash_size = spdm_get_hash_size(m_use_hash_algo);
+	set_mem(stale_hash, sizeof(stale_hash), 0x5A);
+
+	result = spdm_generate_measurement_summary_hash(
+		spdm_context, FALSE,
+		SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH, expected_hash);
+	assert_true(result);
+	assert_true(cache->valid);
+	assert_int_equal(cache->generation, spdm_measurement_generation());
+	assert_memory_equal(cache->hash, expected_hash, hash_size);
+	assert_false(spdm_context->measurement_summary_hash_cache
+			     [SPDM_MEASUREMENT_SUMMARY_HASH_CACHE_TCB]
+				     .valid);
+
+	//
+	// The cached hash is returned while nothing changes.
+	//
+	copy_mem(cache->hash, stale_hash, hash_size);
+	result = spdm_generate_measurement_summary_hash(
+		spdm_context, FALSE,
+		SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH,
+		measurement_summary_hash);
+	assert_true(result);
+	assert_memory_equal(measurement_summary_hash, stale_hash, hash_size);
+
+	//
+	// A different base hash algorithm recalculates the hash.
+	//
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384;
+	result = spdm_generate_measurement_summary_hash(
+		spdm_context, FALSE,
+		SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH,
+		measurement_summary_hash);
+	assert_true(result);
+	assert_true(cache->valid);
+	assert_int_equal(cache->base_hash_algo,
+			 SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384);
+	assert_memory_not_equal(measurement_summary_hash, stale_hash,
+				hash_size);
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	result = spdm_generate_measurement_summary_hash(
+		spdm_context, FALSE,
+		SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH,
+		measurement_summary_hash);
+	assert_true(result);
+	assert_memory_equal(measurement_summary_hash, expected_hash,
+			    hash_size);
+
+	//
+	// A new measurement generation recalculates the hash.
+	//
+	copy_mem(cache->hash, stale_hash, hash_size);
+	spdm_measurement_invalidate(
+		SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS);
+	result = spdm_generate_measurement_summary_hash(
+		spdm_context, FALSE,
+		SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH,
+		measurement_summary_hash);
+	assert_true(result);
+	assert_int_equal(cache->generation, spdm_measurement_generation());
+	assert_memory_equal(measurement_summary_hash, expected_hash,
+			    hash_size);
+
+	//
+	// The TCB summary hash has its own entry.
+	//
+	result = spdm_generate_measurement_summary_hash(
+		spdm_context, FALSE,
+		SPDM_CHALLENGE_REQUEST_TCB_COMPONENT_MEASUREMENT_HASH,
+		measurement_summary_hash);
+	assert_true(result);
+	assert_true(spdm_context->measurement_summary_hash_cache
+			    [SPDM_MEASUREMENT_SUMMARY_HASH_CACHE_TCB]
+				    .valid);
+	assert_memory_equal(cache->hash, expected_hash, hash_size);
+}
+
+static uint8 m_measurement_region[MEASUREMENT_STREAM_CHUNK_SIZE + 0x800];
+static uint8 m_measurement_default_region[MEASUREMENT_MANIFEST_SIZE];
+
+/**
+  Collect one hashed measurement block from the sample device secret library.
+**/
+static void spdm_collect_measurement_digest(IN uint8 measurement_index,
+					    OUT uint8 *digest)
+{
+	return_status status;
+	spdm_version_number_t spdm_version;
+	uint8 measurements[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uintn measurements_size;
+	uint8 measurements_count;
+	spdm_measurement_block_dmtf_t *measurement_block;
+	uintn hash_size;
+
+	zero_mem(&spdm_version, sizeof(spdm_version));
+	spdm_version.major_version = 1;
+	spdm_version.minor_version = 1;
+	hash_size = spdm_get_measurement_hash_size(m_use_measurement_hash_algo);
+	measurements_size = sizeof(measurements);
+	status = spdm_measurement_collection(
+		spdm_version, m_use_measurement_spec,
+		m_use_measurement_hash_algo, measurement_index,
+		&measurements_count, measurements, &measurements_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(measurements_count, 1);
+	assert_int_equal(measurements_size,
+			 sizeof(spdm_measurement_block_dmtf_t) + hash_size);
+	measurement_block = (void *)measurements;
+	assert_int_equal(
+		measurement_block->Measurement_block_common_header.index,
+		measurement_index);
+	copy_mem(digest, measurement_block + 1, hash_size);
+}
+
+/**
+  Test 13: The sample measurement provider hashes each region as a stream,
+  caches the digest until the block is invalidated, and advances the
+  measurement generation on every change.
+**/
+static void test_spdm_common_context_data_case13(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_version_number_t spdm_version;
+	uint8 measurements[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uintn measurements_size;
+	uint8 measurements_count;
+	uint8 digest[MAX_HASH_SIZE];
+	uint8 expected_digest[MAX_HASH_SIZE];
+	uintn hash_size;
+	uint32 generation;
+
+	spdm_test_context = *state;
+	spdm_test_context->case_id = 0xD;
+
+	hash_size = spdm_get_measurement_hash_size(m_use_measurement_hash_algo);
+
+	set_mem(m_measurement_default_region,
+		sizeof(m_measurement_default_region), 1);
+	spdm_measurement_hash_all(m_use_measurement_hash_algo,
+				  m_measurement_default_region,
+				  sizeof(m_measurement_default_region),
+				  expected_digest);
+	spdm_collect_measurement_digest(1, digest);
+	assert_memory_equal(digest, expected_digest, hash_size);
+
+	//
+	// A region larger than one stream chunk is hashed in place.
+	//
+	generation = spdm_measurement_generation();
+	set_mem(m_measurement_region, sizeof(m_measurement_region), 0x33);
+	status = spdm_measurement_set_region(1, m_measurement_region,
+					     sizeof(m_measurement_region));
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_not_equal(spdm_measurement_generation(), generation);
+	spdm_measurement_hash_all(m_use_measurement_hash_algo,
+				  m_measurement_region,
+				  sizeof(m_measurement_region),
+				  expected_digest);
+	spdm_collect_measurement_digest(1, digest);
+	assert_memory_equal(digest, expected_digest, hash_size);
+
+	//
+	// The digest is cached until the block is invalidated.
+	//
+	m_measurement_region[0] = 0x44;
+	spdm_collect_measurement_digest(1, digest);
+	assert_memory_equal(digest, expected_digest, hash_size);
+	generation = spdm_measurement_generation();
+	spdm_measurement_invalidate(1);
+	assert_int_not_equal(spdm_measurement_generation(), generation);
+	spdm_measurement_hash_all(m_use_measurement_hash_algo,
+				  m_measurement_region,
+				  sizeof(m_measurement_region),
+				  expected_digest);
+	spdm_collect_measurement_digest(1, digest);
+	assert_memory_equal(digest, expected_digest, hash_size);
+
+	//
+	// The all measurements path returns the same block.
+	//
+	zero_mem(&spdm_version, sizeof(spdm_version));
+	spdm_version.major_version = 1;
+	spdm_version.minor_version = 1;
+	measurements_size = sizeof(measurements);
+	status = spdm_measurement_collection(
+		spdm_version, m_use_measurement_spec,
+		m_use_measurement_hash_algo,
+		SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+		&measurements_count, measurements, &measurements_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(measurements_count, MEASUREMENT_BLOCK_NUMBER);
+	assert_memory_equal(measurements + sizeof(spdm_measurement_block_dmtf_t),
+			    expected_digest, hash_size);
+
+	status = spdm_measurement_set_region(0, m_measurement_region,
+					     sizeof(m_measurement_region));
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+	status = spdm_measurement_set_region(MEASUREMENT_BLOCK_NUMBER + 1,
+					     m_measurement_region,
+					     sizeof(m_measurement_region));
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+
+	status = spdm_measurement_set_region(1, m_measurement_default_region,
+					     sizeof(m_measurement_default_region));
+	assert_int_equal(status, RETURN_SUCCESS);
+}
+
 static spdm_test_context_t m_spdm_common_context_data_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -198,6 +1170,19 @@ int spdm_common_context_data_test_main(void)
 		cmocka_unit_test(test_spdm_common_context_data_case2),
 		cmocka_unit_test(test_spdm_common_context_data_case3),
 		cmocka_unit_test(test_spdm_common_context_data_case4),
+		cmocka_unit_test(test_spdm_common_context_data_case5),
+#if LIBSPDM_STATISTICS_SUPPORT
+		cmocka_unit_test(test_spdm_common_context_data_case6),
+#endif
+#if LIBSPDM_TRACE_SUPPORT
+		cmocka_unit_test(test_spdm_common_context_data_case7),
+#endif
+		cmocka_unit_test(test_spdm_common_context_data_case8),
+		cmocka_unit_test(test_spdm_common_context_data_case9),
+		cmocka_unit_test(test_spdm_common_context_data_case10),
+		cmocka_unit_test(test_spdm_common_context_data_case11),
+		cmocka_unit_test(test_spdm_common_context_data_case12),
+		cmocka_unit_test(test_spdm_common_context_data_case13),
 	};
 
 	setup_spdm_test_context(&m_spdm_common_context_data_test_context);
@@ -0,0 +1,219 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <internal/libspdm_common_lib.h>
+
+#include <stdio.h>
+#if defined(_MSC_VER)
+#include <io.h>
+#define dup _dup
+#define dup2 _dup2
+#define close _close
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
+
+#if !defined(MDEPKG_NDEBUG)
+#define DUMP_TEST_LINE_SIZE 32
+#define DUMP_TEST_OUTPUT_SIZE 0x400
+
+typedef void (*spdm_dump_func)(IN uint8 *data, IN uintn size);
+
+static uint8 m_dump_test_data[DUMP_TEST_LINE_SIZE + 1];
+
+/**
+  Run a dump function with the standard output redirected to a temporary file.
+
+  @param  dump_func                     The dump function.
+  @param  size                          The size in bytes of m_dump_test_data to dump.
+  @param  output                        The buffer to store the output, NULL terminated.
+  @param  output_size                   The size in bytes of the output buffer.
+
+  @return The length of the output.
+**/
+static uintn spdm_dump_test_capture(IN spdm_dump_func dump_func,
+				    IN uintn size, OUT char8 *output,
+				    IN uintn output_size)
+{
+	FILE *file;
+	int saved_stdout;
+	uintn length;
+
+	file = tmpfile();
+	assert_non_null(file);
+	fflush(stdout);
+	saved_stdout = dup(fileno(stdout));
+	assert_true(saved_stdout >= 0);
+	dup2(fileno(file), fileno(stdout));
+
+	dump_func(m_dump_test_data, size);
+
+	fflush(stdout);
+	dup2(saved_stdout, fileno(stdout));
+	close(saved_stdout);
+
+	rewind(file);
+	length = fread(output, 1, output_size - 1, file);
+	output[length] = '\0';
+	fclose(file);
+	return length;
+}
+
+/**
+  Build the expected output of a dump of m_dump_test_data.
+
+  @param  size                          The size in bytes of m_dump_test_data dumped.
+  @param  offset                        Start each line with its offset, and end it with a new line.
+  @param  separator                     Append a space after each byte.
+  @param  output                        The buffer to store the expected output, NULL terminated.
+**/
+static void spdm_dump_test_expected(IN uintn size, IN boolean offset,
+				    IN boolean separator, OUT char8 *output)
+{
+	uintn index;
+	uintn length;
+
+	length = 0;
+	for (index = 0; index < size; index++) {
+		if (offset && (index % DUMP_TEST_LINE_SIZE == 0)) {
+			length += sprintf(output + length, "%04x: ",
+					  (uint32)index);
+		}
+		length += sprintf(output + length, separator ? "%02x " : "%02x",
+				  m_dump_test_data[index]);
+		if (offset && ((index + 1) % DUMP_TEST_LINE_SIZE == 0 ||
+			       index + 1 == size)) {
+			length += sprintf(output + length, "\n");
+		}
+	}
+	output[length] = '\0';
+}
+
+/**
+  Test 1: dump 0, 31, 32 and 33 bytes with internal_dump_hex.
+  Expected behavior: nothing is printed for 0 bytes, and a line of up to 32 bytes is printed
+  for each 32 bytes, starting with its offset and ending with a new line.
+**/
+static void test_spdm_common_support_case1(void **state)
+{
+	static const uintn size[] = { 0, DUMP_TEST_LINE_SIZE - 1,
+				      DUMP_TEST_LINE_SIZE,
+				      DUMP_TEST_LINE_SIZE + 1 };
+	static const uintn line_count[] = { 0, 1, 1, 2 };
+	char8 output[DUMP_TEST_OUTPUT_SIZE];
+	char8 expected[DUMP_TEST_OUTPUT_SIZE];
+	uintn index;
+	uintn count;
+	uintn length;
+	uintn error_level;
+
+	error_level = get_debug_print_error_level();
+	set_debug_print_error_level(DEBUG_INFO);
+
+	for (index = 0; index < ARRAY_SIZE(size); index++) {
+		length = spdm_dump_test_capture(internal_dump_hex, size[index],
+						output, sizeof(output));
+		spdm_dump_test_expected(size[index], TRUE, TRUE, expected);
+		assert_string_equal(output, expected);
+		count = 0;
+		while (length-- != 0) {
+			if (output[length] == '\n') {
+				count++;
+			}
+		}
+		assert_int_equal(count, line_count[index]);
+	}
+
+	set_debug_print_error_level(error_level);
+}
+
+/**
+  Test 2: dump 0, 31, 32 and 33 bytes with internal_dump_data and internal_dump_hex_str.
+  Expected behavior: each byte is printed as 2 hex characters, followed by a space for
+  internal_dump_data, without any offset or new line.
+**/
+static void test_spdm_common_support_case2(void **state)
+{
+	static const uintn size[] = { 0, DUMP_TEST_LINE_SIZE - 1,
+				      DUMP_TEST_LINE_SIZE,
+				      DUMP_TEST_LINE_SIZE + 1 };
+	char8 output[DUMP_TEST_OUTPUT_SIZE];
+	char8 expected[DUMP_TEST_OUTPUT_SIZE];
+	uintn index;
+	uintn length;
+	uintn error_level;
+
+	error_level = get_debug_print_error_level();
+	set_debug_print_error_level(DEBUG_INFO);
+
+	for (index = 0; index < ARRAY_SIZE(size); index++) {
+		length = spdm_dump_test_capture(internal_dump_data, size[index],
+						output, sizeof(output));
+		spdm_dump_test_expected(size[index], FALSE, TRUE, expected);
+		assert_int_equal(length, size[index] * 3);
+		assert_string_equal(output, expected);
+
+		length = spdm_dump_test_capture(internal_dump_hex_str,
+						size[index], output,
+						sizeof(output));
+		spdm_dump_test_expected(size[index], FALSE, FALSE, expected);
+		assert_int_equal(length, size[index] * 2);
+		assert_string_equal(output, expected);
+	}
+
+	set_debug_print_error_level(error_level);
+}
+
+/**
+  Test 3: dump 33 bytes when DEBUG_INFO is disabled.
+  Expected behavior: nothing is printed.
+**/
+static void test_spdm_common_support_case3(void **state)
+{
+	char8 output[DUMP_TEST_OUTPUT_SIZE];
+	uintn length;
+	uintn error_level;
+
+	error_level = get_debug_print_error_level();
+	set_debug_print_error_level(DEBUG_ERROR);
+
+	length = spdm_dump_test_capture(internal_dump_hex,
+					sizeof(m_dump_test_data), output,
+					sizeof(output));
+	assert_int_equal(length, 0);
+	length = spdm_dump_test_capture(internal_dump_data,
+					sizeof(m_dump_test_data), output,
+					sizeof(output));
+	assert_int_equal(length, 0);
+
+	set_debug_print_error_level(error_level);
+}
+#endif
+
+int spdm_common_support_test_main(void)
+{
+#if !defined(MDEPKG_NDEBUG)
+	const struct CMUnitTest spdm_common_support_tests[] = {
+		// internal_dump_hex line layout
+		cmocka_unit_test(test_spdm_common_support_case1),
+		// internal_dump_data and internal_dump_hex_str layout
+		cmocka_unit_test(test_spdm_common_support_case2),
+		// DEBUG_INFO disabled
+		cmocka_unit_test(test_spdm_common_support_case3),
+	};
+	uintn index;
+
+	for (index = 0; index < sizeof(m_dump_test_data); index++) {
+		m_dump_test_data[index] = (uint8)(0xE0 + index);
+	}
+
+	return cmocka_run_group_tests(spdm_common_support_tests, NULL, NULL);
+#else
+	return 0;
+#endif
+}
@@ -6,6 +6,7 @@
 
 
 extern int spdm_common_context_data_test_main(void);
+extern int spdm_common_support_test_main(void);
 
 int main(void)
 {
@@ -15,5 +16,9 @@ int main(void)
 		return_value = 1;
 	}
 
+	if (spdm_common_support_test_main() != 0) {
+		return_value = 1;
+	}
+
 	return return_value;
 }
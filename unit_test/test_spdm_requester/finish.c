@@ -168,6 +168,7 @@ return_status spdm_requester_finish_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 response_finished_key[MAX_HASH_SIZE];
 		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 		uintn temp_buf_size;
@@ -211,8 +212,9 @@ return_status spdm_requester_finish_test_receive_message(
 		append_managed_buffer(&th_curr, m_local_buffer,
 				      m_local_buffer_size);
 		set_mem(response_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 		free(data);
@@ -235,6 +237,7 @@ return_status spdm_requester_finish_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 response_finished_key[MAX_HASH_SIZE];
 		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 		uintn temp_buf_size;
@@ -278,8 +281,9 @@ return_status spdm_requester_finish_test_receive_message(
 		append_managed_buffer(&th_curr, m_local_buffer,
 				      m_local_buffer_size);
 		set_mem(response_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 		free(data);
@@ -348,6 +352,7 @@ return_status spdm_requester_finish_test_receive_message(
 			uintn cert_buffer_size;
 			uint8 cert_buffer_hash[MAX_HASH_SIZE];
 			large_managed_buffer_t th_curr;
+			uint8 th_curr_hash_data[MAX_HASH_SIZE];
 			uint8 response_finished_key[MAX_HASH_SIZE];
 			uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 			uintn temp_buf_size;
@@ -398,9 +403,9 @@ return_status spdm_requester_finish_test_receive_message(
 					      m_local_buffer_size);
 			set_mem(response_finished_key, MAX_HASH_SIZE,
 				(uint8)(0xFF));
-			spdm_hmac_all(m_use_hash_algo,
-				      get_managed_buffer(&th_curr),
-				      get_managed_buffer_size(&th_curr),
+			spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+				      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+			spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 				      response_finished_key, hash_size, ptr);
 			ptr += hmac_size;
 			free(data);
@@ -481,6 +486,7 @@ return_status spdm_requester_finish_test_receive_message(
 			uintn cert_buffer_size;
 			uint8 cert_buffer_hash[MAX_HASH_SIZE];
 			large_managed_buffer_t th_curr;
+			uint8 th_curr_hash_data[MAX_HASH_SIZE];
 			uint8 response_finished_key[MAX_HASH_SIZE];
 			uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 			uintn temp_buf_size;
@@ -531,9 +537,9 @@ return_status spdm_requester_finish_test_receive_message(
 					      m_local_buffer_size);
 			set_mem(response_finished_key, MAX_HASH_SIZE,
 				(uint8)(0xFF));
-			spdm_hmac_all(m_use_hash_algo,
-				      get_managed_buffer(&th_curr),
-				      get_managed_buffer_size(&th_curr),
+			spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+				      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+			spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 				      response_finished_key, hash_size, ptr);
 			ptr += hmac_size;
 			free(data);
@@ -585,6 +591,7 @@ return_status spdm_requester_finish_test_receive_message(
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 response_finished_key[MAX_HASH_SIZE];
 	uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 	uintn temp_buf_size;
@@ -628,9 +635,10 @@ return_status spdm_requester_finish_test_receive_message(
 	append_managed_buffer(&th_curr, m_local_buffer,
 					m_local_buffer_size);
 	set_mem(response_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-				get_managed_buffer_size(&th_curr),
-				response_finished_key, hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      response_finished_key, hash_size, ptr);
 	ptr += hmac_size;
 	free(data);
 
@@ -652,6 +660,7 @@ return_status spdm_requester_finish_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 response_finished_key[MAX_HASH_SIZE];
 		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 		uintn temp_buf_size;
@@ -695,8 +704,9 @@ return_status spdm_requester_finish_test_receive_message(
 		append_managed_buffer(&th_curr, m_local_buffer,
 				      m_local_buffer_size);
 		set_mem(response_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 		free(data);
@@ -719,6 +729,7 @@ return_status spdm_requester_finish_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 response_finished_key[MAX_HASH_SIZE];
 		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 		uintn temp_buf_size;
@@ -762,8 +773,9 @@ return_status spdm_requester_finish_test_receive_message(
 		append_managed_buffer(&th_curr, m_local_buffer,
 				      m_local_buffer_size);
 		set_mem(response_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 		free(data);
@@ -786,6 +798,7 @@ return_status spdm_requester_finish_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 response_finished_key[MAX_HASH_SIZE];
 		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 		uintn temp_buf_size;
@@ -830,8 +843,9 @@ return_status spdm_requester_finish_test_receive_message(
 		append_managed_buffer(&th_curr, m_local_buffer,
 				      m_local_buffer_size);
 		set_mem(response_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 		free(data);
@@ -854,6 +868,7 @@ return_status spdm_requester_finish_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 response_finished_key[MAX_HASH_SIZE];
 		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 		uintn temp_buf_size;
@@ -897,8 +912,9 @@ return_status spdm_requester_finish_test_receive_message(
 		append_managed_buffer(&th_curr, m_local_buffer,
 				      m_local_buffer_size);
 		set_mem(response_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 		free(data);
@@ -922,6 +938,7 @@ return_status spdm_requester_finish_test_receive_message(
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		uint8 req_cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 response_finished_key[MAX_HASH_SIZE];
 		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 		uintn temp_buf_size;
@@ -977,8 +994,9 @@ return_status spdm_requester_finish_test_receive_message(
 		append_managed_buffer(&th_curr, m_local_buffer,
 			      m_local_buffer_size);
 		set_mem(response_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 		free(data);
@@ -1091,6 +1109,7 @@ return_status spdm_requester_finish_test_receive_message(
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		uint8 req_cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 response_finished_key[MAX_HASH_SIZE];
 		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 		uintn temp_buf_size;
@@ -1147,8 +1166,9 @@ return_status spdm_requester_finish_test_receive_message(
 		append_managed_buffer(&th_curr, m_local_buffer,
 			      m_local_buffer_size);
 		set_mem(response_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		copy_mem(ptr, ptr + hmac_size, hmac_size); // 2x HMAC size
 		ptr += 2*hmac_size;
@@ -1173,6 +1193,7 @@ return_status spdm_requester_finish_test_receive_message(
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		uint8 req_cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 response_finished_key[MAX_HASH_SIZE];
 		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 		uintn temp_buf_size;
@@ -1229,8 +1250,9 @@ return_status spdm_requester_finish_test_receive_message(
 		append_managed_buffer(&th_curr, m_local_buffer,
 			      m_local_buffer_size);
 		set_mem(response_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size/2; // half HMAC size
 		set_mem(ptr, hmac_size/2, (uint8) 0x00);
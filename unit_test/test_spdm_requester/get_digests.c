@@ -63,11 +63,50 @@ return_status spdm_requester_get_digests_test_send_message(
 		return RETURN_SUCCESS;
 	case 0x16:
 		return RETURN_SUCCESS;
+	case 0x17:
+		return RETURN_SUCCESS;
+	case 0x18:
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
 }
 
+/**
+  Build a DIGESTS response with the digest of m_local_certificate_chain in slot 0.
+**/
+void spdm_requester_get_digests_test_build_digests(IN void *spdm_context,
+						    IN OUT uintn *response_size,
+						    IN OUT void *response)
+{
+	spdm_digest_response_t *spdm_response;
+	uint8 *digest;
+	uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn temp_buf_size;
+
+	((spdm_context_t *)spdm_context)
+		->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
+	temp_buf_size = sizeof(spdm_digest_response_t) +
+			spdm_get_hash_size(m_use_hash_algo);
+	spdm_response = (void *)temp_buf;
+
+	spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+	spdm_response->header.param1 = 0;
+	spdm_response->header.request_response_code = SPDM_DIGESTS;
+	spdm_response->header.param2 = 0;
+	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
+		(uint8)(0xFF));
+
+	digest = (void *)(spdm_response + 1);
+	spdm_hash_all(m_use_hash_algo, m_local_certificate_chain,
+		      MAX_SPDM_MESSAGE_BUFFER_SIZE, &digest[0]);
+	spdm_response->header.param2 |= (1 << 0);
+
+	spdm_transport_test_encode_message(spdm_context, NULL, FALSE, FALSE,
+					   temp_buf_size, temp_buf,
+					   response_size, response);
+}
+
 return_status spdm_requester_get_digests_test_receive_message(
 	IN void *spdm_context, IN OUT uintn *response_size,
 	IN OUT void *response, IN uint64 timeout)
@@ -632,11 +671,78 @@ return_status spdm_requester_get_digests_test_receive_message(
   }
     return RETURN_SUCCESS;
 
+	case 0x17: {
+		static uintn sub_index3 = 0;
+		if (sub_index3 < 2) {
+			spdm_error_response_data_response_not_ready_t
+				spdm_response;
+
+			spdm_response.header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			spdm_response.header.request_response_code = SPDM_ERROR;
+			spdm_response.header.param1 =
+				SPDM_ERROR_CODE_RESPONSE_NOT_READY;
+			spdm_response.header.param2 = 0;
+			spdm_response.extend_error_data.rd_exponent = 2;
+			spdm_response.extend_error_data.rd_tm = 4;
+			spdm_response.extend_error_data.request_code =
+				SPDM_GET_DIGESTS;
+			spdm_response.extend_error_data.token =
+				(uint8)(sub_index3 + 1);
+
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE,
+				sizeof(spdm_response), &spdm_response,
+				response_size, response);
+		} else {
+			spdm_requester_get_digests_test_build_digests(
+				spdm_context, response_size, response);
+		}
+		sub_index3++;
+	}
+		return RETURN_SUCCESS;
+
+	case 0x18: {
+		static uintn sub_index4 = 0;
+		if (sub_index4 == 0) {
+			spdm_error_response_t spdm_response;
+
+			spdm_response.header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			spdm_response.header.request_response_code = SPDM_ERROR;
+			spdm_response.header.param1 = SPDM_ERROR_CODE_BUSY;
+			spdm_response.header.param2 = 0;
+
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE,
+				sizeof(spdm_response), &spdm_response,
+				response_size, response);
+		} else {
+			spdm_requester_get_digests_test_build_digests(
+				spdm_context, response_size, response);
+		}
+		sub_index4++;
+	}
+		return RETURN_SUCCESS;
+
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
 }
 
+static uint64 m_spdm_get_digests_test_sleep_duration[4];
+static uintn m_spdm_get_digests_test_sleep_count;
+
+void spdm_requester_get_digests_test_sleep(IN void *spdm_context,
+					   IN uint64 duration)
+{
+	assert_true(m_spdm_get_digests_test_sleep_count <
+		    ARRAY_SIZE(m_spdm_get_digests_test_sleep_duration));
+	m_spdm_get_digests_test_sleep_duration
+		[m_spdm_get_digests_test_sleep_count] = duration;
+	m_spdm_get_digests_test_sleep_count++;
+}
+
 /**
   Test 1: a failure occurs during the sending of the request message
   Expected Behavior: requester returns the status RETURN_DEVICE_ERROR, with no DIGESTS message received
@@ -1526,6 +1632,96 @@ void test_spdm_requester_get_digests_case22(void **state) {
   }
 }
 
+/**
+  Test 23: a sleep function is registered, and the responder returns ResponseNotReady twice
+  with RDTExponent 2 and RDTM 4 before a correct DIGESTS message.
+  Expected behavior: client waits RDT (4us) before the first RESPOND_IF_READY, and twice as long
+  before the second one within RDT * RDTM, then returns a status of RETURN_SUCCESS.
+**/
+void test_spdm_requester_get_digests_case23(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 slot_mask;
+	uint8 total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x17;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->local_context.peer_cert_chain_provision =
+		m_local_certificate_chain;
+	spdm_context->local_context.peer_cert_chain_provision_size =
+		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
+		(uint8)(0xFF));
+	libspdm_reset_message_b(spdm_context);
+	libspdm_register_sleep_func(spdm_context,
+				    spdm_requester_get_digests_test_sleep);
+	m_spdm_get_digests_test_sleep_count = 0;
+
+	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
+	status =
+		libspdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
+	libspdm_register_sleep_func(spdm_context, NULL);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_spdm_get_digests_test_sleep_count, 2);
+	assert_int_equal(m_spdm_get_digests_test_sleep_duration[0], 4);
+	assert_int_equal(m_spdm_get_digests_test_sleep_duration[1], 8);
+	assert_int_equal(spdm_context->error_data.token, 2);
+}
+
+/**
+  Test 24: a sleep function is registered, and the responder returns BUSY before a correct DIGESTS message.
+  Expected behavior: client waits between half of and SPDM_BUSY_RETRY_BASE_DELAY before the retry,
+  then returns a status of RETURN_SUCCESS.
+**/
+void test_spdm_requester_get_digests_case24(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 slot_mask;
+	uint8 total_digest_buffer[MAX_HASH_SIZE * MAX_SPDM_SLOT_COUNT];
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x18;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->local_context.peer_cert_chain_provision =
+		m_local_certificate_chain;
+	spdm_context->local_context.peer_cert_chain_provision_size =
+		MAX_SPDM_MESSAGE_BUFFER_SIZE;
+	set_mem(m_local_certificate_chain, MAX_SPDM_MESSAGE_BUFFER_SIZE,
+		(uint8)(0xFF));
+	libspdm_reset_message_b(spdm_context);
+	libspdm_register_sleep_func(spdm_context,
+				    spdm_requester_get_digests_test_sleep);
+	m_spdm_get_digests_test_sleep_count = 0;
+
+	zero_mem(total_digest_buffer, sizeof(total_digest_buffer));
+	status =
+		libspdm_get_digest(spdm_context, &slot_mask, &total_digest_buffer);
+	libspdm_register_sleep_func(spdm_context, NULL);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_spdm_get_digests_test_sleep_count, 1);
+	assert_true(m_spdm_get_digests_test_sleep_duration[0] >=
+		    SPDM_BUSY_RETRY_BASE_DELAY / 2);
+	assert_true(m_spdm_get_digests_test_sleep_duration[0] <=
+		    SPDM_BUSY_RETRY_BASE_DELAY);
+}
+
 spdm_test_context_t m_spdm_requester_get_digests_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -1582,6 +1778,10 @@ int spdm_requester_get_digests_test_main(void)
 		//cmocka_unit_test(test_spdm_requester_get_digests_case21),
 		// Unexpected errors
 		cmocka_unit_test(test_spdm_requester_get_digests_case22),
+		// SPDM_ERROR_CODE_RESPONSE_NOT_READY twice + Successful response, with RDT wait
+		cmocka_unit_test(test_spdm_requester_get_digests_case23),
+		// SPDM_ERROR_CODE_BUSY + Successful response, with backoff
+		cmocka_unit_test(test_spdm_requester_get_digests_case24),
 	};
 
 	setup_spdm_test_context(&m_spdm_requester_get_digests_test_context);
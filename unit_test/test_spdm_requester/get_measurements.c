@@ -16,6 +16,8 @@
 static uintn m_local_buffer_size;
 static uint8 m_local_buffer[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 static uint8 m_local_psk_hint[32];
+static spdm_message_header_t m_local_request_header;
+static boolean m_local_batch_busy_sent;
 
 uintn spdm_test_get_measurement_request_size(IN void *spdm_context,
 					     IN void *buffer,
@@ -396,6 +398,19 @@ return_status spdm_requester_get_measurements_test_send_message(
 			 app_message_size - 3);
 		m_local_buffer_size += app_message_size - 3;
 		return RETURN_SUCCESS;
+	case 0x23:
+	case 0x24:
+	case 0x25:
+		// L1/L2 accumulates over the whole batch
+		message_size = spdm_test_get_measurement_request_size(
+			spdm_context, (uint8 *)request + header_size,
+			request_size - header_size);
+		copy_mem(&m_local_buffer[m_local_buffer_size],
+			 (uint8 *)request + header_size, message_size);
+		m_local_buffer_size += message_size;
+		copy_mem(&m_local_request_header, (uint8 *)request + header_size,
+			 sizeof(m_local_request_header));
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -2522,6 +2537,107 @@ return_status spdm_requester_get_measurements_test_receive_message(
 			->application_secret.response_data_sequence_number--;
 	}
 		return RETURN_SUCCESS;
+	case 0x25:
+		// BUSY once on the second request of the batch
+		if ((m_local_request_header.param2 == 1) &&
+		    !m_local_batch_busy_sent) {
+			spdm_error_response_t spdm_response;
+
+			spdm_response.header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			spdm_response.header.request_response_code = SPDM_ERROR;
+			spdm_response.header.param1 = SPDM_ERROR_CODE_BUSY;
+			spdm_response.header.param2 = 0;
+
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE,
+				sizeof(spdm_response), &spdm_response,
+				response_size, response);
+			m_local_batch_busy_sent = TRUE;
+			return RETURN_SUCCESS;
+		}
+	// fall through
+	case 0x23:
+	case 0x24: {
+		spdm_measurements_response_t *spdm_response;
+		uint8 *ptr;
+		uintn sig_size;
+		uintn measurment_sig_size;
+		spdm_measurement_block_dmtf_t *measurment_block;
+		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+		uintn temp_buf_size;
+
+		if (m_local_request_header.param1 ==
+		    SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) {
+			sig_size = spdm_get_asym_signature_size(m_use_asym_algo);
+		} else {
+			sig_size = 0;
+		}
+		measurment_sig_size =
+			SPDM_NONCE_SIZE + sizeof(uint16) + 0 + sig_size;
+		temp_buf_size = sizeof(spdm_measurements_response_t) +
+				sizeof(spdm_measurement_block_dmtf_t) +
+				spdm_get_measurement_hash_size(
+					m_use_measurement_hash_algo) +
+				measurment_sig_size;
+		spdm_response = (void *)temp_buf;
+
+		spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_response->header.request_response_code = SPDM_MEASUREMENTS;
+		spdm_response->header.param1 = 0;
+		spdm_response->header.param2 = 0;
+		spdm_response->number_of_blocks = 1;
+		libspdm_write_uint24(
+			spdm_response->measurement_record_length,
+			(uint32)(sizeof(spdm_measurement_block_dmtf_t) +
+				 spdm_get_measurement_hash_size(
+					 m_use_measurement_hash_algo)));
+		measurment_block = (void *)(spdm_response + 1);
+		set_mem(measurment_block,
+			sizeof(spdm_measurement_block_dmtf_t) +
+				spdm_get_measurement_hash_size(
+					m_use_measurement_hash_algo),
+			m_local_request_header.param2);
+		measurment_block->Measurement_block_common_header.index =
+			m_local_request_header.param2;
+		if ((spdm_test_context->case_id == 0x24) &&
+		    (m_local_request_header.param2 == 1)) {
+			// return a block other than the requested one
+			measurment_block->Measurement_block_common_header.index =
+				2;
+		}
+		measurment_block->Measurement_block_common_header
+			.measurement_specification =
+			SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+		measurment_block->Measurement_block_common_header
+			.measurement_size =
+			(uint16)(sizeof(spdm_measurement_block_dmtf_header_t) +
+				 spdm_get_measurement_hash_size(
+					 m_use_measurement_hash_algo));
+		ptr = (void *)((uint8 *)spdm_response + temp_buf_size -
+			       measurment_sig_size);
+		spdm_get_random_number(SPDM_NONCE_SIZE, ptr);
+		ptr += SPDM_NONCE_SIZE;
+		*(uint16 *)ptr = 0;
+		ptr += sizeof(uint16);
+		copy_mem(&m_local_buffer[m_local_buffer_size], spdm_response,
+			 (uintn)ptr - (uintn)spdm_response);
+		m_local_buffer_size += ((uintn)ptr - (uintn)spdm_response);
+		if (sig_size != 0) {
+			spdm_responder_data_sign(spdm_version, SPDM_MEASUREMENTS,
+						 m_use_asym_algo, m_use_hash_algo,
+						 FALSE, m_local_buffer,
+						 m_local_buffer_size, ptr,
+						 &sig_size);
+			ptr += sig_size;
+		}
+
+		spdm_transport_test_encode_message(spdm_context, NULL, FALSE,
+						   FALSE, temp_buf_size,
+						   temp_buf, response_size,
+						   response);
+	}
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -4614,6 +4730,203 @@ spdm_test_context_t m_spdm_requester_get_measurements_test_context = {
 	spdm_requester_get_measurements_test_receive_message,
 };
 
+/**
+  Test 35: Successful response to get a batch of measurements, with a single signature over the batch
+  Expected Behavior: get a RETURN_SUCCESS return code, the blocks in request order, with an empty transcript.message_m
+**/
+void test_spdm_requester_get_measurements_case35(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 measurement_indices[3] = { 3, 1, 2 };
+	spdm_measurement_block_common_header_t *measurement_blocks[3];
+	uint32 measurement_record_length;
+	uint8 measurement_record[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uint8 request_attribute;
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x23;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AUTHENTICATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, &hash, &hash_size);
+	libspdm_reset_message_m(spdm_context, NULL);
+	m_local_buffer_size = 0;
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+		data_size;
+	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 data, data_size);
+	request_attribute =
+		SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE;
+
+	measurement_record_length = sizeof(measurement_record);
+	status = libspdm_get_measurements_batch(
+		spdm_context, NULL, request_attribute, 0,
+		ARRAY_SIZE(measurement_indices), measurement_indices,
+		&measurement_record_length, measurement_record,
+		measurement_blocks);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(measurement_record_length,
+			 ARRAY_SIZE(measurement_indices) *
+				 (sizeof(spdm_measurement_block_dmtf_t) +
+				  spdm_get_measurement_hash_size(
+					  m_use_measurement_hash_algo)));
+	for (index = 0; index < ARRAY_SIZE(measurement_indices); index++) {
+		assert_int_equal(measurement_blocks[index]->index,
+				 measurement_indices[index]);
+	}
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+	free(data);
+}
+
+/**
+  Test 36: Batch of measurements, where a response carries a block other than the requested one
+  Expected Behavior: get a RETURN_DEVICE_ERROR return code, with an empty transcript.message_m
+**/
+void test_spdm_requester_get_measurements_case36(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 measurement_indices[3] = { 3, 1, 2 };
+	uint32 measurement_record_length;
+	uint8 measurement_record[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x24;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AUTHENTICATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+	libspdm_reset_message_m(spdm_context, NULL);
+	m_local_buffer_size = 0;
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+
+	measurement_record_length = sizeof(measurement_record);
+	status = libspdm_get_measurements_batch(
+		spdm_context, NULL, 0, 0, ARRAY_SIZE(measurement_indices),
+		measurement_indices, &measurement_record_length,
+		measurement_record, NULL);
+	assert_int_equal(status, RETURN_DEVICE_ERROR);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+	assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+}
+
+static uintn m_local_batch_sleep_count;
+
+static void spdm_requester_get_measurements_test_sleep(IN void *spdm_context,
+						       IN uint64 duration)
+{
+	assert_true(duration <= SPDM_BUSY_RETRY_MAX_DELAY);
+	m_local_batch_sleep_count++;
+}
+
+/**
+  Test 37: Batch of measurements, where the responder is BUSY once in the middle of the batch
+  Expected Behavior: the request is retried after a backoff, get a RETURN_SUCCESS return code and the blocks in request order
+**/
+void test_spdm_requester_get_measurements_case37(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint8 measurement_indices[3] = { 3, 1, 2 };
+	spdm_measurement_block_common_header_t *measurement_blocks[3];
+	uint32 measurement_record_length;
+	uint8 measurement_record[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uint8 invalid_indices[2] = { 1, 0 };
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x25;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AUTHENTICATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+	spdm_context->retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
+	libspdm_reset_message_m(spdm_context, NULL);
+	m_local_buffer_size = 0;
+	m_local_batch_busy_sent = FALSE;
+	m_local_batch_sleep_count = 0;
+	libspdm_register_sleep_func(spdm_context,
+				    spdm_requester_get_measurements_test_sleep);
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+
+	measurement_record_length = sizeof(measurement_record);
+	status = libspdm_get_measurements_batch(
+		spdm_context, NULL, 0, 0, ARRAY_SIZE(measurement_indices),
+		measurement_indices, &measurement_record_length,
+		measurement_record, measurement_blocks);
+	libspdm_register_sleep_func(spdm_context, NULL);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_true(m_local_batch_busy_sent);
+	// The BUSY response is retried after a backoff.
+	assert_int_equal(m_local_batch_sleep_count, 1);
+	assert_int_equal(measurement_record_length,
+			 ARRAY_SIZE(measurement_indices) *
+				 (sizeof(spdm_measurement_block_dmtf_t) +
+				  spdm_get_measurement_hash_size(
+					  m_use_measurement_hash_algo)));
+	for (index = 0; index < ARRAY_SIZE(measurement_indices); index++) {
+		assert_int_equal(measurement_blocks[index]->index,
+				 measurement_indices[index]);
+	}
+
+	//
+	// Index 0 (total number) and 0xFF (all) are not allowed in a batch.
+	//
+	measurement_record_length = sizeof(measurement_record);
+	status = libspdm_get_measurements_batch(
+		spdm_context, NULL, 0, 0, ARRAY_SIZE(invalid_indices),
+		invalid_indices, &measurement_record_length,
+		measurement_record, NULL);
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+	invalid_indices[1] =
+		SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS;
+	status = libspdm_get_measurements_batch(
+		spdm_context, NULL, 0, 0, ARRAY_SIZE(invalid_indices),
+		invalid_indices, &measurement_record_length,
+		measurement_record, NULL);
+	assert_int_equal(status, RETURN_INVALID_PARAMETER);
+}
+
 int spdm_requester_get_measurements_test_main(void)
 {
 	const struct CMUnitTest spdm_requester_get_measurements_tests[] = {
@@ -4685,6 +4998,12 @@ int spdm_requester_get_measurements_test_main(void)
 		cmocka_unit_test(test_spdm_requester_get_measurements_case33),
 		// Successful response to get a session based measurement with signature
 		cmocka_unit_test(test_spdm_requester_get_measurements_case34),
+		// Successful response to get a batch of measurements with a single signature
+		cmocka_unit_test(test_spdm_requester_get_measurements_case35),
+		// error: a response in the batch carries a block other than the requested one
+		cmocka_unit_test(test_spdm_requester_get_measurements_case36),
+		// BUSY in the middle of a batch + Successful response
+		cmocka_unit_test(test_spdm_requester_get_measurements_case37),
 	};
 
 	setup_spdm_test_context(
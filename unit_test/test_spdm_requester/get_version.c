@@ -54,6 +54,24 @@ return_status spdm_requester_get_version_test_send_message(
 		return RETURN_SUCCESS;
 	case 0xF:
 		return RETURN_SUCCESS;
+	case 0x10:
+		return RETURN_SUCCESS;
+	case 0x11: {
+		static uintn sub_index4 = 0;
+
+		//
+		// The first GET_CAPABILITIES cannot be sent yet.
+		//
+		sub_index4++;
+		if (sub_index4 == 2) {
+			return RETURN_NOT_READY;
+		}
+	}
+		return RETURN_SUCCESS;
+	case 0x12:
+		return RETURN_SUCCESS;
+	case 0x13:
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -407,6 +425,160 @@ return_status spdm_requester_get_version_test_receive_message(
 						   response_size, response);
 	}
 		return RETURN_SUCCESS;
+
+	case 0x10: {
+		static uintn sub_index3 = 0;
+		spdm_version_response_mine_t spdm_response;
+
+		if (sub_index3 == 0) {
+			sub_index3++;
+			return RETURN_NOT_READY;
+		}
+
+		zero_mem(&spdm_response, sizeof(spdm_response));
+		spdm_response.header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		spdm_response.header.request_response_code = SPDM_VERSION;
+		spdm_response.header.param1 = 0;
+		spdm_response.header.param2 = 0;
+		spdm_response.version_number_entry_count = 2;
+		spdm_response.version_number_entry[0].major_version = 1;
+		spdm_response.version_number_entry[0].minor_version = 0;
+		spdm_response.version_number_entry[1].major_version = 1;
+		spdm_response.version_number_entry[1].minor_version = 1;
+
+		spdm_transport_test_encode_message(spdm_context, NULL, FALSE,
+						   FALSE, sizeof(spdm_response),
+						   &spdm_response,
+						   response_size, response);
+	}
+		return RETURN_SUCCESS;
+
+	case 0x11: {
+		static uintn sub_index5 = 0;
+		spdm_version_response_mine_t version_response;
+		spdm_error_response_t error_response;
+		spdm_capabilities_response capabilities_response;
+		spdm_algorithms_response_t algorithms_response;
+
+		//
+		// VERSION, BUSY, not ready, CAPABILITIES, not ready, BUSY, ALGORITHMS
+		//
+		switch (sub_index5++) {
+		case 0:
+			zero_mem(&version_response, sizeof(version_response));
+			version_response.header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			version_response.header.request_response_code =
+				SPDM_VERSION;
+			version_response.version_number_entry_count = 1;
+			version_response.version_number_entry[0].major_version =
+				1;
+			version_response.version_number_entry[0].minor_version =
+				0;
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE,
+				sizeof(version_response), &version_response,
+				response_size, response);
+			return RETURN_SUCCESS;
+		case 1:
+		case 5:
+			zero_mem(&error_response, sizeof(error_response));
+			error_response.header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			error_response.header.request_response_code =
+				SPDM_ERROR;
+			error_response.header.param1 = SPDM_ERROR_CODE_BUSY;
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE,
+				sizeof(error_response), &error_response,
+				response_size, response);
+			return RETURN_SUCCESS;
+		case 2:
+		case 4:
+			return RETURN_NOT_READY;
+		case 3:
+			zero_mem(&capabilities_response,
+				 sizeof(capabilities_response));
+			capabilities_response.header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			capabilities_response.header.request_response_code =
+				SPDM_CAPABILITIES;
+			capabilities_response.flags =
+				SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+				SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE,
+				sizeof(capabilities_response),
+				&capabilities_response, response_size,
+				response);
+			return RETURN_SUCCESS;
+		case 6:
+			zero_mem(&algorithms_response,
+				 sizeof(algorithms_response));
+			algorithms_response.header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			algorithms_response.header.request_response_code =
+				SPDM_ALGORITHMS;
+			algorithms_response.length =
+				sizeof(spdm_algorithms_response_t);
+			algorithms_response.measurement_specification_sel =
+				SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+			algorithms_response.measurement_hash_algo =
+				m_use_measurement_hash_algo;
+			algorithms_response.base_asym_sel = m_use_asym_algo;
+			algorithms_response.base_hash_sel = m_use_hash_algo;
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE,
+				sizeof(algorithms_response),
+				&algorithms_response, response_size,
+				response);
+			return RETURN_SUCCESS;
+		default:
+			return RETURN_DEVICE_ERROR;
+		}
+	}
+
+	case 0x12:
+		return RETURN_NOT_READY;
+
+	case 0x13: {
+		static uintn sub_index5 = 0;
+		if (sub_index5 == 0) {
+			spdm_error_response_t spdm_response;
+
+			zero_mem(&spdm_response, sizeof(spdm_response));
+			spdm_response.header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			spdm_response.header.request_response_code = SPDM_ERROR;
+			spdm_response.header.param1 = SPDM_ERROR_CODE_BUSY;
+			spdm_response.header.param2 = 0;
+
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE,
+				sizeof(spdm_response), &spdm_response,
+				response_size, response);
+		} else if (sub_index5 == 1) {
+			spdm_version_response_mine_t spdm_response;
+
+			zero_mem(&spdm_response, sizeof(spdm_response));
+			spdm_response.header.spdm_version =
+				SPDM_MESSAGE_VERSION_10;
+			spdm_response.header.request_response_code =
+				SPDM_VERSION;
+			spdm_response.header.param1 = 0;
+			spdm_response.header.param2 = 0;
+			spdm_response.version_number_entry_count = 1;
+			spdm_response.version_number_entry[0].major_version = 1;
+			spdm_response.version_number_entry[0].minor_version = 0;
+
+			spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, FALSE,
+				sizeof(spdm_response), &spdm_response,
+				response_size, response);
+		}
+		sub_index5++;
+	}
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -735,6 +907,237 @@ void test_spdm_requester_get_version_case15(void **state)
 		spdm_context->connection_info.version.minor_version, 1);
 }
 
+/**
+  Test 16: GET_VERSION is sent with the non-blocking step API, and the VERSION message is not
+  received in the first step.
+  Expected behavior: the first step returns RETURN_SUCCESS with SPDM_STEP_STATE_NEEDS_RECEIVE,
+  the second step returns RETURN_SUCCESS with SPDM_STEP_STATE_DONE, and the flow is finished.
+**/
+void test_spdm_requester_get_version_case16(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_step_state_t step_state;
+	uint64 wait_time;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x10;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NOT_STARTED;
+
+	status = libspdm_start_init_connection(spdm_context, TRUE);
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = libspdm_start_init_connection(spdm_context, TRUE);
+	assert_int_equal(status, RETURN_ALREADY_STARTED);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(step_state, SPDM_STEP_STATE_NEEDS_RECEIVE);
+	assert_int_equal(wait_time, 0);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_NOT_STARTED);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(step_state, SPDM_STEP_STATE_DONE);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_AFTER_VERSION);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_NOT_STARTED);
+	assert_int_equal(step_state, SPDM_STEP_STATE_DONE);
+}
+
+static uintn m_step_sleep_count;
+
+static void spdm_requester_get_version_test_sleep(IN void *spdm_context,
+						  IN uint64 duration)
+{
+	m_step_sleep_count++;
+}
+
+/**
+  Test 17: the whole connection flow is driven with the non-blocking step API. The first
+  GET_CAPABILITIES cannot be sent, the responder is busy once for GET_CAPABILITIES and once
+  for NEGOTIATE_ALGORITHMS, and CAPABILITIES and ALGORITHMS are not received at once.
+  Expected behavior: each step returns RETURN_SUCCESS with the matching state, a BUSY error
+  returns SPDM_STEP_STATE_NEEDS_WAIT with a wait time instead of sleeping, and the last step
+  returns SPDM_STEP_STATE_DONE with the connection negotiated.
+**/
+void test_spdm_requester_get_version_case17(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_step_state_t step_state;
+	uint64 wait_time;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x11;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NOT_STARTED;
+	spdm_context->retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
+	spdm_context->local_context.version.spdm_version_count = 1;
+	spdm_context->local_context.version.spdm_version[0].major_version = 1;
+	spdm_context->local_context.version.spdm_version[0].minor_version = 0;
+	spdm_context->local_context.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->local_context.algorithm.base_asym_algo = m_use_asym_algo;
+	spdm_context->local_context.algorithm.base_hash_algo = m_use_hash_algo;
+	m_step_sleep_count = 0;
+	libspdm_register_sleep_func(spdm_context,
+				    spdm_requester_get_version_test_sleep);
+
+	status = libspdm_start_init_connection(spdm_context, FALSE);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(step_state, SPDM_STEP_STATE_NEEDS_SEND);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_AFTER_VERSION);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(step_state, SPDM_STEP_STATE_NEEDS_WAIT);
+	assert_true(wait_time != 0);
+	assert_true(wait_time <= SPDM_BUSY_RETRY_MAX_DELAY);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(step_state, SPDM_STEP_STATE_NEEDS_RECEIVE);
+	assert_int_equal(wait_time, 0);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(step_state, SPDM_STEP_STATE_NEEDS_RECEIVE);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_AFTER_CAPABILITIES);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(step_state, SPDM_STEP_STATE_NEEDS_WAIT);
+	assert_true(wait_time != 0);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(step_state, SPDM_STEP_STATE_DONE);
+	assert_int_equal(wait_time, 0);
+	assert_int_equal(spdm_context->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_NEGOTIATED);
+	assert_int_equal(spdm_context->connection_info.algorithm.base_hash_algo,
+			 m_use_hash_algo);
+	assert_int_equal(m_step_sleep_count, 0);
+
+	libspdm_register_sleep_func(spdm_context, NULL);
+}
+
+static return_status spdm_requester_get_version_test_acquire_buffer(
+	IN void *spdm_context, OUT uintn *max_msg_size, OUT void **msg_buf_ptr)
+{
+	return RETURN_NOT_READY;
+}
+
+static void spdm_requester_get_version_test_release_buffer(
+	IN void *spdm_context, IN void *msg_buf_ptr)
+{
+}
+
+/**
+  Test 18: the non-blocking step API is used when no device buffer can be acquired, and the
+  device IO functions would block.
+  Expected behavior: the step returns RETURN_OUT_OF_RESOURCES with SPDM_STEP_STATE_DONE instead
+  of a would-block state, and the flow is finished.
+**/
+void test_spdm_requester_get_version_case18(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_step_state_t step_state;
+	uint64 wait_time;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x12;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NOT_STARTED;
+	libspdm_register_device_buffer_func(
+		spdm_context, spdm_requester_get_version_test_acquire_buffer,
+		spdm_requester_get_version_test_release_buffer,
+		spdm_requester_get_version_test_acquire_buffer,
+		spdm_requester_get_version_test_release_buffer);
+
+	status = libspdm_start_init_connection(spdm_context, TRUE);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+	assert_int_equal(step_state, SPDM_STEP_STATE_DONE);
+
+	status = libspdm_step(spdm_context, &step_state, &wait_time);
+	assert_int_equal(status, RETURN_NOT_STARTED);
+
+	libspdm_register_device_buffer_func(spdm_context, NULL, NULL, NULL,
+					    NULL);
+}
+
+#if LIBSPDM_STATISTICS_SUPPORT
+static uint64 m_statistics_time;
+
+static uint64 spdm_requester_get_version_test_get_time(void)
+{
+	m_statistics_time += 10;
+	return m_statistics_time;
+}
+
+/**
+  Test 19: the responder is busy once, then returns a VERSION message, with the statistics enabled.
+  Expected behavior: both GET_VERSION requests and both responses are counted, the round trip of
+  each request is timed with the registered time function, and the BUSY retry is counted.
+**/
+void test_spdm_requester_get_version_case19(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	spdm_statistics_timer_t *timer;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x13;
+	spdm_context->retry_times = MAX_SPDM_REQUEST_RETRY_TIMES;
+	m_statistics_time = 0;
+	libspdm_register_get_time_func(spdm_context,
+				       spdm_requester_get_version_test_get_time);
+	libspdm_reset_statistics(spdm_context);
+
+	status = spdm_get_version(spdm_context);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	assert_int_equal(spdm_context->statistics.messages_sent, 2);
+	assert_int_equal(spdm_context->statistics.messages_received, 2);
+	assert_true(spdm_context->statistics.bytes_sent >=
+		    2 * sizeof(spdm_get_version_request_t));
+	assert_true(spdm_context->statistics.bytes_received >=
+		    sizeof(spdm_error_response_t) +
+			    sizeof(spdm_version_response));
+	assert_int_equal(spdm_context->statistics.retry_count, 1);
+	timer = &spdm_context->statistics
+			 .request[SPDM_GET_VERSION -
+				  SPDM_STATISTICS_REQUEST_CODE_BASE];
+	assert_int_equal(timer->count, 2);
+	assert_true(timer->total_time != 0);
+	assert_true(timer->max_time <= timer->total_time);
+
+	libspdm_register_get_time_func(spdm_context, NULL);
+	libspdm_reset_statistics(spdm_context);
+}
+#endif
+
 spdm_test_context_t mSpdmRequesterGetVersionTestContext = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -770,6 +1173,16 @@ int spdm_requester_get_version_test_main(void)
 		cmocka_unit_test(test_spdm_requester_get_version_case14),
 		// Successful response for unordered version set
 		cmocka_unit_test(test_spdm_requester_get_version_case15),
+		// Non-blocking step API
+		cmocka_unit_test(test_spdm_requester_get_version_case16),
+		// Non-blocking step API through NEGOTIATE_ALGORITHMS with would-block and BUSY
+		cmocka_unit_test(test_spdm_requester_get_version_case17),
+		// Non-blocking step API without a device buffer
+		cmocka_unit_test(test_spdm_requester_get_version_case18),
+#if LIBSPDM_STATISTICS_SUPPORT
+		// Statistics of SPDM_ERROR_CODE_BUSY + Successful response
+		cmocka_unit_test(test_spdm_requester_get_version_case19),
+#endif
 	};
 
 	setup_spdm_test_context(&mSpdmRequesterGetVersionTestContext);
@@ -203,6 +203,7 @@ return_status spdm_requester_key_exchange_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 THCurrHashData[64];
 		uint8 bin_str0[128];
 		uintn bin_str0_size;
@@ -324,8 +325,9 @@ return_status spdm_requester_key_exchange_test_receive_message(
 		spdm_hkdf_expand(m_use_hash_algo, response_handshake_secret,
 				 hash_size, bin_str7, bin_str7_size,
 				 response_finished_key, hash_size);
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 
@@ -354,6 +356,7 @@ return_status spdm_requester_key_exchange_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 THCurrHashData[64];
 		uint8 bin_str0[128];
 		uintn bin_str0_size;
@@ -475,8 +478,9 @@ return_status spdm_requester_key_exchange_test_receive_message(
 		spdm_hkdf_expand(m_use_hash_algo, response_handshake_secret,
 				 hash_size, bin_str7, bin_str7_size,
 				 response_finished_key, hash_size);
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 
@@ -551,6 +555,7 @@ return_status spdm_requester_key_exchange_test_receive_message(
 			uintn cert_buffer_size;
 			uint8 cert_buffer_hash[MAX_HASH_SIZE];
 			large_managed_buffer_t th_curr;
+			uint8 th_curr_hash_data[MAX_HASH_SIZE];
 			uint8 THCurrHashData[64];
 			uint8 bin_str0[128];
 			uintn bin_str0_size;
@@ -689,9 +694,9 @@ return_status spdm_requester_key_exchange_test_receive_message(
 					 response_handshake_secret, hash_size,
 					 bin_str7, bin_str7_size,
 					 response_finished_key, hash_size);
-			spdm_hmac_all(m_use_hash_algo,
-				      get_managed_buffer(&th_curr),
-				      get_managed_buffer_size(&th_curr),
+			spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+				      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+			spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 				      response_finished_key, hash_size, ptr);
 			ptr += hmac_size;
 
@@ -779,6 +784,7 @@ return_status spdm_requester_key_exchange_test_receive_message(
 			uintn cert_buffer_size;
 			uint8 cert_buffer_hash[MAX_HASH_SIZE];
 			large_managed_buffer_t th_curr;
+			uint8 th_curr_hash_data[MAX_HASH_SIZE];
 			uint8 THCurrHashData[64];
 			uint8 bin_str0[128];
 			uintn bin_str0_size;
@@ -917,9 +923,9 @@ return_status spdm_requester_key_exchange_test_receive_message(
 					 response_handshake_secret, hash_size,
 					 bin_str7, bin_str7_size,
 					 response_finished_key, hash_size);
-			spdm_hmac_all(m_use_hash_algo,
-				      get_managed_buffer(&th_curr),
-				      get_managed_buffer_size(&th_curr),
+			spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+				      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+			spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 				      response_finished_key, hash_size, ptr);
 			ptr += hmac_size;
 
@@ -976,6 +982,7 @@ return_status spdm_requester_key_exchange_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 THCurrHashData[64];
 		uint8 bin_str0[128];
 		uintn bin_str0_size;
@@ -1097,8 +1104,9 @@ return_status spdm_requester_key_exchange_test_receive_message(
 		spdm_hkdf_expand(m_use_hash_algo, response_handshake_secret,
 				 hash_size, bin_str7, bin_str7_size,
 				 response_finished_key, hash_size);
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 
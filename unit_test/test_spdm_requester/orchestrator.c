@@ -0,0 +1,474 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <internal/libspdm_requester_lib.h>
+
+#define TEST_ORCHESTRATOR_DEVICE_COUNT 3
+#define TEST_ORCHESTRATOR_TIME_STEP 10
+
+typedef struct {
+	void *spdm_orchestrator;
+	spdm_orchestrator_device_t device[TEST_ORCHESTRATOR_DEVICE_COUNT];
+} spdm_orchestrator_test_context_t;
+
+static spdm_orchestrator_test_context_t m_spdm_orchestrator_test_context;
+static uint64 m_spdm_orchestrator_test_time;
+static uintn m_spdm_orchestrator_test_lock_count;
+static uint8 m_spdm_orchestrator_sender_buffer[TEST_ORCHESTRATOR_DEVICE_COUNT]
+					      [MAX_SPDM_MESSAGE_BUFFER_SIZE];
+static uint8 m_spdm_orchestrator_receiver_buffer[TEST_ORCHESTRATOR_DEVICE_COUNT]
+						[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+/**
+  A device which always fails to send or receive the message.
+**/
+return_status spdm_orchestrator_test_send_message(IN void *spdm_context,
+						  IN uintn request_size,
+						  IN void *request,
+						  IN uint64 timeout)
+{
+	return RETURN_DEVICE_ERROR;
+}
+
+return_status spdm_orchestrator_test_receive_message(IN void *spdm_context,
+						     IN OUT uintn *response_size,
+						     IN OUT void *response,
+						     IN uint64 timeout)
+{
+	return RETURN_DEVICE_ERROR;
+}
+
+static uint8 m_spdm_orchestrator_test_request_code[TEST_ORCHESTRATOR_DEVICE_COUNT];
+
+/**
+  Return the index of the device using an SPDM context.
+**/
+uintn spdm_orchestrator_test_get_device_index(IN void *spdm_context)
+{
+	uintn index;
+
+	for (index = 0; index < TEST_ORCHESTRATOR_DEVICE_COUNT; index++) {
+		if (m_spdm_orchestrator_test_context.device[index].spdm_context ==
+		    spdm_context) {
+			break;
+		}
+	}
+	assert_true(index < TEST_ORCHESTRATOR_DEVICE_COUNT);
+	return index;
+}
+
+/**
+  A device which answers GET_VERSION, GET_CAPABILITIES, NEGOTIATE_ALGORITHMS and GET_DIGESTS.
+  It remembers the request code, and sends the matching response.
+**/
+return_status spdm_orchestrator_test_responder_send_message(
+	IN void *spdm_context, IN uintn request_size, IN void *request,
+	IN uint64 timeout)
+{
+	return_status status;
+	uint32 *session_id;
+	boolean is_app_message;
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+
+	message_size = sizeof(message);
+	status = spdm_transport_test_decode_message(spdm_context, &session_id,
+						    &is_app_message, TRUE,
+						    request_size, request,
+						    &message_size, message);
+	assert_int_equal(status, RETURN_SUCCESS);
+	m_spdm_orchestrator_test_request_code
+		[spdm_orchestrator_test_get_device_index(spdm_context)] =
+		((spdm_message_header_t *)message)->request_response_code;
+	return RETURN_SUCCESS;
+}
+
+return_status spdm_orchestrator_test_responder_receive_message(
+	IN void *spdm_context, IN OUT uintn *response_size,
+	IN OUT void *response, IN uint64 timeout)
+{
+	uint8 message[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn message_size;
+	spdm_version_response *version_response;
+	spdm_capabilities_response *capabilities_response;
+	spdm_algorithms_response_t *algorithms_response;
+	spdm_digest_response_t *digest_response;
+	uintn hash_size;
+
+	zero_mem(message, sizeof(message));
+	switch (m_spdm_orchestrator_test_request_code
+			[spdm_orchestrator_test_get_device_index(spdm_context)]) {
+	case SPDM_GET_VERSION:
+		version_response = (void *)message;
+		version_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		version_response->header.request_response_code = SPDM_VERSION;
+		version_response->version_number_entry_count = 1;
+		((spdm_version_number_t *)(version_response + 1))->major_version =
+			1;
+		message_size = sizeof(spdm_version_response) +
+			       sizeof(spdm_version_number_t);
+		break;
+	case SPDM_GET_CAPABILITIES:
+		capabilities_response = (void *)message;
+		capabilities_response->header.spdm_version =
+			SPDM_MESSAGE_VERSION_10;
+		capabilities_response->header.request_response_code =
+			SPDM_CAPABILITIES;
+		capabilities_response->flags =
+			SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+		message_size = sizeof(spdm_capabilities_response);
+		break;
+	case SPDM_NEGOTIATE_ALGORITHMS:
+		algorithms_response = (void *)message;
+		algorithms_response->header.spdm_version =
+			SPDM_MESSAGE_VERSION_10;
+		algorithms_response->header.request_response_code =
+			SPDM_ALGORITHMS;
+		algorithms_response->length = sizeof(spdm_algorithms_response_t);
+		algorithms_response->measurement_specification_sel =
+			SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+		algorithms_response->measurement_hash_algo =
+			m_use_measurement_hash_algo;
+		algorithms_response->base_asym_sel = m_use_asym_algo;
+		algorithms_response->base_hash_sel = m_use_hash_algo;
+		message_size = sizeof(spdm_algorithms_response_t);
+		break;
+	case SPDM_GET_DIGESTS:
+		digest_response = (void *)message;
+		digest_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+		digest_response->header.request_response_code = SPDM_DIGESTS;
+		digest_response->header.param2 = 0x01;
+		hash_size = spdm_get_hash_size(m_use_hash_algo);
+		set_mem(digest_response + 1, hash_size, 0xFF);
+		message_size = sizeof(spdm_digest_response_t) + hash_size;
+		break;
+	default:
+		return RETURN_DEVICE_ERROR;
+	}
+
+	spdm_transport_test_encode_message(spdm_context, NULL, FALSE, FALSE,
+					   message_size, message, response_size,
+					   response);
+	return RETURN_SUCCESS;
+}
+
+/**
+  A clock which advances TEST_ORCHESTRATOR_TIME_STEP on each call.
+**/
+uint64 spdm_orchestrator_test_get_time(void)
+{
+	m_spdm_orchestrator_test_time += TEST_ORCHESTRATOR_TIME_STEP;
+	return m_spdm_orchestrator_test_time;
+}
+
+void spdm_orchestrator_test_acquire_lock(IN void *lock)
+{
+	assert_ptr_equal(lock, &m_spdm_orchestrator_test_lock_count);
+	assert_int_equal(m_spdm_orchestrator_test_lock_count, 0);
+	m_spdm_orchestrator_test_lock_count++;
+}
+
+void spdm_orchestrator_test_release_lock(IN void *lock)
+{
+	assert_ptr_equal(lock, &m_spdm_orchestrator_test_lock_count);
+	assert_int_equal(m_spdm_orchestrator_test_lock_count, 1);
+	m_spdm_orchestrator_test_lock_count--;
+}
+
+/**
+  Test 1: a worker attests devices which do not respond.
+  Expected behavior: each device fails in the connection initialization with RETURN_DEVICE_ERROR,
+  the latency is measured per device, and the statistics count every device as failed.
+**/
+void test_spdm_requester_orchestrator_case1(void **state)
+{
+	return_status status;
+	spdm_orchestrator_test_context_t *test_context;
+	spdm_orchestrator_policy_t policy;
+	spdm_orchestrator_statistics_t statistics;
+	uintn index;
+
+	test_context = *state;
+	zero_mem(&policy, sizeof(policy));
+	policy.flows = SPDM_ORCHESTRATOR_FLOW_GET_DIGEST |
+		       SPDM_ORCHESTRATOR_FLOW_GET_CERTIFICATE |
+		       SPDM_ORCHESTRATOR_FLOW_CHALLENGE;
+	libspdm_orchestrator_init(test_context->spdm_orchestrator, &policy,
+				  test_context->device,
+				  TEST_ORCHESTRATOR_DEVICE_COUNT);
+	libspdm_orchestrator_register_lock_func(
+		test_context->spdm_orchestrator,
+		spdm_orchestrator_test_acquire_lock,
+		spdm_orchestrator_test_release_lock,
+		&m_spdm_orchestrator_test_lock_count);
+	libspdm_orchestrator_register_get_time_func(
+		test_context->spdm_orchestrator,
+		spdm_orchestrator_test_get_time);
+	m_spdm_orchestrator_test_time = 0;
+
+	libspdm_orchestrator_get_statistics(test_context->spdm_orchestrator,
+					    &statistics);
+	assert_int_equal(statistics.device_count,
+			 TEST_ORCHESTRATOR_DEVICE_COUNT);
+	assert_int_equal(statistics.finished_count, 0);
+
+	status = libspdm_orchestrator_run_worker(
+		test_context->spdm_orchestrator);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_spdm_orchestrator_test_lock_count, 0);
+
+	for (index = 0; index < TEST_ORCHESTRATOR_DEVICE_COUNT; index++) {
+		assert_int_equal(test_context->device[index].result.status,
+				 RETURN_DEVICE_ERROR);
+		assert_int_equal(test_context->device[index].result.failed_flow,
+				 SPDM_ORCHESTRATOR_FLOW_INIT_CONNECTION);
+		assert_int_equal(test_context->device[index].result.latency,
+				 TEST_ORCHESTRATOR_TIME_STEP);
+	}
+
+	libspdm_orchestrator_get_statistics(test_context->spdm_orchestrator,
+					    &statistics);
+	assert_int_equal(statistics.finished_count,
+			 TEST_ORCHESTRATOR_DEVICE_COUNT);
+	assert_int_equal(statistics.success_count, 0);
+	assert_int_equal(statistics.failure_count,
+			 TEST_ORCHESTRATOR_DEVICE_COUNT);
+	assert_int_equal(statistics.min_latency, TEST_ORCHESTRATOR_TIME_STEP);
+	assert_int_equal(statistics.max_latency, TEST_ORCHESTRATOR_TIME_STEP);
+	assert_int_equal(statistics.total_latency,
+			 TEST_ORCHESTRATOR_TIME_STEP *
+				 TEST_ORCHESTRATOR_DEVICE_COUNT);
+	assert_int_equal(statistics.elapsed_time,
+			 TEST_ORCHESTRATOR_TIME_STEP *
+				 (2 * TEST_ORCHESTRATOR_DEVICE_COUNT - 1));
+
+	status = libspdm_orchestrator_run_worker(
+		test_context->spdm_orchestrator);
+	assert_int_equal(status, RETURN_SUCCESS);
+	libspdm_orchestrator_get_statistics(test_context->spdm_orchestrator,
+					    &statistics);
+	assert_int_equal(statistics.finished_count,
+			 TEST_ORCHESTRATOR_DEVICE_COUNT);
+}
+
+/**
+  Test 2: the same certificate chain is verified in two SPDM contexts of an orchestrator.
+  Expected behavior: both verifications pass, and the certificate chain is cached once
+  in the certificate chain verification cache shared by the contexts.
+**/
+void test_spdm_requester_orchestrator_case2(void **state)
+{
+	spdm_orchestrator_test_context_t *test_context;
+	spdm_orchestrator_t *spdm_orchestrator;
+	spdm_orchestrator_policy_t policy;
+	spdm_context_t *spdm_context;
+	void *data;
+	uintn data_size;
+	uintn index;
+	boolean result;
+
+	test_context = *state;
+	spdm_orchestrator = test_context->spdm_orchestrator;
+	zero_mem(&policy, sizeof(policy));
+	libspdm_orchestrator_init(spdm_orchestrator, &policy,
+				  test_context->device, 2);
+	assert_int_equal(spdm_orchestrator->cert_chain_verify_cache.entry_count,
+			 0);
+
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, NULL, NULL);
+	for (index = 0; index < 2; index++) {
+		spdm_context = test_context->device[index].spdm_context;
+		assert_ptr_equal(spdm_context->local_context.cert_chain_verify_cache,
+				 &spdm_orchestrator->cert_chain_verify_cache);
+		spdm_context->connection_info.algorithm.base_hash_algo =
+			m_use_hash_algo;
+		spdm_context->connection_info.algorithm.base_asym_algo =
+			m_use_asym_algo;
+
+		result = spdm_verify_peer_cert_chain_buffer(spdm_context, data,
+							    data_size, NULL,
+							    NULL);
+		assert_int_equal(result, TRUE);
+		assert_int_equal(
+			spdm_orchestrator->cert_chain_verify_cache.entry_count,
+			1);
+	}
+
+	//
+	// After invalidation, the certificate chain is verified and cached again.
+	//
+	libspdm_invalidate_cert_chain_verify_cache(
+		&spdm_orchestrator->cert_chain_verify_cache);
+	assert_int_equal(spdm_orchestrator->cert_chain_verify_cache.entry_count,
+			 0);
+	result = spdm_verify_peer_cert_chain_buffer(
+		test_context->device[0].spdm_context, data, data_size, NULL,
+		NULL);
+	assert_int_equal(result, TRUE);
+	assert_int_equal(spdm_orchestrator->cert_chain_verify_cache.entry_count,
+			 1);
+	free(data);
+}
+
+/**
+  Test 3: a worker attests devices which answer the connection initialization and GET_DIGESTS.
+  Expected behavior: each device succeeds with the negotiated algorithms and the digest
+  received, and the statistics count every device as successful.
+**/
+void test_spdm_requester_orchestrator_case3(void **state)
+{
+	return_status status;
+	spdm_orchestrator_test_context_t *test_context;
+	spdm_orchestrator_policy_t policy;
+	spdm_orchestrator_statistics_t statistics;
+	spdm_context_t *spdm_context;
+	uintn index;
+
+	test_context = *state;
+	for (index = 0; index < TEST_ORCHESTRATOR_DEVICE_COUNT; index++) {
+		spdm_context = test_context->device[index].spdm_context;
+		libspdm_register_device_io_func(
+			spdm_context,
+			spdm_orchestrator_test_responder_send_message,
+			spdm_orchestrator_test_responder_receive_message);
+		spdm_context->connection_info.connection_state =
+			SPDM_CONNECTION_STATE_NOT_STARTED;
+		spdm_context->local_context.capability.flags =
+			SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CERT_CAP;
+		spdm_context->local_context.algorithm.measurement_spec =
+			SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+		spdm_context->local_context.algorithm.measurement_hash_algo =
+			m_use_measurement_hash_algo;
+		spdm_context->local_context.algorithm.base_asym_algo =
+			m_use_asym_algo;
+		spdm_context->local_context.algorithm.base_hash_algo =
+			m_use_hash_algo;
+	}
+
+	zero_mem(&policy, sizeof(policy));
+	policy.flows = SPDM_ORCHESTRATOR_FLOW_GET_DIGEST;
+	libspdm_orchestrator_init(test_context->spdm_orchestrator, &policy,
+				  test_context->device,
+				  TEST_ORCHESTRATOR_DEVICE_COUNT);
+	libspdm_orchestrator_register_lock_func(
+		test_context->spdm_orchestrator,
+		spdm_orchestrator_test_acquire_lock,
+		spdm_orchestrator_test_release_lock,
+		&m_spdm_orchestrator_test_lock_count);
+	libspdm_orchestrator_register_get_time_func(
+		test_context->spdm_orchestrator,
+		spdm_orchestrator_test_get_time);
+	m_spdm_orchestrator_test_time = 0;
+
+	status = libspdm_orchestrator_run_worker(
+		test_context->spdm_orchestrator);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(m_spdm_orchestrator_test_lock_count, 0);
+
+	for (index = 0; index < TEST_ORCHESTRATOR_DEVICE_COUNT; index++) {
+		spdm_context = test_context->device[index].spdm_context;
+		assert_int_equal(test_context->device[index].result.status,
+				 RETURN_SUCCESS);
+		assert_int_equal(test_context->device[index].result.failed_flow,
+				 0);
+		assert_int_equal(test_context->device[index].result.latency,
+				 TEST_ORCHESTRATOR_TIME_STEP);
+		assert_int_equal(spdm_context->connection_info.connection_state,
+				 SPDM_CONNECTION_STATE_AFTER_DIGESTS);
+		assert_int_equal(
+			spdm_context->connection_info.algorithm.base_hash_algo,
+			m_use_hash_algo);
+		assert_int_equal(m_spdm_orchestrator_test_request_code[index],
+				 SPDM_GET_DIGESTS);
+	}
+
+	libspdm_orchestrator_get_statistics(test_context->spdm_orchestrator,
+					    &statistics);
+	assert_int_equal(statistics.finished_count,
+			 TEST_ORCHESTRATOR_DEVICE_COUNT);
+	assert_int_equal(statistics.success_count,
+			 TEST_ORCHESTRATOR_DEVICE_COUNT);
+	assert_int_equal(statistics.failure_count, 0);
+
+	for (index = 0; index < TEST_ORCHESTRATOR_DEVICE_COUNT; index++) {
+		libspdm_register_device_io_func(
+			test_context->device[index].spdm_context,
+			spdm_orchestrator_test_send_message,
+			spdm_orchestrator_test_receive_message);
+	}
+}
+
+int spdm_requester_orchestrator_test_group_setup(void **state)
+{
+	spdm_orchestrator_test_context_t *test_context;
+	void *spdm_context;
+	uintn index;
+
+	test_context = &m_spdm_orchestrator_test_context;
+	test_context->spdm_orchestrator =
+		(void *)malloc(libspdm_orchestrator_get_size());
+	if (test_context->spdm_orchestrator == NULL) {
+		return -1;
+	}
+
+	for (index = 0; index < TEST_ORCHESTRATOR_DEVICE_COUNT; index++) {
+		spdm_context = (void *)malloc(libspdm_get_context_size());
+		if (spdm_context == NULL) {
+			return -1;
+		}
+		test_context->device[index].spdm_context = spdm_context;
+		libspdm_init_context(spdm_context);
+		libspdm_register_device_io_func(
+			spdm_context, spdm_orchestrator_test_send_message,
+			spdm_orchestrator_test_receive_message);
+		libspdm_register_device_buffer(
+			spdm_context, m_spdm_orchestrator_sender_buffer[index],
+			sizeof(m_spdm_orchestrator_sender_buffer[index]),
+			m_spdm_orchestrator_receiver_buffer[index],
+			sizeof(m_spdm_orchestrator_receiver_buffer[index]));
+		libspdm_register_transport_layer_func(
+			spdm_context, spdm_transport_test_encode_message,
+			spdm_transport_test_decode_message);
+	}
+
+	*state = test_context;
+	return 0;
+}
+
+int spdm_requester_orchestrator_test_group_teardown(void **state)
+{
+	spdm_orchestrator_test_context_t *test_context;
+	uintn index;
+
+	test_context = *state;
+	for (index = 0; index < TEST_ORCHESTRATOR_DEVICE_COUNT; index++) {
+		free(test_context->device[index].spdm_context);
+		test_context->device[index].spdm_context = NULL;
+	}
+	free(test_context->spdm_orchestrator);
+	test_context->spdm_orchestrator = NULL;
+	return 0;
+}
+
+int spdm_requester_orchestrator_test_main(void)
+{
+	const struct CMUnitTest spdm_requester_orchestrator_tests[] = {
+		// Unresponsive devices
+		cmocka_unit_test(test_spdm_requester_orchestrator_case1),
+		// Shared certificate chain verification
+		cmocka_unit_test(test_spdm_requester_orchestrator_case2),
+		// Responsive devices
+		cmocka_unit_test(test_spdm_requester_orchestrator_case3),
+	};
+
+	return cmocka_run_group_tests(
+		spdm_requester_orchestrator_tests,
+		spdm_requester_orchestrator_test_group_setup,
+		spdm_requester_orchestrator_test_group_teardown);
+}
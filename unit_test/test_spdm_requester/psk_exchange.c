@@ -187,6 +187,7 @@ return_status spdm_requester_psk_exchange_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 bin_str2[128];
 		uintn bin_str2_size;
 		uint8 bin_str7[128];
@@ -277,8 +278,9 @@ return_status spdm_requester_psk_exchange_test_receive_message(
 		spdm_hkdf_expand(m_use_hash_algo, response_handshake_secret,
 				 hash_size, bin_str7, bin_str7_size,
 				 response_finished_key, hash_size);
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 
@@ -302,6 +304,7 @@ return_status spdm_requester_psk_exchange_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 bin_str2[128];
 		uintn bin_str2_size;
 		uint8 bin_str7[128];
@@ -392,8 +395,9 @@ return_status spdm_requester_psk_exchange_test_receive_message(
 		spdm_hkdf_expand(m_use_hash_algo, response_handshake_secret,
 				 hash_size, bin_str7, bin_str7_size,
 				 response_finished_key, hash_size);
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 
@@ -463,6 +467,7 @@ return_status spdm_requester_psk_exchange_test_receive_message(
 			uintn cert_buffer_size;
 			uint8 cert_buffer_hash[MAX_HASH_SIZE];
 			large_managed_buffer_t th_curr;
+			uint8 th_curr_hash_data[MAX_HASH_SIZE];
 			uint8 bin_str2[128];
 			uintn bin_str2_size;
 			uint8 bin_str7[128];
@@ -567,9 +572,9 @@ return_status spdm_requester_psk_exchange_test_receive_message(
 					 response_handshake_secret, hash_size,
 					 bin_str7, bin_str7_size,
 					 response_finished_key, hash_size);
-			spdm_hmac_all(m_use_hash_algo,
-				      get_managed_buffer(&th_curr),
-				      get_managed_buffer_size(&th_curr),
+			spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+				      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+			spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 				      response_finished_key, hash_size, ptr);
 			ptr += hmac_size;
 
@@ -652,6 +657,7 @@ return_status spdm_requester_psk_exchange_test_receive_message(
 			uintn cert_buffer_size;
 			uint8 cert_buffer_hash[MAX_HASH_SIZE];
 			large_managed_buffer_t th_curr;
+			uint8 th_curr_hash_data[MAX_HASH_SIZE];
 			uint8 bin_str2[128];
 			uintn bin_str2_size;
 			uint8 bin_str7[128];
@@ -756,9 +762,9 @@ return_status spdm_requester_psk_exchange_test_receive_message(
 					 response_handshake_secret, hash_size,
 					 bin_str7, bin_str7_size,
 					 response_finished_key, hash_size);
-			spdm_hmac_all(m_use_hash_algo,
-				      get_managed_buffer(&th_curr),
-				      get_managed_buffer_size(&th_curr),
+			spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+				      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+			spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 				      response_finished_key, hash_size, ptr);
 			ptr += hmac_size;
 
@@ -811,6 +817,7 @@ return_status spdm_requester_psk_exchange_test_receive_message(
 		uintn cert_buffer_size;
 		uint8 cert_buffer_hash[MAX_HASH_SIZE];
 		large_managed_buffer_t th_curr;
+		uint8 th_curr_hash_data[MAX_HASH_SIZE];
 		uint8 bin_str2[128];
 		uintn bin_str2_size;
 		uint8 bin_str7[128];
@@ -901,8 +908,9 @@ return_status spdm_requester_psk_exchange_test_receive_message(
 		spdm_hkdf_expand(m_use_hash_algo, response_handshake_secret,
 				 hash_size, bin_str7, bin_str7_size,
 				 response_finished_key, hash_size);
-		spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-			      get_managed_buffer_size(&th_curr),
+		spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+			      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+		spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
 			      response_finished_key, hash_size, ptr);
 		ptr += hmac_size;
 
@@ -85,6 +85,8 @@ return_status spdm_requester_psk_finish_test_send_message(IN void *spdm_context,
 		return RETURN_SUCCESS;
 	case 0xE:
 		return RETURN_SUCCESS;
+	case 0xF:
+		return RETURN_SUCCESS;
 	default:
 		return RETURN_DEVICE_ERROR;
 	}
@@ -101,7 +103,8 @@ return_status spdm_requester_psk_finish_test_receive_message(
 	case 0x1:
 		return RETURN_DEVICE_ERROR;
 
-	case 0x2: {
+	case 0x2:
+	case 0xF: {
 		spdm_psk_finish_response_t *spdm_response;
 		uint8 temp_buf[MAX_SPDM_MESSAGE_BUFFER_SIZE];
 		uintn temp_buf_size;
@@ -1888,6 +1891,197 @@ void test_spdm_requester_psk_finish_case14(void **state)
 	free(data);
 }
 
+#if LIBSPDM_TRACE_SUPPORT
+typedef struct {
+	spdm_trace_phase_t phase;
+	spdm_trace_event_t event;
+	uint32 session_id;
+	uint8 request_code;
+} spdm_psk_finish_test_trace_record_t;
+
+static boolean m_trace_enabled;
+static spdm_psk_finish_test_trace_record_t m_trace_record[32];
+static uintn m_trace_count;
+static uintn m_trace_begin_count[SPDM_TRACE_PHASE_MAX];
+static uintn m_trace_end_count[SPDM_TRACE_PHASE_MAX];
+
+static void spdm_requester_psk_finish_test_trace(IN void *spdm_context,
+						 IN spdm_trace_phase_t phase,
+						 IN spdm_trace_event_t event,
+						 IN uint32 session_id,
+						 IN uint8 request_code)
+{
+	if (!m_trace_enabled) {
+		return;
+	}
+	if (m_trace_count < ARRAY_SIZE(m_trace_record)) {
+		m_trace_record[m_trace_count].phase = phase;
+		m_trace_record[m_trace_count].event = event;
+		m_trace_record[m_trace_count].session_id = session_id;
+		m_trace_record[m_trace_count].request_code = request_code;
+	}
+	m_trace_count++;
+	if (event == SPDM_TRACE_EVENT_BEGIN) {
+		m_trace_begin_count[phase]++;
+	} else {
+		m_trace_end_count[phase]++;
+	}
+}
+
+/**
+  Test 15: receiving a correct PSK_FINISH_RSP message with a trace callback registered.
+  Expected behavior: the message, secured message and key schedule phases are reported
+  in begin/end pairs with the session ID and the PSK_FINISH request code, and the session
+  data keys are derived after the response is decrypted.
+**/
+void test_spdm_requester_psk_finish_case15(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uint32 session_id;
+	void *data;
+	uintn data_size;
+	void *hash;
+	uintn hash_size;
+	spdm_session_info_t *session_info;
+	uintn index;
+	uintn key_schedule_index;
+	uintn secured_message_decode_index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0xF;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_NEGOTIATED;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP;
+	spdm_context->connection_info.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP;
+	spdm_context->local_context.capability.flags |=
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP;
+	spdm_context->local_context.capability.flags |=
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP;
+	spdm_context->local_context.capability.flags |=
+		SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP;
+	read_responder_public_certificate_chain(m_use_hash_algo,
+						m_use_asym_algo, &data,
+						&data_size, &hash, &hash_size);
+	libspdm_reset_message_a(spdm_context);
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.algorithm.dhe_named_group =
+		m_use_dhe_algo;
+	spdm_context->connection_info.algorithm.aead_cipher_suite =
+		m_use_aead_algo;
+	spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+		data_size;
+	copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+		 data, data_size);
+	zero_mem(m_local_psk_hint, 32);
+	copy_mem(&m_local_psk_hint[0], TEST_PSK_HINT_STRING,
+		 sizeof(TEST_PSK_HINT_STRING));
+	spdm_context->local_context.psk_hint_size =
+		sizeof(TEST_PSK_HINT_STRING);
+	spdm_context->local_context.psk_hint = m_local_psk_hint;
+
+	session_id = 0xFFFFFFFF;
+	session_info = &spdm_context->session_info[0];
+	spdm_session_info_init(spdm_context, session_info, session_id, TRUE);
+	spdm_secured_message_set_session_state(
+		session_info->secured_message_context,
+		SPDM_SESSION_STATE_HANDSHAKING);
+	set_mem(m_dummy_key_buffer,
+		((spdm_secured_message_context_t
+			  *)(session_info->secured_message_context))
+			->aead_key_size,
+		(uint8)(0xFF));
+	spdm_secured_message_set_response_handshake_encryption_key(
+		session_info->secured_message_context, m_dummy_key_buffer,
+		((spdm_secured_message_context_t
+			  *)(session_info->secured_message_context))
+			->aead_key_size);
+	set_mem(m_dummy_salt_buffer,
+		((spdm_secured_message_context_t
+			  *)(session_info->secured_message_context))
+			->aead_iv_size,
+		(uint8)(0xFF));
+	spdm_secured_message_set_response_handshake_salt(
+		session_info->secured_message_context, m_dummy_salt_buffer,
+		((spdm_secured_message_context_t
+			  *)(session_info->secured_message_context))
+			->aead_iv_size);
+	((spdm_secured_message_context_t *)(session_info
+						    ->secured_message_context))
+		->handshake_secret.response_handshake_sequence_number = 0;
+	spdm_secured_message_set_dummy_finished_key (session_info->secured_message_context);
+
+	m_trace_count = 0;
+	zero_mem(m_trace_begin_count, sizeof(m_trace_begin_count));
+	zero_mem(m_trace_end_count, sizeof(m_trace_end_count));
+	m_trace_enabled = TRUE;
+	libspdm_register_trace_callback_func(spdm_context,
+					     spdm_requester_psk_finish_test_trace);
+
+	status = spdm_send_receive_psk_finish(spdm_context, session_id);
+	m_trace_enabled = FALSE;
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(
+		spdm_secured_message_get_session_state(
+			spdm_context->session_info[0].secured_message_context),
+		SPDM_SESSION_STATE_ESTABLISHED);
+
+	//
+	// Every event is reported for the PSK_FINISH message of the session,
+	// and the events of each phase are balanced.
+	//
+	assert_true(m_trace_count <= ARRAY_SIZE(m_trace_record));
+	for (index = 0; index < m_trace_count; index++) {
+		assert_int_equal(m_trace_record[index].session_id, session_id);
+		assert_int_equal(m_trace_record[index].request_code,
+				 SPDM_PSK_FINISH);
+	}
+	for (index = 0; index < SPDM_TRACE_PHASE_MAX; index++) {
+		assert_int_equal(m_trace_begin_count[index],
+				 m_trace_end_count[index]);
+	}
+	assert_true(m_trace_begin_count[SPDM_TRACE_PHASE_TRANSPORT_ENCODE] != 0);
+	assert_true(m_trace_begin_count[SPDM_TRACE_PHASE_SECURED_MESSAGE_ENCODE] !=
+		    0);
+	assert_int_equal(m_trace_begin_count[SPDM_TRACE_PHASE_SEND], 1);
+	assert_int_equal(m_trace_begin_count[SPDM_TRACE_PHASE_TRANSPORT_DECODE],
+			 1);
+	assert_int_equal(
+		m_trace_begin_count[SPDM_TRACE_PHASE_SECURED_MESSAGE_DECODE], 1);
+	assert_int_equal(m_trace_begin_count[SPDM_TRACE_PHASE_KEY_SCHEDULE], 1);
+
+	//
+	// The session data keys are derived after the response is decrypted.
+	//
+	key_schedule_index = m_trace_count;
+	secured_message_decode_index = m_trace_count;
+	for (index = 0; index < m_trace_count; index++) {
+		if ((m_trace_record[index].phase ==
+		     SPDM_TRACE_PHASE_SECURED_MESSAGE_DECODE) &&
+		    (m_trace_record[index].event == SPDM_TRACE_EVENT_END)) {
+			secured_message_decode_index = index;
+		}
+		if ((m_trace_record[index].phase ==
+		     SPDM_TRACE_PHASE_KEY_SCHEDULE) &&
+		    (m_trace_record[index].event == SPDM_TRACE_EVENT_BEGIN)) {
+			key_schedule_index = index;
+		}
+	}
+	assert_true(secured_message_decode_index < key_schedule_index);
+	assert_true(key_schedule_index < m_trace_count);
+	free(data);
+}
+#endif
+
 spdm_test_context_t m_spdm_requester_psk_finish_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	TRUE,
@@ -1926,6 +2120,10 @@ int spdm_requester_psk_finish_test_main(void)
 		cmocka_unit_test(test_spdm_requester_psk_finish_case13),
 		// Uninitialized session
 		cmocka_unit_test(test_spdm_requester_psk_finish_case14),
+#if LIBSPDM_TRACE_SUPPORT
+		// Trace callbacks of a successful response
+		cmocka_unit_test(test_spdm_requester_psk_finish_case15),
+#endif
 	};
 
 	setup_spdm_test_context(&m_spdm_requester_psk_finish_test_context);
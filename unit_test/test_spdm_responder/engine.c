@@ -0,0 +1,353 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include "spdm_unit_test.h"
+#include <internal/libspdm_responder_lib.h>
+
+#define TEST_ENGINE_ENDPOINT_COUNT 2
+#define TEST_ENGINE_ENDPOINT_ID_BASE 0x08
+
+typedef struct {
+	void *spdm_responder_engine;
+	void *spdm_context[TEST_ENGINE_ENDPOINT_COUNT];
+} spdm_engine_test_context_t;
+
+static spdm_engine_test_context_t m_spdm_engine_test_context;
+static uint8 m_spdm_engine_sender_buffer[TEST_ENGINE_ENDPOINT_COUNT]
+					[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+static uint8 m_spdm_engine_receiver_buffer[TEST_ENGINE_ENDPOINT_COUNT]
+					  [MAX_SPDM_MESSAGE_BUFFER_SIZE];
+
+spdm_get_version_request_t m_spdm_engine_get_version_request = {
+	{
+		SPDM_MESSAGE_VERSION_10,
+		SPDM_GET_VERSION,
+	},
+};
+
+/**
+  Send a GET_VERSION request from an endpoint through the loopback transport.
+**/
+static void spdm_engine_test_send_get_version(IN uint32 endpoint_id)
+{
+	return_status status;
+	uint8 request[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn request_size;
+
+	request_size = sizeof(request);
+	status = spdm_transport_test_encode_message(
+		NULL, NULL, FALSE, TRUE,
+		sizeof(m_spdm_engine_get_version_request),
+		&m_spdm_engine_get_version_request, &request_size, request);
+	assert_int_equal(status, RETURN_SUCCESS);
+	status = test_loopback_send_request(endpoint_id, request_size,
+					    request);
+	assert_int_equal(status, RETURN_SUCCESS);
+}
+
+/**
+  Test 1: two endpoints send GET_VERSION through the loopback transport.
+  Expected behavior: each request is processed by the SPDM context of its endpoint,
+  each response is sent back to its endpoint, and the other context is not changed.
+**/
+void test_spdm_responder_engine_case1(void **state)
+{
+	return_status status;
+	spdm_engine_test_context_t *test_context;
+	spdm_context_t *spdm_context_a;
+	spdm_context_t *spdm_context_b;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+	spdm_message_header_t *spdm_response;
+
+	test_context = *state;
+	spdm_context_a = test_context->spdm_context[0];
+	spdm_context_b = test_context->spdm_context[1];
+	test_loopback_reset();
+
+	spdm_engine_test_send_get_version(TEST_ENGINE_ENDPOINT_ID_BASE);
+	status = libspdm_responder_engine_dispatch_message(
+		test_context->spdm_responder_engine);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(spdm_context_a->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_AFTER_VERSION);
+	assert_int_equal(spdm_context_b->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_NOT_STARTED);
+
+	response_size = sizeof(response);
+	status = test_loopback_receive_response(TEST_ENGINE_ENDPOINT_ID_BASE + 1,
+						&response_size, response);
+	assert_int_equal(status, RETURN_NOT_READY);
+	response_size = sizeof(response);
+	status = test_loopback_receive_response(TEST_ENGINE_ENDPOINT_ID_BASE,
+						&response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_response = (void *)(response + sizeof(test_message_header_t));
+	assert_int_equal(spdm_response->request_response_code, SPDM_VERSION);
+
+	spdm_engine_test_send_get_version(TEST_ENGINE_ENDPOINT_ID_BASE + 1);
+	status = libspdm_responder_engine_dispatch_message(
+		test_context->spdm_responder_engine);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(spdm_context_b->connection_info.connection_state,
+			 SPDM_CONNECTION_STATE_AFTER_VERSION);
+
+	response_size = sizeof(response);
+	status = test_loopback_receive_response(TEST_ENGINE_ENDPOINT_ID_BASE + 1,
+						&response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_response = (void *)(response + sizeof(test_message_header_t));
+	assert_int_equal(spdm_response->request_response_code, SPDM_VERSION);
+
+	status = libspdm_responder_engine_dispatch_message(
+		test_context->spdm_responder_engine);
+	assert_int_equal(status, RETURN_NOT_READY);
+}
+
+/**
+  Test 2: a request is received from an endpoint without SPDM context.
+  Expected behavior: the request is dropped with RETURN_NOT_FOUND and no response is sent.
+**/
+void test_spdm_responder_engine_case2(void **state)
+{
+	return_status status;
+	spdm_engine_test_context_t *test_context;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+
+	test_context = *state;
+	test_loopback_reset();
+
+	spdm_engine_test_send_get_version(TEST_ENGINE_ENDPOINT_ID_BASE +
+					  TEST_ENGINE_ENDPOINT_COUNT);
+	status = libspdm_responder_engine_dispatch_message(
+		test_context->spdm_responder_engine);
+	assert_int_equal(status, RETURN_NOT_FOUND);
+
+	response_size = sizeof(response);
+	status = test_loopback_receive_response(
+		TEST_ENGINE_ENDPOINT_ID_BASE + TEST_ENGINE_ENDPOINT_COUNT,
+		&response_size, response);
+	assert_int_equal(status, RETURN_NOT_READY);
+}
+
+/**
+  Test 3: SPDM contexts are registered and unregistered.
+  Expected behavior: an endpoint can be registered once, up to MAX_SPDM_RESPONDER_ENGINE_ENDPOINT_COUNT
+  endpoints, and an unregistered endpoint has no SPDM context.
+**/
+void test_spdm_responder_engine_case3(void **state)
+{
+	return_status status;
+	spdm_engine_test_context_t *test_context;
+	void *spdm_responder_engine;
+	uint32 endpoint_id;
+
+	test_context = *state;
+	spdm_responder_engine = test_context->spdm_responder_engine;
+
+	status = libspdm_responder_engine_register_context(
+		spdm_responder_engine, TEST_ENGINE_ENDPOINT_ID_BASE,
+		test_context->spdm_context[1]);
+	assert_int_equal(status, RETURN_ALREADY_STARTED);
+	assert_ptr_equal(libspdm_responder_engine_get_context(
+				 spdm_responder_engine,
+				 TEST_ENGINE_ENDPOINT_ID_BASE),
+			 test_context->spdm_context[0]);
+
+	for (endpoint_id = TEST_ENGINE_ENDPOINT_ID_BASE +
+			   TEST_ENGINE_ENDPOINT_COUNT;
+	     endpoint_id < TEST_ENGINE_ENDPOINT_ID_BASE +
+				   MAX_SPDM_RESPONDER_ENGINE_ENDPOINT_COUNT;
+	     endpoint_id++) {
+		status = libspdm_responder_engine_register_context(
+			spdm_responder_engine, endpoint_id,
+			test_context->spdm_context[0]);
+		assert_int_equal(status, RETURN_SUCCESS);
+	}
+	status = libspdm_responder_engine_register_context(
+		spdm_responder_engine, endpoint_id,
+		test_context->spdm_context[0]);
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+
+	for (endpoint_id = TEST_ENGINE_ENDPOINT_ID_BASE +
+			   TEST_ENGINE_ENDPOINT_COUNT;
+	     endpoint_id < TEST_ENGINE_ENDPOINT_ID_BASE +
+				   MAX_SPDM_RESPONDER_ENGINE_ENDPOINT_COUNT;
+	     endpoint_id++) {
+		status = libspdm_responder_engine_unregister_context(
+			spdm_responder_engine, endpoint_id);
+		assert_int_equal(status, RETURN_SUCCESS);
+		assert_ptr_equal(libspdm_responder_engine_get_context(
+					 spdm_responder_engine, endpoint_id),
+				 NULL);
+	}
+	status = libspdm_responder_engine_unregister_context(
+		spdm_responder_engine, endpoint_id);
+	assert_int_equal(status, RETURN_NOT_FOUND);
+
+	assert_ptr_equal(libspdm_responder_engine_get_context(
+				 spdm_responder_engine,
+				 TEST_ENGINE_ENDPOINT_ID_BASE + 1),
+			 test_context->spdm_context[1]);
+}
+
+#if LIBSPDM_STATISTICS_SUPPORT
+static uint64 m_statistics_time;
+
+static uint64 spdm_engine_test_get_time(void)
+{
+	m_statistics_time += 10;
+	return m_statistics_time;
+}
+
+/**
+  Test 4: an endpoint sends GET_VERSION twice with the statistics enabled, and the response
+  to the second request cannot be sent because the transport is full.
+  Expected behavior: both requests are counted as received and their handling is timed,
+  but only the response that is sent is counted in messages_sent and bytes_sent.
+**/
+void test_spdm_responder_engine_case4(void **state)
+{
+	return_status status;
+	spdm_engine_test_context_t *test_context;
+	spdm_context_t *spdm_context;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	uintn response_size;
+	spdm_statistics_timer_t *timer;
+
+	test_context = *state;
+	spdm_context = test_context->spdm_context[0];
+	test_loopback_reset();
+	m_statistics_time = 0;
+	libspdm_register_get_time_func(spdm_context, spdm_engine_test_get_time);
+	libspdm_reset_statistics(spdm_context);
+
+	spdm_engine_test_send_get_version(TEST_ENGINE_ENDPOINT_ID_BASE);
+	status = libspdm_responder_engine_dispatch_message(
+		test_context->spdm_responder_engine);
+	assert_int_equal(status, RETURN_SUCCESS);
+	response_size = sizeof(response);
+	status = test_loopback_receive_response(TEST_ENGINE_ENDPOINT_ID_BASE,
+						&response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	assert_int_equal(spdm_context->statistics.messages_received, 1);
+	assert_int_equal(spdm_context->statistics.messages_sent, 1);
+	assert_int_equal(spdm_context->statistics.bytes_sent, response_size);
+	timer = &spdm_context->statistics
+			 .response[SPDM_GET_VERSION -
+				   SPDM_STATISTICS_REQUEST_CODE_BASE];
+	assert_int_equal(timer->count, 1);
+	assert_true(timer->total_time != 0);
+
+	//
+	// Fill the response queue so the next response cannot be sent.
+	//
+	do {
+		status = test_loopback_responder_send_message(
+			test_context->spdm_responder_engine,
+			TEST_ENGINE_ENDPOINT_ID_BASE + 1, response_size,
+			response, 0);
+	} while (!RETURN_ERROR(status));
+	assert_int_equal(status, RETURN_OUT_OF_RESOURCES);
+
+	spdm_engine_test_send_get_version(TEST_ENGINE_ENDPOINT_ID_BASE);
+	status = libspdm_responder_engine_dispatch_message(
+		test_context->spdm_responder_engine);
+	assert_true(RETURN_ERROR(status));
+
+	assert_int_equal(spdm_context->statistics.messages_received, 2);
+	assert_int_equal(timer->count, 2);
+	assert_int_equal(spdm_context->statistics.messages_sent, 1);
+	assert_int_equal(spdm_context->statistics.bytes_sent, response_size);
+
+	test_loopback_reset();
+	libspdm_register_get_time_func(spdm_context, NULL);
+	libspdm_reset_statistics(spdm_context);
+}
+#endif
+
+int spdm_responder_engine_test_group_setup(void **state)
+{
+	spdm_engine_test_context_t *test_context;
+	void *spdm_context;
+	uintn index;
+	return_status status;
+
+	test_context = &m_spdm_engine_test_context;
+	test_context->spdm_responder_engine =
+		(void *)malloc(libspdm_responder_engine_get_size());
+	if (test_context->spdm_responder_engine == NULL) {
+		return -1;
+	}
+	libspdm_responder_engine_init(test_context->spdm_responder_engine,
+				      test_loopback_responder_send_message,
+				      test_loopback_responder_receive_message);
+
+	for (index = 0; index < TEST_ENGINE_ENDPOINT_COUNT; index++) {
+		test_context->spdm_context[index] =
+			(void *)malloc(libspdm_get_context_size());
+		if (test_context->spdm_context[index] == NULL) {
+			return -1;
+		}
+		spdm_context = test_context->spdm_context[index];
+		libspdm_init_context(spdm_context);
+		libspdm_register_device_buffer(
+			spdm_context, m_spdm_engine_sender_buffer[index],
+			sizeof(m_spdm_engine_sender_buffer[index]),
+			m_spdm_engine_receiver_buffer[index],
+			sizeof(m_spdm_engine_receiver_buffer[index]));
+		libspdm_register_transport_layer_func(
+			spdm_context, spdm_transport_test_encode_message,
+			spdm_transport_test_decode_message);
+		status = libspdm_responder_engine_register_context(
+			test_context->spdm_responder_engine,
+			TEST_ENGINE_ENDPOINT_ID_BASE + (uint32)index,
+			spdm_context);
+		if (RETURN_ERROR(status)) {
+			return -1;
+		}
+	}
+
+	*state = test_context;
+	return 0;
+}
+
+int spdm_responder_engine_test_group_teardown(void **state)
+{
+	spdm_engine_test_context_t *test_context;
+	uintn index;
+
+	test_context = *state;
+	for (index = 0; index < TEST_ENGINE_ENDPOINT_COUNT; index++) {
+		free(test_context->spdm_context[index]);
+		test_context->spdm_context[index] = NULL;
+	}
+	free(test_context->spdm_responder_engine);
+	test_context->spdm_responder_engine = NULL;
+	return 0;
+}
+
+int spdm_responder_engine_test_main(void)
+{
+	const struct CMUnitTest spdm_responder_engine_tests[] = {
+		// Success Case
+		cmocka_unit_test(test_spdm_responder_engine_case1),
+		// Unknown endpoint
+		cmocka_unit_test(test_spdm_responder_engine_case2),
+		// Register and unregister
+		cmocka_unit_test(test_spdm_responder_engine_case3),
+#if LIBSPDM_STATISTICS_SUPPORT
+		// Statistics of sent and unsent responses
+		cmocka_unit_test(test_spdm_responder_engine_case4),
+#endif
+	};
+
+	return cmocka_run_group_tests(spdm_responder_engine_tests,
+				      spdm_responder_engine_test_group_setup,
+				      spdm_responder_engine_test_group_teardown);
+}
@@ -71,6 +71,7 @@ void test_spdm_responder_finish_case1(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -142,9 +143,10 @@ void test_spdm_responder_finish_case1(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request1,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_finish_request1_size = sizeof(spdm_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
 	status = spdm_get_response_finish(spdm_context,
@@ -180,6 +182,7 @@ void test_spdm_responder_finish_case2(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -249,9 +252,10 @@ void test_spdm_responder_finish_case2(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request2,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	response_size = sizeof(response);
 	status = spdm_get_response_finish(spdm_context,
 					  m_spdm_finish_request2_size,
@@ -289,6 +293,7 @@ void test_spdm_responder_finish_case3(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -361,9 +366,10 @@ void test_spdm_responder_finish_case3(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request1,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_finish_request1_size = sizeof(spdm_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
 	status = spdm_get_response_finish(spdm_context,
@@ -403,6 +409,7 @@ void test_spdm_responder_finish_case4(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -475,9 +482,10 @@ void test_spdm_responder_finish_case4(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request1,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_finish_request1_size = sizeof(spdm_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
 	status = spdm_get_response_finish(spdm_context,
@@ -518,6 +526,7 @@ void test_spdm_responder_finish_case5(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -591,9 +600,10 @@ void test_spdm_responder_finish_case5(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request1,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_finish_request1_size = sizeof(spdm_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
 	status = spdm_get_response_finish(spdm_context,
@@ -641,6 +651,7 @@ void test_spdm_responder_finish_case6(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -713,9 +724,10 @@ void test_spdm_responder_finish_case6(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request1,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_finish_request1_size = sizeof(spdm_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
 	status = spdm_get_response_finish(spdm_context,
@@ -748,6 +760,7 @@ void test_spdm_responder_finish_case7(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -832,9 +845,10 @@ void test_spdm_responder_finish_case7(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request1,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_finish_request1_size = sizeof(spdm_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
 	status = spdm_get_response_finish(spdm_context,
@@ -883,6 +897,7 @@ void test_spdm_responder_finish_case8(void **state)
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	uint8 req_cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -982,9 +997,10 @@ void test_spdm_responder_finish_case8(void **state)
 	append_managed_buffer(&th_curr, ptr, req_asym_signature_size);
 	ptr += req_asym_signature_size;
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_finish_request3_size = sizeof(spdm_finish_request_t) + 
 		req_asym_signature_size + hmac_size;
 	response_size = sizeof(response);
@@ -1023,6 +1039,7 @@ void test_spdm_responder_finish_case9(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -1095,9 +1112,10 @@ void test_spdm_responder_finish_case9(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request1,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_finish_request1_size = sizeof(spdm_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
 	status = spdm_get_response_finish(spdm_context,
@@ -1137,6 +1155,7 @@ void test_spdm_responder_finish_case10(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -1208,9 +1227,10 @@ void test_spdm_responder_finish_case10(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request1,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_finish_request1_size = sizeof(spdm_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
 	status = spdm_get_response_finish(spdm_context,
@@ -1443,6 +1463,7 @@ void test_spdm_responder_finish_case13(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -1514,9 +1535,10 @@ void test_spdm_responder_finish_case13(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request1,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	copy_mem(ptr, ptr + hmac_size, hmac_size); // 2x HMAC size
 	m_spdm_finish_request1_size = sizeof(spdm_finish_request_t) + 2*hmac_size;
 	response_size = sizeof(response);
@@ -1556,6 +1578,7 @@ void test_spdm_responder_finish_case14(void **state)
 	uintn cert_buffer_size;
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -1627,9 +1650,10 @@ void test_spdm_responder_finish_case14(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_finish_request1,
 			      sizeof(spdm_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	set_mem(ptr + hmac_size/2, hmac_size/2, (uint8) 0x00); // half HMAC size
 	m_spdm_finish_request1_size = sizeof(spdm_finish_request_t) + hmac_size/2;
 	response_size = sizeof(response);
@@ -1672,6 +1696,7 @@ void test_spdm_responder_finish_case15(void **state)
 	uint8 cert_buffer_hash[MAX_HASH_SIZE];
 	uint8 req_cert_buffer_hash[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -1771,9 +1796,10 @@ void test_spdm_responder_finish_case15(void **state)
 	append_managed_buffer(&th_curr, ptr, req_asym_signature_size);
 	ptr += req_asym_signature_size;
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	set_mem(m_spdm_finish_request3.signature, 
 		      req_asym_signature_size, (uint8) 0x00); //zero signature
 	m_spdm_finish_request3_size = sizeof(spdm_finish_request_t) + 
@@ -1820,6 +1846,7 @@ void test_spdm_responder_finish_case16(void **state)
 	uint8 req_cert_buffer_hash[MAX_HASH_SIZE];
 	uint8 random_buffer[MAX_HASH_SIZE];
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -1921,9 +1948,10 @@ void test_spdm_responder_finish_case16(void **state)
 	append_managed_buffer(&th_curr, ptr, req_asym_signature_size);
 	ptr += req_asym_signature_size;
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_finish_request3_size = sizeof(spdm_finish_request_t) + 
 		req_asym_signature_size + hmac_size;
 	response_size = sizeof(response);
@@ -1467,6 +1467,191 @@ void test_spdm_responder_measurements_case23(void **state)
 #endif
 }
 
+/**
+  Test 24: Successful response to get all measurements, with the measurement record
+  built block by block directly in the response buffer.
+  Expected Behavior: get a RETURN_SUCCESS return code, and the same measurement record as
+  collected in one call.
+**/
+void test_spdm_responder_measurements_case24(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	spdm_measurements_response_t *spdm_response;
+	uint8 measurement_record[MAX_SPDM_MEASUREMENT_RECORD_SIZE];
+	uintn measurement_record_size;
+	uint8 measurement_count;
+	uint32 measurement_record_length;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x18;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AUTHENTICATED;
+	spdm_context->local_context.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->connection_info.version.major_version = 1;
+	spdm_context->connection_info.version.minor_version = 0;
+	spdm_context->last_spdm_request_session_id_valid = FALSE;
+	libspdm_reset_message_m(spdm_context, NULL);
+	spdm_context->local_context.opaque_measurement_rsp_size = 0;
+	spdm_context->local_context.opaque_measurement_rsp = NULL;
+
+	measurement_record_size = sizeof(measurement_record);
+	status = spdm_measurement_collection(
+		spdm_context->connection_info.version, m_use_measurement_spec,
+		m_use_measurement_hash_algo,
+		SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+		&measurement_count, measurement_record,
+		&measurement_record_size);
+	assert_int_equal(status, RETURN_SUCCESS);
+
+	response_size = sizeof(response);
+	status = spdm_get_response_measurements(
+		spdm_context, m_spdm_get_measurements_request7_size,
+		&m_spdm_get_measurements_request7, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.request_response_code,
+			 SPDM_MEASUREMENTS);
+	assert_int_equal(spdm_response->number_of_blocks, measurement_count);
+	measurement_record_length = 0;
+	copy_mem(&measurement_record_length,
+		 spdm_response->measurement_record_length,
+		 sizeof(spdm_response->measurement_record_length));
+	assert_int_equal(measurement_record_length, measurement_record_size);
+	assert_memory_equal(spdm_response + 1, measurement_record,
+			    measurement_record_size);
+}
+
+#if LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT
+/**
+  Test 25: Unsigned MEASUREMENTS responses are served from the response cache.
+  Expected Behavior: a repeated request gets the cached response. Updating the opaque data
+  in place, or advancing the measurement generation, builds a new response.
+**/
+void test_spdm_responder_measurements_case25(void **state)
+{
+	return_status status;
+	spdm_test_context_t *spdm_test_context;
+	spdm_context_t *spdm_context;
+	uintn response_size;
+	uint8 response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+	spdm_measurements_response_t *spdm_response;
+	uint8 opaque_data[8];
+	uintn digest_offset;
+	uintn opaque_offset;
+	uint8 digest;
+	uintn index;
+
+	spdm_test_context = *state;
+	spdm_context = spdm_test_context->spdm_context;
+	spdm_test_context->case_id = 0x19;
+	spdm_context->connection_info.connection_state =
+		SPDM_CONNECTION_STATE_AUTHENTICATED;
+	spdm_context->local_context.capability.flags |=
+		SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+	spdm_context->connection_info.algorithm.base_hash_algo =
+		m_use_hash_algo;
+	spdm_context->connection_info.algorithm.base_asym_algo =
+		m_use_asym_algo;
+	spdm_context->connection_info.algorithm.measurement_spec =
+		m_use_measurement_spec;
+	spdm_context->connection_info.algorithm.measurement_hash_algo =
+		m_use_measurement_hash_algo;
+	spdm_context->connection_info.version.major_version = 1;
+	spdm_context->connection_info.version.minor_version = 0;
+	spdm_context->last_spdm_request_session_id_valid = FALSE;
+	set_mem(opaque_data, sizeof(opaque_data), 0xA5);
+	spdm_context->local_context.opaque_measurement_rsp_size =
+		sizeof(opaque_data);
+	spdm_context->local_context.opaque_measurement_rsp = opaque_data;
+	zero_mem(spdm_context->measurement_response_cache,
+		 sizeof(spdm_context->measurement_response_cache));
+	spdm_context->measurement_response_cache_next = 0;
+
+	// The first byte of the digest of block 1, and the opaque data
+	digest_offset = sizeof(spdm_measurements_response_t) +
+			sizeof(spdm_measurement_block_dmtf_t);
+	opaque_offset = digest_offset +
+			spdm_get_measurement_hash_size(
+				m_use_measurement_hash_algo) +
+			SPDM_NONCE_SIZE + sizeof(uint16);
+
+	libspdm_reset_message_m(spdm_context, NULL);
+	response_size = sizeof(response);
+	status = spdm_get_response_measurements(
+		spdm_context, m_spdm_get_measurements_request6_size,
+		&m_spdm_get_measurements_request6, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	spdm_response = (void *)response;
+	assert_int_equal(spdm_response->header.request_response_code,
+			 SPDM_MEASUREMENTS);
+	assert_int_equal(response_size, opaque_offset + sizeof(opaque_data));
+	assert_true(spdm_context->measurement_response_cache[0].valid);
+	digest = response[digest_offset];
+
+	//
+	// A repeated request is served from the cache.
+	//
+	spdm_context->measurement_response_cache[0].response[digest_offset] ^=
+		0xFF;
+	libspdm_reset_message_m(spdm_context, NULL);
+	response_size = sizeof(response);
+	status = spdm_get_response_measurements(
+		spdm_context, m_spdm_get_measurements_request6_size,
+		&m_spdm_get_measurements_request6, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(response[digest_offset], (uint8)(digest ^ 0xFF));
+
+	//
+	// The opaque data is updated in place: same buffer, same size.
+	//
+	set_mem(opaque_data, sizeof(opaque_data), 0x5A);
+	libspdm_reset_message_m(spdm_context, NULL);
+	response_size = sizeof(response);
+	status = spdm_get_response_measurements(
+		spdm_context, m_spdm_get_measurements_request6_size,
+		&m_spdm_get_measurements_request6, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(response[digest_offset], digest);
+	assert_memory_equal(response + opaque_offset, opaque_data,
+			    sizeof(opaque_data));
+	assert_true(spdm_context->measurement_response_cache[1].valid);
+
+	//
+	// A new measurement generation invalidates every cached response.
+	//
+	for (index = 0; index < MAX_SPDM_MEASUREMENT_RESPONSE_CACHE_COUNT;
+	     index++) {
+		spdm_context->measurement_response_cache[index]
+			.response[digest_offset] ^= 0xFF;
+	}
+	spdm_measurement_invalidate(1);
+	libspdm_reset_message_m(spdm_context, NULL);
+	response_size = sizeof(response);
+	status = spdm_get_response_measurements(
+		spdm_context, m_spdm_get_measurements_request6_size,
+		&m_spdm_get_measurements_request6, &response_size, response);
+	assert_int_equal(status, RETURN_SUCCESS);
+	assert_int_equal(response[digest_offset], digest);
+
+	spdm_context->local_context.opaque_measurement_rsp_size = 0;
+	spdm_context->local_context.opaque_measurement_rsp = NULL;
+}
+#endif // LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT
+
 spdm_test_context_t m_spdm_responder_measurements_test_context = {
 	SPDM_TEST_CONTEXT_SIGNATURE,
 	FALSE,
@@ -1524,6 +1709,12 @@ int spdm_responder_measurements_test_main(void)
 		cmocka_unit_test(test_spdm_responder_measurements_case22),
 		// Successful response to get a session based measurement with signature
 		cmocka_unit_test(test_spdm_responder_measurements_case23),
+		// Success Case to get all measurements, built block by block
+		cmocka_unit_test(test_spdm_responder_measurements_case24),
+#if LIBSPDM_MEASUREMENT_RESPONSE_CACHE_SUPPORT
+		// Unsigned responses served from the response cache
+		cmocka_unit_test(test_spdm_responder_measurements_case25),
+#endif
 	};
 
 	setup_spdm_test_context(&m_spdm_responder_measurements_test_context);
@@ -60,6 +60,7 @@ void test_spdm_responder_psk_finish_case1(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -130,9 +131,10 @@ void test_spdm_responder_psk_finish_case1(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_psk_finish_request1,
 			      sizeof(spdm_psk_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_psk_finish_request1_size =
 		sizeof(spdm_psk_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
@@ -165,6 +167,7 @@ void test_spdm_responder_psk_finish_case2(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -233,9 +236,10 @@ void test_spdm_responder_psk_finish_case2(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_psk_finish_request2,
 			      sizeof(spdm_psk_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	response_size = sizeof(response);
 	status = spdm_get_response_psk_finish(spdm_context,
 					      m_spdm_psk_finish_request2_size,
@@ -270,6 +274,7 @@ void test_spdm_responder_psk_finish_case3(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -341,9 +346,10 @@ void test_spdm_responder_psk_finish_case3(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_psk_finish_request1,
 			      sizeof(spdm_psk_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_psk_finish_request1_size =
 		sizeof(spdm_psk_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
@@ -381,6 +387,7 @@ void test_spdm_responder_psk_finish_case4(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -452,9 +459,10 @@ void test_spdm_responder_psk_finish_case4(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_psk_finish_request1,
 			      sizeof(spdm_psk_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_psk_finish_request1_size =
 		sizeof(spdm_psk_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
@@ -493,6 +501,7 @@ void test_spdm_responder_psk_finish_case5(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -565,9 +574,10 @@ void test_spdm_responder_psk_finish_case5(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_psk_finish_request1,
 			      sizeof(spdm_psk_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_psk_finish_request1_size =
 		sizeof(spdm_psk_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
@@ -613,6 +623,7 @@ void test_spdm_responder_psk_finish_case6(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -684,9 +695,10 @@ void test_spdm_responder_psk_finish_case6(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_psk_finish_request1,
 			      sizeof(spdm_psk_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_psk_finish_request1_size =
 		sizeof(spdm_psk_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
@@ -717,6 +729,7 @@ void test_spdm_responder_psk_finish_case7(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -801,9 +814,10 @@ void test_spdm_responder_psk_finish_case7(void **state)
 #endif
 
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_psk_finish_request1_size =
 		sizeof(spdm_psk_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
@@ -845,6 +859,7 @@ void test_spdm_responder_psk_finish_case8(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -915,9 +930,10 @@ void test_spdm_responder_psk_finish_case8(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_psk_finish_request1,
 			      sizeof(spdm_psk_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_psk_finish_request1_size =
 		sizeof(spdm_psk_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
@@ -955,6 +971,7 @@ void test_spdm_responder_psk_finish_case9(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -1025,9 +1042,10 @@ void test_spdm_responder_psk_finish_case9(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_psk_finish_request1,
 			      sizeof(spdm_psk_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	m_spdm_psk_finish_request1_size =
 		sizeof(spdm_psk_finish_request_t) + hmac_size;
 	response_size = sizeof(response);
@@ -1268,6 +1286,7 @@ void test_spdm_responder_psk_finish_case12(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -1338,9 +1357,10 @@ void test_spdm_responder_psk_finish_case12(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_psk_finish_request1,
 			      sizeof(spdm_psk_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	copy_mem(ptr, ptr + hmac_size, hmac_size); // 2x HMAC size
 	m_spdm_psk_finish_request1_size =
 		sizeof(spdm_psk_finish_request_t) + 2*hmac_size;
@@ -1378,6 +1398,7 @@ void test_spdm_responder_psk_finish_case13(void **state)
 	uintn data_size1;
 	uint8 *ptr;
 	large_managed_buffer_t th_curr;
+	uint8 th_curr_hash_data[MAX_HASH_SIZE];
 	uint8 request_finished_key[MAX_HASH_SIZE];
 	spdm_session_info_t *session_info;
 	uint32 session_id;
@@ -1448,9 +1469,10 @@ void test_spdm_responder_psk_finish_case13(void **state)
 	append_managed_buffer(&th_curr, (uint8 *)&m_spdm_psk_finish_request1,
 			      sizeof(spdm_psk_finish_request_t));
 	set_mem(request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-	spdm_hmac_all(m_use_hash_algo, get_managed_buffer(&th_curr),
-		      get_managed_buffer_size(&th_curr), request_finished_key,
-		      hash_size, ptr);
+	spdm_hash_all(m_use_hash_algo, get_managed_buffer(&th_curr),
+		      get_managed_buffer_size(&th_curr), th_curr_hash_data);
+	spdm_hmac_all(m_use_hash_algo, th_curr_hash_data, hash_size,
+		      request_finished_key, hash_size, ptr);
 	set_mem(ptr + hmac_size/2, hmac_size/2, (uint8) 0x00); // half HMAC size
 	m_spdm_psk_finish_request1_size =
 		sizeof(spdm_psk_finish_request_t) + hmac_size/2;
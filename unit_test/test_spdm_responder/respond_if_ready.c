@@ -632,6 +632,7 @@ void test_spdm_responder_respond_if_ready_case6(void **state) {
   uint8                cert_buffer_hash[MAX_HASH_SIZE];
   large_managed_buffer_t th_curr;
   uint8                request_finished_key[MAX_HASH_SIZE];
+  uint8                th_curr_hash_data[MAX_HASH_SIZE];
   spdm_session_info_t    *session_info;
   uint32               session_id;
   uint32               hash_size;
@@ -687,7 +688,8 @@ void test_spdm_responder_respond_if_ready_case6(void **state) {
   // SessionTranscript.MessageK is 0 
   append_managed_buffer (&th_curr, (uint8 *)&m_spdm_finish_request, sizeof(spdm_finish_request_t));
   set_mem (request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-  spdm_hmac_all (m_use_hash_algo, get_managed_buffer(&th_curr), get_managed_buffer_size(&th_curr), request_finished_key, hash_size, ptr);
+  spdm_hash_all (m_use_hash_algo, get_managed_buffer(&th_curr), get_managed_buffer_size(&th_curr), th_curr_hash_data);
+  spdm_hmac_all (m_use_hash_algo, th_curr_hash_data, hash_size, request_finished_key, hash_size, ptr);
 
   spdm_context->last_spdm_request_size = sizeof(spdm_finish_request_t) + hmac_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_finish_request, m_spdm_finish_request_size);
@@ -824,6 +826,7 @@ void test_spdm_responder_respond_if_ready_case8(void **state) {
   uint8                dummy_buffer[MAX_HASH_SIZE];
   large_managed_buffer_t th_curr;
   uint8                request_finished_key[MAX_HASH_SIZE];
+  uint8                th_curr_hash_data[MAX_HASH_SIZE];
   spdm_session_info_t    *session_info;
   uint32               session_id;
   uint32               hash_size;
@@ -881,7 +884,8 @@ void test_spdm_responder_respond_if_ready_case8(void **state) {
   // SessionTranscript.MessageK is 0 
   append_managed_buffer (&th_curr, (uint8 *)&m_spdm_psk_finish_request, sizeof(spdm_psk_finish_request_t));
   set_mem (request_finished_key, MAX_HASH_SIZE, (uint8)(0xFF));
-  spdm_hmac_all (m_use_hash_algo, get_managed_buffer(&th_curr), get_managed_buffer_size(&th_curr), request_finished_key, hash_size, ptr);
+  spdm_hash_all (m_use_hash_algo, get_managed_buffer(&th_curr), get_managed_buffer_size(&th_curr), th_curr_hash_data);
+  spdm_hmac_all (m_use_hash_algo, th_curr_hash_data, hash_size, request_finished_key, hash_size, ptr);
 
   spdm_context->last_spdm_request_size = sizeof(spdm_psk_finish_request_t) + hmac_size;
   copy_mem (spdm_context->last_spdm_request, &m_spdm_psk_finish_request, m_spdm_psk_finish_request_size);
@@ -1224,6 +1228,77 @@ void test_spdm_responder_respond_if_ready_case14(void **state) {
   assert_int_equal (spdm_response->header.param1, SPDM_ERROR_CODE_INVALID_REQUEST);
   assert_int_equal (spdm_response->header.param2, 0);
 }
+
+return_status spdm_test_get_response_digests (IN void *spdm_context, IN uintn request_size, IN void *request, IN OUT uintn *response_size, OUT void *response) {
+  spdm_digest_response_t *spdm_response;
+
+  spdm_response = response;
+  spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+  spdm_response->header.request_response_code = SPDM_DIGESTS;
+  spdm_response->header.param1 = 0;
+  spdm_response->header.param2 = 0;
+  *response_size = sizeof(spdm_digest_response_t);
+  return RETURN_SUCCESS;
+}
+
+/**
+  Test 15: receiving a correct RESPOND_IF_READY for a request code with a registered process function.
+  Expected behavior: the registered function is invoked, and the default one is restored after unregistering.
+**/
+void test_spdm_responder_respond_if_ready_case15(void **state) {
+  return_status        status;
+  spdm_test_context_t    *spdm_test_context;
+  spdm_context_t  *spdm_context;
+  uintn                response_size;
+  uint8                response[MAX_SPDM_MESSAGE_BUFFER_SIZE];
+  spdm_digest_response_t *spdm_response; //response to the original request (DIGESTS)
+
+  spdm_test_context = *state;
+  spdm_context = spdm_test_context->spdm_context;
+  spdm_test_context->case_id = 0xF;
+  spdm_context->response_state = SPDM_RESPONSE_STATE_NORMAL;
+
+  //state for the the original request (GET_DIGESTS)
+  spdm_context->connection_info.connection_state = SPDM_CONNECTION_STATE_NEGOTIATED; 
+  spdm_context->local_context.capability.flags = 0;
+  spdm_context->connection_info.algorithm.base_hash_algo = m_use_hash_algo;
+  spdm_context->last_spdm_request_size = m_spdm_get_digest_request_size;
+  copy_mem (spdm_context->last_spdm_request, &m_spdm_get_digest_request, m_spdm_get_digest_request_size);
+
+  //RESPOND_IF_READY specific data
+  spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
+  copy_mem (spdm_context->cache_spdm_request, spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
+  spdm_context->error_data.rd_exponent = 1;
+  spdm_context->error_data.rd_tm        = 1;
+  spdm_context->error_data.request_code = SPDM_GET_DIGESTS;
+  spdm_context->error_data.token       = MY_TEST_TOKEN;
+
+  status = libspdm_register_get_response_func_via_request_code (spdm_context, SPDM_DIGESTS, spdm_test_get_response_digests);
+  assert_int_equal (status, RETURN_INVALID_PARAMETER);
+  status = libspdm_register_get_response_func_via_request_code (spdm_context, SPDM_RESPOND_IF_READY, spdm_test_get_response_digests);
+  assert_int_equal (status, RETURN_INVALID_PARAMETER);
+  status = libspdm_register_get_response_func_via_request_code (spdm_context, SPDM_GET_DIGESTS, spdm_test_get_response_digests);
+  assert_int_equal (status, RETURN_SUCCESS);
+
+  //check DIGESTS response from the registered function
+  response_size = sizeof(response);
+  status = spdm_get_response_respond_if_ready(spdm_context, m_spdm_respond_if_ready_request1_size, &m_spdm_respond_if_ready_request1, &response_size, response);
+  assert_int_equal (status, RETURN_SUCCESS);
+  assert_int_equal (response_size, sizeof(spdm_digest_response_t));
+  spdm_response = (void *)response;
+  assert_int_equal (spdm_response->header.request_response_code, SPDM_DIGESTS);
+
+  status = libspdm_register_get_response_func_via_request_code (spdm_context, SPDM_GET_DIGESTS, NULL);
+  assert_int_equal (status, RETURN_SUCCESS);
+
+  //check ERROR response from the default function, CERT_CAP is not set
+  response_size = sizeof(response);
+  status = spdm_get_response_respond_if_ready(spdm_context, m_spdm_respond_if_ready_request1_size, &m_spdm_respond_if_ready_request1, &response_size, response);
+  assert_int_equal (status, RETURN_SUCCESS);
+  assert_int_equal (response_size, sizeof(spdm_error_response_t));
+  spdm_response = (void *)response;
+  assert_int_equal (spdm_response->header.request_response_code, SPDM_ERROR);
+}
 #endif // SPDM_ENABLE_CAPABILITY_CERT_CAP
 
 spdm_test_context_t       m_spdm_responder_respond_if_ready_test_context = {
@@ -1264,6 +1339,8 @@ int spdm_responder_respond_if_ready_test_main(void) {
     cmocka_unit_test(test_spdm_responder_respond_if_ready_case12),
     cmocka_unit_test(test_spdm_responder_respond_if_ready_case13),
     cmocka_unit_test(test_spdm_responder_respond_if_ready_case14),
+    // Registered process function
+    cmocka_unit_test(test_spdm_responder_respond_if_ready_case15),
     #endif // SPDM_ENABLE_CAPABILITY_CERT_CAP
 
   };
@@ -25,6 +25,7 @@ int spdm_responder_measurements_test_main(void);
 #endif // SPDM_ENABLE_CAPABILITY_MEAS_CAP
 
 int spdm_responder_respond_if_ready_test_main (void);
+int spdm_responder_engine_test_main(void);
 
 #if SPDM_ENABLE_CAPABILITY_KEY_EX_CAP
 int spdm_responder_key_exchange_test_main(void);
@@ -119,5 +120,9 @@ int main(void)
 		return_value = 1;
 	}
 
+	if (spdm_responder_engine_test_main() != 0) {
+		return_value = 1;
+	}
+
 	return return_value;
 }
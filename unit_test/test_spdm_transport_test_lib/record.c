@@ -0,0 +1,573 @@
+/**
+    Copyright Notice:
+    Copyright 2021 DMTF. All rights reserved.
+    License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+**/
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+#include <stdlib.h>
+
+#undef NULL
+#include <base.h>
+#include <library/memlib.h>
+#include <library/spdm_responder_lib.h>
+#include <library/spdm_transport_test_lib.h>
+
+#define TEST_RECORD_TRACE_SIZE 0x10000
+#define TEST_RECORD_MESSAGE_SIZE 0x4001
+#define TEST_RECORD_CONFIG "record test"
+
+//
+// The device of the recorded SPDM context.
+// The device returns m_test_record_device_response and m_test_record_device_status on receive,
+// and keeps the last sent message in m_test_record_device_request.
+//
+static uint8 m_test_record_device_request[TEST_RECORD_MESSAGE_SIZE];
+static uintn m_test_record_device_request_size;
+static uint8 m_test_record_device_response[TEST_RECORD_MESSAGE_SIZE];
+static uintn m_test_record_device_response_size;
+static return_status m_test_record_device_status;
+static uint64 m_test_record_time;
+
+static uint8 m_test_record_trace[TEST_RECORD_TRACE_SIZE];
+static uint8 m_test_record_message[TEST_RECORD_MESSAGE_SIZE];
+
+static return_status test_record_device_send_message(IN void *spdm_context,
+						     IN uintn request_size,
+						     IN void *request,
+						     IN uint64 timeout)
+{
+	assert_true(request_size <= sizeof(m_test_record_device_request));
+	copy_mem(m_test_record_device_request, request, request_size);
+	m_test_record_device_request_size = request_size;
+	return RETURN_SUCCESS;
+}
+
+static return_status test_record_device_receive_message(
+	IN void *spdm_context, IN OUT uintn *response_size,
+	IN OUT void *response, IN uint64 timeout)
+{
+	if (RETURN_ERROR(m_test_record_device_status)) {
+		return m_test_record_device_status;
+	}
+	assert_true(*response_size >= m_test_record_device_response_size);
+	copy_mem(response, m_test_record_device_response,
+		 m_test_record_device_response_size);
+	*response_size = m_test_record_device_response_size;
+	return RETURN_SUCCESS;
+}
+
+static uint64 test_record_device_get_time(void)
+{
+	return m_test_record_time;
+}
+
+/**
+  Start recording to m_test_record_trace with the test device.
+
+  @param  trace_size                    The size in bytes of the buffer of the trace.
+**/
+static void test_record_test_start(IN uintn trace_size)
+{
+	m_test_record_time = 5;
+	m_test_record_device_status = RETURN_SUCCESS;
+	assert_int_equal(test_record_start(m_test_record_trace, trace_size,
+					   TEST_RECORD_CONFIG,
+					   sizeof(TEST_RECORD_CONFIG),
+					   test_record_device_get_time,
+					   test_record_device_send_message,
+					   test_record_device_receive_message),
+			 RETURN_SUCCESS);
+}
+
+/**
+  Record a trace with a send, a receive, 2 random draws, a send and a receive error.
+
+  @return The size in bytes of the trace.
+**/
+static uintn test_record_test_sample(void)
+{
+	uint8 data[0x40];
+	uintn size;
+
+	test_record_test_start(sizeof(m_test_record_trace));
+	assert_int_equal(test_record_send_message(NULL, 8,
+						  m_test_record_message, 0),
+			 RETURN_SUCCESS);
+	m_test_record_time += 100;
+	m_test_record_device_response_size = 12;
+	size = sizeof(data);
+	assert_int_equal(test_record_receive_message(NULL, &size, data, 0),
+			 RETURN_SUCCESS);
+	test_record_random(m_test_record_message + 0x10, 16);
+	test_record_random(m_test_record_message + 0x20, 32);
+	assert_int_equal(test_record_send_message(NULL, 4,
+						  m_test_record_message + 0x40,
+						  0),
+			 RETURN_SUCCESS);
+	m_test_record_device_status = RETURN_TIMEOUT;
+	size = sizeof(data);
+	assert_int_equal(test_record_receive_message(NULL, &size, data, 0),
+			 RETURN_TIMEOUT);
+	assert_int_equal(test_record_stop(&size), RETURN_SUCCESS);
+	return size;
+}
+
+/**
+  Replay the trace of test_record_test_sample.
+
+  @param  trace_size                    The size in bytes of the trace.
+
+  @return The status of test_replay_stop.
+**/
+static return_status test_record_test_replay_sample(IN uintn trace_size)
+{
+	uint8 data[0x40];
+	uintn size;
+
+	if (RETURN_ERROR(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL))) {
+		return RETURN_BAD_BUFFER_SIZE;
+	}
+	if (!RETURN_ERROR(test_replay_send_message(
+		    NULL, 8, m_test_record_message, 0))) {
+		size = sizeof(data);
+		if (!RETURN_ERROR(test_replay_receive_message(NULL, &size,
+							      data, 0)) &&
+		    test_replay_random(data, 48)) {
+			if (!RETURN_ERROR(test_replay_send_message(
+				    NULL, 4, m_test_record_message + 0x40,
+				    0))) {
+				size = sizeof(data);
+				test_replay_receive_message(NULL, &size, data,
+							    0);
+			}
+		}
+	}
+	return test_replay_stop();
+}
+
+/**
+  Test 1: messages of 0 to 0x4001 bytes are recorded with time deltas of 0 to 2^63.
+  Expected behavior: the sizes and the time deltas are encoded as unsigned LEB128, and the replay
+  returns the configuration, accepts the same messages, and returns the recorded times.
+**/
+static void test_record_case1(void **state)
+{
+	static const uint64 delta[] = { 0,     1,     127,         128,
+					16383, 16384, 0x123456789, BIT63 };
+	static const uintn size[] = { 0, 1, 127, 128, 300, 16383, 16384, 7 };
+	const void *config;
+	uintn config_size;
+	uintn trace_size;
+	uintn offset;
+	uint64 time;
+	uintn index;
+
+	for (index = 0; index < sizeof(m_test_record_message); index++) {
+		m_test_record_message[index] = (uint8)(index * 7);
+	}
+
+	test_record_test_start(sizeof(m_test_record_trace));
+	for (index = 0; index < ARRAY_SIZE(delta); index++) {
+		m_test_record_time += delta[index];
+		assert_int_equal(test_record_send_message(NULL, size[index],
+							  m_test_record_message,
+							  0),
+				 RETURN_SUCCESS);
+		assert_int_equal(m_test_record_device_request_size,
+				 size[index]);
+	}
+	assert_int_equal(test_record_stop(&trace_size), RETURN_SUCCESS);
+
+	// The second record has a delta of 1 and a size of 1, the fourth a delta of 128 and a size of 128.
+	offset = sizeof(test_record_header_t) + sizeof(TEST_RECORD_CONFIG);
+	assert_int_equal(m_test_record_trace[offset], TEST_RECORD_TYPE_SEND);
+	assert_int_equal(m_test_record_trace[offset + 1], 0x00);
+	assert_int_equal(m_test_record_trace[offset + 2], 0x00);
+	offset += 3;
+	assert_int_equal(m_test_record_trace[offset + 1], 0x01);
+	assert_int_equal(m_test_record_trace[offset + 2], 0x01);
+	offset += 3 + 1;
+	offset += 1 + 1 + 1 + 127;
+	assert_int_equal(m_test_record_trace[offset + 1], 0x80);
+	assert_int_equal(m_test_record_trace[offset + 2], 0x01);
+	assert_int_equal(m_test_record_trace[offset + 3], 0x80);
+	assert_int_equal(m_test_record_trace[offset + 4], 0x01);
+
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   &config, &config_size),
+			 RETURN_SUCCESS);
+	assert_true(test_replay_is_active());
+	assert_int_equal(config_size, sizeof(TEST_RECORD_CONFIG));
+	assert_memory_equal(config, TEST_RECORD_CONFIG, config_size);
+	time = 5;
+	assert_true(test_replay_get_time() == time);
+	for (index = 0; index < ARRAY_SIZE(delta); index++) {
+		time += delta[index];
+		assert_int_equal(test_replay_send_message(NULL, size[index],
+							  m_test_record_message,
+							  0),
+				 RETURN_SUCCESS);
+		assert_true(test_replay_get_time() == time);
+	}
+	assert_int_equal(test_replay_stop(), RETURN_SUCCESS);
+	assert_false(test_replay_is_active());
+}
+
+/**
+  Test 2: a trace is truncated at every size, and a recording overflows the buffer of the trace.
+  Expected behavior: a truncated header or configuration is rejected, a truncated record makes
+  the replay diverge, and the overflowing recording is reported and still replays up to the overflow.
+**/
+static void test_record_case2(void **state)
+{
+	test_record_header_t header;
+	uintn trace_size;
+	uintn size;
+	uintn start_size;
+
+	trace_size = test_record_test_sample();
+	assert_int_equal(test_record_test_replay_sample(trace_size),
+			 RETURN_SUCCESS);
+
+	start_size = sizeof(test_record_header_t) + sizeof(TEST_RECORD_CONFIG);
+	for (size = 0; size < start_size; size++) {
+		assert_int_equal(test_replay_start(m_test_record_trace, size,
+						   NULL, NULL),
+				 RETURN_BAD_BUFFER_SIZE);
+	}
+	for (size = start_size; size < trace_size; size++) {
+		assert_int_equal(test_record_test_replay_sample(size),
+				 RETURN_DEVICE_ERROR);
+	}
+
+	copy_mem(&header, m_test_record_trace, sizeof(header));
+	header.version = TEST_RECORD_VERSION + 1;
+	copy_mem(m_test_record_trace, &header, sizeof(header));
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_UNSUPPORTED);
+
+	// A size of more than 64 bits.
+	trace_size = test_record_test_sample();
+	m_test_record_trace[start_size] = TEST_RECORD_TYPE_SEND;
+	set_mem(m_test_record_trace + start_size + 1, 10, 0x80);
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_send_message(NULL, 8,
+						  m_test_record_message, 0),
+			 RETURN_DEVICE_ERROR);
+	assert_int_equal(test_replay_stop(), RETURN_DEVICE_ERROR);
+
+	assert_int_equal(test_record_start(m_test_record_trace, start_size - 1,
+					   TEST_RECORD_CONFIG,
+					   sizeof(TEST_RECORD_CONFIG), NULL,
+					   test_record_device_send_message,
+					   test_record_device_receive_message),
+			 RETURN_BUFFER_TOO_SMALL);
+
+	// The first record of 8 bytes fits, the second one does not.
+	test_record_test_start(start_size + 3 + 8 + 3);
+	assert_int_equal(test_record_send_message(NULL, 8,
+						  m_test_record_message, 0),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_record_send_message(NULL, 8,
+						  m_test_record_message, 0),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_record_stop(&trace_size),
+			 RETURN_BUFFER_TOO_SMALL);
+	assert_int_equal(trace_size, start_size + 3 + 8);
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_send_message(NULL, 8,
+						  m_test_record_message, 0),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_stop(), RETURN_SUCCESS);
+}
+
+/**
+  Test 3: the replayed SPDM context sends other messages, draws other random bytes, or stops early.
+  Expected behavior: the replay diverges and test_replay_stop returns RETURN_DEVICE_ERROR,
+  except for an early stop which returns RETURN_ABORTED. A recorded receive error is
+  replayed as it was recorded.
+**/
+static void test_record_case3(void **state)
+{
+	uint8 data[0x40];
+	uintn trace_size;
+	uintn size;
+
+	trace_size = test_record_test_sample();
+
+	// Another message.
+	m_test_record_message[3] ^= 0xFF;
+	assert_int_equal(test_record_test_replay_sample(trace_size),
+			 RETURN_DEVICE_ERROR);
+	m_test_record_message[3] ^= 0xFF;
+
+	// Another size.
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_send_message(NULL, 7,
+						  m_test_record_message, 0),
+			 RETURN_DEVICE_ERROR);
+	assert_int_equal(test_replay_stop(), RETURN_DEVICE_ERROR);
+
+	// A receive instead of the recorded send.
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	size = sizeof(data);
+	assert_int_equal(test_replay_receive_message(NULL, &size, data, 0),
+			 RETURN_DEVICE_ERROR);
+	assert_int_equal(test_replay_send_message(NULL, 8,
+						  m_test_record_message, 0),
+			 RETURN_DEVICE_ERROR);
+	assert_int_equal(test_replay_stop(), RETURN_DEVICE_ERROR);
+
+	// A response buffer smaller than the recorded response.
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_send_message(NULL, 8,
+						  m_test_record_message, 0),
+			 RETURN_SUCCESS);
+	size = 11;
+	assert_int_equal(test_replay_receive_message(NULL, &size, data, 0),
+			 RETURN_DEVICE_ERROR);
+	assert_int_equal(test_replay_stop(), RETURN_DEVICE_ERROR);
+
+	// Less random bytes than recorded, then more random bytes than recorded.
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_send_message(NULL, 8,
+						  m_test_record_message, 0),
+			 RETURN_SUCCESS);
+	size = sizeof(data);
+	assert_int_equal(test_replay_receive_message(NULL, &size, data, 0),
+			 RETURN_SUCCESS);
+	assert_int_equal(size, 12);
+	assert_true(test_replay_random(data, 47));
+	assert_memory_equal(data, m_test_record_message + 0x10, 16);
+	assert_memory_equal(data + 16, m_test_record_message + 0x20, 31);
+	assert_int_equal(test_replay_send_message(NULL, 4,
+						  m_test_record_message + 0x40,
+						  0),
+			 RETURN_DEVICE_ERROR);
+	assert_int_equal(test_replay_stop(), RETURN_DEVICE_ERROR);
+
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_send_message(NULL, 8,
+						  m_test_record_message, 0),
+			 RETURN_SUCCESS);
+	size = sizeof(data);
+	assert_int_equal(test_replay_receive_message(NULL, &size, data, 0),
+			 RETURN_SUCCESS);
+	assert_false(test_replay_random(data, 49));
+	assert_int_equal(test_replay_stop(), RETURN_DEVICE_ERROR);
+
+	// The recorded receive error, then an early stop.
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_send_message(NULL, 8,
+						  m_test_record_message, 0),
+			 RETURN_SUCCESS);
+	size = sizeof(data);
+	assert_int_equal(test_replay_receive_message(NULL, &size, data, 0),
+			 RETURN_SUCCESS);
+	assert_true(test_replay_random(data, 48));
+	assert_int_equal(test_replay_send_message(NULL, 4,
+						  m_test_record_message + 0x40,
+						  0),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_stop(), RETURN_ABORTED);
+
+	assert_int_equal(test_record_test_replay_sample(trace_size),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	test_replay_send_message(NULL, 8, m_test_record_message, 0);
+	size = sizeof(data);
+	test_replay_receive_message(NULL, &size, data, 0);
+	test_replay_random(data, 48);
+	test_replay_send_message(NULL, 4, m_test_record_message + 0x40, 0);
+	size = sizeof(data);
+	assert_int_equal(test_replay_receive_message(NULL, &size, data, 0),
+			 RETURN_TIMEOUT);
+	assert_int_equal(test_replay_stop(), RETURN_SUCCESS);
+}
+
+//
+// The requests received by the recorded responder of test 4.
+//
+static spdm_get_version_request_t m_test_record_get_version = {
+	{ SPDM_MESSAGE_VERSION_10, SPDM_GET_VERSION, 0, 0 },
+};
+
+static spdm_get_capabilities_request m_test_record_get_capabilities = {
+	{ SPDM_MESSAGE_VERSION_11, SPDM_GET_CAPABILITIES, 0, 0 },
+	0,
+	0,
+	0,
+	0,
+};
+
+static void *m_test_record_responder_request[] = {
+	&m_test_record_get_version,
+	&m_test_record_get_capabilities,
+};
+
+static uintn m_test_record_responder_request_size[] = {
+	sizeof(m_test_record_get_version),
+	sizeof(m_test_record_get_capabilities),
+};
+
+/**
+  Create a responder with the device IO of the record or the replay transport.
+
+  @param  record                        Record the responder, or replay it.
+  @param  ct_exponent                   The CT exponent of the responder.
+
+  @return The responder, freed by the caller.
+**/
+static void *test_record_test_create_responder(IN boolean record,
+					       IN uint8 ct_exponent)
+{
+	void *spdm_context;
+	spdm_data_parameter_t parameter;
+	uint32 capability_flags;
+
+	spdm_context = (void *)malloc(libspdm_get_context_size());
+	assert_non_null(spdm_context);
+	libspdm_init_context(spdm_context);
+	if (record) {
+		libspdm_register_device_io_func(spdm_context,
+						test_record_send_message,
+						test_record_receive_message);
+	} else {
+		libspdm_register_device_io_func(spdm_context,
+						test_replay_send_message,
+						test_replay_receive_message);
+	}
+	libspdm_register_transport_layer_func(
+		spdm_context, spdm_transport_test_encode_message,
+		spdm_transport_test_decode_message);
+
+	zero_mem(&parameter, sizeof(parameter));
+	parameter.location = SPDM_DATA_LOCATION_LOCAL;
+	libspdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_CT_EXPONENT,
+			 &parameter, &ct_exponent, sizeof(ct_exponent));
+	capability_flags = SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+			   SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP;
+	libspdm_set_data(spdm_context, SPDM_DATA_CAPABILITY_FLAGS, &parameter,
+			 &capability_flags, sizeof(capability_flags));
+	return spdm_context;
+}
+
+/**
+  Dispatch the requests of m_test_record_responder_request in a responder.
+
+  In record mode, each request is encoded with the test transport for the test device.
+
+  @param  spdm_context                  The responder.
+  @param  record                        Record the responder, or replay it.
+
+  @return The status of the first failed dispatch, or RETURN_SUCCESS.
+**/
+static return_status test_record_test_run_responder(IN void *spdm_context,
+						    IN boolean record)
+{
+	return_status status;
+	uintn index;
+
+	for (index = 0; index < ARRAY_SIZE(m_test_record_responder_request);
+	     index++) {
+		if (record) {
+			m_test_record_device_response_size =
+				sizeof(m_test_record_device_response);
+			status = spdm_transport_test_encode_message(
+				spdm_context, NULL, FALSE, TRUE,
+				m_test_record_responder_request_size[index],
+				m_test_record_responder_request[index],
+				&m_test_record_device_response_size,
+				m_test_record_device_response);
+			assert_int_equal(status, RETURN_SUCCESS);
+		}
+		status = libspdm_responder_dispatch_message(spdm_context);
+		if (RETURN_ERROR(status)) {
+			return status;
+		}
+	}
+	return RETURN_SUCCESS;
+}
+
+/**
+  Test 4: a responder is recorded while it processes GET_VERSION and GET_CAPABILITIES, and is
+  replayed from the trace alone.
+  Expected behavior: the replayed responder sends the recorded CAPABILITIES, and a responder
+  with another CT exponent diverges from the trace.
+**/
+static void test_record_case4(void **state)
+{
+	void *spdm_context;
+	spdm_message_header_t *header;
+	uintn trace_size;
+
+	spdm_context = test_record_test_create_responder(TRUE, 3);
+	test_record_test_start(sizeof(m_test_record_trace));
+	assert_int_equal(test_record_test_run_responder(spdm_context, TRUE),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_record_stop(&trace_size), RETURN_SUCCESS);
+	free(spdm_context);
+	header = (void *)(m_test_record_device_request +
+			  sizeof(test_message_header_t));
+	assert_int_equal(header->request_response_code, SPDM_CAPABILITIES);
+
+	spdm_context = test_record_test_create_responder(FALSE, 3);
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_record_test_run_responder(spdm_context, FALSE),
+			 RETURN_SUCCESS);
+	assert_int_equal(test_replay_stop(), RETURN_SUCCESS);
+	free(spdm_context);
+
+	spdm_context = test_record_test_create_responder(FALSE, 4);
+	assert_int_equal(test_replay_start(m_test_record_trace, trace_size,
+					   NULL, NULL),
+			 RETURN_SUCCESS);
+	assert_true(RETURN_ERROR(
+		test_record_test_run_responder(spdm_context, FALSE)));
+	assert_int_equal(test_replay_stop(), RETURN_DEVICE_ERROR);
+	free(spdm_context);
+}
+
+int spdm_transport_test_record_test_main(void)
+{
+	const struct CMUnitTest spdm_transport_test_record_tests[] = {
+		// LEB128 round trips of the sizes and the time deltas
+		cmocka_unit_test(test_record_case1),
+		// Truncated traces
+		cmocka_unit_test(test_record_case2),
+		// Divergence detection
+		cmocka_unit_test(test_record_case3),
+		// Responder replay
+		cmocka_unit_test(test_record_case4),
+	};
+
+	return cmocka_run_group_tests(spdm_transport_test_record_tests, NULL,
+				      NULL);
+}